@@ -0,0 +1,153 @@
+/*	Daniel McNulty II
+*
+*	"Adjoint Test Source.cpp"
+*
+*	Checks the adjoint gradients of calls and puts against the closed form Greeks over a random book, that
+*	the recorded price is identical to CallPrice()/PutPrice(), that the batch and EuropeanOption::Gradient()
+*	agree with the single option function, and that a reused tape stops growing after the first call.
+*	Then times one price, one adjoint sweep and the twelve repricings central differences need for the
+*	same six sensitivities, and shows the error of DeltaDiff() against the adjoint delta for a range of
+*	bump sizes. Returns 1 on any failure.
+*/
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionAdjoint.h"
+#include "EuropeanOptionBatch.h"
+#include "NormalDistribution.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+using namespace std;
+
+bool Check(const char* Name, bool Passed)		// Print one result, true if it passed
+{
+	cout << left << setw(52) << Name << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed;
+}
+
+double Relative(double Value, double Exact)		// Error relative to Exact, absolute below 1
+{
+	return fabs(Value - Exact) / fmax(1.0, fabs(Exact));
+}
+
+int main()
+{
+	bool Passed = true;
+
+	// Random book of calls and puts with every kind of carry
+	const size_t Rows = 2000;
+	mt19937_64 Generator(2020);
+	uniform_real_distribution<> Unit(0.0, 1.0);
+	EuroOptBatch Book;
+	Book.Reserve(Rows);
+	for (size_t i = 0; i < Rows; i++)
+	{
+		double r = 0.1 * Unit(Generator);
+		Book.AddRow(0.05 + 3.0 * Unit(Generator), 50.0 + 100.0 * Unit(Generator), 0.05 + 0.6 * Unit(Generator), r, 100.0, r - 0.1 + 0.2 * Unit(Generator));
+	}
+
+	// Every partial against the closed forms
+	double Worst = 0.0;
+	bool Identical = true;
+	for (size_t i = 0; i < Rows; i++)
+	{
+		double T = Book.T[i], K = Book.K[i], sig = Book.sig[i], r = Book.r[i], U = Book.U[i], b = Book.b[i];
+		AdjointGreeks C = CallAdjoint(T, K, sig, r, U, b);
+		AdjointGreeks P = PutAdjoint(T, K, sig, r, U, b);
+		Identical = Identical && (C.Price == CallPrice(T, K, sig, r, U, b)) && (P.Price == PutPrice(T, K, sig, r, U, b));
+		double d2 = ((log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T))) - (sig * sqrt(T));
+		double CallStrike = -exp(-r * T) * NormCdf(d2);		// Dual delta, dC/dK = -exp(-rT) N(d2)
+		double PutStrike = exp(-r * T) * NormCdf(-d2);
+		double Errors[12] = {
+			Relative(C.dU, CallDelta(T, K, sig, r, U, b)), Relative(P.dU, PutDelta(T, K, sig, r, U, b)),
+			Relative(C.dsig, CallVega(T, K, sig, r, U, b)), Relative(P.dsig, PutVega(T, K, sig, r, U, b)),
+			Relative(-C.dT, CallTheta(T, K, sig, r, U, b)), Relative(-P.dT, PutTheta(T, K, sig, r, U, b)),
+			Relative(C.dr + C.db, CallRho(T, K, sig, r, U, b)), Relative(P.dr + P.db, PutRho(T, K, sig, r, U, b)),
+			Relative(C.db, CallCarryRho(T, K, sig, r, U, b)), Relative(P.db, PutCarryRho(T, K, sig, r, U, b)),
+			Relative(C.dK, CallStrike), Relative(P.dK, PutStrike) };
+		for (double Error : Errors)
+		{
+			Worst = fmax(Worst, Error);
+		}
+	}
+	cout << "Largest gradient error against the closed forms " << Worst << endl;
+	Passed = Check("Adjoint gradients match the closed form Greeks", Worst < 1e-11) && Passed;
+	Passed = Check("Recorded prices identical to CallPrice/PutPrice", Identical) && Passed;
+
+	// Batch and member function against the single option function
+	AlignedColumn Prices;
+	EuroOptBatch Gradient;
+	AdjointBatch(Book, Put, Prices, Gradient, Parallel_Execution);
+	AdjointGreeks Last = PutAdjoint(Book.T[Rows - 1], Book.K[Rows - 1], Book.sig[Rows - 1], Book.r[Rows - 1], Book.U[Rows - 1], Book.b[Rows - 1]);
+	EuropeanOption Option(Book.T[Rows - 1], Book.K[Rows - 1], Book.sig[Rows - 1], Book.r[Rows - 1], Book.U[Rows - 1], Book.b[Rows - 1], Put);
+	AdjointGreeks Member = Option.Gradient();
+	Passed = Check("Batch row identical to PutAdjoint", (Prices[Rows - 1] == Last.Price) && (Gradient.sig[Rows - 1] == Last.dsig) && (Gradient.T[Rows - 1] == Last.dT)) && Passed;
+	Passed = Check("EuropeanOption::Gradient identical to PutAdjoint", (Member.Price == Last.Price) && (Member.dU == Last.dU) && (Member.dK == Last.dK)) && Passed;
+
+	// A reused tape keeps its memory, the thread's tape is already warm from the loop above
+	size_t Capacity = ThreadTape().Capacity();
+	size_t Nodes = ThreadTape().Size();
+	for (size_t i = 0; i < Rows; i++)
+	{
+		CallAdjoint(Book.T[i], Book.K[i], Book.sig[i], Book.r[i], Book.U[i], Book.b[i]);
+	}
+	cout << "Tape nodes per option " << Nodes << ", capacity " << Capacity << endl;
+	Passed = Check("Reused tape does not grow", ThreadTape().Capacity() == Capacity) && Passed;
+
+	// Cost of the six sensitivities, in units of one price
+	const int Repeats = 50;
+	double Sink = 0.0;
+	auto Start = chrono::steady_clock::now();
+	for (int Repeat = 0; Repeat < Repeats; Repeat++)
+	{
+		for (size_t i = 0; i < Rows; i++)
+		{
+			Sink += CallPrice(Book.T[i], Book.K[i], Book.sig[i], Book.r[i], Book.U[i], Book.b[i]);
+		}
+	}
+	double PriceTime = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	Start = chrono::steady_clock::now();
+	for (int Repeat = 0; Repeat < Repeats; Repeat++)
+	{
+		for (size_t i = 0; i < Rows; i++)
+		{
+			Sink += CallAdjoint(Book.T[i], Book.K[i], Book.sig[i], Book.r[i], Book.U[i], Book.b[i]).dU;
+		}
+	}
+	double AdjointTime = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	Start = chrono::steady_clock::now();
+	for (int Repeat = 0; Repeat < Repeats; Repeat++)
+	{
+		for (size_t i = 0; i < Rows; i++)
+		{
+			double T = Book.T[i], K = Book.K[i], sig = Book.sig[i], r = Book.r[i], U = Book.U[i], b = Book.b[i];
+			Sink += CallDeltaDiff(T, K, sig, r, U, b, 1e-4 * U);
+			Sink += CallPrice(T + 1e-4, K, sig, r, U, b) - CallPrice(T - 1e-4, K, sig, r, U, b);
+			Sink += CallPrice(T, K + 1e-2, sig, r, U, b) - CallPrice(T, K - 1e-2, sig, r, U, b);
+			Sink += CallPrice(T, K, sig + 1e-4, r, U, b) - CallPrice(T, K, sig - 1e-4, r, U, b);
+			Sink += CallPrice(T, K, sig, r + 1e-4, U, b) - CallPrice(T, K, sig, r - 1e-4, U, b);
+			Sink += CallPrice(T, K, sig, r, U, b + 1e-4) - CallPrice(T, K, sig, r, U, b - 1e-4);
+		}
+	}
+	double BumpTime = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	double PerOption = 1e9 / (Repeats * Rows);
+	cout << endl << "METHOD                      | NS PER OPTION | PRICES" << endl << fixed << setprecision(1);
+	cout << left << setw(28) << "Price" << "| " << setw(14) << PriceTime * PerOption << "| " << 1.0 << endl;
+	cout << left << setw(28) << "Adjoint, price + 6 partials" << "| " << setw(14) << AdjointTime * PerOption << "| " << AdjointTime / PriceTime << endl;
+	cout << left << setw(28) << "Central differences, 6" << "| " << setw(14) << BumpTime * PerOption << "| " << BumpTime / PriceTime << endl;
+	cout << defaultfloat << setprecision(6) << (Sink == 0.0 ? " " : "") << endl;		// Sink keeps the timed calls from being dropped
+
+	// Divided difference delta error against the bump size, truncation for large h and cancellation for small h
+	const double T = 0.5, K = 100.0, sig = 0.25, r = 0.05, U = 100.0, b = 0.02;
+	double Exact = CallAdjoint(T, K, sig, r, U, b).dU;
+	cout << endl << "BUMP      | DELTADIFF ERROR" << endl;
+	for (double h : { 1.0, 1e-2, 1e-4, 1e-6, 1e-8, 1e-10 })
+	{
+		cout << left << setw(10) << h << "| " << fabs(CallDeltaDiff(T, K, sig, r, U, b, h) - Exact) << endl;
+	}
+
+	cout << endl << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed ? 0 : 1;
+}
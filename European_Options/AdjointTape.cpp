@@ -0,0 +1,91 @@
+/*	Daniel McNulty II
+*
+*	AdjointTape.cpp
+*/
+
+#include "AdjointTape.h"
+
+using namespace std;
+
+const size_t InitialTapeNodes = 256;		// Nodes reserved by a new tape, enough for the European pricers without growing
+
+// ADJOINTTAPE CONSTRUCTORS
+AdjointTape::AdjointTape()		// Default constructor, an empty tape
+{
+	Nodes.reserve(InitialTapeNodes);
+	Adjoints.reserve(InitialTapeNodes);
+}
+
+// ADJOINTTAPE DESTRUCTORS
+AdjointTape::~AdjointTape()		// Default destructor
+{
+}
+
+// ADJOINTTAPE RECORDING
+ADouble AdjointTape::Input(double Value)		// New independent variable
+{
+	return ADouble(Value, Push(-1, 0.0, -1, 0.0), this);
+}
+
+void AdjointTape::Rewind()		// Forget every node and adjoint, keeping their memory for the next recording
+{
+	Nodes.clear();
+	Adjoints.clear();
+}
+
+// ADJOINTTAPE PROPAGATION
+void AdjointTape::Propagate(const ADouble& Output)		// Adjoints of every node with respect to Output
+{
+	Adjoints.assign(Nodes.size(), 0.0);
+	if ((Output.Tape != this) || (Output.Index < 0))
+	{
+		return;		// A constant output depends on nothing
+	}
+
+	// Every node is recorded after its operands, so one backward sweep sees each adjoint complete before using it
+	Adjoints[Output.Index] = 1.0;
+	for (int i = Output.Index; i >= 0; i--)
+	{
+		double Bar = Adjoints[i];
+		if (Bar == 0.0)
+		{
+			continue;
+		}
+		const TapeNode& Node = Nodes[i];
+		if (Node.Arg[0] >= 0)
+		{
+			Adjoints[Node.Arg[0]] += Node.Partial[0] * Bar;
+		}
+		if (Node.Arg[1] >= 0)
+		{
+			Adjoints[Node.Arg[1]] += Node.Partial[1] * Bar;
+		}
+	}
+}
+
+double AdjointTape::Adjoint(const ADouble& x) const		// d Output / d x after Propagate()
+{
+	if ((x.Tape != this) || (x.Index < 0) || (static_cast<size_t>(x.Index) >= Adjoints.size()))
+	{
+		return 0.0;
+	}
+	return Adjoints[x.Index];
+}
+
+// ADJOINTTAPE ACCESSORS
+size_t AdjointTape::Size() const		// Recorded nodes
+{
+	return Nodes.size();
+}
+
+size_t AdjointTape::Capacity() const		// Nodes that fit without allocating
+{
+	return Nodes.capacity();
+}
+
+// GLOBAL TAPE FUNCTIONS
+AdjointTape& ThreadTape()		// The calling thread's tape, kept for the life of the thread
+{
+	static thread_local AdjointTape Tape;
+	return Tape;
+}
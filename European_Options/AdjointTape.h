@@ -0,0 +1,157 @@
+/*	Daniel McNulty II
+*
+*	AdjointTape.h
+*
+*	Tape based reverse mode algorithmic differentiation. An ADouble computes its value like a double and
+*	records every operation on a tape as one node holding the partial derivatives of the result with
+*	respect to its (at most two) operands. Propagate() then sweeps the tape once from the output back to
+*	the inputs, accumulating adjoints, which gives the derivative of the output with respect to every
+*	input for a small constant multiple of the cost of the recording, however many inputs there are.
+*
+*	Rewind() forgets a recording but keeps the memory of the node and adjoint arrays, so a tape that is
+*	reused never allocates once it has grown to the largest recording. ThreadTape() hands out one such
+*	tape per thread, which is how the pricers stay allocation free when called repeatedly or from the
+*	rows of a parallel loop. Values are computed with the same double expressions as without the tape,
+*	so a recorded price is identical to the plain one.
+*/
+
+#ifndef AdjointTape_H
+#define AdjointTape_H
+
+#include "NormalDistribution.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+class AdjointTape;
+
+struct TapeNode			// One recorded operation
+{
+	int Arg[2];			// Tape index of each operand, -1 for none or for a constant
+	double Partial[2];	// Derivative of the result with respect to each operand
+};
+
+class ADouble			// Value that records the operations applied to it
+{
+public:
+	double Value;		// Value, the same as the double computation would give
+	int Index;			// Node of the value on Tape, -1 for a constant
+	AdjointTape* Tape;	// Tape the value is recorded on, null for a constant
+
+	// Constructors
+	ADouble() : Value(0.0), Index(-1), Tape(nullptr) {}													// Default constructor, the constant 0
+	ADouble(double newValue) : Value(newValue), Index(-1), Tape(nullptr) {}								// Constructor of a constant
+	ADouble(double newValue, int newIndex, AdjointTape* newTape) : Value(newValue), Index(newIndex), Tape(newTape) {}	// Constructor of a recorded value
+};
+
+class AdjointTape
+{
+private:
+	vector<TapeNode> Nodes;			// Recorded operations in the order they were computed
+	vector<double> Adjoints;		// Adjoint of every node after Propagate()
+
+public:
+	// Constructors
+	AdjointTape();					// Default constructor, an empty tape
+	// Destructors
+	virtual ~AdjointTape();			// Default destructor
+
+	// Recording
+	ADouble Input(double Value);							// New independent variable
+	int Push(int Arg0, double Partial0, int Arg1, double Partial1);		// Record one operation, returns its node
+	void Rewind();											// Forget every node and adjoint, keeping their memory for the next recording
+
+	// Propagation
+	void Propagate(const ADouble& Output);					// Adjoints of every node with respect to Output
+	double Adjoint(const ADouble& x) const;					// d Output / d x after Propagate(), 0 for a constant or a value Output does not depend on
+
+	// Accessors
+	size_t Size() const;			// Recorded nodes
+	size_t Capacity() const;		// Nodes that fit without allocating
+
+private:
+	AdjointTape(const AdjointTape& source);						// Not copyable
+	AdjointTape& operator = (const AdjointTape& source);		// Not assignable
+};
+
+AdjointTape& ThreadTape();			// The calling thread's tape, kept for the life of the thread and reused by every recording on it
+
+inline int AdjointTape::Push(int Arg0, double Partial0, int Arg1, double Partial1)		// Record one operation, returns its node
+{
+	TapeNode Node = { { Arg0, Arg1 }, { Partial0, Partial1 } };
+	Nodes.push_back(Node);
+	return static_cast<int>(Nodes.size()) - 1;
+}
+
+// Recording helpers, a result is a constant unless an operand is recorded
+inline ADouble Recorded(double Value, const ADouble& a, double da)		// Result of a unary operation
+{
+	if (!a.Tape)
+	{
+		return ADouble(Value);
+	}
+	return ADouble(Value, a.Tape->Push(a.Index, da, -1, 0.0), a.Tape);
+}
+
+inline ADouble Recorded(double Value, const ADouble& a, double da, const ADouble& b, double db)	// Result of a binary operation
+{
+	AdjointTape* Tape = a.Tape ? a.Tape : b.Tape;
+	if (!Tape)
+	{
+		return ADouble(Value);
+	}
+	return ADouble(Value, Tape->Push(a.Index, da, b.Index, db), Tape);
+}
+
+// Arithmetic operators
+inline ADouble operator + (const ADouble& a, const ADouble& b) { return Recorded(a.Value + b.Value, a, 1.0, b, 1.0); }
+inline ADouble operator - (const ADouble& a, const ADouble& b) { return Recorded(a.Value - b.Value, a, 1.0, b, -1.0); }
+inline ADouble operator * (const ADouble& a, const ADouble& b) { return Recorded(a.Value * b.Value, a, b.Value, b, a.Value); }
+inline ADouble operator / (const ADouble& a, const ADouble& b) { return Recorded(a.Value / b.Value, a, 1.0 / b.Value, b, -a.Value / (b.Value * b.Value)); }
+inline ADouble operator - (const ADouble& a) { return Recorded(-a.Value, a, -1.0); }
+
+inline ADouble operator + (const ADouble& a, double b) { return Recorded(a.Value + b, a, 1.0); }
+inline ADouble operator + (double a, const ADouble& b) { return Recorded(a + b.Value, b, 1.0); }
+inline ADouble operator - (const ADouble& a, double b) { return Recorded(a.Value - b, a, 1.0); }
+inline ADouble operator - (double a, const ADouble& b) { return Recorded(a - b.Value, b, -1.0); }
+inline ADouble operator * (const ADouble& a, double b) { return Recorded(a.Value * b, a, b); }
+inline ADouble operator * (double a, const ADouble& b) { return Recorded(a * b.Value, b, a); }
+inline ADouble operator / (const ADouble& a, double b) { return Recorded(a.Value / b, a, 1.0 / b); }
+inline ADouble operator / (double a, const ADouble& b) { return Recorded(a / b.Value, b, -a / (b.Value * b.Value)); }
+
+// Elementary functions
+inline ADouble exp(const ADouble& x)		// e^x
+{
+	double Value = exp(x.Value);
+	return Recorded(Value, x, Value);
+}
+
+inline ADouble log(const ADouble& x)		// Natural logarithm
+{
+	return Recorded(log(x.Value), x, 1.0 / x.Value);
+}
+
+inline ADouble sqrt(const ADouble& x)		// Square root
+{
+	double Value = sqrt(x.Value);
+	return Recorded(Value, x, 0.5 / Value);
+}
+
+inline ADouble pow(const ADouble& x, double p)		// x^p for a constant power
+{
+	return Recorded(pow(x.Value, p), x, p * pow(x.Value, p - 1.0));
+}
+
+inline ADouble NormCdf(const ADouble& x)	// N(x) with the active backend, its derivative is the exact density
+{
+	return Recorded(NormCdf(x.Value), x, NormPdf(x.Value, Full_Normal));
+}
+
+inline ADouble NormPdf(const ADouble& x)	// n(x) with the active backend
+{
+	double Value = NormPdf(x.Value);
+	return Recorded(Value, x, -x.Value * Value);
+}
+
+#endif
@@ -0,0 +1,109 @@
+/*	Daniel McNulty II
+*
+*	"American Benchmark Source.cpp"
+*
+*	Accuracy and speed of the finite maturity American pricers. A random book of calls and puts is priced
+*	on a 2001 step Leisen-Reimer lattice with the control variate as the reference, then with the
+*	Barone-Adesi-Whaley and Bjerksund-Stensland 2002 approximations and with coarser lattices. For each
+*	pricer it reports the largest and RMS absolute error against the reference and the time per option.
+*/
+
+#include "AmericanOptionApprox.h"
+#include "AmericanOptionLattice.h"
+#include "EuropeanOptionBatch.h"
+#include "EuropeanOptionSIMD.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+using namespace std;
+
+const LatticeSettings Reference_Lattice = { Leisen_Reimer_Lattice, 2001, true };	// Leisen-Reimer error falls as 1 / Steps^2, so this is converged to a small fraction of a cent
+
+struct AmericanPricer		// One row of the report
+{
+	string Name;					// Printed name
+	bool Lattice;					// Priced by AmericanPriceBatch() with Settings, otherwise by AmericanApproxBatch() with Method
+	LatticeSettings Settings;		// Lattice of the row
+	AmericanApproximation Method;	// Approximation of the row
+};
+
+int main()
+{
+	// Random book with early exercise for both calls (b < r) and puts (r > 0), strikes around the spot
+	const size_t Rows = 1000;
+	mt19937_64 Generator(2020);
+	uniform_real_distribution<> Unit(0.0, 1.0);
+	EuroOptBatch Book;
+	Book.Reserve(Rows);
+	for (size_t i = 0; i < Rows; i++)
+	{
+		double r = 0.01 + 0.08 * Unit(Generator);
+		Book.AddRow(0.05 + 2.0 * Unit(Generator), 70.0 + 60.0 * Unit(Generator), 0.1 + 0.4 * Unit(Generator), r, 100.0, r - 0.1 * Unit(Generator));
+	}
+
+	AlignedColumn Reference[2];
+	for (OptionType Type : { Call, Put })
+	{
+		AmericanPriceBatch(Book, Type, Reference[Type], Reference_Lattice);
+	}
+
+	const AmericanPricer Pricers[] = {
+		{ "BAW", false, Default_Lattice, Barone_Adesi_Whaley },
+		{ "BS2002", false, Default_Lattice, Bjerksund_Stensland_2002 },
+		{ "LR 101 CV", true, { Leisen_Reimer_Lattice, 101, true }, Barone_Adesi_Whaley },
+		{ "LR 201 CV", true, { Leisen_Reimer_Lattice, 201, true }, Barone_Adesi_Whaley },
+		{ "CRR 201 CV", true, { CRR_Lattice, 201, true }, Barone_Adesi_Whaley } };
+
+	cout << "SIMD path: " << SimdPathName(DetectSimdPath()) << ", " << Rows << " calls and puts against an LR " << Reference_Lattice.Steps << " step lattice" << endl
+		 << "PRICER      | CALL MAX ERROR | CALL RMS ERROR | PUT MAX ERROR | PUT RMS ERROR | ns/option" << endl;
+
+	double Checksum = 0.0;
+	for (const AmericanPricer& Pricer : Pricers)
+	{
+		double MaxError[2] = {}, SquareSum[2] = {};
+		AlignedColumn Out;
+
+		// Repeat the fast pricers so their timings are not dominated by the clock
+		int Repeats = Pricer.Lattice ? 1 : 50;
+		auto Start = chrono::steady_clock::now();
+		for (int Repeat = 0; Repeat < Repeats; Repeat++)
+		{
+			for (OptionType Type : { Call, Put })
+			{
+				if (Pricer.Lattice)
+					AmericanPriceBatch(Book, Type, Out, Pricer.Settings);
+				else
+					AmericanApproxBatch(Book, Type, Pricer.Method, Out);
+				Checksum += Out[0];
+			}
+		}
+		double Ns = chrono::duration<double, nano>(chrono::steady_clock::now() - Start).count() / (2.0 * Rows * Repeats);
+
+		for (OptionType Type : { Call, Put })
+		{
+			if (Pricer.Lattice)
+				AmericanPriceBatch(Book, Type, Out, Pricer.Settings);
+			else
+				AmericanApproxBatch(Book, Type, Pricer.Method, Out);
+			for (size_t i = 0; i < Rows; i++)
+			{
+				double Error = Out[i] - Reference[Type][i];
+				MaxError[Type] = fmax(MaxError[Type], fabs(Error));
+				SquareSum[Type] += Error * Error;
+			}
+		}
+
+		cout << left << setw(12) << setfill(' ') << Pricer.Name
+			 << "| " << left << setw(15) << MaxError[Call]
+			 << "| " << left << setw(15) << sqrt(SquareSum[Call] / Rows)
+			 << "| " << left << setw(14) << MaxError[Put]
+			 << "| " << left << setw(14) << sqrt(SquareSum[Put] / Rows)
+			 << "| " << Ns << endl;
+	}
+
+	cout << "Checksum: " << Checksum << endl;		// Printed so the timed loops cannot be optimized away
+	return 0;
+}
@@ -0,0 +1,368 @@
+/*	Daniel McNulty II
+*
+*	AmericanOptionApprox.cpp
+*/
+
+#include "AmericanOptionApprox.h"
+#include "AmericanOptionApproxKernel.h"
+#include "EuropeanOptionKernels.h"
+#include "EuropeanOptionSIMD.h"
+#include "NormalDistribution.h"
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+const size_t BoundaryChunkRows = 256;		// Rows whose boundaries are solved together before their prices, small enough to stay in L1
+
+// KERNELS
+void BAWBoundaryScalar(OptionType Type, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* b, double* Boundary)
+{
+	BAWBoundaryType<ScalarLanes>(Type, n, T, K, sig, r, b, Boundary);
+}
+
+static void BAWBoundaryColumns(SimdPath Path, OptionType Type, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* b, double* Boundary)	// Boundaries of n rows on a code path
+{
+	switch (Path)
+	{
+#ifdef EUROPEAN_SIMD_X86
+	case (AVX512_Path):
+		BAWBoundaryAVX512(Type, n, T, K, sig, r, b, Boundary);
+		break;
+	case (AVX2_Path):
+		BAWBoundaryAVX2(Type, n, T, K, sig, r, b, Boundary);
+		break;
+#endif
+	default:
+		BAWBoundaryScalar(Type, n, T, K, sig, r, b, Boundary);
+		break;
+	}
+}
+
+// BARONE-ADESI-WHALEY
+static double Intrinsic(OptionType Type, double K, double U)		// Value of exercising now
+{
+	double Exercise = (Type == Call) ? (U - K) : (K - U);
+	return (Exercise > 0.0) ? Exercise : 0.0;
+}
+
+static bool EarlyExercise(OptionType Type, double r, double b)		// False where the American option is worth the European one
+{
+	// Single boundary rule: a call is exercised early only when it pays a positive yield r - b, a put only when
+	// r > 0. With negative rates a call with r < b < 0 (a put with r < 0 < b) can have two exercise boundaries,
+	// which neither approximation models, so those options are priced at the European value, a lower bound
+
+	return (Type == Call) ? (b < r) : (r > 0.0);
+}
+
+template <OptionType Type>
+static double BAWPrice(double T, double K, double sig, double r, double U, double b, double Si)	// Price from the critical price Si
+{
+	if (!(T > 0.0))
+	{
+		return Intrinsic(Type, K, U);
+	}
+
+	double European = KernelPrice<Type, General_Carry>(T, K, sig, r, U, b);
+	if (!EarlyExercise(Type, r, b))
+	{
+		return European;
+	}
+	if ((Type == Call) ? (U >= Si) : (U <= Si))
+	{
+		return Intrinsic(Type, K, U);
+	}
+
+	// Exponent of the early exercise premium, the same quadratic root the boundary solve uses
+	double Var = sig * sig;
+	double rT = r * T;
+	double Annuity = (fabs(rT) > BAWSmallRate) ? (rT / (1.0 - exp(-rT))) : (1.0 + (0.5 * rT));
+	double Nm1 = ((2.0 * b) / Var) - 1.0;
+	double Root = sqrt((Nm1 * Nm1) + ((8.0 * Annuity) / (Var * T)));
+	double q = 0.5 * (-Nm1 + ((Type == Call) ? Root : -Root));
+
+	double d1 = (log(Si / K) + ((b + (Var / 2)) * T)) / (sig * sqrt(T));
+	double CarryDiscount = exp((b - r) * T);
+	double A = (Type == Call) ? ((Si / q) * (1.0 - (CarryDiscount * NormCdf(d1)))) : (-(Si / q) * (1.0 - (CarryDiscount * NormCdf(-d1))));
+	return European + (A * pow(U / Si, q));
+}
+
+// BJERKSUND-STENSLAND 2002
+static double Phi(double S, double T, double gamma, double h, double i, double r, double b, double sig)		// Value of S^gamma paid on first hitting i before T, provided S stays above h
+{
+	double Var = sig * sig;
+	double sigSqrtT = sig * sqrt(T);
+	double Lambda = -r + (gamma * b) + (0.5 * gamma * (gamma - 1.0) * Var);
+	double d = -(log(S / h) + ((b + ((gamma - 0.5) * Var)) * T)) / sigSqrtT;
+	double Kappa = ((2.0 * b) / Var) + ((2.0 * gamma) - 1.0);
+	return exp(Lambda * T) * pow(S, gamma) * (NormCdf(d) - (pow(i / S, Kappa) * NormCdf(d - ((2.0 * log(i / S)) / sigSqrtT))));
+}
+
+static double Ksi(double S, double T2, double gamma, double h, double I2, double I1, double t1, double r, double b, double sig, const BivariateNormTerms& Pos, const BivariateNormTerms& Neg)	// Two period counterpart of Phi, boundary I1 up to t1 and I2 after, Pos and Neg planned for +-sqrt(t1 / T2)
+{
+	double Var = sig * sig;
+	double Drift = b + ((gamma - 0.5) * Var);
+	double Short = sig * sqrt(t1), Long = sig * sqrt(T2);
+	double e1 = (log(S / I1) + (Drift * t1)) / Short;
+	double e2 = (log((I2 * I2) / (S * I1)) + (Drift * t1)) / Short;
+	double e3 = (log(S / I1) - (Drift * t1)) / Short;
+	double e4 = (log((I2 * I2) / (S * I1)) - (Drift * t1)) / Short;
+	double f1 = (log(S / h) + (Drift * T2)) / Long;
+	double f2 = (log((I2 * I2) / (S * h)) + (Drift * T2)) / Long;
+	double f3 = (log((I1 * I1) / (S * h)) + (Drift * T2)) / Long;
+	double f4 = (log((S * I1 * I1) / (h * I2 * I2)) + (Drift * T2)) / Long;
+	double Lambda = -r + (gamma * b) + (0.5 * gamma * (gamma - 1.0) * Var);
+	double Kappa = ((2.0 * b) / Var) + ((2.0 * gamma) - 1.0);
+	return exp(Lambda * T2) * pow(S, gamma) * (BivariateNormCdf(-e1, -f1, Pos) - (pow(I2 / S, Kappa) * BivariateNormCdf(-e2, -f2, Pos))
+		- (pow(I1 / S, Kappa) * BivariateNormCdf(-e3, -f3, Neg)) + (pow(I1 / I2, Kappa) * BivariateNormCdf(-e4, -f4, Neg)));
+}
+
+struct BS2002Boundary		// Flat exercise boundaries of a Bjerksund-Stensland 2002 call
+{
+	double Beta;		// Exponent of the perpetual call
+	double t1;			// End of the first period, (sqrt(5) - 1) T / 2
+	double I1;			// Trigger after t1
+	double I2;			// Trigger up to t1
+};
+
+static BS2002Boundary BS2002Triggers(double T, double K, double sig, double r, double b)		// Triggers of a call with b < r
+{
+	BS2002Boundary Out;
+	double Var = sig * sig;
+	double Half = 0.5 - (b / Var);
+	Out.Beta = Half + sqrt((Half * Half) + ((2.0 * r) / Var));
+	Out.t1 = 0.5 * (sqrt(5.0) - 1.0) * T;
+
+	double BInfinity = (Out.Beta / (Out.Beta - 1.0)) * K;
+	double B0 = fmax(K, (r / (r - b)) * K);
+	double Scale = (K * K) / ((BInfinity - B0) * B0);
+	double ht1 = -((b * Out.t1) + (2.0 * sig * sqrt(Out.t1))) * Scale;
+	double ht2 = -((b * T) + (2.0 * sig * sqrt(T))) * Scale;
+	Out.I1 = B0 + ((BInfinity - B0) * (1.0 - exp(ht1)));
+	Out.I2 = B0 + ((BInfinity - B0) * (1.0 - exp(ht2)));
+	return Out;
+}
+
+static double BS2002Call(double T, double K, double sig, double r, double U, double b)		// Call price, puts arrive here through the put-call transformation
+{
+	if (!(T > 0.0))
+	{
+		return Intrinsic(Call, K, U);
+	}
+	if (!(b < r))		// Never exercised early
+	{
+		return KernelPrice<Call, General_Carry>(T, K, sig, r, U, b);
+	}
+
+	BS2002Boundary B = BS2002Triggers(T, K, sig, r, b);
+	if (U >= B.I2)
+	{
+		return U - K;
+	}
+
+	// Every Ksi term shares the correlation sqrt(t1 / T), so its quadrature is planned once per option
+	double Rho = sqrt(B.t1 / T);
+	BivariateNormTerms Pos = BivariateNormPlan(Rho), Neg = BivariateNormPlan(-Rho);
+
+	double Alpha1 = (B.I1 - K) * pow(B.I1, -B.Beta);
+	double Alpha2 = (B.I2 - K) * pow(B.I2, -B.Beta);
+	return (Alpha2 * pow(U, B.Beta)) - (Alpha2 * Phi(U, B.t1, B.Beta, B.I2, B.I2, r, b, sig))
+		+ Phi(U, B.t1, 1.0, B.I2, B.I2, r, b, sig) - Phi(U, B.t1, 1.0, B.I1, B.I2, r, b, sig)
+		- (K * Phi(U, B.t1, 0.0, B.I2, B.I2, r, b, sig)) + (K * Phi(U, B.t1, 0.0, B.I1, B.I2, r, b, sig))
+		+ (Alpha1 * Phi(U, B.t1, B.Beta, B.I1, B.I2, r, b, sig)) - (Alpha1 * Ksi(U, T, B.Beta, B.I1, B.I2, B.I1, B.t1, r, b, sig, Pos, Neg))
+		+ Ksi(U, T, 1.0, B.I1, B.I2, B.I1, B.t1, r, b, sig, Pos, Neg) - Ksi(U, T, 1.0, K, B.I2, B.I1, B.t1, r, b, sig, Pos, Neg)
+		- (K * Ksi(U, T, 0.0, B.I1, B.I2, B.I1, B.t1, r, b, sig, Pos, Neg)) + (K * Ksi(U, T, 0.0, K, B.I2, B.I1, B.t1, r, b, sig, Pos, Neg));
+}
+
+static double ApproxPrice(AmericanApproximation Method, OptionType Type, double T, double K, double sig, double r, double U, double b)	// Price of one option with either approximation
+{
+	if (Method == Barone_Adesi_Whaley)
+		return (Type == Call) ? BAWCallPrice(T, K, sig, r, U, b) : BAWPutPrice(T, K, sig, r, U, b);
+	else
+		return (Type == Call) ? BS2002CallPrice(T, K, sig, r, U, b) : BS2002PutPrice(T, K, sig, r, U, b);
+}
+
+// AMERICANAPPROXOPTION MEMBER FUNCTIONS
+// Private Functions
+void AmericanApproxOption::Copy(const AmericanApproxOption& Opt)		// Copy all values from another AmericanApproxOption object
+{
+	Option::Copy(Opt);
+	T = Opt.T;
+	K = Opt.K;
+	sig = Opt.sig;
+	r = Opt.r;
+	U = Opt.U;
+	b = Opt.b;
+	Method = Opt.Method;
+}
+
+// Constructors
+AmericanApproxOption::AmericanApproxOption() : Option(), T(0.25), K(65), sig(0.30), r(0.08), U(60), b(0.08), Method(Bjerksund_Stensland_2002) {}	// Default constructor
+
+AmericanApproxOption::AmericanApproxOption(const AmericanApproxOption& Opt) : Option(Opt), T(Opt.T), K(Opt.K), sig(Opt.sig), r(Opt.r), U(Opt.U), b(Opt.b), Method(Opt.Method) {}	// Copy constructor
+
+AmericanApproxOption::AmericanApproxOption(const enum OptionType type) : Option(type), T(0.25), K(65), sig(0.30), r(0.08), U(60), b(0.08), Method(Bjerksund_Stensland_2002) {}	// Constructor that accepts option type
+
+AmericanApproxOption::AmericanApproxOption(double newT, double newK, double newSig, double newR, double newU, double newB) : Option(), T(newT), K(newK), sig(newSig), r(newR), U(newU), b(newB), Method(Bjerksund_Stensland_2002) {}		// Constructor that accepts all derived class data
+
+AmericanApproxOption::AmericanApproxOption(double newT, double newK, double newSig, double newR, double newU, double newB, const enum OptionType type) : Option(type), T(newT), K(newK), sig(newSig), r(newR), U(newU), b(newB), Method(Bjerksund_Stensland_2002) {}	// Constructor that accepts all base and derived class data
+
+// Destructors
+AmericanApproxOption::~AmericanApproxOption() {}		// Default destructor
+
+// Functionality
+double AmericanApproxOption::Price() const				// Calculate the price of the given option with its approximation
+{
+	return ApproxPrice(Method, optionType, T, K, sig, r, U, b);
+}
+
+double AmericanApproxOption::PriceWithS(double newU) const		// Calculate price using the set T, K, sig, r, and b with a different underlying value
+{
+	return ApproxPrice(Method, optionType, T, K, sig, r, newU, b);
+}
+
+double AmericanApproxOption::CriticalPrice() const		// Underlying price at which the approximation exercises now
+{
+	if (Method == Barone_Adesi_Whaley)
+		return ::BAWCriticalPrice(T, K, sig, r, b, optionType);
+	else
+		return ::BS2002CriticalPrice(T, K, sig, r, b, optionType);
+}
+
+// Assignment operator
+AmericanApproxOption& AmericanApproxOption::operator = (const AmericanApproxOption& Opt)
+{
+	if (this == &Opt)
+	{
+		return *this;
+	}
+	else
+	{
+		Option::operator = (Opt);
+		Copy(Opt);
+		return *this;
+	}
+}
+
+// GLOBAL AMERICAN APPROXIMATION FUNCTIONS
+double BAWCallPrice(double T, double K, double sig, double r, double U, double b)		// Barone-Adesi-Whaley price of call
+{
+	return BAWPrice<Call>(T, K, sig, r, U, b, BAWCriticalPrice(T, K, sig, r, b, Call));
+}
+
+double BAWPutPrice(double T, double K, double sig, double r, double U, double b)		// Barone-Adesi-Whaley price of put
+{
+	return BAWPrice<Put>(T, K, sig, r, U, b, BAWCriticalPrice(T, K, sig, r, b, Put));
+}
+
+double BS2002CallPrice(double T, double K, double sig, double r, double U, double b)	// Bjerksund-Stensland 2002 price of call
+{
+	return BS2002Call(T, K, sig, r, U, b);
+}
+
+double BS2002PutPrice(double T, double K, double sig, double r, double U, double b)		// Bjerksund-Stensland 2002 price of put, the call with U and K swapped, rate r - b and carry -b
+{
+	return BS2002Call(T, U, sig, r - b, K, -b);
+}
+
+double BAWCriticalPrice(double T, double K, double sig, double r, double b, OptionType Type)		// Barone-Adesi-Whaley critical price
+{
+	if (!(T > 0.0))
+	{
+		return K;
+	}
+	double Boundary;
+	BAWBoundaryScalar(Type, 1, &T, &K, &sig, &r, &b, &Boundary);
+	return Boundary;
+}
+
+double BS2002CriticalPrice(double T, double K, double sig, double r, double b, OptionType Type)	// Bjerksund-Stensland 2002 exercise trigger at the valuation date
+{
+	if (!(T > 0.0))
+	{
+		return K;
+	}
+	if (Type == Call)
+	{
+		return (b < r) ? BS2002Triggers(T, K, sig, r, b).I2 : numeric_limits<double>::infinity();
+	}
+
+	// The transformed call exercises once K reaches I2 of a call struck at U, and I2 scales with its strike
+	return (r > 0.0) ? ((K * K) / BS2002Triggers(T, K, sig, r - b, -b).I2) : 0.0;
+}
+
+void AmericanBoundaryBatch(const EuroOptBatch& Data, OptionType Type, AmericanApproximation Method, AlignedColumn& Boundary)		// Critical prices of every row on the calling thread
+{
+	AmericanBoundaryBatch(Data, Type, Method, Boundary, Serial_Execution);
+}
+
+void AmericanBoundaryBatch(const EuroOptBatch& Data, OptionType Type, AmericanApproximation Method, AlignedColumn& Boundary, const ExecutionPolicy& Policy)	// Critical prices of every row on Policy's threads
+{
+	size_t n = Data.Size();
+	Boundary.resize(n);
+	SimdPath Path = DetectSimdPath();
+
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		if (Method == Barone_Adesi_Whaley)
+		{
+			BAWBoundaryColumns(Path, Type, Last - First, Data.T.data() + First, Data.K.data() + First, Data.sig.data() + First, Data.r.data() + First, Data.b.data() + First, Boundary.data() + First);
+			for (size_t i = First; i < Last; i++)
+			{
+				if (!(Data.T[i] > 0.0))
+				{
+					Boundary[i] = Data.K[i];
+				}
+			}
+		}
+		else
+		{
+			for (size_t i = First; i < Last; i++)
+			{
+				Boundary[i] = BS2002CriticalPrice(Data.T[i], Data.K[i], Data.sig[i], Data.r[i], Data.b[i], Type);
+			}
+		}
+	}, Policy);
+}
+
+void AmericanApproxBatch(const EuroOptBatch& Data, OptionType Type, AmericanApproximation Method, AlignedColumn& Out)		// Prices of every row on the calling thread
+{
+	AmericanApproxBatch(Data, Type, Method, Out, Serial_Execution);
+}
+
+void AmericanApproxBatch(const EuroOptBatch& Data, OptionType Type, AmericanApproximation Method, AlignedColumn& Out, const ExecutionPolicy& Policy)	// Prices of every row on Policy's threads
+{
+	size_t n = Data.Size();
+	Out.resize(n);
+	SimdPath Path = DetectSimdPath();
+	NormalBackend Backend = ActiveNormalBackend();		// The caller's tier for the European legs on every thread
+
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		NormalBackendScope Scope(Backend);
+		if (Method == Bjerksund_Stensland_2002)
+		{
+			for (size_t i = First; i < Last; i++)
+			{
+				Out[i] = (Type == Call) ? BS2002CallPrice(Data.T[i], Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i]) : BS2002PutPrice(Data.T[i], Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i]);
+			}
+			return;
+		}
+
+		// Solve a chunk of boundaries on the vector path, then price the chunk against them
+		double Boundary[BoundaryChunkRows];
+		for (size_t Start = First; Start < Last; Start += BoundaryChunkRows)
+		{
+			size_t m = (Last - Start < BoundaryChunkRows) ? (Last - Start) : BoundaryChunkRows;
+			BAWBoundaryColumns(Path, Type, m, Data.T.data() + Start, Data.K.data() + Start, Data.sig.data() + Start, Data.r.data() + Start, Data.b.data() + Start, Boundary);
+			for (size_t j = 0; j < m; j++)
+			{
+				size_t i = Start + j;
+				if (Type == Call)
+					Out[i] = BAWPrice<Call>(Data.T[i], Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i], Boundary[j]);
+				else
+					Out[i] = BAWPrice<Put>(Data.T[i], Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i], Boundary[j]);
+			}
+		}
+	}, Policy);
+}
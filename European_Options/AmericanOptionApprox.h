@@ -0,0 +1,81 @@
+/*	Daniel McNulty II
+*
+*	AmericanOptionApprox.h
+*
+*	Closed form approximations of finite maturity American options for screening, where a lattice is too
+*	slow. Barone-Adesi-Whaley (1987) adds a quadratic early exercise premium to the European value and
+*	needs the critical price from a one dimensional root solve. Bjerksund-Stensland (2002) prices against
+*	a two piece flat exercise boundary in closed form, with bivariate normals. Both take the generalized
+*	cost of carry b and are built on the European generalized Black-Scholes kernel. Bjerksund-Stensland
+*	prices puts with the put-call transformation P(U, K, r, b) = C(K, U, r - b, -b).
+*	Both assume a single exercise boundary: calls are exercised early only when b < r and puts only when
+*	r > 0. The negative rate cases with two boundaries (calls with r < b < 0, puts with r < 0 < b) are
+*	priced at the European value, which is a lower bound there.
+*
+*	The batch pricers solve the Barone-Adesi-Whaley boundaries a chunk of rows at a time on the widest
+*	vector path of the CPU, every lane taking the same fixed number of Newton steps.
+*/
+
+#ifndef AmericanOptionApprox_H
+#define AmericanOptionApprox_H
+
+#include "EuropeanOptionBatch.h"
+#include "Option.h"
+#include "ThreadPool.h"
+using namespace std;
+
+enum AmericanApproximation		// Closed form approximation used by an AmericanApproxOption
+{
+	Barone_Adesi_Whaley,		// Quadratic approximation, Barone-Adesi and Whaley (1987)
+	Bjerksund_Stensland_2002	// Two step flat boundary, Bjerksund and Stensland (2002)
+};
+
+class AmericanApproxOption : public Option
+{
+private:
+	void Copy(const AmericanApproxOption& source);		// Copy all values from another AmericanApproxOption object
+
+public:
+	// Data members for the variables involved in American option pricing
+	double T;		// Expiry time
+	double K;		// Strike price
+	double sig;		// Volatility
+	double r;		// Risk free interest rate
+	double U;		// Current price of the underlying asset
+	double b;		// Cost of carry
+	AmericanApproximation Method;		// Approximation used by Price()
+
+public:
+	// Constructors
+	AmericanApproxOption();																											// Default constructor
+	AmericanApproxOption(const AmericanApproxOption& Opt);																			// Copy constructor
+	AmericanApproxOption(const enum OptionType type);																				// Constructor that accepts option type
+	AmericanApproxOption(double newT, double newK, double newSig, double newR, double newU, double newB);							// Constructor that accepts all derived class data
+	AmericanApproxOption(double newT, double newK, double newSig, double newR, double newU, double newB, const enum OptionType type);	// Constructor that accepts all base and derived class data
+	// Destructors
+	virtual ~AmericanApproxOption();			// Default destructor
+
+	// Functionality
+	double Price() const;						// Calculate the price of the given option with its approximation
+	double PriceWithS(double newU) const;		// Calculate price using the set T, K, sig, r, and b with a different underlying value
+	double CriticalPrice() const;				// Underlying price at which the approximation exercises now, infinite (call) or zero (put) if never
+
+	// Assignment operator
+	AmericanApproxOption& operator = (const AmericanApproxOption& Opt);
+};
+
+// Global American Approximation Functions
+double BAWCallPrice(double T, double K, double sig, double r, double U, double b);			// Barone-Adesi-Whaley price of call
+double BAWPutPrice(double T, double K, double sig, double r, double U, double b);			// Barone-Adesi-Whaley price of put
+double BS2002CallPrice(double T, double K, double sig, double r, double U, double b);		// Bjerksund-Stensland 2002 price of call
+double BS2002PutPrice(double T, double K, double sig, double r, double U, double b);		// Bjerksund-Stensland 2002 price of put
+double BAWCriticalPrice(double T, double K, double sig, double r, double b, OptionType Type);		// Barone-Adesi-Whaley critical price
+double BS2002CriticalPrice(double T, double K, double sig, double r, double b, OptionType Type);	// Bjerksund-Stensland 2002 exercise trigger at the valuation date
+
+// Batch functions, Out is resized to the size of Data and the U column is ignored by the boundary solve
+void AmericanBoundaryBatch(const EuroOptBatch& Data, OptionType Type, AmericanApproximation Method, AlignedColumn& Boundary);						// Critical prices of every row
+void AmericanBoundaryBatch(const EuroOptBatch& Data, OptionType Type, AmericanApproximation Method, AlignedColumn& Boundary, const ExecutionPolicy& Policy);
+void AmericanApproxBatch(const EuroOptBatch& Data, OptionType Type, AmericanApproximation Method, AlignedColumn& Out);								// Prices of every row
+void AmericanApproxBatch(const EuroOptBatch& Data, OptionType Type, AmericanApproximation Method, AlignedColumn& Out, const ExecutionPolicy& Policy);
+
+#endif
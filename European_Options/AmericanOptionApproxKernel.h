@@ -0,0 +1,152 @@
+/*	Daniel McNulty II
+*
+*	AmericanOptionApproxKernel.h
+*
+*	Lane-generic solve for the Barone-Adesi-Whaley critical price, shared by the scalar, AVX2 and AVX-512
+*	code paths. Every lane starts from the Barone-Adesi-Whaley seed and takes the same fixed number of
+*	Newton steps on the value matching condition, so the lanes never diverge and the loop has no
+*	branches. Lanes without early exercise (calls with b >= r, puts with r <= 0) get an infinite or zero
+*	boundary. Only AmericanOptionApprox.cpp and the instruction set specific translation units include
+*	this header; the instruction set specific units include it after enabling their instruction set.
+*/
+
+#ifndef AmericanOptionApproxKernel_H
+#define AmericanOptionApproxKernel_H
+
+#include "EuropeanOptionSIMDKernel.h"
+#include "Option.h"
+#include "SimdMath.h"
+#include <cstddef>
+#include <limits>
+
+const double BAWSmallRate = 1e-6;		// Below this |rT| the quadratic coefficient uses its series, 1 - exp(-rT) loses too many digits
+const int BAWBoundaryIterations = 16;		// Newton steps per row, the seed is within a few percent so this converges to rounding
+
+template <class Lanes, OptionType Type>
+inline void BAWBoundaryLanes(size_t i, const double* T, const double* K, const double* sig, const double* r, const double* b, double* Boundary)	// Critical prices of rows i to i + Lanes::Width - 1
+{
+	typedef typename Lanes::Vec Vec;
+
+	Vec vT = Lanes::Load(T + i), vK = Lanes::Load(K + i), vSig = Lanes::Load(sig + i);
+	Vec vR = Lanes::Load(r + i), vB = Lanes::Load(b + i);
+	Vec One = Lanes::Set1(1.0), Zero = Lanes::Set1(0.0), Two = Lanes::Set1(2.0);
+
+	// q from the quadratic in the Barone-Adesi-Whaley approximation, and its T -> infinity limit for the seed
+	Vec Var = Lanes::Mul(vSig, vSig);
+	Vec Nm1 = Lanes::Sub(Lanes::Div(Lanes::Mul(Two, vB), Var), One);				// 2b / sig^2 - 1
+	Vec M = Lanes::Div(Lanes::Mul(Two, vR), Var);									// 2r / sig^2
+	Vec Discount = SimdExp<Lanes>(Lanes::Sub(Zero, Lanes::Mul(vR, vT)));			// exp(-rT)
+	Vec CarryDiscount = SimdExp<Lanes>(Lanes::Mul(Lanes::Sub(vB, vR), vT));		// exp((b - r)T)
+	Vec rT = Lanes::Mul(vR, vT);
+	Vec Annuity = Lanes::Select(Lanes::Greater(Lanes::Abs(rT), Lanes::Set1(BAWSmallRate)), Lanes::Div(rT, Lanes::Sub(One, Discount)), Lanes::Fma(rT, Lanes::Set1(0.5), One));	// rT / (1 - exp(-rT)), series near r = 0
+	Vec Root = Lanes::Sqrt(Lanes::Fma(Nm1, Nm1, Lanes::Div(Lanes::Mul(Lanes::Set1(8.0), Annuity), Lanes::Mul(Var, vT))));	// 4M / (1 - exp(-rT)) = 8 Annuity / (sig^2 T)
+	Vec RootInf = Lanes::Sqrt(Lanes::Fma(Nm1, Nm1, Lanes::Mul(Lanes::Set1(4.0), M)));
+	Vec Sign = Lanes::Set1((Type == Call) ? 1.0 : -1.0);
+	Vec q = Lanes::Mul(Lanes::Set1(0.5), Lanes::Fma(Sign, Root, Lanes::Sub(Zero, Nm1)));
+	Vec qInf = Lanes::Mul(Lanes::Set1(0.5), Lanes::Fma(Sign, RootInf, Lanes::Sub(Zero, Nm1)));
+
+	// Seed, Barone-Adesi and Whaley (1987) equations 26 and 27
+	Vec sigSqrtT = Lanes::Mul(vSig, Lanes::Sqrt(vT));
+	Vec SInf = Lanes::Div(vK, Lanes::Sub(One, Lanes::Div(One, qInf)));
+	Vec Si;
+	if (Type == Call)
+	{
+		Vec h = Lanes::Div(Lanes::Mul(Lanes::Sub(Zero, Lanes::Fma(vB, vT, Lanes::Mul(Two, sigSqrtT))), vK), Lanes::Sub(SInf, vK));
+		Si = Lanes::Fma(Lanes::Sub(SInf, vK), Lanes::Sub(One, SimdExp<Lanes>(h)), vK);
+	}
+	else
+	{
+		Vec h = Lanes::Div(Lanes::Mul(Lanes::Sub(Lanes::Mul(vB, vT), Lanes::Mul(Two, sigSqrtT)), vK), Lanes::Sub(vK, SInf));
+		Si = Lanes::Fma(Lanes::Sub(vK, SInf), SimdExp<Lanes>(h), SInf);
+	}
+
+	// Newton steps on value matching, the European leg comes from the same generalized cost of carry formula as CallPrice()/PutPrice()
+	Vec Drift = Lanes::Fma(Var, Lanes::Set1(0.5), vB);
+	Vec InvQ = Lanes::Div(One, q);
+	for (int Step = 0; Step < BAWBoundaryIterations; Step++)
+	{
+		Vec d1 = Lanes::Div(Lanes::Fma(Drift, vT, SimdLog<Lanes>(Lanes::Div(Si, vK))), sigSqrtT);
+		Vec d2 = Lanes::Sub(d1, sigSqrtT);
+		Vec Tail1 = SimdNormTail<Lanes>(Lanes::Abs(d1));
+		Vec Tail2 = SimdNormTail<Lanes>(Lanes::Abs(d2));
+		Vec Nd1 = Lanes::Select(Lanes::Greater(d1, Zero), Lanes::Sub(One, Tail1), Tail1);
+		Vec Nd2 = Lanes::Select(Lanes::Greater(d2, Zero), Lanes::Sub(One, Tail2), Tail2);
+		Vec Density = Lanes::Mul(Lanes::Set1(0.3989422804014327), SimdExp<Lanes>(Lanes::Mul(Lanes::Mul(d1, d1), Lanes::Set1(-0.5))));
+		Vec SpotGamma = Lanes::Div(Lanes::Mul(CarryDiscount, Density), sigSqrtT);	// exp((b - r)T) n(d1) / (sig sqrt(T)), the European gamma times the spot
+
+		if (Type == Call)
+		{
+			Vec Delta = Lanes::Mul(CarryDiscount, Nd1);
+			Vec European = Lanes::Sub(Lanes::Mul(Si, Delta), Lanes::Mul(Lanes::Mul(vK, Discount), Nd2));
+			Vec RHS = Lanes::Fma(Lanes::Mul(Lanes::Sub(One, Delta), Si), InvQ, European);
+			Vec Slope = Lanes::Fma(Delta, Lanes::Sub(One, InvQ), Lanes::Mul(Lanes::Sub(One, SpotGamma), InvQ));
+			Si = Lanes::Div(Lanes::Sub(Lanes::Add(vK, RHS), Lanes::Mul(Slope, Si)), Lanes::Sub(One, Slope));
+		}
+		else
+		{
+			Vec Delta = Lanes::Mul(CarryDiscount, Lanes::Sub(One, Nd1));				// exp((b - r)T) N(-d1)
+			Vec European = Lanes::Sub(Lanes::Mul(Lanes::Mul(vK, Discount), Lanes::Sub(One, Nd2)), Lanes::Mul(Si, Delta));
+			Vec RHS = Lanes::Sub(European, Lanes::Mul(Lanes::Mul(Lanes::Sub(One, Delta), Si), InvQ));
+			Vec Slope = Lanes::Sub(Lanes::Sub(Zero, Lanes::Mul(Delta, Lanes::Sub(One, InvQ))), Lanes::Mul(Lanes::Add(One, SpotGamma), InvQ));
+			Si = Lanes::Div(Lanes::Add(Lanes::Sub(vK, RHS), Lanes::Mul(Slope, Si)), Lanes::Add(One, Slope));
+		}
+	}
+
+	// Never exercised early: calls when b >= r, puts when r <= 0
+	if (Type == Call)
+	{
+		Si = Lanes::Select(Lanes::Less(vB, vR), Si, Lanes::Set1(std::numeric_limits<double>::infinity()));
+	}
+	else
+	{
+		Si = Lanes::Select(Lanes::Greater(vR, Zero), Si, Zero);
+	}
+	Lanes::Store(Boundary + i, Si);
+}
+
+template <class Lanes, OptionType Type>
+inline void BAWBoundaryRange(size_t n, const double* T, const double* K, const double* sig, const double* r, const double* b, double* Boundary)	// Critical prices of n rows of raw columns
+{
+	size_t i = 0;
+	for (; i + Lanes::Width <= n; i += Lanes::Width)
+	{
+		BAWBoundaryLanes<Lanes, Type>(i, T, K, sig, r, b, Boundary);
+	}
+
+	// Remaining rows go through one padded vector, so the instruction set specific units never instantiate the ScalarLanes code
+	if (i < n)
+	{
+		double In[5][Lanes::Width], Out[Lanes::Width];
+		const double* Columns[5] = { T, K, sig, r, b };
+		for (size_t c = 0; c < 5; c++)
+		{
+			for (size_t j = 0; j < Lanes::Width; j++)
+			{
+				In[c][j] = Columns[c][(i + j < n) ? (i + j) : (n - 1)];		// Pad with copies of the last row
+			}
+		}
+		BAWBoundaryLanes<Lanes, Type>(0, In[0], In[1], In[2], In[3], In[4], Out);
+		for (size_t j = 0; i + j < n; j++)
+		{
+			Boundary[i + j] = Out[j];
+		}
+	}
+}
+
+template <class Lanes>
+inline void BAWBoundaryType(OptionType Type, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* b, double* Boundary)	// Pick the option type once for the whole range
+{
+	if (Type == Call)
+		BAWBoundaryRange<Lanes, Call>(n, T, K, sig, r, b, Boundary);
+	else
+		BAWBoundaryRange<Lanes, Put>(n, T, K, sig, r, b, Boundary);
+}
+
+// Per instruction set entry points, each solves n rows of raw columns
+void BAWBoundaryScalar(OptionType Type, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* b, double* Boundary);
+#ifdef EUROPEAN_SIMD_X86
+void BAWBoundaryAVX2(OptionType Type, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* b, double* Boundary);
+void BAWBoundaryAVX512(OptionType Type, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* b, double* Boundary);
+#endif
+
+#endif
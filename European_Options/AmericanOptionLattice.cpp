@@ -0,0 +1,315 @@
+/*	Daniel McNulty II
+*
+*	AmericanOptionLattice.cpp
+*/
+
+#include "AmericanOptionLattice.h"
+#include "EuropeanOption.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+struct LatticeTree		// Step parameters of one lattice, node (i, j) has spot U exp(i LogDown) Ratio[j]
+{
+	LatticeModel Model;		// Parameters the tree was built with
+	int Steps;				// Time steps
+	double ProbUp;			// Risk neutral probability of an up move
+	double DiscountUp;		// exp(-r dt) ProbUp
+	double DiscountDown;	// exp(-r dt) (1 - ProbUp)
+	double LogDown;			// log(d)
+	vector<double> Ratio;	// (u / d)^j for j = 0 to Steps
+};
+
+static int LatticeSteps(const LatticeSettings& Settings)		// Step count of Settings, made odd for Leisen-Reimer
+{
+	int Steps = Settings.Steps;
+	if (Steps < 1)
+	{
+		cout << "ERROR: A lattice needs at least one step. Resorting to default " << Default_Lattice.Steps << " steps" << endl;
+		Steps = Default_Lattice.Steps;
+	}
+	if ((Settings.Model == Leisen_Reimer_Lattice) && ((Steps % 2) == 0))
+	{
+		Steps++;
+	}
+	return Steps;
+}
+
+static double PeizerPratt(double z, int n)		// Peizer-Pratt method 2 inversion, the probability a binomial with n steps matches N(z)
+{
+	double x = z / (n + (1.0 / 3.0) + (0.1 / (n + 1.0)));
+	double Spread = 0.5 * sqrt(1.0 - exp(-(x * x) * (n + (1.0 / 6.0))));
+	return (z >= 0.0) ? (0.5 + Spread) : (0.5 - Spread);
+}
+
+static void BuildTree(LatticeTree& Tree, double T, double K, double sig, double r, double U, double b, const LatticeSettings& Settings)	// Fill Tree for one option, K and U only matter to Leisen-Reimer
+{
+	int n = LatticeSteps(Settings);
+	double dt = T / n;
+	double Growth = exp(b * dt);		// Expected growth of the spot over one step
+	double LogUp, LogDown, p;
+
+	if (Settings.Model == Leisen_Reimer_Lattice)
+	{
+		double d1 = (log(U / K) + ((b + (0.5 * sig * sig)) * T)) / (sig * sqrt(T));
+		double d2 = d1 - (sig * sqrt(T));
+		p = PeizerPratt(d2, n);
+		double Up = Growth * PeizerPratt(d1, n) / p;
+		LogUp = log(Up);
+		LogDown = log((Growth - (p * Up)) / (1.0 - p));
+	}
+	else
+	{
+		LogUp = sig * sqrt(dt);
+		LogDown = -LogUp;
+		p = (Growth - exp(LogDown)) / (exp(LogUp) - exp(LogDown));
+		if (!((p > 0.0) && (p < 1.0)))		// Too few steps for the carry, the tree would need negative probabilities
+		{
+			cout << "ERROR: The CRR probability " << p << " is outside (0, 1) with " << n << " steps. Resorting to the Leisen-Reimer lattice" << endl;
+			LatticeSettings Fallback = Settings;
+			Fallback.Model = Leisen_Reimer_Lattice;
+			BuildTree(Tree, T, K, sig, r, U, b, Fallback);
+			return;
+		}
+	}
+
+	double Discount = exp(-r * dt);
+	Tree.Model = Settings.Model;
+	Tree.Steps = n;
+	Tree.ProbUp = p;
+	Tree.DiscountUp = Discount * p;
+	Tree.DiscountDown = Discount * (1.0 - p);
+	Tree.LogDown = LogDown;
+	Tree.Ratio.resize(n + 1);
+	for (int j = 0; j <= n; j++)
+	{
+		Tree.Ratio[j] = exp(j * (LogUp - LogDown));
+	}
+}
+
+template <OptionType Type>
+static double InductLattice(const LatticeTree& Tree, double K, double U, vector<double>& Values)		// American value at the root, Values is the one level scratch array
+{
+	int n = Tree.Steps;
+	Values.resize(n + 1);
+	double* V = Values.data();
+	const double* Ratio = Tree.Ratio.data();
+	double Up = Tree.DiscountUp, Down = Tree.DiscountDown;
+
+	// Payoff at expiry
+	double Base = U * exp(n * Tree.LogDown);
+	for (int j = 0; j <= n; j++)
+	{
+		double Exercise = (Type == Call) ? ((Base * Ratio[j]) - K) : (K - (Base * Ratio[j]));
+		V[j] = (Exercise > 0.0) ? Exercise : 0.0;
+	}
+
+	// Each level overwrites the one after it in place, node j only reads nodes j and j + 1 which are not yet overwritten
+	for (int i = n - 1; i >= 0; i--)
+	{
+		Base = U * exp(i * Tree.LogDown);
+		for (int j = 0; j <= i; j++)
+		{
+			double Continuation = (Down * V[j]) + (Up * V[j + 1]);
+			double Exercise = (Type == Call) ? ((Base * Ratio[j]) - K) : (K - (Base * Ratio[j]));
+			V[j] = (Continuation > Exercise) ? Continuation : Exercise;
+		}
+	}
+
+	return V[0];
+}
+
+template <OptionType Type>
+static double EuropeanLatticeValue(const LatticeTree& Tree, double T, double K, double r, double U)		// European value on the same tree, the discounted binomial expectation of the payoff
+{
+	int n = Tree.Steps;
+	double LogUp = log(Tree.ProbUp), LogDown = log(1.0 - Tree.ProbUp);
+	double Base = U * exp(n * Tree.LogDown);
+	double LogChoose = 0.0;		// log(n choose j)
+	double Sum = 0.0;
+	for (int j = 0; j <= n; j++)
+	{
+		double Exercise = (Type == Call) ? ((Base * Tree.Ratio[j]) - K) : (K - (Base * Tree.Ratio[j]));
+		if (Exercise > 0.0)
+		{
+			Sum += exp(LogChoose + (j * LogUp) + ((n - j) * LogDown)) * Exercise;
+		}
+		LogChoose += log(static_cast<double>(n - j) / (j + 1));
+	}
+
+	return exp(-r * T) * Sum;
+}
+
+template <OptionType Type>
+static double LatticePrice(const LatticeTree& Tree, double T, double K, double sig, double r, double U, double b, bool ControlVariate, vector<double>& Values)	// Price on a built tree
+{
+	double Value = InductLattice<Type>(Tree, K, U, Values);
+	if (ControlVariate)
+	{
+		double ClosedForm = (Type == Call) ? CallPrice(T, K, sig, r, U, b) : PutPrice(T, K, sig, r, U, b);
+		Value += ClosedForm - EuropeanLatticeValue<Type>(Tree, T, K, r, U);
+	}
+	return Value;
+}
+
+template <OptionType Type>
+static double AmericanPrice(double T, double K, double sig, double r, double U, double b, const LatticeSettings& Settings, LatticeTree& Tree, vector<double>& Values)	// Price of one option with caller owned scratch
+{
+	if (!(T > 0.0))		// Exercised now
+	{
+		double Exercise = (Type == Call) ? (U - K) : (K - U);
+		return (Exercise > 0.0) ? Exercise : 0.0;
+	}
+
+	BuildTree(Tree, T, K, sig, r, U, b, Settings);
+	return LatticePrice<Type>(Tree, T, K, sig, r, U, b, Settings.ControlVariate, Values);
+}
+
+// Private Functions
+void AmericanOption::Copy(const AmericanOption& Opt)		// Copy all values from another AmericanOption object
+{
+	Option::Copy(Opt);
+	T = Opt.T;
+	K = Opt.K;
+	sig = Opt.sig;
+	r = Opt.r;
+	U = Opt.U;
+	b = Opt.b;
+	Settings = Opt.Settings;
+}
+
+// Constructors
+AmericanOption::AmericanOption() : Option(), T(0.25), K(65), sig(0.30), r(0.08), U(60), b(0.08), Settings(Default_Lattice) {}	// Default constructor
+
+AmericanOption::AmericanOption(const AmericanOption& Opt) : Option(Opt), T(Opt.T), K(Opt.K), sig(Opt.sig), r(Opt.r), U(Opt.U), b(Opt.b), Settings(Opt.Settings) {}	// Copy constructor
+
+AmericanOption::AmericanOption(const enum OptionType type) : Option(type), T(0.25), K(65), sig(0.30), r(0.08), U(60), b(0.08), Settings(Default_Lattice) {}	// Constructor that accepts option type
+
+AmericanOption::AmericanOption(double newT, double newK, double newSig, double newR, double newU, double newB) : Option(), T(newT), K(newK), sig(newSig), r(newR), U(newU), b(newB), Settings(Default_Lattice) {}		// Constructor that accepts all derived class data
+
+AmericanOption::AmericanOption(double newT, double newK, double newSig, double newR, double newU, double newB, const enum OptionType type) : Option(type), T(newT), K(newK), sig(newSig), r(newR), U(newU), b(newB), Settings(Default_Lattice) {}	// Constructor that accepts all base and derived class data
+
+// Destructors
+AmericanOption::~AmericanOption() {}		// Default destructor
+
+// Functionality
+double AmericanOption::Price() const				// Calculate the price of the given option on its lattice
+{
+	if (optionType == Call)
+		return ::AmericanCallPrice(T, K, sig, r, U, b, Settings);
+	else
+		return ::AmericanPutPrice(T, K, sig, r, U, b, Settings);
+}
+
+double AmericanOption::PriceWithS(double newU) const		// Calculate price using the set T, K, sig, r, and b with a different underlying value
+{
+	if (optionType == Call)
+		return ::AmericanCallPrice(T, K, sig, r, newU, b, Settings);
+	else
+		return ::AmericanPutPrice(T, K, sig, r, newU, b, Settings);
+}
+
+// Assignment operator
+AmericanOption& AmericanOption::operator = (const AmericanOption& Opt)
+{
+	if (this == &Opt)
+	{
+		return *this;
+	}
+	else
+	{
+		Option::operator = (Opt);
+		Copy(Opt);
+		return *this;
+	}
+}
+
+// GLOBAL AMERICAN OPTION FUNCTIONS
+double AmericanCallPrice(double T, double K, double sig, double r, double U, double b)		// Price of American call on the default lattice
+{
+	return AmericanCallPrice(T, K, sig, r, U, b, Default_Lattice);
+}
+
+double AmericanPutPrice(double T, double K, double sig, double r, double U, double b)		// Price of American put on the default lattice
+{
+	return AmericanPutPrice(T, K, sig, r, U, b, Default_Lattice);
+}
+
+double AmericanCallPrice(double T, double K, double sig, double r, double U, double b, const LatticeSettings& Settings)	// Price of American call on a chosen lattice
+{
+	LatticeTree Tree;
+	vector<double> Values;
+	return AmericanPrice<Call>(T, K, sig, r, U, b, Settings, Tree, Values);
+}
+
+double AmericanPutPrice(double T, double K, double sig, double r, double U, double b, const LatticeSettings& Settings)	// Price of American put on a chosen lattice
+{
+	LatticeTree Tree;
+	vector<double> Values;
+	return AmericanPrice<Put>(T, K, sig, r, U, b, Settings, Tree, Values);
+}
+
+void AmericanPriceBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out, const LatticeSettings& Settings)		// Prices of every row of Data on the calling thread
+{
+	AmericanPriceBatch(Data, Type, Out, Settings, Serial_Execution);
+}
+
+void AmericanPriceBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out, const LatticeSettings& Settings, const ExecutionPolicy& Policy)	// Prices of every row of Data on Policy's threads
+{
+	Out.resize(Data.Size());
+	ParallelFor(Data.Size(), [&](size_t First, size_t Last)
+	{
+		LatticeTree Tree;				// Scratch reused by every row of the range
+		vector<double> Values;
+		for (size_t i = First; i < Last; i++)
+		{
+			if (Type == Call)
+				Out[i] = AmericanPrice<Call>(Data.T[i], Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i], Settings, Tree, Values);
+			else
+				Out[i] = AmericanPrice<Put>(Data.T[i], Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i], Settings, Tree, Values);
+		}
+	}, Policy);
+}
+
+vector<double> AmericanStrikeChain(double T, const vector<double>& Strikes, double sig, double r, double U, double b, OptionType Type, const LatticeSettings& Settings, const ExecutionPolicy& Policy)	// Prices of one expiry's strikes on Policy's threads
+{
+	// The CRR tree does not depend on the strike, so it is built once and shared by every strike
+	LatticeSettings ChainSettings = Settings;
+	LatticeTree Shared;
+	if ((T > 0.0) && (Settings.Model == CRR_Lattice) && !Strikes.empty())
+	{
+		BuildTree(Shared, T, Strikes[0], sig, r, U, b, Settings);
+		ChainSettings.Model = Shared.Model;		// Leisen-Reimer if the CRR probability was out of range
+	}
+
+	vector<double> Prices(Strikes.size());
+	if (!(T > 0.0) || (ChainSettings.Model == Leisen_Reimer_Lattice))		// Leisen-Reimer trees depend on the strike, so every row builds its own
+	{
+		EuroOptBatch Chain;
+		Chain.Reserve(Strikes.size());
+		for (double K : Strikes)
+		{
+			Chain.AddRow(T, K, sig, r, U, b);
+		}
+		AlignedColumn Values;
+		AmericanPriceBatch(Chain, Type, Values, ChainSettings, Policy);
+		Prices.assign(Values.begin(), Values.end());
+		return Prices;
+	}
+
+	ParallelFor(Strikes.size(), [&](size_t First, size_t Last)
+	{
+		vector<double> Values;
+		for (size_t i = First; i < Last; i++)
+		{
+			if (Type == Call)
+				Prices[i] = LatticePrice<Call>(Shared, T, Strikes[i], sig, r, U, b, Settings.ControlVariate, Values);
+			else
+				Prices[i] = LatticePrice<Put>(Shared, T, Strikes[i], sig, r, U, b, Settings.ControlVariate, Values);
+		}
+	}, Policy);
+
+	return Prices;
+}
@@ -0,0 +1,86 @@
+/*	Daniel McNulty II
+*
+*	AmericanOptionLattice.h
+*
+*	Finite maturity American options on a recombining binomial lattice, with the Cox-Ross-Rubinstein or
+*	the Leisen-Reimer (Peizer-Pratt method 2) parameters and the same (T, K, sig, r, U, b) inputs as
+*	EuropeanOption. The backward induction keeps one array of node values of length Steps + 1 and
+*	overwrites it level by level; a node's spot is the level factor U d^i times the precomputed (u / d)^j,
+*	so the inner loop is a branch free max over contiguous arrays that the compiler vectorizes.
+*
+*	With the control variate on, the lattice value of the European option on the same tree is subtracted
+*	and the CallPrice()/PutPrice() closed form added back. Most of the oscillating CRR discretization error
+*	is shared by the American and European values, so far fewer steps reach a given accuracy; Leisen-Reimer
+*	already prices the European option almost exactly, so there the correction is small. The European
+*	lattice value is the binomial expectation of the terminal payoff, so it needs no second induction.
+*/
+
+#ifndef AmericanOptionLattice_H
+#define AmericanOptionLattice_H
+
+#include "EuropeanOptionBatch.h"
+#include "Option.h"
+#include "ThreadPool.h"
+#include <vector>
+using namespace std;
+
+enum LatticeModel			// Parameters of the binomial lattice
+{
+	CRR_Lattice,			// Cox-Ross-Rubinstein, u = exp(sig sqrt(dt)) and d = 1 / u
+	Leisen_Reimer_Lattice	// Leisen-Reimer, probabilities from the Peizer-Pratt inversion of d1 and d2, odd step counts only
+};
+
+struct LatticeSettings		// How a lattice is built
+{
+	LatticeModel Model;		// Lattice parameters
+	int Steps;				// Time steps, Leisen-Reimer rounds an even count up to the next odd one
+	bool ControlVariate;	// Correct with the European closed form
+};
+
+const LatticeSettings Default_Lattice = { Leisen_Reimer_Lattice, 201, true };	// Within about a tenth of a cent of the converged value on typical listed options
+
+class AmericanOption : public Option
+{
+private:
+	void Copy(const AmericanOption& source);		// Copy all values from another AmericanOption object
+
+public:
+	// Data members for the variables involved in American option pricing
+	double T;		// Expiry time
+	double K;		// Strike price
+	double sig;		// Volatility
+	double r;		// Risk free interest rate
+	double U;		// Current price of the underlying asset
+	double b;		// Cost of carry
+	LatticeSettings Settings;		// Lattice used by Price()
+
+public:
+	// Constructors
+	AmericanOption();																											// Default constructor
+	AmericanOption(const AmericanOption& Opt);																					// Copy constructor
+	AmericanOption(const enum OptionType type);																					// Constructor that accepts option type
+	AmericanOption(double newT, double newK, double newSig, double newR, double newU, double newB);							// Constructor that accepts all derived class data
+	AmericanOption(double newT, double newK, double newSig, double newR, double newU, double newB, const enum OptionType type);	// Constructor that accepts all base and derived class data
+	// Destructors
+	virtual ~AmericanOption();					// Default destructor
+
+	// Functionality
+	double Price() const;						// Calculate the price of the given option on its lattice
+	double PriceWithS(double newU) const;		// Calculate price using the set T, K, sig, r, and b with a different underlying value
+
+	// Assignment operator
+	AmericanOption& operator = (const AmericanOption& Opt);
+};
+
+// Global American Option Functions
+double AmericanCallPrice(double T, double K, double sig, double r, double U, double b);									// Price of American call on the default lattice
+double AmericanPutPrice(double T, double K, double sig, double r, double U, double b);									// Price of American put on the default lattice
+double AmericanCallPrice(double T, double K, double sig, double r, double U, double b, const LatticeSettings& Settings);	// Price of American call on a chosen lattice
+double AmericanPutPrice(double T, double K, double sig, double r, double U, double b, const LatticeSettings& Settings);	// Price of American put on a chosen lattice
+
+// Batch and chain pricers, one lattice per row spread over Policy's threads
+void AmericanPriceBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out, const LatticeSettings& Settings);								// Prices of every row of Data
+void AmericanPriceBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out, const LatticeSettings& Settings, const ExecutionPolicy& Policy);
+vector<double> AmericanStrikeChain(double T, const vector<double>& Strikes, double sig, double r, double U, double b, OptionType Type, const LatticeSettings& Settings, const ExecutionPolicy& Policy);	// Prices of one expiry's strikes, a CRR chain shares its tree
+
+#endif
@@ -0,0 +1,101 @@
+/*	Daniel McNulty II
+*
+*	"Benchmark Source.cpp"
+*
+*	Microbenchmark of the standard normal backends. For each accuracy tier it reports the largest
+*	absolute and relative cdf error against boost, the time per NormCdf() call, and the time per row
+*	of CallPrice()/PutPrice() and of the vectorized batch pricer (which runs the Boost tier as Full).
+*/
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionBatch.h"
+#include "EuropeanOptionSIMD.h"
+#include "NormalDistribution.h"
+#include <boost/math/distributions/normal.hpp>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+using namespace std;
+
+int main()
+{
+	const NormalBackend Tiers[] = { Boost_Normal, Full_Normal, Fast_Normal, Screening_Normal };
+
+	// Error of each tier against boost on a fine grid over the range the pricers can reach
+	vector<double> Grid = GenerateMeshArray(-38.0, 38.0, 760000);
+	vector<double> Reference(Grid.size());
+	boost::math::normal_distribution<> N(0, 1);
+	for (unsigned int i = 0; i < Grid.size(); i++)
+	{
+		Reference[i] = boost::math::cdf(N, Grid[i]);
+	}
+
+	// Random option book for the pricing timings
+	const size_t Rows = 1000000;
+	mt19937_64 Generator(2020);
+	uniform_real_distribution<> Unit(0.0, 1.0);
+	EuroOptBatch Book;
+	Book.Reserve(Rows);
+	for (size_t i = 0; i < Rows; i++)
+	{
+		Book.AddRow(0.05 + 2.0 * Unit(Generator), 50.0 + 100.0 * Unit(Generator), 0.1 + 0.5 * Unit(Generator), 0.08 * Unit(Generator), 50.0 + 100.0 * Unit(Generator), 0.08 * Unit(Generator));
+	}
+
+	cout << "SIMD path: " << SimdPathName(DetectSimdPath()) << endl
+		 << "TIER      | MAX ABS ERROR | MAX REL ERROR (|x| < 5) | NormCdf ns/call | CallPrice+PutPrice ns/row | PriceBatchSIMD ns/row" << endl;
+
+	double Checksum = 0.0;
+	for (NormalBackend Tier : Tiers)
+	{
+		double MaxAbs = 0.0, MaxRel = 0.0;
+		for (unsigned int i = 0; i < Grid.size(); i++)
+		{
+			double Error = fabs(NormCdf(Grid[i], Tier) - Reference[i]);
+			MaxAbs = fmax(MaxAbs, Error);
+			if (fabs(Grid[i]) < 5.0)
+			{
+				MaxRel = fmax(MaxRel, Error / Reference[i]);
+			}
+		}
+
+		// Time the scalar cdf on its own
+		double Sink = 0.0;
+		auto Start = chrono::steady_clock::now();
+		for (unsigned int i = 0; i < Grid.size(); i++)
+		{
+			Sink += NormCdf(Grid[i], Tier);
+		}
+		double CdfNs = chrono::duration<double, nano>(chrono::steady_clock::now() - Start).count() / Grid.size();
+
+		// Time the scalar pricing functions with the tier installed globally
+		SetNormalBackend(Tier);
+		Start = chrono::steady_clock::now();
+		for (size_t i = 0; i < Rows; i++)
+		{
+			Sink += CallPrice(Book.T[i], Book.K[i], Book.sig[i], Book.r[i], Book.U[i], Book.b[i]) + PutPrice(Book.T[i], Book.K[i], Book.sig[i], Book.r[i], Book.U[i], Book.b[i]);
+		}
+		double ScalarNs = chrono::duration<double, nano>(chrono::steady_clock::now() - Start).count() / Rows;
+
+		// Time the vectorized pricer with the tier given per batch
+		EuroOptBatchResult Out;
+		Start = chrono::steady_clock::now();
+		PriceBatchSIMD(Book, Out, DetectSimdPath(), Tier);
+		double SimdNs = chrono::duration<double, nano>(chrono::steady_clock::now() - Start).count() / Rows;
+		Sink += Out.Call[0];
+
+		cout << left << setw(10) << setfill(' ') << NormalBackendName(Tier)
+			 << "| " << left << setw(14) << MaxAbs
+			 << "| " << left << setw(24) << MaxRel
+			 << "| " << left << setw(16) << CdfNs
+			 << "| " << left << setw(26) << ScalarNs
+			 << "| " << left << setw(10) << SimdNs << endl;
+		Checksum += Sink;
+	}
+
+	cout << "Checksum: " << Checksum << endl;		// Printed so the timed loops cannot be optimized away
+	SetNormalBackend(Full_Normal);
+	return 0;
+}
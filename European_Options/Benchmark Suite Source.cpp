@@ -0,0 +1,175 @@
+/*	Daniel McNulty II
+*
+*	"Benchmark Suite Source.cpp"
+*
+*	Benchmark of every European option pricing entry point at batch sizes from L1 resident up to DRAM
+*	bound. Progress goes to standard error and the results to standard output (or the -o file) as JSON,
+*	in ns/option and options/sec, so they can be kept and compared against earlier runs.
+*
+*	Usage: BenchmarkSuite [-o FILE] [--min-time SECONDS] [--max-batch N] [--threads N]
+*		-o FILE				write the JSON to FILE instead of standard output
+*		--min-time SECONDS	least time spent timing each case (default 0.2)
+*		--max-batch N		largest batch size (default 1048576)
+*		--threads N			threads used by the parallel cases, 0 for every hardware thread (default 0)
+*/
+
+#include "BenchmarkSuite.h"
+#include "EuropeanOption.h"
+#include "EuropeanOptionBatch.h"
+#include "EuropeanOptionSIMD.h"
+#include "EuropeanOptionTermPlan.h"
+#include "NormalDistribution.h"
+#include "ThreadPool.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+	const char* OutputPath = nullptr;
+	double MinSeconds = 0.2;
+	size_t MaxBatch = 1048576;
+	ExecutionPolicy Parallel = Parallel_Execution;
+
+	// Read the command line
+	for (int i = 1; i < argc; i++)
+	{
+		string Arg = argv[i];
+		bool HasValue = (i + 1 < argc);
+		if ((Arg == "-o") && HasValue)
+			OutputPath = argv[++i];
+		else if ((Arg == "--min-time") && HasValue)
+			MinSeconds = atof(argv[++i]);
+		else if ((Arg == "--max-batch") && HasValue)
+			MaxBatch = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+		else if ((Arg == "--threads") && HasValue)
+			Parallel.Threads = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+		else
+		{
+			cerr << "ERROR: Unknown or incomplete option " << Arg << endl;
+			return 1;
+		}
+	}
+	vector<size_t> Batches = BenchmarkBatchSizes(MaxBatch);
+	if (Batches.empty())
+	{
+		cerr << "ERROR: --max-batch must be at least " << BenchmarkBatchSizes(~size_t(0))[0] << endl;
+		return 1;
+	}
+
+	// One random book as large as the largest batch, smaller batches use its first rows
+	mt19937_64 Generator(2020);
+	uniform_real_distribution<> Unit(0.0, 1.0);
+	EuroOptBatch Book;
+	Book.Reserve(Batches.back());
+	for (size_t i = 0; i < Batches.back(); i++)
+	{
+		Book.AddRow(0.05 + 2.0 * Unit(Generator), 50.0 + 100.0 * Unit(Generator), 0.1 + 0.5 * Unit(Generator), 0.08 * Unit(Generator), 50.0 + 100.0 * Unit(Generator), 0.08 * Unit(Generator));
+	}
+	const double* T = Book.T.data(); const double* K = Book.K.data(); const double* sig = Book.sig.data();
+	const double* r = Book.r.data(); const double* U = Book.U.data(); const double* b = Book.b.data();
+	const double h = 0.01;		// Step of the divided differences functions
+
+	BenchmarkSuite Suite("European", MinSeconds);
+	Suite.AddProperty("simd_path", SimdPathName(DetectSimdPath()));
+	Suite.AddProperty("normal_backend", NormalBackendName(GetNormalBackend()));
+	Suite.AddProperty("parallel_threads", to_string((Parallel.Threads == 0) ? HardwareThreads() : Parallel.Threads));
+
+	const size_t RowBytes = 6 * sizeof(double);						// Parameters read per option
+	const size_t MatrixRowBytes = RowBytes + (3 * sizeof(void*));	// A matrix row also costs its vector header and its own allocation
+	for (size_t n : Batches)
+	{
+		// Scalar pricing functions, one call per option
+		Suite.Run("CallPrice", n, RowBytes, [&]() { double Sum = 0.0; for (size_t i = 0; i < n; i++) Sum += CallPrice(T[i], K[i], sig[i], r[i], U[i], b[i]); return Sum; });
+		Suite.Run("PutPrice", n, RowBytes, [&]() { double Sum = 0.0; for (size_t i = 0; i < n; i++) Sum += PutPrice(T[i], K[i], sig[i], r[i], U[i], b[i]); return Sum; });
+		Suite.Run("CallDelta", n, RowBytes, [&]() { double Sum = 0.0; for (size_t i = 0; i < n; i++) Sum += CallDelta(T[i], K[i], sig[i], r[i], U[i], b[i]); return Sum; });
+		Suite.Run("CallGamma", n, RowBytes, [&]() { double Sum = 0.0; for (size_t i = 0; i < n; i++) Sum += CallGamma(T[i], K[i], sig[i], r[i], U[i], b[i]); return Sum; });
+
+		// Divided differences functions, each prices the option two or three times
+		Suite.Run("CallDeltaDiff", n, RowBytes, [&]() { double Sum = 0.0; for (size_t i = 0; i < n; i++) Sum += CallDeltaDiff(T[i], K[i], sig[i], r[i], U[i], b[i], h); return Sum; });
+		Suite.Run("PutDeltaDiff", n, RowBytes, [&]() { double Sum = 0.0; for (size_t i = 0; i < n; i++) Sum += PutDeltaDiff(T[i], K[i], sig[i], r[i], U[i], b[i], h); return Sum; });
+		Suite.Run("CallGammaDiff", n, RowBytes, [&]() { double Sum = 0.0; for (size_t i = 0; i < n; i++) Sum += CallGammaDiff(T[i], K[i], sig[i], r[i], U[i], b[i], h); return Sum; });
+		Suite.Run("PutGammaDiff", n, RowBytes, [&]() { double Sum = 0.0; for (size_t i = 0; i < n; i++) Sum += PutGammaDiff(T[i], K[i], sig[i], r[i], U[i], b[i], h); return Sum; });
+
+		// Matrix functions, rows of (T, K, sig, r, U, b) in and rows of results out
+		vector<vector<double>> DataVec(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			DataVec[i] = { T[i], K[i], sig[i], r[i], U[i], b[i] };
+		}
+		Suite.Run("MatrixPricer/Price", n, MatrixRowBytes, [&]() { return MatrixPricer(DataVec, Price).back()[0]; });
+		Suite.Run("MatrixPricer/All", n, MatrixRowBytes, [&]() { return MatrixPricer(DataVec, All).back()[0]; });
+		Suite.Run("MatrixPricer/Price/parallel", n, MatrixRowBytes, [&]() { return MatrixPricer(DataVec, Price, Parallel).back()[0]; });
+		Suite.Run("GreeksVector/All_Greeks", n, MatrixRowBytes, [&]() { return GreeksVector(DataVec, All_Greeks).back()[0]; });
+		DataVec = vector<vector<double>>();
+
+		// Batch pricers on the structure-of-arrays columns
+		EuroOptBatch Batch;
+		Batch.Reserve(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			Batch.AddRow(T[i], K[i], sig[i], r[i], U[i], b[i]);
+		}
+		EuroOptBatchResult Out;
+		EuroOptGreeksResult Greeks;
+		const size_t BatchBytes = 8 * sizeof(double);		// Six parameters read and two results written per option
+		Suite.Run("PriceBatch", n, BatchBytes, [&]() { PriceBatch(Batch, Out); return Out.Call[n - 1]; });
+		Suite.Run("PriceBatchSIMD", n, BatchBytes, [&]() { PriceBatchSIMD(Batch, Out); return Out.Call[n - 1]; });
+		Suite.Run("PriceBatchSIMD/parallel", n, BatchBytes, [&]() { PriceBatchSIMD(Batch, Out, Parallel); return Out.Call[n - 1]; });
+		Suite.Run("GreeksBatch/All_Greeks", n, RowBytes + (20 * sizeof(double)), [&]() { GreeksBatch(Batch, All_Greeks, Greeks); return Greeks.Prices.Call[n - 1]; });
+
+		// Chain shaped book, ChainUnderlyings x ChainExpiries (T, r, b) groups sorted by underlying, expiry and strike
+		const size_t ChainUnderlyings = 40, ChainExpiries = 16;
+		size_t Strikes = (n + (ChainUnderlyings * ChainExpiries) - 1) / (ChainUnderlyings * ChainExpiries);
+		EuroOptBatch Chain;
+		Chain.Reserve(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			size_t Underlying = i / (ChainExpiries * Strikes), Expiry = (i / Strikes) % ChainExpiries, Strike = i % Strikes;
+			double Spot = 50.0 + (2.5 * Underlying), Expiry_T = (Expiry + 1) / 12.0, Rate = 0.02 + (0.002 * Expiry);
+			double Moneyness = 0.5 + ((Strikes > 1) ? static_cast<double>(Strike) / (Strikes - 1) : 0.5);
+			Chain.AddRow(Expiry_T, Spot * Moneyness, 0.15 + (0.1 * fabs(Moneyness - 1.0)), Rate, Spot, Rate - (0.0005 * Underlying));
+		}
+		vector<vector<double>> ChainVec(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			ChainVec[i] = { Chain.T[i], Chain.K[i], Chain.sig[i], Chain.r[i], Chain.U[i], Chain.b[i] };
+		}
+		EuroOptTermPlan Plan(Chain);
+		const size_t PlannedBytes = BatchBytes - (3 * sizeof(double)) + sizeof(unsigned int);		// T, r and b are replaced by a group index
+		Suite.Run("Chain/PriceVector", n, MatrixRowBytes, [&]() { return PriceVector(ChainVec).back()[0]; });
+		Suite.Run("Chain/PlannedPriceVector", n, MatrixRowBytes, [&]() { return PlannedPriceVector(ChainVec).back()[0]; });
+		Suite.Run("Chain/PriceBatch", n, BatchBytes, [&]() { PriceBatch(Chain, Out); return Out.Call[n - 1]; });
+		Suite.Run("Chain/EuroOptTermPlan", n, 3 * sizeof(double), [&]() { Plan.Plan(Chain); return static_cast<double>(Plan.GroupCount()); });
+		Suite.Run("Chain/PriceBatch/planned", n, PlannedBytes, [&]() { PriceBatch(Chain, Plan, Out); return Out.Call[n - 1]; });
+		Suite.Run("Chain/PriceBatch/planned/parallel", n, PlannedBytes, [&]() { PriceBatch(Chain, Plan, Out, Parallel); return Out.Call[n - 1]; });
+
+		// Generators, one option row or mesh point per unit
+		int Steps = static_cast<int>(n) - 1;
+		Suite.Run("GenerateParameterMatrix", n, MatrixRowBytes, [&]() { return GenerateParameterMatrix(0.5, 100.0, 0.2, 0.05, 50.0, 0.05, 150.0, Steps, Underlying).back()[4]; });
+		Suite.Run("GenerateParameterMatrix/parallel", n, MatrixRowBytes, [&]() { return GenerateParameterMatrix(0.5, 100.0, 0.2, 0.05, 50.0, 0.05, 150.0, Steps, Underlying, Parallel).back()[4]; });
+		Suite.Run("GenerateMeshArray", n, sizeof(double), [&]() { return GenerateMeshArray(50.0, 150.0, Steps).back(); });
+	}
+
+	if (OutputPath == nullptr)
+	{
+		Suite.WriteJson(cout);
+		return 0;
+	}
+
+	ofstream File(OutputPath);
+	Suite.WriteJson(File);
+	File.close();
+	if (!File)
+	{
+		cerr << "ERROR: Could not write " << OutputPath << endl;
+		return 1;
+	}
+
+	return 0;
+}
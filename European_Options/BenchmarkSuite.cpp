@@ -0,0 +1,155 @@
+/*	Daniel McNulty II
+*
+*	BenchmarkSuite.cpp
+*/
+
+#include "BenchmarkSuite.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+static string JsonString(const string& Text)		// Quote and escape Text as a JSON string
+{
+	string Quoted = "\"";
+	for (char c : Text)
+	{
+		if ((c == '"') || (c == '\\'))
+		{
+			Quoted += '\\';
+			Quoted += c;
+		}
+		else if (static_cast<unsigned char>(c) < 0x20)
+		{
+			Quoted += ' ';
+		}
+		else
+		{
+			Quoted += c;
+		}
+	}
+
+	return Quoted + "\"";
+}
+
+static string CompilerName()		// Compiler and version this benchmark was built with
+{
+	ostringstream Name;
+#if defined(_MSC_VER)
+	Name << "MSVC " << _MSC_FULL_VER;
+#elif defined(__clang__)
+	Name << "clang " << __clang_major__ << "." << __clang_minor__ << "." << __clang_patchlevel__;
+#elif defined(__GNUC__)
+	Name << "gcc " << __GNUC__ << "." << __GNUC_MINOR__ << "." << __GNUC_PATCHLEVEL__;
+#else
+	Name << "unknown";
+#endif
+#ifdef NDEBUG
+	Name << " release";
+#else
+	Name << " debug";
+#endif
+	return Name.str();
+}
+
+// Constructors
+BenchmarkSuite::BenchmarkSuite(const string& newModel, double newMinSeconds) : Model(newModel), MinSeconds(newMinSeconds), MinSamples(5), Sink(0.0) {}	// Constructor that accepts the model name and the least time per case
+
+// Destructors
+BenchmarkSuite::~BenchmarkSuite() {}		// Default destructor
+
+// Functionality
+void BenchmarkSuite::AddProperty(const string& Key, const string& Value)		// Describe the run
+{
+	Properties.push_back({ Key, Value });
+}
+
+void BenchmarkSuite::Run(const string& Name, size_t BatchSize, size_t BytesPerOption, const function<double()>& Case)	// Time Case, one call of which handles BatchSize options
+{
+	Sink += Case();		// Warm up, the first call pays for page faults and cold caches
+
+	vector<double> Samples;
+	double Total = 0.0;
+	while ((Samples.size() < MinSamples) || (Total < MinSeconds))
+	{
+		auto Start = chrono::steady_clock::now();
+		Sink += Case();
+		double Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+		Samples.push_back(Seconds);
+		Total += Seconds;
+	}
+	sort(Samples.begin(), Samples.end());
+
+	BenchmarkResult Result;
+	Result.Name = Name;
+	Result.BatchSize = BatchSize;
+	Result.WorkingSetBytes = BatchSize * BytesPerOption;
+	Result.Samples = Samples.size();
+	Result.MedianNs = Samples[Samples.size() / 2] * 1e9 / BatchSize;
+	Result.MinNs = Samples[0] * 1e9 / BatchSize;
+	Result.OptionsPerSec = 1e9 / Result.MedianNs;
+	Results.push_back(Result);
+
+	// Progress goes to cerr so standard output carries nothing but the JSON document
+	cerr << left << setw(40) << Name << right << setw(10) << BatchSize << setw(12) << fixed << setprecision(2) << Result.MedianNs << " ns/option" << endl;
+	cerr.unsetf(ios::floatfield);
+}
+
+const vector<BenchmarkResult>& BenchmarkSuite::GetResults() const		// Results so far
+{
+	return Results;
+}
+
+void BenchmarkSuite::WriteJson(ostream& Out) const		// Write the machine description and every result as one JSON document
+{
+	Out << "{" << endl
+		<< "  \"model\": " << JsonString(Model) << "," << endl
+		<< "  \"compiler\": " << JsonString(CompilerName()) << "," << endl
+		<< "  \"hardware_threads\": " << HardwareThreads() << "," << endl
+		<< "  \"min_seconds_per_case\": " << MinSeconds << "," << endl;
+	for (const pair<string, string>& Property : Properties)
+	{
+		Out << "  " << JsonString(Property.first) << ": " << JsonString(Property.second) << "," << endl;
+	}
+	Out << "  \"checksum\": " << setprecision(17) << Sink << "," << endl
+		<< "  \"results\": [" << endl;
+
+	for (size_t i = 0; i < Results.size(); i++)
+	{
+		const BenchmarkResult& Result = Results[i];
+		Out << "    {\"name\": " << JsonString(Result.Name)
+			<< ", \"batch_size\": " << Result.BatchSize
+			<< ", \"working_set_bytes\": " << Result.WorkingSetBytes
+			<< ", \"samples\": " << Result.Samples
+			<< setprecision(6)
+			<< ", \"ns_per_option\": " << Result.MedianNs
+			<< ", \"min_ns_per_option\": " << Result.MinNs
+			<< ", \"options_per_sec\": " << Result.OptionsPerSec
+			<< "}" << ((i + 1 < Results.size()) ? "," : "") << endl;
+	}
+
+	Out << "  ]" << endl
+		<< "}" << endl;
+}
+
+// GLOBAL BENCHMARK FUNCTIONS
+vector<size_t> BenchmarkBatchSizes(size_t MaxBatch)		// Batch sizes from L1 resident up to DRAM bound
+{
+	// With six input and two output doubles per option, 256 options fit in a 32 KiB L1, 4096 in L2, 65536 in
+	// a typical last level cache, and a million or more have to stream from DRAM
+	const size_t Sizes[] = { 256, 4096, 65536, 1048576, 4194304 };
+	vector<size_t> Batches;
+	for (size_t n : Sizes)
+	{
+		if (n <= MaxBatch)
+		{
+			Batches.push_back(n);
+		}
+	}
+
+	return Batches;
+}
@@ -0,0 +1,160 @@
+/*	Daniel McNulty II
+*
+*	BrownianBridge.cpp
+*/
+
+#include "BrownianBridge.h"
+#include <cmath>
+#include <iostream>
+
+using namespace std;
+
+// BROWNIANBRIDGE CONSTRUCTORS
+BrownianBridge::BrownianBridge() : BrownianBridge(1)		// Default constructor, a single date at 1
+{
+}
+
+BrownianBridge::BrownianBridge(int Steps)		// Constructor that accepts a number of evenly spaced dates, t_i = i
+{
+	if (Steps < 1)
+	{
+		cout << "ERROR: A Brownian bridge needs at least one date. Resorting to a single date" << endl;
+		Steps = 1;
+	}
+	for (int i = 1; i <= Steps; i++)
+	{
+		Times.push_back(i);
+	}
+	Build();
+}
+
+BrownianBridge::BrownianBridge(const vector<double>& Dates) : Times(Dates)		// Constructor that accepts increasing dates after 0
+{
+	bool Valid = !Times.empty() && (Times[0] > 0.0);
+	for (unsigned int i = 1; Valid && (i < Times.size()); i++)
+	{
+		Valid = Times[i] > Times[i - 1];
+	}
+	if (!Valid)
+	{
+		cout << "ERROR: Brownian bridge dates must be positive and increasing. Resorting to a single date" << endl;
+		Times.assign(1, 1.0);
+	}
+	Build();
+}
+
+// BROWNIANBRIDGE DESTRUCTORS
+BrownianBridge::~BrownianBridge()		// Default destructor
+{
+}
+
+// BROWNIANBRIDGE ACCESSORS
+int BrownianBridge::Steps() const		// Number of dates
+{
+	return static_cast<int>(Times.size());
+}
+
+// BROWNIANBRIDGE FUNCTIONALITY
+void BrownianBridge::Build()		// Index tables and weights of Times
+{
+	int n = Steps();
+	BridgeIndex.assign(n, 0);
+	LeftIndex.assign(n, 0);
+	RightIndex.assign(n, 0);
+	LeftWeight.assign(n, 0.0);
+	RightWeight.assign(n, 0.0);
+	StdDev.assign(n, 0.0);
+
+	// The last date from the first normal
+	vector<int> Filled(n, 0);		// Normal that set each date, 0 if not yet set
+	Filled[n - 1] = 1;
+	BridgeIndex[0] = n - 1;
+	StdDev[0] = sqrt(Times[n - 1]);
+
+	// Each later normal bisects the next unfilled gap, sweeping left to right and starting over at the end
+	int j = 0;
+	for (int i = 1; i < n; i++)
+	{
+		while (Filled[j])
+		{
+			j++;
+		}
+		int k = j;
+		while (!Filled[k])
+		{
+			k++;
+		}
+		int l = j + ((k - 1 - j) >> 1);		// Middle of the gap j ... k - 1
+		Filled[l] = i;
+		BridgeIndex[i] = l;
+		LeftIndex[i] = j;
+		RightIndex[i] = k;
+
+		double Left = (j > 0) ? Times[j - 1] : 0.0;		// W(0) = 0 when the gap starts at the origin
+		LeftWeight[i] = (Times[k] - Times[l]) / (Times[k] - Left);
+		RightWeight[i] = (Times[l] - Left) / (Times[k] - Left);
+		StdDev[i] = sqrt(((Times[l] - Left) * (Times[k] - Times[l])) / (Times[k] - Left));
+
+		j = k + 1;
+		if (j >= n)
+		{
+			j = 0;
+		}
+	}
+}
+
+void BrownianBridge::Transform(const double* Z, size_t n, double* Out) const	// n paths, normal i of path j in Z[i * n + j], standardized increments in Out[i * n + j]
+{
+	int Dates = Steps();
+
+	// W at every date, one normal of the whole block at a time
+	double* Last = Out + (static_cast<size_t>(Dates - 1) * n);
+	for (size_t p = 0; p < n; p++)
+	{
+		Last[p] = StdDev[0] * Z[p];
+	}
+	for (int i = 1; i < Dates; i++)
+	{
+		const double* Normal = Z + (static_cast<size_t>(i) * n);
+		const double* Right = Out + (static_cast<size_t>(RightIndex[i]) * n);
+		double* Bridge = Out + (static_cast<size_t>(BridgeIndex[i]) * n);
+		if (LeftIndex[i] > 0)
+		{
+			const double* Left = Out + (static_cast<size_t>(LeftIndex[i] - 1) * n);
+			for (size_t p = 0; p < n; p++)
+			{
+				Bridge[p] = (LeftWeight[i] * Left[p]) + (RightWeight[i] * Right[p]) + (StdDev[i] * Normal[p]);
+			}
+		}
+		else
+		{
+			for (size_t p = 0; p < n; p++)
+			{
+				Bridge[p] = (RightWeight[i] * Right[p]) + (StdDev[i] * Normal[p]);
+			}
+		}
+	}
+
+	// Standardized increments, from the last date back so every difference still sees the value before it
+	for (int i = Dates - 1; i >= 0; i--)
+	{
+		double* Date = Out + (static_cast<size_t>(i) * n);
+		double Previous = (i > 0) ? Times[i - 1] : 0.0;
+		double Scale = 1.0 / sqrt(Times[i] - Previous);
+		if (i > 0)
+		{
+			const double* Before = Out + (static_cast<size_t>(i - 1) * n);
+			for (size_t p = 0; p < n; p++)
+			{
+				Date[p] = (Date[p] - Before[p]) * Scale;
+			}
+		}
+		else
+		{
+			for (size_t p = 0; p < n; p++)
+			{
+				Date[p] *= Scale;
+			}
+		}
+	}
+}
@@ -0,0 +1,50 @@
+/*	Daniel McNulty II
+*
+*	BrownianBridge.h
+*
+*	Brownian bridge construction of a path from independent standard normals. The first normal sets the
+*	value at the last date, the second the midpoint given both ends, and so on down to the gaps between
+*	neighbouring dates, so the first few normals carry most of the variance of the path. Fed with a low
+*	discrepancy sequence, that puts the path's important directions on the best distributed dimensions,
+*	which is what makes Sobol paths pay off on path-dependent payoffs with many dates.
+*
+*	The construction is the bisection of Glasserman (2004) 3.1 with the index tables of QuantLib's
+*	BrownianBridge, built once per set of dates and applied to a whole block of paths at a time.
+*/
+
+#ifndef BrownianBridge_H
+#define BrownianBridge_H
+
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+class BrownianBridge
+{
+private:
+	vector<double> Times;			// Dates t_1 < ... < t_n, after t_0 = 0
+	vector<int> BridgeIndex;		// Date set by normal i
+	vector<int> LeftIndex;			// First date of the gap filled by normal i, its left end is the date before
+	vector<int> RightIndex;			// Known right end of the gap filled by normal i
+	vector<double> LeftWeight;		// Weight of the left end in the conditional mean
+	vector<double> RightWeight;		// Weight of the right end in the conditional mean
+	vector<double> StdDev;			// Conditional standard deviation of the date given both ends
+
+	void Build();					// Index tables and weights of Times
+
+public:
+	// Constructors
+	BrownianBridge();								// Default constructor, a single date at 1
+	BrownianBridge(int Steps);						// Constructor that accepts a number of evenly spaced dates, t_i = i
+	BrownianBridge(const vector<double>& Dates);	// Constructor that accepts increasing dates after 0
+	// Destructors
+	virtual ~BrownianBridge();						// Default destructor
+
+	// Accessors
+	int Steps() const;								// Number of dates
+
+	// Functionality
+	void Transform(const double* Z, size_t n, double* Out) const;		// n paths, normal i of path j in Z[i * n + j], the standardized increment (W(t_i) - W(t_(i-1))) / sqrt(t_i - t_(i-1)) of path j in Out[i * n + j]
+};
+
+#endif
@@ -0,0 +1,87 @@
+/*	Daniel McNulty II
+*
+*	"Cache Test Source.cpp"
+*
+*	Checks the intermediate term cache of EuropeanOption: with the cache on, every output is identical to
+*	the same option with the cache off after EnableCache(), after each setter patches its terms, after a
+*	data member is assigned directly, after SetData() and after a copy. Returns 1 on any failure.
+*/
+
+#include "EuropeanOption.h"
+#include <iomanip>
+#include <iostream>
+#include <random>
+using namespace std;
+
+bool Check(const char* Name, bool Passed)		// Print one result, true if it passed
+{
+	cout << left << setw(52) << Name << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed;
+}
+
+bool SameOutputs(const EuropeanOption& Cached)		// Every output identical to an uncached option with the same data
+{
+	EuropeanOption Plain(Cached.T, Cached.K, Cached.sig, Cached.r, Cached.U, Cached.b, Cached.optionType);
+	return (Cached.Price() == Plain.Price()) && (Cached.Delta() == Plain.Delta()) && (Cached.Gamma() == Plain.Gamma()) && (Cached.Vega() == Plain.Vega())
+		&& (Cached.Theta() == Plain.Theta()) && (Cached.Rho() == Plain.Rho()) && (Cached.CarryRho() == Plain.CarryRho()) && (Cached.Vanna() == Plain.Vanna())
+		&& (Cached.Volga() == Plain.Volga()) && (Cached.Charm() == Plain.Charm()) && (Cached.Parity() == Plain.Parity()) && (Cached.PriceWithS(Cached.U * 1.1) == Plain.PriceWithS(Plain.U * 1.1));
+}
+
+int main()
+{
+	bool Passed = true;
+	mt19937_64 Generator(2020);
+	uniform_real_distribution<> Unit(0.0, 1.0);
+	bool Enabled = true, Setters = true, Direct = true, Whole = true, Copied = true, Disabled = true;
+
+	for (int i = 0; i < 2000; i++)
+	{
+		double r = 0.1 * Unit(Generator);
+		EuropeanOption Option(0.05 + 2.0 * Unit(Generator), 60.0 + 80.0 * Unit(Generator), 0.1 + 0.5 * Unit(Generator), r, 100.0, r - 0.05 + 0.1 * Unit(Generator), (i % 2 == 0) ? Call : Put);
+		Option.EnableCache();
+		Enabled = Enabled && Option.CacheEnabled() && SameOutputs(Option);
+
+		// Each setter patches only its own terms
+		Option.SetT(Option.T * (0.5 + Unit(Generator)));
+		Setters = Setters && SameOutputs(Option);
+		Option.SetK(Option.K * (0.8 + 0.4 * Unit(Generator)));
+		Setters = Setters && SameOutputs(Option);
+		Option.SetSig(0.05 + 0.6 * Unit(Generator));
+		Setters = Setters && SameOutputs(Option);
+		Option.SetR(0.1 * Unit(Generator));
+		Setters = Setters && SameOutputs(Option);
+		Option.SetU(70.0 + 60.0 * Unit(Generator));
+		Setters = Setters && SameOutputs(Option);
+		Option.SetB(Option.r - 0.05 + 0.1 * Unit(Generator));
+		Setters = Setters && SameOutputs(Option);
+
+		// A member assigned directly makes the cache stale, the next setter rebuilds it
+		Option.U *= 1.05;
+		Direct = Direct && SameOutputs(Option);
+		Option.SetSig(Option.sig * 1.1);
+		Direct = Direct && SameOutputs(Option);
+
+		EuroOptData Data = { 1.0, 100.0, 0.2 + 0.2 * Unit(Generator), 0.05, 90.0 + 20.0 * Unit(Generator), 0.03 };
+		Option.SetData(Data);
+		Whole = Whole && Option.CacheEnabled() && SameOutputs(Option);
+
+		EuropeanOption Copy(Option);
+		EuropeanOption Assigned;
+		Assigned = Option;
+		Copied = Copied && Copy.CacheEnabled() && SameOutputs(Copy) && Assigned.CacheEnabled() && SameOutputs(Assigned);
+
+		Option.DisableCache();
+		Option.SetU(Option.U * 0.9);
+		Disabled = Disabled && !Option.CacheEnabled() && SameOutputs(Option);
+	}
+
+	Passed = Check("EnableCache gives the uncached outputs", Enabled) && Passed;
+	Passed = Check("Every setter keeps the outputs identical", Setters) && Passed;
+	Passed = Check("Directly assigned members are detected", Direct) && Passed;
+	Passed = Check("SetData rebuilds the cache", Whole) && Passed;
+	Passed = Check("Copies keep a current cache", Copied) && Passed;
+	Passed = Check("DisableCache stops the cache", Disabled) && Passed;
+
+	cout << endl << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+/*	Daniel McNulty II
+*
+*	"Dual Test Source.cpp"
+*
+*	Checks the forward mode gradients and second derivatives of calls and puts against the closed form
+*	Greeks and the adjoint over a random book, that the dual price is identical to CallPrice()/PutPrice(),
+*	that the second derivative matrix is symmetric, and that the batches agree with the single option
+*	functions. Then times one price, one first order pass, one second order pass and the central
+*	differences needed for the same six sensitivities. Returns 1 on any failure.
+*/
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionAdjoint.h"
+#include "EuropeanOptionBatch.h"
+#include "EuropeanOptionDual.h"
+#include "NormalDistribution.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+using namespace std;
+
+bool Check(const char* Name, bool Passed)		// Print one result, true if it passed
+{
+	cout << left << setw(52) << Name << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed;
+}
+
+double Relative(double Value, double Exact)		// Error relative to Exact, absolute below 1
+{
+	return fabs(Value - Exact) / fmax(1.0, fabs(Exact));
+}
+
+int main()
+{
+	bool Passed = true;
+
+	// Random book of calls and puts with every kind of carry
+	const size_t Rows = 2000;
+	mt19937_64 Generator(2020);
+	uniform_real_distribution<> Unit(0.0, 1.0);
+	EuroOptBatch Book;
+	Book.Reserve(Rows);
+	for (size_t i = 0; i < Rows; i++)
+	{
+		double r = 0.1 * Unit(Generator);
+		Book.AddRow(0.05 + 3.0 * Unit(Generator), 50.0 + 100.0 * Unit(Generator), 0.05 + 0.6 * Unit(Generator), r, 100.0, r - 0.1 + 0.2 * Unit(Generator));
+	}
+
+	// Every first and second derivative against the closed forms and the adjoint
+	double Worst = 0.0, WorstAdjoint = 0.0, WorstSymmetry = 0.0;
+	bool Identical = true;
+	for (size_t i = 0; i < Rows; i++)
+	{
+		double T = Book.T[i], K = Book.K[i], sig = Book.sig[i], r = Book.r[i], U = Book.U[i], b = Book.b[i];
+		EuroOptDual C = CallDual(T, K, sig, r, U, b);
+		EuroOptDual P = PutDual(T, K, sig, r, U, b);
+		EuroOptDual2 C2 = CallDual2(T, K, sig, r, U, b);
+		EuroOptDual2 P2 = PutDual2(T, K, sig, r, U, b);
+		Identical = Identical && (C.Value == CallPrice(T, K, sig, r, U, b)) && (P.Value == PutPrice(T, K, sig, r, U, b));
+		Identical = Identical && (C2.Value.Value == C.Value) && (P2.Value.Value == P.Value) && (C2.Value.d[Sigma] == C.d[Sigma]);
+		double Errors[18] = {
+			Relative(C.d[Underlying], CallDelta(T, K, sig, r, U, b)), Relative(P.d[Underlying], PutDelta(T, K, sig, r, U, b)),
+			Relative(C.d[Sigma], CallVega(T, K, sig, r, U, b)), Relative(P.d[Sigma], PutVega(T, K, sig, r, U, b)),
+			Relative(-C.d[Expiry], CallTheta(T, K, sig, r, U, b)), Relative(-P.d[Expiry], PutTheta(T, K, sig, r, U, b)),
+			Relative(C.d[Interest] + C.d[Cost_Of_Carry], CallRho(T, K, sig, r, U, b)), Relative(P.d[Interest] + P.d[Cost_Of_Carry], PutRho(T, K, sig, r, U, b)),
+			Relative(C.d[Cost_Of_Carry], CallCarryRho(T, K, sig, r, U, b)), Relative(P.d[Cost_Of_Carry], PutCarryRho(T, K, sig, r, U, b)),
+			Relative(C2.d[Underlying].d[Underlying], CallGamma(T, K, sig, r, U, b)), Relative(P2.d[Underlying].d[Underlying], PutGamma(T, K, sig, r, U, b)),
+			Relative(C2.d[Underlying].d[Sigma], CallVanna(T, K, sig, r, U, b)), Relative(P2.d[Underlying].d[Sigma], PutVanna(T, K, sig, r, U, b)),
+			Relative(C2.d[Sigma].d[Sigma], CallVolga(T, K, sig, r, U, b)), Relative(P2.d[Sigma].d[Sigma], PutVolga(T, K, sig, r, U, b)),
+			Relative(-C2.d[Underlying].d[Expiry], CallCharm(T, K, sig, r, U, b)), Relative(-P2.d[Underlying].d[Expiry], PutCharm(T, K, sig, r, U, b)) };
+		for (double Error : Errors)
+		{
+			Worst = fmax(Worst, Error);
+		}
+
+		AdjointGreeks A = CallAdjoint(T, K, sig, r, U, b);
+		double Adjoint[EuroOptVariables] = { A.dT, A.dK, A.dsig, A.dr, A.dU, A.db };
+		for (int j = 0; j < EuroOptVariables; j++)
+		{
+			WorstAdjoint = fmax(WorstAdjoint, Relative(C.d[j], Adjoint[j]));
+			for (int k = 0; k < EuroOptVariables; k++)
+			{
+				WorstSymmetry = fmax(WorstSymmetry, Relative(C2.d[j].d[k], C2.d[k].d[j]));
+			}
+		}
+	}
+	cout << "Largest error against the closed forms " << Worst << endl;
+	cout << "Largest gradient difference from the adjoint " << WorstAdjoint << endl;
+	cout << "Largest asymmetry of the second derivatives " << WorstSymmetry << endl;
+	Passed = Check("Dual derivatives match the closed form Greeks", Worst < 1e-11) && Passed;
+	Passed = Check("Dual gradients match the adjoint", WorstAdjoint < 1e-12) && Passed;
+	Passed = Check("Second derivatives are symmetric", WorstSymmetry < 1e-11) && Passed;
+	Passed = Check("Dual prices identical to CallPrice/PutPrice", Identical) && Passed;
+
+	// Batches against the single option functions
+	AlignedColumn Prices, Prices2;
+	EuroOptBatch Gradient, Gradient2;
+	vector<EuroOptBatch> Hessian;
+	JacobianBatch(Book, Put, Prices, Gradient, Parallel_Execution);
+	HessianBatch(Book, Put, Prices2, Gradient2, Hessian, Parallel_Execution);
+	size_t Row = Rows - 1;
+	EuroOptDual2 Last = PutDual2(Book.T[Row], Book.K[Row], Book.sig[Row], Book.r[Row], Book.U[Row], Book.b[Row]);
+	Passed = Check("Jacobian batch row identical to PutDual", (Prices[Row] == Last.Value.Value) && (Gradient.sig[Row] == Last.Value.d[Sigma]) && (Gradient.T[Row] == Last.Value.d[Expiry])) && Passed;
+	Passed = Check("Hessian batch row identical to PutDual2", (Prices2[Row] == Last.Value.Value) && (Gradient2.U[Row] == Last.Value.d[Underlying]) && (Hessian[Underlying].U[Row] == Last.d[Underlying].d[Underlying]) && (Hessian[Sigma].T[Row] == Last.d[Sigma].d[Expiry])) && Passed;
+
+	// Cost of the six sensitivities, in units of one price
+	const int Repeats = 50;
+	double Sink = 0.0;
+	auto Start = chrono::steady_clock::now();
+	for (int Repeat = 0; Repeat < Repeats; Repeat++)
+	{
+		for (size_t i = 0; i < Rows; i++)
+		{
+			Sink += CallPrice(Book.T[i], Book.K[i], Book.sig[i], Book.r[i], Book.U[i], Book.b[i]);
+		}
+	}
+	double PriceTime = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	Start = chrono::steady_clock::now();
+	for (int Repeat = 0; Repeat < Repeats; Repeat++)
+	{
+		for (size_t i = 0; i < Rows; i++)
+		{
+			Sink += CallDual(Book.T[i], Book.K[i], Book.sig[i], Book.r[i], Book.U[i], Book.b[i]).d[Underlying];
+		}
+	}
+	double DualTime = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	Start = chrono::steady_clock::now();
+	for (int Repeat = 0; Repeat < Repeats; Repeat++)
+	{
+		for (size_t i = 0; i < Rows; i++)
+		{
+			Sink += CallDual2(Book.T[i], Book.K[i], Book.sig[i], Book.r[i], Book.U[i], Book.b[i]).d[Underlying].d[Underlying];
+		}
+	}
+	double Dual2Time = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	Start = chrono::steady_clock::now();
+	for (int Repeat = 0; Repeat < Repeats; Repeat++)
+	{
+		for (size_t i = 0; i < Rows; i++)
+		{
+			double T = Book.T[i], K = Book.K[i], sig = Book.sig[i], r = Book.r[i], U = Book.U[i], b = Book.b[i];
+			Sink += CallDeltaDiff(T, K, sig, r, U, b, 1e-4 * U);
+			Sink += CallPrice(T + 1e-4, K, sig, r, U, b) - CallPrice(T - 1e-4, K, sig, r, U, b);
+			Sink += CallPrice(T, K + 1e-2, sig, r, U, b) - CallPrice(T, K - 1e-2, sig, r, U, b);
+			Sink += CallPrice(T, K, sig + 1e-4, r, U, b) - CallPrice(T, K, sig - 1e-4, r, U, b);
+			Sink += CallPrice(T, K, sig, r + 1e-4, U, b) - CallPrice(T, K, sig, r - 1e-4, U, b);
+			Sink += CallPrice(T, K, sig, r, U, b + 1e-4) - CallPrice(T, K, sig, r, U, b - 1e-4);
+		}
+	}
+	double BumpTime = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	double PerOption = 1e9 / (Repeats * Rows);
+	cout << endl << "METHOD                      | NS PER OPTION | PRICES" << endl << fixed << setprecision(1);
+	cout << left << setw(28) << "Price" << "| " << setw(14) << PriceTime * PerOption << "| " << 1.0 << endl;
+	cout << left << setw(28) << "Dual, price + 6 partials" << "| " << setw(14) << DualTime * PerOption << "| " << DualTime / PriceTime << endl;
+	cout << left << setw(28) << "Dual, + 36 second partials" << "| " << setw(14) << Dual2Time * PerOption << "| " << Dual2Time / PriceTime << endl;
+	cout << left << setw(28) << "Central differences, 6" << "| " << setw(14) << BumpTime * PerOption << "| " << BumpTime / PriceTime << endl;
+	cout << defaultfloat << setprecision(6) << (Sink == 0.0 ? " " : "") << endl;		// Sink keeps the timed calls from being dropped
+
+	cout << endl << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed ? 0 : 1;
+}
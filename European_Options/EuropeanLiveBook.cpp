@@ -0,0 +1,280 @@
+/*	Daniel McNulty II
+*
+*	EuropeanLiveBook.cpp
+*/
+
+#include "EuropeanLiveBook.h"
+#include "NormalDistribution.h"
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+// EUROLIVEGROUP MEMBER FUNCTIONS
+// Constructors
+EuroLiveGroup::EuroLiveGroup(unsigned int newUnderlying, double newSpot) : Underlying(newUnderlying), Spot(newSpot) {}	// Constructor that accepts the underlying ID and its first spot
+
+// Destructors
+EuroLiveGroup::~EuroLiveGroup() {}		// Default destructor
+
+// Functionality
+size_t EuroLiveGroup::Add(size_t OptionId, const EuropeanOption& Option)		// Append an option and price it at the group's spot
+{
+	Ids.push_back(OptionId);
+	Types.push_back(Option.optionType);
+	LogK.push_back(log(Option.K));
+	DriftT.push_back((Option.b + (pow(Option.sig, 2) / 2)) * Option.T);
+	SqrtT.push_back(sqrt(Option.T));
+	SigSqrtT.push_back(Option.sig * sqrt(Option.T));
+	CarryDiscount.push_back(exp((Option.b - Option.r) * Option.T));
+	StrikeDiscount.push_back(Option.K * exp(-Option.r * Option.T));
+	Price.push_back(0.0);
+	Delta.push_back(0.0);
+	Gamma.push_back(0.0);
+	Vega.push_back(0.0);
+
+	size_t Slot = Ids.size() - 1;
+	Reprice(Slot, Slot + 1);
+	return Slot;
+}
+
+size_t EuroLiveGroup::Remove(size_t Slot)		// Move the last option into Slot
+{
+	size_t Last = Ids.size() - 1;
+	Ids[Slot] = Ids[Last];
+	Types[Slot] = Types[Last];
+	AlignedColumn* Columns[] = { &LogK, &DriftT, &SigSqrtT, &SqrtT, &CarryDiscount, &StrikeDiscount, &Price, &Delta, &Gamma, &Vega };
+	for (AlignedColumn* Column : Columns)
+	{
+		(*Column)[Slot] = (*Column)[Last];
+		Column->pop_back();
+	}
+	Ids.pop_back();
+	Types.pop_back();
+
+	return (Slot < Ids.size()) ? Ids[Slot] : numeric_limits<size_t>::max();
+}
+
+void EuroLiveGroup::Reprice(size_t First, size_t Last)		// Reprice slots [First, Last) at Spot
+{
+	double LogU = log(Spot);		// The only transcendental shared by the whole group
+	for (size_t i = First; i < Last; i++)
+	{
+		double d1 = ((LogU - LogK[i]) + DriftT[i]) / SigSqrtT[i];
+		double d2 = d1 - SigSqrtT[i];
+		double Forward = Spot * CarryDiscount[i];
+		double Density = NormPdf(d1);
+
+		if (Types[i] == Call)
+		{
+			double Nd1 = NormCdf(d1);
+			Price[i] = (Forward * Nd1) - (StrikeDiscount[i] * NormCdf(d2));
+			Delta[i] = CarryDiscount[i] * Nd1;
+		}
+		else
+		{
+			double Nmd1 = NormCdf(-d1);
+			Price[i] = (StrikeDiscount[i] * NormCdf(-d2)) - (Forward * Nmd1);
+			Delta[i] = -CarryDiscount[i] * Nmd1;
+		}
+		Gamma[i] = (Density * CarryDiscount[i]) / (Spot * SigSqrtT[i]);
+		Vega[i] = Forward * Density * SqrtT[i];
+	}
+}
+
+// EUROLIVEBOOK MEMBER FUNCTIONS
+// Private Functions
+EuroLiveGroup* EuroLiveBook::FindGroup(unsigned int Underlying) const		// Group of an underlying, BookLock must be held
+{
+	unordered_map<unsigned int, size_t>::const_iterator Found = GroupIndex.find(Underlying);
+	return (Found == GroupIndex.end()) ? nullptr : Groups[Found->second].get();
+}
+
+void EuroLiveBook::RepriceGroup(EuroLiveGroup& Group, double Spot, double QueuedSeconds, const ExecutionPolicy& Policy)	// Reprice and publish one group
+{
+	lock_guard<mutex> Guard(Group.Lock);
+	Group.Spot = Spot;
+
+	NormalBackend Backend = ActiveNormalBackend();		// The caller's backend, installed on every thread of the loop
+	ParallelFor(Group.Ids.size(), [&](size_t First, size_t Last)
+	{
+		NormalBackendScope Scope(Backend);
+		Group.Reprice(First, Last);
+	}, Policy);
+
+	if (Subscriber)
+	{
+		EuroLiveUpdate Update = { Group.Underlying, Spot, QueuedSeconds, Group.Ids.size(), Group.Ids.data(), Group.Price.data(), Group.Delta.data(), Group.Gamma.data(), Group.Vega.data() };
+		Subscriber(Update);
+	}
+}
+
+// Constructors
+EuroLiveBook::EuroLiveBook() : LiveOptions(0) {}		// Default constructor
+
+// Destructors
+EuroLiveBook::~EuroLiveBook()		// Destructor that stops the worker
+{
+	Stop();
+}
+
+// Functionality
+size_t EuroLiveBook::AddOption(unsigned int Underlying, const EuropeanOption& Option)	// Add a position priced at the underlying's latest spot
+{
+	lock_guard<mutex> Guard(BookLock);
+	EuroLiveGroup* Group = FindGroup(Underlying);
+	if (Group == nullptr)
+	{
+		GroupIndex[Underlying] = Groups.size();
+		Groups.push_back(unique_ptr<EuroLiveGroup>(new EuroLiveGroup(Underlying, Option.U)));
+		Group = Groups.back().get();
+	}
+
+	size_t OptionId = Locations.size();
+	lock_guard<mutex> GroupGuard(Group->Lock);
+	Locations.push_back({ Group, Group->Add(OptionId, Option) });
+	LiveOptions++;
+	return OptionId;
+}
+
+void EuroLiveBook::RemoveOption(size_t OptionId)		// Remove a position
+{
+	lock_guard<mutex> Guard(BookLock);
+	if ((OptionId >= Locations.size()) || (Locations[OptionId].Group == nullptr))
+	{
+		return;
+	}
+
+	OptionLocation& Location = Locations[OptionId];
+	lock_guard<mutex> GroupGuard(Location.Group->Lock);
+	size_t Moved = Location.Group->Remove(Location.Slot);
+	if (Moved != numeric_limits<size_t>::max())
+	{
+		Locations[Moved].Slot = Location.Slot;
+	}
+	Location.Group = nullptr;
+	LiveOptions--;
+}
+
+void EuroLiveBook::Subscribe(const function<void(const EuroLiveUpdate&)>& Callback)	// Set the function called with every update
+{
+	lock_guard<mutex> Guard(BookLock);
+	Subscriber = Callback;
+}
+
+EuroLiveQuote EuroLiveBook::Quote(size_t OptionId) const		// Latest outputs of an option
+{
+	lock_guard<mutex> Guard(BookLock);
+	if ((OptionId >= Locations.size()) || (Locations[OptionId].Group == nullptr))
+	{
+		double NaN = numeric_limits<double>::quiet_NaN();
+		return { NaN, NaN, NaN, NaN, NaN };
+	}
+
+	const OptionLocation& Location = Locations[OptionId];
+	EuroLiveGroup& Group = *Location.Group;
+	lock_guard<mutex> GroupGuard(Group.Lock);
+	size_t i = Location.Slot;
+	return { Group.Spot, Group.Price[i], Group.Delta[i], Group.Gamma[i], Group.Vega[i] };
+}
+
+size_t EuroLiveBook::OptionCount() const		// Live positions
+{
+	lock_guard<mutex> Guard(BookLock);
+	return LiveOptions;
+}
+
+size_t EuroLiveBook::UnderlyingCount() const	// Underlyings with a group
+{
+	lock_guard<mutex> Guard(BookLock);
+	return Groups.size();
+}
+
+void EuroLiveBook::ApplyTick(unsigned int Underlying, double Spot)		// Reprice the dependent options on the calling thread
+{
+	ApplyTick(Underlying, Spot, Serial_Execution);
+}
+
+void EuroLiveBook::ApplyTick(unsigned int Underlying, double Spot, const ExecutionPolicy& Policy)	// Reprice the dependent options on Policy's threads
+{
+	EuroLiveGroup* Group;
+	{
+		lock_guard<mutex> Guard(BookLock);
+		Group = FindGroup(Underlying);
+	}
+	if (Group != nullptr)		// Groups are never freed, so the pointer stays valid without BookLock
+	{
+		RepriceGroup(*Group, Spot, 0.0, Policy);
+	}
+}
+
+void EuroLiveBook::PostTick(unsigned int Underlying, double Spot)		// Queue a tick from any thread
+{
+	Pending.Post(Underlying, Spot);
+}
+
+size_t EuroLiveBook::ProcessTicks()				// Reprice every underlying with a queued tick on the calling thread
+{
+	return ProcessTicks(Serial_Execution);
+}
+
+size_t EuroLiveBook::ProcessTicks(const ExecutionPolicy& Policy)		// Reprice every underlying with a queued tick on Policy's threads
+{
+	lock_guard<mutex> Guard(ProcessLock);
+	size_t n = Pending.Drain(Draining);
+	chrono::steady_clock::time_point Now = chrono::steady_clock::now();
+
+	// Look every group up once, then reprice them without holding the book lock
+	vector<EuroLiveGroup*> Targets(n);
+	{
+		lock_guard<mutex> BookGuard(BookLock);
+		for (size_t t = 0; t < n; t++)
+		{
+			Targets[t] = FindGroup(Draining[t].Underlying);
+		}
+	}
+
+	size_t Repriced = 0;
+	for (size_t t = 0; t < n; t++)
+	{
+		Repriced += (Targets[t] != nullptr) ? 1 : 0;		// Ticks for underlyings without options are dropped
+	}
+
+	NormalBackend Backend = ActiveNormalBackend();
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		NormalBackendScope Scope(Backend);
+		for (size_t t = First; t < Last; t++)
+		{
+			if (Targets[t] != nullptr)
+			{
+				double Queued = chrono::duration<double>(Now - Draining[t].Posted).count();
+				RepriceGroup(*Targets[t], Draining[t].Spot, Queued, Serial_Execution);
+			}
+		}
+	}, Policy);
+
+	return Repriced;
+}
+
+void EuroLiveBook::Start(const ExecutionPolicy& Policy)		// Start a worker that runs ProcessTicks() as ticks arrive
+{
+	Stop();
+	Pending.Restart();
+	Worker = thread([this, Policy]()
+	{
+		while (Pending.Wait())
+		{
+			ProcessTicks(Policy);
+		}
+	});
+}
+
+void EuroLiveBook::Stop()		// Stop the worker after its current pass
+{
+	if (Worker.joinable())
+	{
+		Pending.Stop();
+		Worker.join();
+	}
+}
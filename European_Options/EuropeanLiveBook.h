@@ -0,0 +1,132 @@
+/*	Daniel McNulty II
+*
+*	EuropeanLiveBook.h
+*
+*	Live book of European options indexed by underlying. The options of an underlying are kept together
+*	as structure-of-arrays columns of the terms that do not depend on the spot: log(K), (b + sig^2 / 2)T,
+*	sig sqrt(T), exp((b - r)T) and K exp(-rT). A spot tick therefore costs one log for the underlying and,
+*	per dependent option, the two normal cdfs and one pdf; no other option is touched. Prices agree with
+*	CallPrice()/PutPrice() to rounding (log(U) - log(K) stands in for log(U / K)).
+*
+*	Ticks are either applied at once with ApplyTick() or posted from feed threads with PostTick() into a
+*	conflating queue that ProcessTicks() drains, or that a worker started with Start() drains as ticks
+*	arrive. Conflation keeps at most one pending reprice per underlying, so the time from a tick to its
+*	published update is bounded by one pass over the underlyings that ticked, whatever the tick rate.
+*/
+
+#ifndef EuropeanLiveBook_H
+#define EuropeanLiveBook_H
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionBatch.h"
+#include "LiveTicks.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+struct EuroLiveQuote		// Latest outputs of one live option
+{
+	double Spot;			// Underlying price the outputs were computed at
+	double Price;			// Option value
+	double Delta;			// dV/dU
+	double Gamma;			// d2V/dU2
+	double Vega;			// dV/dsig
+};
+
+struct EuroLiveUpdate		// What a subscriber is given each time an underlying is repriced, the pointers are only valid during the call
+{
+	unsigned int Underlying;	// Underlying ID
+	double Spot;				// Spot the options were repriced at
+	double QueuedSeconds;		// Time from the oldest tick this update covers being posted to the start of the reprice, 0 for ApplyTick()
+	size_t Count;				// Options of the underlying
+	const size_t* OptionIds;	// Option IDs, entry i belongs to the outputs at index i
+	const double* Price;		// Option values
+	const double* Delta;		// dV/dU
+	const double* Gamma;		// d2V/dU2
+	const double* Vega;			// dV/dsig
+};
+
+class EuroLiveGroup		// Options of one underlying with their spot independent terms and latest outputs
+{
+public:
+	mutex Lock;						// Held while the group is repriced, changed or read
+	unsigned int Underlying;		// Underlying ID
+	double Spot;					// Spot of the latest reprice
+	vector<size_t> Ids;				// Option ID of each slot
+	vector<OptionType> Types;		// Call or put
+	AlignedColumn LogK;				// log(K)
+	AlignedColumn DriftT;			// (b + sig^2 / 2)T
+	AlignedColumn SigSqrtT;			// sig sqrt(T)
+	AlignedColumn SqrtT;			// sqrt(T)
+	AlignedColumn CarryDiscount;	// exp((b - r)T)
+	AlignedColumn StrikeDiscount;	// K exp(-rT)
+	AlignedColumn Price, Delta, Gamma, Vega;		// Latest outputs
+
+	// Constructors
+	EuroLiveGroup(unsigned int Underlying, double Spot);		// Constructor that accepts the underlying ID and its first spot
+	// Destructors
+	virtual ~EuroLiveGroup();									// Default destructor
+
+	// Functionality
+	size_t Add(size_t OptionId, const EuropeanOption& Option);	// Append an option and price it at the group's spot, returns its slot
+	size_t Remove(size_t Slot);									// Move the last option into Slot, returns the ID of the option moved (or the removed one if it was last)
+	void Reprice(size_t First, size_t Last);					// Reprice slots [First, Last) at Spot
+};
+
+class EuroLiveBook		// Live European option book indexed by underlying
+{
+private:
+	struct OptionLocation		// Where a live option is stored
+	{
+		EuroLiveGroup* Group;	// Group of its underlying, nullptr once removed
+		size_t Slot;			// Slot within the group
+	};
+
+	mutable mutex BookLock;									// Guards the index below, taken before any group lock
+	unordered_map<unsigned int, size_t> GroupIndex;			// Underlying ID to position in Groups
+	vector<unique_ptr<EuroLiveGroup>> Groups;				// One group per underlying, never freed while the book lives
+	vector<OptionLocation> Locations;						// Location of each option ID
+	size_t LiveOptions;										// Options added and not removed
+	function<void(const EuroLiveUpdate&)> Subscriber;		// Called after every reprice of an underlying
+	TickConflator Pending;									// Ticks posted and not yet priced
+	vector<PendingTick> Draining;							// Ticks taken from Pending by the current ProcessTicks() call
+	mutex ProcessLock;										// One ProcessTicks() at a time
+	thread Worker;											// Thread started by Start()
+
+	EuroLiveGroup* FindGroup(unsigned int Underlying) const;						// Group of an underlying, nullptr if it has no options yet, BookLock must be held
+	void RepriceGroup(EuroLiveGroup& Group, double Spot, double QueuedSeconds, const ExecutionPolicy& Policy);	// Reprice and publish one group
+
+public:
+	// Constructors
+	EuroLiveBook();							// Default constructor, creates an empty book
+	// Destructors
+	virtual ~EuroLiveBook();				// Destructor that stops the worker
+
+	// Functionality
+	size_t AddOption(unsigned int Underlying, const EuropeanOption& Option);	// Add a position priced at the underlying's latest spot (the option's U for a new underlying), returns its option ID
+	void RemoveOption(size_t OptionId);											// Remove a position, its ID is not reused
+	void Subscribe(const function<void(const EuroLiveUpdate&)>& Callback);		// Set the function called with every update before ticks start. It runs on the repricing threads, possibly several at once for different underlyings, and must not call back into the book
+	EuroLiveQuote Quote(size_t OptionId) const;									// Latest outputs of an option, NaN if it was removed
+	size_t OptionCount() const;													// Live positions
+	size_t UnderlyingCount() const;												// Underlyings with a group
+
+	void ApplyTick(unsigned int Underlying, double Spot);									// Reprice the dependent options on the calling thread and publish them
+	void ApplyTick(unsigned int Underlying, double Spot, const ExecutionPolicy& Policy);	// As above with the options spread over Policy's threads
+	void PostTick(unsigned int Underlying, double Spot);									// Queue a tick from any thread, a later tick for the same underlying replaces it
+	size_t ProcessTicks();																	// Reprice every underlying with a queued tick at its latest spot, returns the number repriced
+	size_t ProcessTicks(const ExecutionPolicy& Policy);										// As above with the underlyings spread over Policy's threads
+	void Start(const ExecutionPolicy& Policy);												// Start a worker that runs ProcessTicks() as ticks arrive
+	void Stop();																			// Stop the worker after its current pass
+
+private:
+	EuroLiveBook(const EuroLiveBook& source);					// Not copyable
+	EuroLiveBook& operator = (const EuroLiveBook& source);		// Not assignable
+};
+
+#endif
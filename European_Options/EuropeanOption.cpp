@@ -4,13 +4,33 @@
 */
 
 #include "EuropeanOption.h"
-#include <boost/math/distributions/normal.hpp>
+#include "EuropeanOptionAdjoint.h"
+#include "EuropeanOptionBatch.h"
+#include "EuropeanOptionImpliedVol.h"
+#include "NormalDistribution.h"
 #include <cmath>
 #include <iostream>
 
-using namespace boost::math;
 using namespace std;
 
+// CACHED TERM FUNCTIONS, each evaluates its formula in the same order as the global function it stands in for
+static double CallPriceTerms(const EuroOptTerms& t, double U, double d1, double d2)		// Call price from cached terms
+{
+	return (U * t.CarryDiscount * NormCdf(d1)) - (t.K * t.Discount * NormCdf(d2));
+}
+
+static double PutPriceTerms(const EuroOptTerms& t, double U, double d1, double d2)		// Put price from cached terms
+{
+	return (t.K * t.Discount * NormCdf(-d2)) - (U * t.CarryDiscount * NormCdf(-d1));
+}
+
+static double PriceTermsAt(const EuroOptTerms& t, double newU, OptionType Type)			// Price with a different underlying value, only log(U / K), d1 and d2 are recomputed
+{
+	double d1 = (log(newU / t.K) + ((t.b + (pow(t.sig, 2) / 2)) * t.T)) / (t.sig * t.SqrtT);
+	double d2 = d1 - (t.sig * t.SqrtT);
+	return (Type == Call) ? CallPriceTerms(t, newU, d1, d2) : PutPriceTerms(t, newU, d1, d2);
+}
+
 // PRIVATE MEMBER FUNCTIONS
 void EuropeanOption::Copy(const EuropeanOption& source)	// Copy the values of datamembers from one EuropeanOption object to another
 {
@@ -21,21 +41,34 @@ void EuropeanOption::Copy(const EuropeanOption& source)	// Copy the values of da
 	r = source.r;			// Set the risk-free interest rate equal to the source's risk-free interest rate
 	U = source.U;			// Set the price of the underlying security to underlying security's price of the underlying security
 	b = source.b;			// Set the cost of carry to the source's cost of carry
+	Cached = source.Cached;	// Take over the source's cache, its terms belong to the values just copied
+	Terms = source.Terms;
+}
+
+bool EuropeanOption::CacheCurrent() const	// The cache is enabled and was computed from the current data members
+{
+	return Cached && (Terms.T == T) && (Terms.K == K) && (Terms.sig == sig) && (Terms.r == r) && (Terms.U == U) && (Terms.b == b);
+}
+
+void EuropeanOption::RefreshD()				// Recompute d1 and d2 from the other cached terms
+{
+	Terms.d1 = (Terms.LogMoneyness + ((Terms.b + (pow(Terms.sig, 2) / 2)) * Terms.T)) / (Terms.sig * Terms.SqrtT);
+	Terms.d2 = Terms.d1 - (Terms.sig * Terms.SqrtT);
 }
 
 // PUBLIC MEMBER FUNCTIONS
 // Constructors
-EuropeanOption::EuropeanOption() : Option(), T(0.25), K(65.0), sig(0.30), r(0.08), U(60.0), b(0.08) {}	// Default constructor
+EuropeanOption::EuropeanOption() : Option(), Cached(false), Terms(), T(0.25), K(65.0), sig(0.30), r(0.08), U(60.0), b(0.08) {}	// Default constructor
 
-EuropeanOption::EuropeanOption(const EuropeanOption& source) : Option(source), T(source.T), K(source.K), sig(source.sig), r(source.r), U(source.U), b(source.b) {}		// Copy constructor
+EuropeanOption::EuropeanOption(const EuropeanOption& source) : Option(source), Cached(source.Cached), Terms(source.Terms), T(source.T), K(source.K), sig(source.sig), r(source.r), U(source.U), b(source.b) {}		// Copy constructor
 
-EuropeanOption::EuropeanOption(const OptionType& optionType) : Option(optionType), T(0.25), K(65.0), sig(0.30), r(0.08), U(60.0), b(0.08) {}	// Constructor that accepts OptionType as an argument
+EuropeanOption::EuropeanOption(const OptionType& optionType) : Option(optionType), Cached(false), Terms(), T(0.25), K(65.0), sig(0.30), r(0.08), U(60.0), b(0.08) {}	// Constructor that accepts OptionType as an argument
 
-EuropeanOption::EuropeanOption(const struct EuroOptData& optionData) : Option(), T(optionData.T), K(optionData.K), sig(optionData.sig), r(optionData.r), U(optionData.U), b(optionData.b) {}	// Constructor that accepts EuropeanOptionData
+EuropeanOption::EuropeanOption(const struct EuroOptData& optionData) : Option(), Cached(false), Terms(), T(optionData.T), K(optionData.K), sig(optionData.sig), r(optionData.r), U(optionData.U), b(optionData.b) {}	// Constructor that accepts EuropeanOptionData
 
-EuropeanOption::EuropeanOption(double T, double K, double sig, double r, double U, double b) : Option(), T(T), K(K), sig(sig), r(r), U(U), b(b) {}						// Constructor that accepts EuropeanOption data member input
+EuropeanOption::EuropeanOption(double T, double K, double sig, double r, double U, double b) : Option(), Cached(false), Terms(), T(T), K(K), sig(sig), r(r), U(U), b(b) {}						// Constructor that accepts EuropeanOption data member input
 
-EuropeanOption::EuropeanOption(double T, double K, double sig, double r, double U, double b, OptionType Opt) : Option(Opt), T(T), K(K), sig(sig), r(r), U(U), b(b) {}	// Constructor that accepts EuropeanOption and Option data member input
+EuropeanOption::EuropeanOption(double T, double K, double sig, double r, double U, double b, OptionType Opt) : Option(Opt), Cached(false), Terms(), T(T), K(K), sig(sig), r(r), U(U), b(b) {}	// Constructor that accepts EuropeanOption and Option data member input
 
 // Destructors
 EuropeanOption::~EuropeanOption() {}	// Default destructor
@@ -43,6 +76,14 @@ EuropeanOption::~EuropeanOption() {}	// Default destructor
 // Functions that calculate option price and sensitivities
 double EuropeanOption::Price() const
 {
+	if (CacheCurrent())
+	{
+		if (optionType == Call)
+			return CallPriceTerms(Terms, U, Terms.d1, Terms.d2);
+		else
+			return PutPriceTerms(Terms, U, Terms.d1, Terms.d2);
+	}
+
 	if (optionType == Call)
 		return ::CallPrice(T, K, sig, r, U, b);
 	else
@@ -51,6 +92,14 @@ double EuropeanOption::Price() const
 
 double EuropeanOption::Delta() const
 {
+	if (CacheCurrent())
+	{
+		if (optionType == Call)
+			return Terms.CarryDiscount * NormCdf(Terms.d1);
+		else
+			return (Terms.CarryDiscount * NormCdf(Terms.d1)) - Terms.CarryDiscount;
+	}
+
 	if (optionType == Call)
 		return ::CallDelta(T, K, sig, r, U, b);
 	else
@@ -59,14 +108,138 @@ double EuropeanOption::Delta() const
 
 double EuropeanOption::Gamma() const
 {
+	if (CacheCurrent())
+	{
+		return (NormPdf(Terms.d1) * Terms.CarryDiscount) / (U * sig * Terms.SqrtT);		// Same for calls and puts
+	}
+
 	if (optionType == Call)
 		return ::CallGamma(T, K, sig, r, U, b);
 	else
 		return ::PutGamma(T, K, sig, r, U, b);
 }
 
+double EuropeanOption::Vega() const
+{
+	if (CacheCurrent())
+	{
+		return U * Terms.CarryDiscount * NormPdf(Terms.d1) * Terms.SqrtT;			// Same for calls and puts
+	}
+
+	if (optionType == Call)
+		return ::CallVega(T, K, sig, r, U, b);
+	else
+		return ::PutVega(T, K, sig, r, U, b);
+}
+
+double EuropeanOption::Theta() const
+{
+	if (CacheCurrent())
+	{
+		if (optionType == Call)
+			return -((U * Terms.CarryDiscount * NormPdf(Terms.d1) * sig) / (2 * Terms.SqrtT)) - ((b - r) * U * Terms.CarryDiscount * NormCdf(Terms.d1)) - (r * K * Terms.Discount * NormCdf(Terms.d2));
+		else
+			return -((U * Terms.CarryDiscount * NormPdf(Terms.d1) * sig) / (2 * Terms.SqrtT)) + ((b - r) * U * Terms.CarryDiscount * NormCdf(-Terms.d1)) + (r * K * Terms.Discount * NormCdf(-Terms.d2));
+	}
+
+	if (optionType == Call)
+		return ::CallTheta(T, K, sig, r, U, b);
+	else
+		return ::PutTheta(T, K, sig, r, U, b);
+}
+
+double EuropeanOption::Rho() const
+{
+	if (CacheCurrent())
+	{
+		if (optionType == Call)
+			return T * K * Terms.Discount * NormCdf(Terms.d2);
+		else
+			return -T * K * Terms.Discount * NormCdf(-Terms.d2);
+	}
+
+	if (optionType == Call)
+		return ::CallRho(T, K, sig, r, U, b);
+	else
+		return ::PutRho(T, K, sig, r, U, b);
+}
+
+double EuropeanOption::CarryRho() const
+{
+	if (CacheCurrent())
+	{
+		if (optionType == Call)
+			return T * U * Terms.CarryDiscount * NormCdf(Terms.d1);
+		else
+			return -T * U * Terms.CarryDiscount * NormCdf(-Terms.d1);
+	}
+
+	if (optionType == Call)
+		return ::CallCarryRho(T, K, sig, r, U, b);
+	else
+		return ::PutCarryRho(T, K, sig, r, U, b);
+}
+
+double EuropeanOption::Vanna() const
+{
+	if (CacheCurrent())
+	{
+		return -(Terms.CarryDiscount * NormPdf(Terms.d1) * Terms.d2) / sig;		// Same for calls and puts
+	}
+
+	if (optionType == Call)
+		return ::CallVanna(T, K, sig, r, U, b);
+	else
+		return ::PutVanna(T, K, sig, r, U, b);
+}
+
+double EuropeanOption::Volga() const
+{
+	if (CacheCurrent())
+	{
+		return ((U * Terms.CarryDiscount * NormPdf(Terms.d1) * Terms.SqrtT) * Terms.d1 * Terms.d2) / sig;	// Same for calls and puts
+	}
+
+	if (optionType == Call)
+		return ::CallVolga(T, K, sig, r, U, b);
+	else
+		return ::PutVolga(T, K, sig, r, U, b);
+}
+
+double EuropeanOption::Charm() const
+{
+	if (CacheCurrent())
+	{
+		if (optionType == Call)
+			return -Terms.CarryDiscount * ((NormPdf(Terms.d1) * ((b / (sig * Terms.SqrtT)) - (Terms.d2 / (2 * T)))) + ((b - r) * NormCdf(Terms.d1)));
+		else
+			return -Terms.CarryDiscount * ((NormPdf(Terms.d1) * ((b / (sig * Terms.SqrtT)) - (Terms.d2 / (2 * T)))) - ((b - r) * NormCdf(-Terms.d1)));
+	}
+
+	if (optionType == Call)
+		return ::CallCharm(T, K, sig, r, U, b);
+	else
+		return ::PutCharm(T, K, sig, r, U, b);
+}
+
+double EuropeanOption::ImpliedVol(double MarketPrice) const		// Volatility at which the option is worth MarketPrice, the sig data member is ignored
+{
+	if (optionType == Call)
+		return ::CallImpliedVol(MarketPrice, T, K, r, U, b);
+	else
+		return ::PutImpliedVol(MarketPrice, T, K, r, U, b);
+}
+
 double EuropeanOption::Parity() const			// Use put-call parity to calculate put price
 {
+	if (CacheCurrent())
+	{
+		if (optionType == Call)
+			return CallPriceTerms(Terms, U, Terms.d1, Terms.d2) + (K * Terms.Discount) - U;
+		else
+			return PutPriceTerms(Terms, U, Terms.d1, Terms.d2) + U - (K * Terms.Discount);
+	}
+
 	if (optionType == Call)
 		return ::CallToPut(::CallPrice(T, K, sig, r, U, b), T, K, r, U);
 	else
@@ -75,6 +248,11 @@ double EuropeanOption::Parity() const			// Use put-call parity to calculate put
 
 double EuropeanOption::PriceWithS(double newU) const		// Use underlying price as an argument to calculate option price
 {
+	if (CacheCurrent())
+	{
+		return PriceTermsAt(Terms, newU, optionType);
+	}
+
 	if (optionType == Call)
 	{
 		return ::CallPrice(T, K, sig, r, newU, b);
@@ -87,6 +265,11 @@ double EuropeanOption::PriceWithS(double newU) const		// Use underlying price as
 
 double EuropeanOption::DeltaDiff(double h) const	// Use divided differences to calculate delta
 {
+	if (CacheCurrent())
+	{
+		return (PriceTermsAt(Terms, U + h, optionType) - PriceTermsAt(Terms, U - h, optionType)) / (2 * h);
+	}
+
 	if (optionType == Call)
 		return ::CallDeltaDiff(T, K, sig, r, U, b, h);
 	else
@@ -95,12 +278,146 @@ double EuropeanOption::DeltaDiff(double h) const	// Use divided differences to c
 
 double EuropeanOption::GammaDiff(double h) const	// Use divided differences to calculate gamma
 {
+	if (CacheCurrent())
+	{
+		double Mid = (optionType == Call) ? CallPriceTerms(Terms, U, Terms.d1, Terms.d2) : PutPriceTerms(Terms, U, Terms.d1, Terms.d2);
+		return (PriceTermsAt(Terms, U + h, optionType) - (2 * Mid) + PriceTermsAt(Terms, U - h, optionType)) / (pow(h, 2));
+	}
+
 	if (optionType == Call)
 		return ::CallGammaDiff(T, K, sig, r, U, b, h);
 	else
 		return ::PutGammaDiff(T, K, sig, r, U, b, h);
 }
 
+AdjointGreeks EuropeanOption::Gradient() const	// Price and its derivative with respect to every parameter from one adjoint sweep
+{
+	return AdjointSensitivities(T, K, sig, r, U, b, optionType, ThreadTape());
+}
+
+// Intermediate term cache
+void EuropeanOption::EnableCache()		// Compute the intermediate terms and keep them up to date
+{
+	Cached = true;
+	Terms.T = T; Terms.K = K; Terms.sig = sig; Terms.r = r; Terms.U = U; Terms.b = b;
+	Terms.SqrtT = sqrt(T);
+	Terms.Discount = exp(-r * T);
+	Terms.CarryDiscount = exp((b - r) * T);
+	Terms.LogMoneyness = log(U / K);
+	RefreshD();
+}
+
+void EuropeanOption::DisableCache()		// Stop keeping the intermediate terms
+{
+	Cached = false;
+}
+
+bool EuropeanOption::CacheEnabled() const		// The intermediate terms are being kept
+{
+	return Cached;
+}
+
+// Modifier functions, a stale cache (a data member was assigned directly) is rebuilt in full instead of patched
+void EuropeanOption::SetT(double newT)		// Set the expiry time, sqrt(T), both discount factors, d1 and d2 change
+{
+	bool Patch = CacheCurrent();
+	T = newT;
+	if (!Patch)
+	{
+		if (Cached)
+			EnableCache();
+		return;
+	}
+	Terms.T = T;
+	Terms.SqrtT = sqrt(T);
+	Terms.Discount = exp(-r * T);
+	Terms.CarryDiscount = exp((b - r) * T);
+	RefreshD();
+}
+
+void EuropeanOption::SetK(double newK)		// Set the strike price, log(U / K), d1 and d2 change
+{
+	bool Patch = CacheCurrent();
+	K = newK;
+	if (!Patch)
+	{
+		if (Cached)
+			EnableCache();
+		return;
+	}
+	Terms.K = K;
+	Terms.LogMoneyness = log(U / K);
+	RefreshD();
+}
+
+void EuropeanOption::SetSig(double newSig)	// Set the volatility, only d1 and d2 change
+{
+	bool Patch = CacheCurrent();
+	sig = newSig;
+	if (!Patch)
+	{
+		if (Cached)
+			EnableCache();
+		return;
+	}
+	Terms.sig = sig;
+	RefreshD();
+}
+
+void EuropeanOption::SetR(double newR)		// Set the risk-free interest rate, only the discount factors change
+{
+	bool Patch = CacheCurrent();
+	r = newR;
+	if (!Patch)
+	{
+		if (Cached)
+			EnableCache();
+		return;
+	}
+	Terms.r = r;
+	Terms.Discount = exp(-r * T);
+	Terms.CarryDiscount = exp((b - r) * T);
+}
+
+void EuropeanOption::SetU(double newU)		// Set the price of the underlying security, log(U / K), d1 and d2 change
+{
+	bool Patch = CacheCurrent();
+	U = newU;
+	if (!Patch)
+	{
+		if (Cached)
+			EnableCache();
+		return;
+	}
+	Terms.U = U;
+	Terms.LogMoneyness = log(U / K);
+	RefreshD();
+}
+
+void EuropeanOption::SetB(double newB)		// Set the cost of carry, exp((b - r)T), d1 and d2 change
+{
+	bool Patch = CacheCurrent();
+	b = newB;
+	if (!Patch)
+	{
+		if (Cached)
+			EnableCache();
+		return;
+	}
+	Terms.b = b;
+	Terms.CarryDiscount = exp((b - r) * T);
+	RefreshD();
+}
+
+void EuropeanOption::SetData(const struct EuroOptData& optionData)		// Set every parameter at once
+{
+	T = optionData.T; K = optionData.K; sig = optionData.sig; r = optionData.r; U = optionData.U; b = optionData.b;
+	if (Cached)
+	{
+		EnableCache();
+	}
+}
+
 // Assignment Operator
 EuropeanOption& EuropeanOption::operator = (const EuropeanOption& source)
 {
@@ -149,6 +466,30 @@ vector<vector<double>> GenerateParameterMatrix(double T, double K, double sig, d
 	}
 }
 
+vector<vector<double>> GenerateParameterMatrix(double T, double K, double sig, double r, double U, double b, double End_Parameter_Val, int steps, EuroOptParam VariedParameter, const ExecutionPolicy& Policy)	// General Varying Parameter Matrix Generator that fills its rows on Policy's threads
+{
+	vector<double> BaseRow = { T, K, sig, r, U, b };			// Every row starts as the base parameters
+	int Column = VariedParameter;								// Column of the varied parameter, enum order matches the row layout
+	if ((VariedParameter < Expiry) || (VariedParameter > Cost_Of_Carry))
+	{
+		cout << "ERROR: No proper parameter (Expiry, Strike, Sigma, Interest, Underlying, or Cost_Of_Carry) was chosen. Resorting to default parameter Underlying Price";
+		Column = Underlying;
+	}
+
+	double Begin = BaseRow[Column];
+	double h = ((End_Parameter_Val - Begin) / steps);			// Same step and formula as GenerateMeshArray() so the values match the serial generators exactly
+	vector<vector<double>> ReturnMatrix(steps + 1, BaseRow);	// Create the return matrix
+	ParallelFor(ReturnMatrix.size(), [&](size_t First, size_t Last)
+	{
+		for (size_t i = First; i < Last; i++)
+		{
+			ReturnMatrix[i][Column] = Begin + (h * static_cast<int>(i));
+		}
+	}, Policy);
+
+	return ReturnMatrix;
+}
+
 vector<vector<double>> GenerateExpiryMatrix(double StartT, double K, double sig, double r, double U, double b, double EndT, int steps)			// Expiry Time Varying Matrix Generator
 {
 	vector<vector<double>> ReturnMatrix;										// Create the return matrix
@@ -221,7 +562,7 @@ vector<vector<double>> GenerateCostOfCarryMatrix(double T, double K, double sig,
 	return ReturnMatrix;
 }
 
-vector<vector<double>> MatrixPricer(const vector<vector<double>> DataVec, PricerOutput Out)			// General matrix pricer
+vector<vector<double>> MatrixPricer(const vector<vector<double>>& DataVec, PricerOutput Out)			// General matrix pricer
 {
 	switch (Out)
 	{
@@ -231,52 +572,108 @@ vector<vector<double>> MatrixPricer(const vector<vector<double>> DataVec, Pricer
 		return DeltaVector(DataVec);
 	case (Gamma):
 		return GammaVector(DataVec);
+	case (All):
+		return PriceDeltaGammaVector(DataVec);
 	default:
-		cout << "ERROR: No proper output (Price, Delta, or Gamma) was chosen. Resorting to default output Price";
+		if ((Out > 0) && ((Out & All_Greeks) == Out))		// Any other subset of outputs goes through the fused sensitivity engine
+		{
+			return GreeksVector(DataVec, Out);
+		}
+		cout << "ERROR: No proper output (Price, Delta, Gamma, All, or a combination of outputs) was chosen. Resorting to default output Price";
 		return PriceVector(DataVec);
 	}
 }
 
-vector<vector<double>> PriceVector(const vector<vector<double>> DataVec)														// Return a price vector with a matrix of option parameters
+vector<vector<double>> PriceVector(const vector<vector<double>>& DataVec)		// Return a price vector with a matrix of option parameters
 {
-	vector<vector<double>> Prices;																								// Create return price matrix
-	for (unsigned int i = 0; i < DataVec.size(); i++)
-	{
-		double CallP = CallPrice(DataVec[i][0], DataVec[i][1], DataVec[i][2], DataVec[i][3], DataVec[i][4], DataVec[i][5]);		// Calculate call price
-		double PutP = PutPrice(DataVec[i][0], DataVec[i][1], DataVec[i][2], DataVec[i][3], DataVec[i][4], DataVec[i][5]);		// Calculate put price
+	EuroOptBatchResult Prices;													// Create return price columns
+	PriceBatch(MatrixToBatch(DataVec), Prices);									// Price the parameter matrix as a contiguous batch
+	return BatchToMatrix(Prices);
+}
 
-		Prices.push_back({ CallP, PutP });																						// Fill the return price matrix
-	}
+vector<vector<double>> DeltaVector(const vector<vector<double>>& DataVec)		// Return a delta vector with a matrix of option parameters
+{
+	EuroOptBatchResult Deltas;													// Create return delta columns
+	DeltaBatch(MatrixToBatch(DataVec), Deltas);									// Calculate the deltas of the parameter matrix as a contiguous batch
+	return BatchToMatrix(Deltas);
+}
 
-	return Prices;
+vector<vector<double>> GammaVector(const vector<vector<double>>& DataVec)		// Return a gamma vector with a matrix of option parameters
+{
+	EuroOptBatchResult Gammas;													// Create return gamma columns
+	GammaBatch(MatrixToBatch(DataVec), Gammas);									// Calculate the gammas of the parameter matrix as a contiguous batch
+	return BatchToMatrix(Gammas);
 }
 
-vector<vector<double>> DeltaVector(const vector<vector<double>> DataVec)
+vector<vector<double>> PriceDeltaGammaVector(const vector<vector<double>>& DataVec)	// Return rows of (call price, put price, call delta, put delta, call gamma, put gamma) with a matrix of option parameters
 {
-	vector<vector<double>> Deltas;																								// Create return deltas matrix
-	for (unsigned int i = 0; i < DataVec.size(); i++)
-	{
-		double CallD = CallDelta(DataVec[i][0], DataVec[i][1], DataVec[i][2], DataVec[i][3], DataVec[i][4], DataVec[i][5]);		// Calculate call delta price
-		double PutD = PutDelta(DataVec[i][0], DataVec[i][1], DataVec[i][2], DataVec[i][3], DataVec[i][4], DataVec[i][5]);		// Calculate put delta price
+	EuroOptBatchResult Prices, Deltas, Gammas;									// Create return columns
+	PriceDeltaGammaBatch(MatrixToBatch(DataVec), Prices, Deltas, Gammas);		// Calculate all three outputs in a single pass over the batch
+	return BatchToMatrix(Prices, Deltas, Gammas);
+}
+
+vector<vector<double>> GreeksVector(const vector<vector<double>>& DataVec, PricerOutput Outputs)	// Return rows with a (call, put) pair per selected output with a matrix of option parameters
+{
+	EuroOptGreeksResult Greeks;													// Create return columns for the selected outputs
+	GreeksBatch(MatrixToBatch(DataVec), Outputs, Greeks);						// Calculate every selected output in a single pass over the batch
+	return BatchToMatrix(Greeks, Outputs);
+}
 
-		Deltas.push_back({ CallD, PutD });																						// Fill the return deltas matrix
+vector<vector<double>> MatrixPricer(const vector<vector<double>>& DataVec, PricerOutput Out, const ExecutionPolicy& Policy)		// General matrix pricer on Policy's threads
+{
+	switch (Out)
+	{
+	case (Price):
+		return PriceVector(DataVec, Policy);
+	case (Delta):
+		return DeltaVector(DataVec, Policy);
+	case (Gamma):
+		return GammaVector(DataVec, Policy);
+	case (All):
+		return PriceDeltaGammaVector(DataVec, Policy);
+	default:
+		if ((Out > 0) && ((Out & All_Greeks) == Out))
+		{
+			return GreeksVector(DataVec, Out, Policy);
+		}
+		cout << "ERROR: No proper output (Price, Delta, Gamma, All, or a combination of outputs) was chosen. Resorting to default output Price";
+		return PriceVector(DataVec, Policy);
 	}
+}
 
-	return Deltas;
+vector<vector<double>> PriceVector(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy)		// Price vector on Policy's threads
+{
+	EuroOptBatchResult Prices;
+	PriceBatch(MatrixToBatch(DataVec, Policy), Prices, Policy);
+	return BatchToMatrix(Prices, Policy);
 }
 
-vector<vector<double>> GammaVector(const vector<vector<double>> DataVec)
+vector<vector<double>> DeltaVector(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy)		// Delta vector on Policy's threads
 {
-	vector<vector<double>> Gammas;																								// Create return gammas matrix
-	for (unsigned int i = 0; i < DataVec.size(); i++)
-	{
-		double CallG = CallGamma(DataVec[i][0], DataVec[i][1], DataVec[i][2], DataVec[i][3], DataVec[i][4], DataVec[i][5]);		// Calculate call gamma price
-		double PutG = PutGamma(DataVec[i][0], DataVec[i][1], DataVec[i][2], DataVec[i][3], DataVec[i][4], DataVec[i][5]);		// Calculate put gamma price
+	EuroOptBatchResult Deltas;
+	DeltaBatch(MatrixToBatch(DataVec, Policy), Deltas, Policy);
+	return BatchToMatrix(Deltas, Policy);
+}
 
-		Gammas.push_back({ CallG, PutG });																						// Fill the return gamma matrix
-	}
+vector<vector<double>> GammaVector(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy)		// Gamma vector on Policy's threads
+{
+	EuroOptBatchResult Gammas;
+	GammaBatch(MatrixToBatch(DataVec, Policy), Gammas, Policy);
+	return BatchToMatrix(Gammas, Policy);
+}
 
-	return Gammas;
+vector<vector<double>> PriceDeltaGammaVector(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy)	// Fused prices, deltas and gammas on Policy's threads
+{
+	EuroOptBatchResult Prices, Deltas, Gammas;
+	PriceDeltaGammaBatch(MatrixToBatch(DataVec, Policy), Prices, Deltas, Gammas, Policy);
+	return BatchToMatrix(Prices, Deltas, Gammas, Policy);
+}
+
+vector<vector<double>> GreeksVector(const vector<vector<double>>& DataVec, PricerOutput Outputs, const ExecutionPolicy& Policy)	// Selected outputs on Policy's threads
+{
+	EuroOptGreeksResult Greeks;
+	GreeksBatch(MatrixToBatch(DataVec, Policy), Outputs, Greeks, Policy);
+	return BatchToMatrix(Greeks, Outputs, Policy);
 }
 
 // Call Option Global Functions
@@ -284,22 +681,66 @@ double CallPrice(double T, double K, double sig, double r, double U, double b)
 {
 	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
 	double d2 = d1 - (sig * sqrt(T));
-	normal_distribution<> N(0, 1);
-	return (U * exp((b - r) * T) * cdf(N, d1)) - (K * exp(-r * T) * cdf(N, d2));
+	return (U * exp((b - r) * T) * NormCdf(d1)) - (K * exp(-r * T) * NormCdf(d2));
 }
 
 double CallDelta(double T, double K, double sig, double r, double U, double b)		// Delta of call
 {
 	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
-	normal_distribution<> N(0, 1);
-	return exp((b - r) * T) * cdf(N, d1);
+	return exp((b - r) * T) * NormCdf(d1);
 }
 
 double CallGamma(double T, double K, double sig, double r, double U, double b)		// Gamma of call
 {
 	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
-	normal_distribution<> N(0, 1);
-	return (pdf(N, d1) * exp((b - r) * T)) / (U * sig * sqrt(T));
+	return (NormPdf(d1) * exp((b - r) * T)) / (U * sig * sqrt(T));
+}
+
+double CallVega(double T, double K, double sig, double r, double U, double b)		// Vega of call
+{
+	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	return U * exp((b - r) * T) * NormPdf(d1) * sqrt(T);
+}
+
+double CallTheta(double T, double K, double sig, double r, double U, double b)		// Theta of call, the change in value per year as time passes
+{
+	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	return -((U * exp((b - r) * T) * NormPdf(d1) * sig) / (2 * sqrt(T))) - ((b - r) * U * exp((b - r) * T) * NormCdf(d1)) - (r * K * exp(-r * T) * NormCdf(d2));
+}
+
+double CallRho(double T, double K, double sig, double r, double U, double b)		// Rho of call, b moves with r so the yield r - b is held fixed
+{
+	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	return T * K * exp(-r * T) * NormCdf(d2);
+}
+
+double CallCarryRho(double T, double K, double sig, double r, double U, double b)	// Cost of carry rho of call
+{
+	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	return T * U * exp((b - r) * T) * NormCdf(d1);
+}
+
+double CallVanna(double T, double K, double sig, double r, double U, double b)		// Vanna of call
+{
+	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	return -(exp((b - r) * T) * NormPdf(d1) * d2) / sig;
+}
+
+double CallVolga(double T, double K, double sig, double r, double U, double b)		// Volga of call
+{
+	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	return (CallVega(T, K, sig, r, U, b) * d1 * d2) / sig;
+}
+
+double CallCharm(double T, double K, double sig, double r, double U, double b)		// Charm of call, the change in delta per year as time passes
+{
+	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	return -exp((b - r) * T) * ((NormPdf(d1) * ((b / (sig * sqrt(T))) - (d2 / (2 * T)))) + ((b - r) * NormCdf(d1)));
 }
 
 // Put Option Global Functions
@@ -307,8 +748,7 @@ double PutPrice(double T, double K, double sig, double r, double U, double b)		/
 {
 	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
 	double d2 = d1 - (sig * sqrt(T));
-	normal_distribution<> N(0, 1);
-	return (K * exp(-r * T) * cdf(N, -d2)) - (U * exp((b - r) * T) * cdf(N, -d1));
+	return (K * exp(-r * T) * NormCdf(-d2)) - (U * exp((b - r) * T) * NormCdf(-d1));
 }
 
 double PutDelta(double T, double K, double sig, double r, double U, double b)		// Delta of put
@@ -321,6 +761,48 @@ double PutGamma(double T, double K, double sig, double r, double U, double b)		/
 	return CallGamma(T, K, sig, r, U, b);
 }
 
+double PutVega(double T, double K, double sig, double r, double U, double b)		// Vega of put
+{
+	return CallVega(T, K, sig, r, U, b);
+}
+
+double PutTheta(double T, double K, double sig, double r, double U, double b)		// Theta of put, the change in value per year as time passes
+{
+	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	return -((U * exp((b - r) * T) * NormPdf(d1) * sig) / (2 * sqrt(T))) + ((b - r) * U * exp((b - r) * T) * NormCdf(-d1)) + (r * K * exp(-r * T) * NormCdf(-d2));
+}
+
+double PutRho(double T, double K, double sig, double r, double U, double b)		// Rho of put, b moves with r so the yield r - b is held fixed
+{
+	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	return -T * K * exp(-r * T) * NormCdf(-d2);
+}
+
+double PutCarryRho(double T, double K, double sig, double r, double U, double b)	// Cost of carry rho of put
+{
+	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	return -T * U * exp((b - r) * T) * NormCdf(-d1);
+}
+
+double PutVanna(double T, double K, double sig, double r, double U, double b)		// Vanna of put
+{
+	return CallVanna(T, K, sig, r, U, b);
+}
+
+double PutVolga(double T, double K, double sig, double r, double U, double b)		// Volga of put
+{
+	return CallVolga(T, K, sig, r, U, b);
+}
+
+double PutCharm(double T, double K, double sig, double r, double U, double b)		// Charm of put, the change in delta per year as time passes
+{
+	double d1 = (log(U / K) + ((b + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	double d2 = d1 - (sig * sqrt(T));
+	return -exp((b - r) * T) * ((NormPdf(d1) * ((b / (sig * sqrt(T))) - (d2 / (2 * T)))) - ((b - r) * NormCdf(-d1)));
+}
+
 // Divided Differences Functions
 double CallDeltaDiff(double T, double K, double sig, double r, double U, double b, double h)			// Use divided differences to calculate call delta
 {
@@ -7,14 +7,33 @@
 #define EuropeanOption_H
 
 #include "Option.h"
+#include "ThreadPool.h"
 #include <string>
 #include <vector>
 using namespace std;
 
+struct AdjointGreeks;		// Price and gradient from one adjoint sweep, EuropeanOptionAdjoint.h
+
+struct EuroOptTerms	// Intermediate terms shared by the pricing formulas, kept by an EuropeanOption with its cache enabled
+{
+	double T, K, sig, r, U, b;	// Parameters the terms were computed from
+	double SqrtT;				// sqrt(T)
+	double Discount;			// exp(-rT)
+	double CarryDiscount;		// exp((b - r)T)
+	double LogMoneyness;		// log(U / K)
+	double d1;					// (log(U / K) + (b + sig^2 / 2)T) / (sig sqrt(T))
+	double d2;					// d1 - sig sqrt(T)
+};
+
 class EuropeanOption : public Option
 {
 private:
+	bool Cached;			// The intermediate terms are kept in Terms
+	EuroOptTerms Terms;		// Intermediate terms, only updated by the non-const modifier functions so const readers never write
+
 	void Copy(const EuropeanOption& source);		// Copy the values of datamembers from one EuropeanOption object to another
+	bool CacheCurrent() const;						// The cache is enabled and was computed from the current data members
+	void RefreshD();								// Recompute d1 and d2 from the other cached terms
 
 public:
 	// Data members for the variables involved in European option pricing
@@ -39,10 +58,36 @@ public:
 	double Price() const;						// Calculate the price of the given option
 	double Delta() const;						// Calculate the delta of the given option
 	double Gamma() const;						// Calculate the gamma of the given option
+	double Vega() const;						// Calculate the vega of the given option
+	double Theta() const;						// Calculate the theta of the given option, the change in value per year as time passes
+	double Rho() const;							// Calculate the rho of the given option, b moves with r so the yield r - b is held fixed
+	double CarryRho() const;					// Calculate the cost of carry rho of the given option
+	double Vanna() const;						// Calculate the vanna of the given option
+	double Volga() const;						// Calculate the volga of the given option
+	double Charm() const;						// Calculate the charm of the given option, the change in delta per year as time passes
+	double ImpliedVol(double MarketPrice) const;	// Volatility at which the option is worth MarketPrice, NaN if there is none
 	double Parity() const;						// Use parity to calculate price opposite to optionType
 	double PriceWithS(double newU) const;		// Use underlying price as an argument to calculate option price
 	double DeltaDiff(double h) const;			// Use divided differences to calculate delta
 	double GammaDiff(double h) const;			// Use divided differences to calculate gamma
+	AdjointGreeks Gradient() const;				// Price and its derivative with respect to every parameter from one adjoint sweep
+
+	// Intermediate term cache, off by default. While it is on, the functions above reuse sqrt(T), exp(-rT), exp((b - r)T),
+	// log(U / K), d1 and d2 and give the same results as with it off. The setters below recompute only the terms their
+	// parameter affects. Const functions never write the cache, so any number of threads may call them at once; a data
+	// member assigned directly is detected and priced without the cache until EnableCache() or a setter is called again
+	void EnableCache();							// Compute the intermediate terms and keep them up to date
+	void DisableCache();						// Stop keeping the intermediate terms
+	bool CacheEnabled() const;					// The intermediate terms are being kept
+
+	// Modifier functions that keep the cache up to date
+	void SetT(double newT);						// Set the expiry time
+	void SetK(double newK);						// Set the strike price
+	void SetSig(double newSig);					// Set the volatility
+	void SetR(double newR);						// Set the risk-free interest rate
+	void SetU(double newU);						// Set the price of the underlying security
+	void SetB(double newB);						// Set the cost of carry
+	void SetData(const struct EuroOptData& optionData);	// Set every parameter at once
 
 	// Assignment Operator
 	EuropeanOption& operator = (const EuropeanOption& source);
@@ -68,17 +113,32 @@ enum EuroOptParam			// enum to chose the varying parameter in the GenerateMatrix
 	Cost_Of_Carry
 };
 
-enum PricerOutput			// enum to chose what you want output from the Matrix Pricer
+enum PricerOutput			// enum to chose what you want output from the Matrix Pricer, values can be combined with | to request any subset
 {
-	Price,
-	Delta,
-	Gamma
+	Price = 1,
+	Delta = 2,
+	Gamma = 4,
+	All = 7,				// Price, delta and gamma together from one fused pass
+	Vega = 8,
+	Theta = 16,
+	Rho = 32,
+	CarryRho = 64,
+	Vanna = 128,
+	Volga = 256,
+	Charm = 512,
+	All_Greeks = 1023		// Price and every sensitivity
 };
 
+constexpr PricerOutput operator | (PricerOutput A, PricerOutput B)		// Combine PricerOutput selections, usable in constant expressions
+{
+	return static_cast<PricerOutput>(static_cast<int>(A) | static_cast<int>(B));
+}
+
 // Vector and Matrix Generators
 vector<double> GenerateMeshArray(double begin, double end, int n);					// Mesh generator
 
 vector<vector<double>> GenerateParameterMatrix(double T, double K, double sig, double r, double U, double b, double End_Parameter_Val, int steps, EuroOptParam VariedParameter);	// General Varying Parameter Matrix Generator
+vector<vector<double>> GenerateParameterMatrix(double T, double K, double sig, double r, double U, double b, double End_Parameter_Val, int steps, EuroOptParam VariedParameter, const ExecutionPolicy& Policy);	// General Varying Parameter Matrix Generator that fills its rows on Policy's threads
 vector<vector<double>> GenerateExpiryMatrix(double StartT, double K, double sig, double r, double U, double b, double EndT, int steps);				// Expiry Time Varying Matrix Generator
 vector<vector<double>> GenerateStrikeMatrix(double T, double StartK, double sig, double r, double U, double b, double EndK, int steps);				// Strike Price Varying Matrix Generator
 vector<vector<double>> GenerateVolatilityMatrix(double T, double K, double Start_sig, double r, double U, double b, double End_sig, int steps);		// Volitility Varying Matrix Generator
@@ -86,20 +146,44 @@ vector<vector<double>> GenerateInterestMatrix(double T, double K, double sig, do
 vector<vector<double>> GenerateUnderlyingMatrix(double T, double K, double sig, double r, double StartU, double b, double EndU, int steps);			// Underlying Price Varying Matrix Generator
 vector<vector<double>> GenerateCostOfCarryMatrix(double T, double K, double sig, double r, double U, double Start_b, double End_b, int steps);		// Cost of Cary Varying Matrix Generator
 
-vector<vector<double>> MatrixPricer(const vector<vector<double>> DataVec, PricerOutput Out);			// General matrix pricer
-vector<vector<double>> PriceVector(const vector<vector<double>> DataVec);			// Pricer of an input matrix
-vector<vector<double>> DeltaVector(const vector<vector<double>> DataVec);			// Calculate the deltas of a matrix
-vector<vector<double>> GammaVector(const vector<vector<double>> DataVec);			// Calculate the gammas of a matrix
+vector<vector<double>> MatrixPricer(const vector<vector<double>>& DataVec, PricerOutput Out);			// General matrix pricer
+vector<vector<double>> PriceVector(const vector<vector<double>>& DataVec);			// Pricer of an input matrix
+vector<vector<double>> DeltaVector(const vector<vector<double>>& DataVec);			// Calculate the deltas of a matrix
+vector<vector<double>> GammaVector(const vector<vector<double>>& DataVec);			// Calculate the gammas of a matrix
+vector<vector<double>> PriceDeltaGammaVector(const vector<vector<double>>& DataVec);	// Calculate the prices, deltas and gammas of a matrix in one pass
+vector<vector<double>> GreeksVector(const vector<vector<double>>& DataVec, PricerOutput Outputs);		// Calculate any subset of outputs in one pass, each row holds a (call, put) pair per selected output in enum order
+
+// Matrix pricers that spread the rows over Policy's threads, the output is identical to the serial versions above
+vector<vector<double>> MatrixPricer(const vector<vector<double>>& DataVec, PricerOutput Out, const ExecutionPolicy& Policy);
+vector<vector<double>> PriceVector(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy);
+vector<vector<double>> DeltaVector(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy);
+vector<vector<double>> GammaVector(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy);
+vector<vector<double>> PriceDeltaGammaVector(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy);
+vector<vector<double>> GreeksVector(const vector<vector<double>>& DataVec, PricerOutput Outputs, const ExecutionPolicy& Policy);
 
 // Call Option Global Functions
 double CallPrice(double T, double K, double sig, double r, double U, double b);		// Price of call
 double CallDelta(double T, double K, double sig, double r, double U, double b);		// Delta of call
 double CallGamma(double T, double K, double sig, double r, double U, double b);		// Gamma of call
+double CallVega(double T, double K, double sig, double r, double U, double b);		// Vega of call
+double CallTheta(double T, double K, double sig, double r, double U, double b);		// Theta of call
+double CallRho(double T, double K, double sig, double r, double U, double b);		// Rho of call
+double CallCarryRho(double T, double K, double sig, double r, double U, double b);	// Cost of carry rho of call
+double CallVanna(double T, double K, double sig, double r, double U, double b);		// Vanna of call
+double CallVolga(double T, double K, double sig, double r, double U, double b);		// Volga of call
+double CallCharm(double T, double K, double sig, double r, double U, double b);		// Charm of call
 
 // Put Option Global Functions
 double PutPrice(double T, double K, double sig, double r, double U, double b);		// Price of put
 double PutDelta(double T, double K, double sig, double r, double U, double b);		// Delta of put
 double PutGamma(double T, double K, double sig, double r, double U, double b);		// Gamma of put
+double PutVega(double T, double K, double sig, double r, double U, double b);		// Vega of put
+double PutTheta(double T, double K, double sig, double r, double U, double b);		// Theta of put
+double PutRho(double T, double K, double sig, double r, double U, double b);		// Rho of put
+double PutCarryRho(double T, double K, double sig, double r, double U, double b);	// Cost of carry rho of put
+double PutVanna(double T, double K, double sig, double r, double U, double b);		// Vanna of put
+double PutVolga(double T, double K, double sig, double r, double U, double b);		// Volga of put
+double PutCharm(double T, double K, double sig, double r, double U, double b);		// Charm of put
 
 // Divided Differences Functions
 double CallDeltaDiff(double T, double K, double sig, double r, double U, double b, double h);			// Use divided differences to calculate call delta
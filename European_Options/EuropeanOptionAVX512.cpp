@@ -0,0 +1,82 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionAVX512.cpp
+*
+*	AVX-512F path of the vectorized European pricer and of the Barone-Adesi-Whaley boundary solve,
+*	eight rows per vector. MSVC builds this file with /arch:AVX512 (set per file in the project);
+*	GCC and Clang get the same instruction set from the pragma below. Nothing in here may be called
+*	unless DetectSimdPath() has reported AVX-512F support.
+*/
+
+#include "NormalDistribution.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+
+#if defined(__GNUC__) && !defined(__AVX512F__)
+#pragma GCC target("avx512f")
+#endif
+
+#include "AmericanOptionApproxKernel.h"
+#include "EuropeanOptionSIMDKernel.h"
+
+struct AVX512Lanes		// Eight doubles per __m512d, comparisons produce bit masks
+{
+	typedef __m512d Vec;
+	typedef __mmask8 Mask;
+	static const size_t Width = 8;
+
+	static Vec Load(const double* p) { return _mm512_loadu_pd(p); }
+	static void Store(double* p, Vec a) { _mm512_storeu_pd(p, a); }
+	static Vec Set1(double a) { return _mm512_set1_pd(a); }
+
+	static Vec Add(Vec a, Vec b) { return _mm512_add_pd(a, b); }
+	static Vec Sub(Vec a, Vec b) { return _mm512_sub_pd(a, b); }
+	static Vec Mul(Vec a, Vec b) { return _mm512_mul_pd(a, b); }
+	static Vec Div(Vec a, Vec b) { return _mm512_div_pd(a, b); }
+	static Vec Fma(Vec a, Vec b, Vec c) { return _mm512_fmadd_pd(a, b, c); }
+	static Vec Sqrt(Vec a) { return _mm512_sqrt_pd(a); }
+	static Vec Abs(Vec a) { return _mm512_castsi512_pd(_mm512_and_epi64(_mm512_castpd_si512(a), _mm512_set1_epi64(0x7FFFFFFFFFFFFFFFLL))); }
+	static Vec Min(Vec a, Vec b) { return _mm512_min_pd(a, b); }
+	static Vec Max(Vec a, Vec b) { return _mm512_max_pd(a, b); }
+	static Vec Round(Vec a) { return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+	static Mask Less(Vec a, Vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+	static Mask Greater(Vec a, Vec b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+	static Vec Select(Mask m, Vec a, Vec b) { return _mm512_mask_blend_pd(m, b, a); }
+
+	static Vec Exp2Int(Vec n)		// 2^n for integer valued n in [-1022, 1023], the sum puts n + 1023 in the low mantissa bits
+	{
+		__m512i Bits = _mm512_castpd_si512(_mm512_add_pd(n, _mm512_set1_pd(4503599627370496.0 + 1023.0)));
+		return _mm512_castsi512_pd(_mm512_slli_epi64(Bits, 52));
+	}
+
+	static Vec Exponent(Vec a)		// Unbiased binary exponent of a positive normal a, as a double
+	{
+		__m512i Biased = _mm512_srli_epi64(_mm512_castpd_si512(a), 52);
+		Vec AsDouble = _mm512_castsi512_pd(_mm512_or_epi64(Biased, _mm512_set1_epi64(0x4330000000000000LL)));
+		return _mm512_sub_pd(AsDouble, _mm512_set1_pd(4503599627370496.0 + 1023.0));
+	}
+
+	static Vec Mantissa(Vec a)		// Mantissa of a positive normal a, scaled into [1, 2)
+	{
+		__m512i Bits = _mm512_and_epi64(_mm512_castpd_si512(a), _mm512_set1_epi64(0x000FFFFFFFFFFFFFLL));
+		return _mm512_castsi512_pd(_mm512_or_epi64(Bits, _mm512_set1_epi64(0x3FF0000000000000LL)));
+	}
+};
+
+void PriceKernelAVX512(NormalBackend Backend, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* U, const double* b, double* Call, double* Put)
+{
+	PriceKernelTier<AVX512Lanes>(Backend, n, T, K, sig, r, U, b, Call, Put);
+}
+
+void BAWBoundaryAVX512(OptionType Type, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* b, double* Boundary)
+{
+	BAWBoundaryType<AVX512Lanes>(Type, n, T, K, sig, r, b, Boundary);
+}
+
+#endif
@@ -0,0 +1,68 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionAdjoint.cpp
+*/
+
+#include "EuropeanOptionAdjoint.h"
+#include "NormalDistribution.h"
+
+using namespace std;
+
+// GLOBAL ADJOINT FUNCTIONS
+AdjointGreeks AdjointSensitivities(double T, double K, double sig, double r, double U, double b, OptionType Type, AdjointTape& Tape)	// Price and gradient recorded on Tape
+{
+	Tape.Rewind();
+	ADouble aT = Tape.Input(T), aK = Tape.Input(K), aSig = Tape.Input(sig), aR = Tape.Input(r), aU = Tape.Input(U), aB = Tape.Input(b);
+	ADouble Value = (Type == Call) ? KernelPrice<Call, General_Carry>(aT, aK, aSig, aR, aU, aB) : KernelPrice<Put, General_Carry>(aT, aK, aSig, aR, aU, aB);
+	Tape.Propagate(Value);
+
+	AdjointGreeks Out;
+	Out.Price = Value.Value;
+	Out.dT = Tape.Adjoint(aT);
+	Out.dK = Tape.Adjoint(aK);
+	Out.dsig = Tape.Adjoint(aSig);
+	Out.dr = Tape.Adjoint(aR);
+	Out.dU = Tape.Adjoint(aU);
+	Out.db = Tape.Adjoint(aB);
+	return Out;
+}
+
+AdjointGreeks CallAdjoint(double T, double K, double sig, double r, double U, double b)		// Price and gradient of call
+{
+	return AdjointSensitivities(T, K, sig, r, U, b, Call, ThreadTape());
+}
+
+AdjointGreeks PutAdjoint(double T, double K, double sig, double r, double U, double b)		// Price and gradient of put
+{
+	return AdjointSensitivities(T, K, sig, r, U, b, Put, ThreadTape());
+}
+
+void AdjointBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient)		// Prices and gradients of every row on the calling thread
+{
+	AdjointBatch(Data, Type, Price, Gradient, Serial_Execution);
+}
+
+void AdjointBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient, const ExecutionPolicy& Policy)	// Prices and gradients of every row on Policy's threads
+{
+	size_t n = Data.Size();
+	Price.resize(n);
+	Gradient.Resize(n);
+	NormalBackend Backend = ActiveNormalBackend();		// The caller's tier on every thread
+
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		NormalBackendScope Scope(Backend);
+		AdjointTape& Tape = ThreadTape();		// One tape per thread, reused by every row of the range
+		for (size_t i = First; i < Last; i++)
+		{
+			AdjointGreeks Row = AdjointSensitivities(Data.T[i], Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i], Type, Tape);
+			Price[i] = Row.Price;
+			Gradient.T[i] = Row.dT;
+			Gradient.K[i] = Row.dK;
+			Gradient.sig[i] = Row.dsig;
+			Gradient.r[i] = Row.dr;
+			Gradient.U[i] = Row.dU;
+			Gradient.b[i] = Row.db;
+		}
+	}, Policy);
+}
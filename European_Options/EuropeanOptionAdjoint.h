@@ -0,0 +1,47 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionAdjoint.h
+*
+*	First order sensitivities of the generalized Black-Scholes price by reverse mode algorithmic
+*	differentiation. KernelPrice() is recorded once on an AdjointTape and one backward sweep gives its
+*	derivative with respect to all six inputs, at a few times the cost of one price, where the divided
+*	differences of DeltaDiff() reprice twice per sensitivity and lose digits to the bump size. The
+*	recording uses the calling thread's ThreadTape(), so repeated calls do not allocate.
+*
+*	The derivatives are the plain partials: dT is dV/dT, so Theta() = -dT, and dr holds b fixed, so
+*	Rho(), which moves b with r, is dr + db. Gamma and the other second order Greeks are not first
+*	derivatives of the price, they come from the closed forms or the second order duals of
+*	EuropeanOptionDual.h.
+*/
+
+#ifndef EuropeanOptionAdjoint_H
+#define EuropeanOptionAdjoint_H
+
+#include "AdjointTape.h"
+#include "EuropeanOptionBatch.h"
+#include "EuropeanOptionKernels.h"
+#include "Option.h"
+#include "ThreadPool.h"
+using namespace std;
+
+struct AdjointGreeks	// Price and its derivative with respect to every input
+{
+	double Price;		// Option value, identical to CallPrice()/PutPrice()
+	double dT;			// dV/dT
+	double dK;			// dV/dK
+	double dsig;		// dV/dsig, the vega
+	double dr;			// dV/dr with b fixed
+	double dU;			// dV/dU, the delta
+	double db;			// dV/db, the cost of carry rho
+};
+
+// Single option sensitivities, on the calling thread's tape or on a given one
+AdjointGreeks CallAdjoint(double T, double K, double sig, double r, double U, double b);		// Price and gradient of call
+AdjointGreeks PutAdjoint(double T, double K, double sig, double r, double U, double b);		// Price and gradient of put
+AdjointGreeks AdjointSensitivities(double T, double K, double sig, double r, double U, double b, OptionType Type, AdjointTape& Tape);	// Price and gradient recorded on Tape, which is rewound first
+
+// Batch sensitivities, Gradient has the columns of Data with each holding the derivative with respect to that parameter
+void AdjointBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient);
+void AdjointBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient, const ExecutionPolicy& Policy);
+
+#endif
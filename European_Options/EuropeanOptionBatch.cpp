@@ -0,0 +1,582 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionBatch.cpp
+*/
+
+#include "EuropeanOptionBatch.h"
+#include "NormalDistribution.h"
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+// EUROOPTBATCH MEMBER FUNCTIONS
+// Constructors
+EuroOptBatch::EuroOptBatch() {}																// Default constructor, creates an empty batch
+
+EuroOptBatch::EuroOptBatch(size_t n) : T(n), K(n), sig(n), r(n), U(n), b(n) {}				// Constructor that creates a batch of n zeroed rows
+
+// Destructors
+EuroOptBatch::~EuroOptBatch() {}															// Default destructor
+
+// Functionality
+size_t EuroOptBatch::Size() const		// Number of rows in the batch
+{
+	return T.size();
+}
+
+void EuroOptBatch::Resize(size_t n)		// Resize every column to n rows
+{
+	T.resize(n);
+	K.resize(n);
+	sig.resize(n);
+	r.resize(n);
+	U.resize(n);
+	b.resize(n);
+}
+
+void EuroOptBatch::Reserve(size_t n)	// Reserve capacity for n rows in every column
+{
+	T.reserve(n);
+	K.reserve(n);
+	sig.reserve(n);
+	r.reserve(n);
+	U.reserve(n);
+	b.reserve(n);
+}
+
+void EuroOptBatch::AddRow(const EuroOptData& Data)		// Append one row of option parameters
+{
+	AddRow(Data.T, Data.K, Data.sig, Data.r, Data.U, Data.b);
+}
+
+void EuroOptBatch::AddRow(double newT, double newK, double newSig, double newR, double newU, double newB)	// Append one row of option parameters
+{
+	T.push_back(newT);
+	K.push_back(newK);
+	sig.push_back(newSig);
+	r.push_back(newR);
+	U.push_back(newU);
+	b.push_back(newB);
+}
+
+EuroOptData EuroOptBatch::Row(size_t i) const			// Return row i as an EuroOptData
+{
+	EuroOptData Data = { T[i], K[i], sig[i], r[i], U[i], b[i] };
+	return Data;
+}
+
+// EUROOPTBATCHRESULT MEMBER FUNCTIONS
+// Constructors
+EuroOptBatchResult::EuroOptBatchResult() {}										// Default constructor, creates an empty result
+
+EuroOptBatchResult::EuroOptBatchResult(size_t n) : Call(n), Put(n) {}			// Constructor that creates a result of n zeroed rows
+
+// Destructors
+EuroOptBatchResult::~EuroOptBatchResult() {}									// Default destructor
+
+// Functionality
+size_t EuroOptBatchResult::Size() const		// Number of rows in the result
+{
+	return Call.size();
+}
+
+void EuroOptBatchResult::Resize(size_t n)	// Resize both columns to n rows
+{
+	Call.resize(n);
+	Put.resize(n);
+}
+
+// EUROOPTGREEKSRESULT MEMBER FUNCTIONS
+static const PricerOutput GreekOrder[] = { Price, Delta, Gamma, Vega, Theta, Rho, CarryRho, Vanna, Volga, Charm };		// Single outputs in the order their columns appear in a matrix
+
+// Constructors
+EuroOptGreeksResult::EuroOptGreeksResult() {}									// Default constructor, every column empty
+
+// Destructors
+EuroOptGreeksResult::~EuroOptGreeksResult() {}									// Default destructor
+
+// Functionality
+EuroOptBatchResult& EuroOptGreeksResult::Column(PricerOutput Output)			// Column pair of a single output
+{
+	return const_cast<EuroOptBatchResult&>(static_cast<const EuroOptGreeksResult&>(*this).Column(Output));
+}
+
+const EuroOptBatchResult& EuroOptGreeksResult::Column(PricerOutput Output) const	// Column pair of a single output
+{
+	switch (Output)
+	{
+	case (Price):
+		return Prices;
+	case (Delta):
+		return Deltas;
+	case (Gamma):
+		return Gammas;
+	case (Vega):
+		return Vegas;
+	case (Theta):
+		return Thetas;
+	case (Rho):
+		return Rhos;
+	case (CarryRho):
+		return CarryRhos;
+	case (Vanna):
+		return Vannas;
+	case (Volga):
+		return Volgas;
+	case (Charm):
+		return Charms;
+	default:
+		cout << "ERROR: Column() needs a single output (Price, Delta, Gamma, Vega, Theta, Rho, CarryRho, Vanna, Volga, or Charm). Resorting to default output Price";
+		return Prices;
+	}
+}
+
+void EuroOptGreeksResult::Resize(size_t n, PricerOutput Outputs)			// Resize the selected column pairs to n rows and empty the others
+{
+	for (PricerOutput Output : GreekOrder)
+	{
+		Column(Output).Resize((Outputs & Output) ? n : 0);
+	}
+}
+
+// CARRY MODEL KERNEL LOOPS
+template <CarryModel Carry, bool Calls, bool Puts>
+static void PriceRowsModel(const EuroOptBatch& Data, double* Call, double* Put, const ExecutionPolicy& Policy)		// Prices of the selected legs of every row with the kernels of one model
+{
+	const double* T = Data.T.data(); const double* K = Data.K.data(); const double* sig = Data.sig.data();
+	const double* r = Data.r.data(); const double* U = Data.U.data(); const double* b = Data.b.data();
+
+	NormalBackend Backend = ActiveNormalBackend();		// The caller's backend, installed on every thread of the loop
+	ParallelFor(Data.Size(), [&](size_t First, size_t Last)
+	{
+		NormalBackendScope Scope(Backend);
+		for (size_t i = First; i < Last; i++)
+		{
+			if (Calls)
+				Call[i] = KernelPrice<OptionType::Call, Carry>(T[i], K[i], sig[i], r[i], U[i], b[i]);		// Calculate call price
+			if (Puts)
+				Put[i] = KernelPrice<OptionType::Put, Carry>(T[i], K[i], sig[i], r[i], U[i], b[i]);		// Calculate put price
+		}
+	}, Policy);
+}
+
+template <CarryModel Carry, bool Calls, bool Puts>
+static void DeltaRowsModel(const EuroOptBatch& Data, double* Call, double* Put, const ExecutionPolicy& Policy)		// Deltas of the selected legs of every row with the kernels of one model
+{
+	const double* T = Data.T.data(); const double* K = Data.K.data(); const double* sig = Data.sig.data();
+	const double* r = Data.r.data(); const double* U = Data.U.data(); const double* b = Data.b.data();
+
+	NormalBackend Backend = ActiveNormalBackend();
+	ParallelFor(Data.Size(), [&](size_t First, size_t Last)
+	{
+		NormalBackendScope Scope(Backend);
+		for (size_t i = First; i < Last; i++)
+		{
+			if (Calls)
+				Call[i] = KernelDelta<OptionType::Call, Carry>(T[i], K[i], sig[i], r[i], U[i], b[i]);		// Calculate call delta
+			if (Puts)
+				Put[i] = KernelDelta<OptionType::Put, Carry>(T[i], K[i], sig[i], r[i], U[i], b[i]);		// Calculate put delta
+		}
+	}, Policy);
+}
+
+template <CarryModel Carry>
+static void GammaRowsModel(const EuroOptBatch& Data, double* Call, double* Put, const ExecutionPolicy& Policy)		// Gammas of every row with the kernel of one model, calls and puts share it
+{
+	const double* T = Data.T.data(); const double* K = Data.K.data(); const double* sig = Data.sig.data();
+	const double* r = Data.r.data(); const double* U = Data.U.data(); const double* b = Data.b.data();
+
+	NormalBackend Backend = ActiveNormalBackend();
+	ParallelFor(Data.Size(), [&](size_t First, size_t Last)
+	{
+		NormalBackendScope Scope(Backend);
+		for (size_t i = First; i < Last; i++)
+		{
+			Call[i] = KernelGamma<Carry>(T[i], K[i], sig[i], r[i], U[i], b[i]);		// Calculate call gamma
+			Put[i] = Call[i];														// Put gamma equals call gamma
+		}
+	}, Policy);
+}
+
+template <bool Calls, bool Puts>
+static void PriceRows(const EuroOptBatch& Data, double* Call, double* Put, const ExecutionPolicy& Policy)		// Pick the price kernels once for the whole batch
+{
+	switch (DetectCarryModel(Data))
+	{
+	case (BlackScholes_Carry):
+		PriceRowsModel<BlackScholes_Carry, Calls, Puts>(Data, Call, Put, Policy);
+		break;
+	case (Black76_Carry):
+		PriceRowsModel<Black76_Carry, Calls, Puts>(Data, Call, Put, Policy);
+		break;
+	default:
+		PriceRowsModel<General_Carry, Calls, Puts>(Data, Call, Put, Policy);
+	}
+}
+
+template <bool Calls, bool Puts>
+static void DeltaRows(const EuroOptBatch& Data, double* Call, double* Put, const ExecutionPolicy& Policy)		// Pick the delta kernels once for the whole batch
+{
+	switch (DetectCarryModel(Data))
+	{
+	case (BlackScholes_Carry):
+		DeltaRowsModel<BlackScholes_Carry, Calls, Puts>(Data, Call, Put, Policy);
+		break;
+	case (Black76_Carry):
+		DeltaRowsModel<Black76_Carry, Calls, Puts>(Data, Call, Put, Policy);
+		break;
+	default:
+		DeltaRowsModel<General_Carry, Calls, Puts>(Data, Call, Put, Policy);
+	}
+}
+
+// GLOBAL BATCH FUNCTIONS
+CarryModel DetectCarryModel(const EuroOptBatch& Data)		// Cost of carry model every row of Data satisfies
+{
+	size_t n = Data.Size();
+	bool BlackScholes = (n > 0), Black76 = (n > 0);
+	for (size_t i = 0; (i < n) && (BlackScholes || Black76); i++)
+	{
+		BlackScholes = BlackScholes && (Data.b[i] == Data.r[i]);
+		Black76 = Black76 && (Data.b[i] == 0.0);
+	}
+
+	if (BlackScholes)
+		return BlackScholes_Carry;
+	else if (Black76)
+		return Black76_Carry;
+	else
+		return General_Carry;
+}
+
+EuroOptBatch MatrixToBatch(const vector<vector<double>>& DataVec)			// Copy a (T, K, sig, r, U, b) parameter matrix into a batch
+{
+	return MatrixToBatch(DataVec, Serial_Execution);
+}
+
+vector<vector<double>> BatchToMatrix(const EuroOptBatchResult& Result)		// Copy a batch result into a matrix with (call, put) rows
+{
+	return BatchToMatrix(Result, Serial_Execution);
+}
+
+vector<vector<double>> BatchToMatrix(const EuroOptBatchResult& Prices, const EuroOptBatchResult& Deltas, const EuroOptBatchResult& Gammas)	// Copy fused results into a matrix with six values per row
+{
+	return BatchToMatrix(Prices, Deltas, Gammas, Serial_Execution);
+}
+
+vector<vector<double>> BatchToMatrix(const EuroOptGreeksResult& Greeks, PricerOutput Outputs)		// Copy the selected outputs into a matrix with a (call, put) pair per output
+{
+	return BatchToMatrix(Greeks, Outputs, Serial_Execution);
+}
+
+void PriceBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out)			// Call and put prices of every row in the batch
+{
+	PriceBatch(Data, Out, Serial_Execution);
+}
+
+void DeltaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out)			// Call and put deltas of every row in the batch
+{
+	DeltaBatch(Data, Out, Serial_Execution);
+}
+
+void GammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out)			// Call and put gammas of every row in the batch
+{
+	GammaBatch(Data, Out, Serial_Execution);
+}
+
+void PriceDeltaGammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Prices, EuroOptBatchResult& Deltas, EuroOptBatchResult& Gammas)	// Fused price, delta and gamma of every row in the batch
+{
+	PriceDeltaGammaBatch(Data, Prices, Deltas, Gammas, Serial_Execution);
+}
+
+void GreeksBatch(const EuroOptBatch& Data, PricerOutput Outputs, EuroOptGreeksResult& Out)		// Any subset of price and sensitivities of every row in the batch
+{
+	GreeksBatch(Data, Outputs, Out, Serial_Execution);
+}
+
+void PriceBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out)		// Prices of every row as options of type Type
+{
+	PriceBatch(Data, Type, Out, Serial_Execution);
+}
+
+void DeltaBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out)		// Deltas of every row as options of type Type
+{
+	DeltaBatch(Data, Type, Out, Serial_Execution);
+}
+
+void PriceBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, NormalBackend Backend)		// Call and put prices of every row with a per batch normal backend
+{
+	NormalBackendScope Scope(Backend);
+	PriceBatch(Data, Out);
+}
+
+void DeltaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, NormalBackend Backend)		// Call and put deltas of every row with a per batch normal backend
+{
+	NormalBackendScope Scope(Backend);
+	DeltaBatch(Data, Out);
+}
+
+void GammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, NormalBackend Backend)		// Call and put gammas of every row with a per batch normal backend
+{
+	NormalBackendScope Scope(Backend);
+	GammaBatch(Data, Out);
+}
+
+void PriceDeltaGammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Prices, EuroOptBatchResult& Deltas, EuroOptBatchResult& Gammas, NormalBackend Backend)	// Fused pricer with a per batch normal backend
+{
+	NormalBackendScope Scope(Backend);
+	PriceDeltaGammaBatch(Data, Prices, Deltas, Gammas);
+}
+
+void GreeksBatch(const EuroOptBatch& Data, PricerOutput Outputs, EuroOptGreeksResult& Out, NormalBackend Backend)	// Fused sensitivity engine with a per batch normal backend
+{
+	NormalBackendScope Scope(Backend);
+	GreeksBatch(Data, Outputs, Out);
+}
+
+// PARALLEL BATCH FUNCTIONS
+EuroOptBatch MatrixToBatch(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy)		// Copy a parameter matrix into a batch on Policy's threads
+{
+	EuroOptBatch Batch(DataVec.size());										// Allocate every column once instead of growing row by row
+	ParallelFor(DataVec.size(), [&](size_t First, size_t Last)
+	{
+		for (size_t i = First; i < Last; i++)
+		{
+			Batch.T[i] = DataVec[i][0];
+			Batch.K[i] = DataVec[i][1];
+			Batch.sig[i] = DataVec[i][2];
+			Batch.r[i] = DataVec[i][3];
+			Batch.U[i] = DataVec[i][4];
+			Batch.b[i] = DataVec[i][5];
+		}
+	}, Policy);
+
+	return Batch;
+}
+
+vector<vector<double>> BatchToMatrix(const EuroOptBatchResult& Result, const ExecutionPolicy& Policy)		// Copy a batch result into a (call, put) matrix on Policy's threads
+{
+	vector<vector<double>> Matrix(Result.Size());							// Rows are filled in place so their order never depends on the threads
+	ParallelFor(Result.Size(), [&](size_t First, size_t Last)
+	{
+		for (size_t i = First; i < Last; i++)
+		{
+			Matrix[i] = { Result.Call[i], Result.Put[i] };
+		}
+	}, Policy);
+
+	return Matrix;
+}
+
+vector<vector<double>> BatchToMatrix(const EuroOptBatchResult& Prices, const EuroOptBatchResult& Deltas, const EuroOptBatchResult& Gammas, const ExecutionPolicy& Policy)	// Copy fused results into a matrix on Policy's threads
+{
+	vector<vector<double>> Matrix(Prices.Size());
+	ParallelFor(Prices.Size(), [&](size_t First, size_t Last)
+	{
+		for (size_t i = First; i < Last; i++)
+		{
+			Matrix[i] = { Prices.Call[i], Prices.Put[i], Deltas.Call[i], Deltas.Put[i], Gammas.Call[i], Gammas.Put[i] };
+		}
+	}, Policy);
+
+	return Matrix;
+}
+
+void PriceBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, const ExecutionPolicy& Policy)		// Call and put prices of every row on Policy's threads
+{
+	Out.Resize(Data.Size());
+	PriceRows<true, true>(Data, Out.Call.data(), Out.Put.data(), Policy);		// Calculate call and put prices
+}
+
+void DeltaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, const ExecutionPolicy& Policy)		// Call and put deltas of every row on Policy's threads
+{
+	Out.Resize(Data.Size());
+	DeltaRows<true, true>(Data, Out.Call.data(), Out.Put.data(), Policy);		// Calculate call and put deltas
+}
+
+void GammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, const ExecutionPolicy& Policy)		// Call and put gammas of every row on Policy's threads
+{
+	Out.Resize(Data.Size());
+	switch (DetectCarryModel(Data))		// Pick the gamma kernel once for the whole batch
+	{
+	case (BlackScholes_Carry):
+		GammaRowsModel<BlackScholes_Carry>(Data, Out.Call.data(), Out.Put.data(), Policy);
+		break;
+	case (Black76_Carry):
+		GammaRowsModel<Black76_Carry>(Data, Out.Call.data(), Out.Put.data(), Policy);
+		break;
+	default:
+		GammaRowsModel<General_Carry>(Data, Out.Call.data(), Out.Put.data(), Policy);
+	}
+}
+
+void PriceBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out, const ExecutionPolicy& Policy)		// Prices of every row as options of type Type on Policy's threads
+{
+	Out.resize(Data.Size());
+	if (Type == Call)
+		PriceRows<true, false>(Data, Out.data(), nullptr, Policy);
+	else
+		PriceRows<false, true>(Data, nullptr, Out.data(), Policy);
+}
+
+void DeltaBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out, const ExecutionPolicy& Policy)		// Deltas of every row as options of type Type on Policy's threads
+{
+	Out.resize(Data.Size());
+	if (Type == Call)
+		DeltaRows<true, false>(Data, Out.data(), nullptr, Policy);
+	else
+		DeltaRows<false, true>(Data, nullptr, Out.data(), Policy);
+}
+
+vector<vector<double>> BatchToMatrix(const EuroOptGreeksResult& Greeks, PricerOutput Outputs, const ExecutionPolicy& Policy)	// Copy the selected outputs into a matrix on Policy's threads
+{
+	vector<const EuroOptBatchResult*> Selected;							// Selected column pairs in matrix order
+	for (PricerOutput Output : GreekOrder)
+	{
+		if (Outputs & Output)
+		{
+			Selected.push_back(&Greeks.Column(Output));
+		}
+	}
+
+	size_t n = Selected.empty() ? 0 : Selected[0]->Size();
+	vector<vector<double>> Matrix(n);
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		for (size_t i = First; i < Last; i++)
+		{
+			Matrix[i].reserve(2 * Selected.size());
+			for (const EuroOptBatchResult* Pair : Selected)
+			{
+				Matrix[i].push_back(Pair->Call[i]);
+				Matrix[i].push_back(Pair->Put[i]);
+			}
+		}
+	}, Policy);
+
+	return Matrix;
+}
+
+void PriceDeltaGammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Prices, EuroOptBatchResult& Deltas, EuroOptBatchResult& Gammas, const ExecutionPolicy& Policy)	// Fused price, delta and gamma of every row on Policy's threads
+{
+	EuroOptGreeksResult Greeks;
+	GreeksBatch(Data, All, Greeks, Policy);
+
+	// Hand the computed columns over without copying them
+	Prices.Call.swap(Greeks.Prices.Call); Prices.Put.swap(Greeks.Prices.Put);
+	Deltas.Call.swap(Greeks.Deltas.Call); Deltas.Put.swap(Greeks.Deltas.Put);
+	Gammas.Call.swap(Greeks.Gammas.Call); Gammas.Put.swap(Greeks.Gammas.Put);
+}
+
+void GreeksBatch(const EuroOptBatch& Data, PricerOutput Outputs, EuroOptGreeksResult& Out, const ExecutionPolicy& Policy)	// Any subset of price and sensitivities of every row on Policy's threads
+{
+	size_t n = Data.Size();
+	Out.Resize(n, Outputs);
+
+	const double* T = Data.T.data(); const double* K = Data.K.data(); const double* sig = Data.sig.data();
+	const double* r = Data.r.data(); const double* U = Data.U.data(); const double* b = Data.b.data();
+
+	// Output columns, null when the output was not selected
+	double* CallP = Out.Prices.Call.data(); double* PutP = Out.Prices.Put.data();
+	double* CallD = Out.Deltas.Call.data(); double* PutD = Out.Deltas.Put.data();
+	double* CallG = Out.Gammas.Call.data(); double* PutG = Out.Gammas.Put.data();
+	double* CallV = Out.Vegas.Call.data(); double* PutV = Out.Vegas.Put.data();
+	double* CallTh = Out.Thetas.Call.data(); double* PutTh = Out.Thetas.Put.data();
+	double* CallR = Out.Rhos.Call.data(); double* PutR = Out.Rhos.Put.data();
+	double* CallCR = Out.CarryRhos.Call.data(); double* PutCR = Out.CarryRhos.Put.data();
+	double* CallVa = Out.Vannas.Call.data(); double* PutVa = Out.Vannas.Put.data();
+	double* CallVo = Out.Volgas.Call.data(); double* PutVo = Out.Volgas.Put.data();
+	double* CallCh = Out.Charms.Call.data(); double* PutCh = Out.Charms.Put.data();
+
+	bool NeedPutCdf = (Outputs & (Theta | Rho | CarryRho | Charm)) != 0;		// N(-d1) and N(-d2) are only evaluated when a put sensitivity uses them
+	NormalBackend Backend = ActiveNormalBackend();		// Resolved once for the whole batch
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		for (size_t i = First; i < Last; i++)
+		{
+			// Terms shared by every output of the row
+			double sqrtT = sqrt(T[i]);
+			double sigSqrtT = sig[i] * sqrtT;
+			double d1 = (log(U[i] / K[i]) + ((b[i] + (0.5 * sig[i] * sig[i])) * T[i])) / sigSqrtT;
+			double d2 = d1 - sigSqrtT;
+			double Nd1 = NormCdf(d1, Backend);
+			double Nd2 = NormCdf(d2, Backend);
+			double nd1 = NormPdf(d1, Backend);
+			double Nmd1 = NeedPutCdf ? NormCdf(-d1, Backend) : 0.0;
+			double Nmd2 = NeedPutCdf ? NormCdf(-d2, Backend) : 0.0;
+			double Carry = exp((b[i] - r[i]) * T[i]);		// Cost of carry factor exp((b - r)T)
+			double Discount = exp(-r[i] * T[i]);			// Discount factor exp(-rT)
+			double VegaValue = U[i] * Carry * nd1 * sqrtT;	// Vega, equal for calls and puts and reused by volga
+
+			// Prices, the put comes from generalized put-call parity P = C - U exp((b - r)T) + K exp(-rT), which reduces to CallToPut() when b = r
+			if (Outputs & Price)
+			{
+				CallP[i] = (U[i] * Carry * Nd1) - (K[i] * Discount * Nd2);
+				PutP[i] = CallP[i] - (U[i] * Carry) + (K[i] * Discount);
+			}
+
+			// Deltas
+			if (Outputs & Delta)
+			{
+				CallD[i] = Carry * Nd1;
+				PutD[i] = Carry * (Nd1 - 1.0);
+			}
+
+			// Gammas, equal for calls and puts
+			if (Outputs & Gamma)
+			{
+				CallG[i] = (nd1 * Carry) / (U[i] * sigSqrtT);
+				PutG[i] = CallG[i];
+			}
+
+			if (Outputs & Vega)
+			{
+				CallV[i] = VegaValue;
+				PutV[i] = VegaValue;
+			}
+
+			// Thetas, the decay of the time value plus the carry and discounting terms
+			if (Outputs & Theta)
+			{
+				double Decay = -(U[i] * Carry * nd1 * sig[i]) / (2.0 * sqrtT);
+				CallTh[i] = Decay - ((b[i] - r[i]) * U[i] * Carry * Nd1) - (r[i] * K[i] * Discount * Nd2);
+				PutTh[i] = Decay + ((b[i] - r[i]) * U[i] * Carry * Nmd1) + (r[i] * K[i] * Discount * Nmd2);
+			}
+
+			if (Outputs & Rho)
+			{
+				CallR[i] = T[i] * K[i] * Discount * Nd2;
+				PutR[i] = -T[i] * K[i] * Discount * Nmd2;
+			}
+
+			if (Outputs & CarryRho)
+			{
+				CallCR[i] = T[i] * U[i] * Carry * Nd1;
+				PutCR[i] = -T[i] * U[i] * Carry * Nmd1;
+			}
+
+			// Vannas and volgas, equal for calls and puts
+			if (Outputs & Vanna)
+			{
+				CallVa[i] = -(Carry * nd1 * d2) / sig[i];
+				PutVa[i] = CallVa[i];
+			}
+
+			if (Outputs & Volga)
+			{
+				CallVo[i] = (VegaValue * d1 * d2) / sig[i];
+				PutVo[i] = CallVo[i];
+			}
+
+			// Charms, the drift of d1 with time plus the carry term
+			if (Outputs & Charm)
+			{
+				double Drift = -Carry * nd1 * ((b[i] / sigSqrtT) - (d2 / (2.0 * T[i])));
+				CallCh[i] = Drift - ((b[i] - r[i]) * Carry * Nd1);
+				PutCh[i] = Drift + ((b[i] - r[i]) * Carry * Nmd1);
+			}
+		}
+	}, Policy);
+}
@@ -0,0 +1,170 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionBatch.h
+*/
+
+#ifndef EuropeanOptionBatch_H
+#define EuropeanOptionBatch_H
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionKernels.h"
+#include "NormalDistribution.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <new>
+#include <vector>
+using namespace std;
+
+const size_t CacheLineSize = 64;	// Alignment used for every batch column so each column starts on its own cache line
+
+template <class Type, size_t Alignment = CacheLineSize>
+class AlignedAllocator		// Allocator that places the storage of a vector on an Alignment byte boundary
+{
+public:
+	typedef Type value_type;
+
+	template <class Other>
+	struct rebind
+	{
+		typedef AlignedAllocator<Other, Alignment> other;
+	};
+
+	// Constructors
+	AlignedAllocator() {}															// Default constructor
+	template <class Other>
+	AlignedAllocator(const AlignedAllocator<Other, Alignment>&) {}					// Converting copy constructor
+
+	// Functionality
+	Type* allocate(size_t n)														// Allocate aligned storage for n objects of type Type
+	{
+		return static_cast<Type*>(::operator new(n * sizeof(Type), align_val_t(Alignment)));
+	}
+
+	void deallocate(Type* p, size_t)												// Release storage obtained from allocate()
+	{
+		::operator delete(p, align_val_t(Alignment));
+	}
+
+	template <class Other>
+	bool operator == (const AlignedAllocator<Other, Alignment>&) const { return true; }
+	template <class Other>
+	bool operator != (const AlignedAllocator<Other, Alignment>&) const { return false; }
+};
+
+typedef vector<double, AlignedAllocator<double>> AlignedColumn;		// Contiguous, cache line aligned column of doubles
+
+class EuroOptBatch		// Structure-of-arrays batch of European option parameters, one contiguous column per parameter
+{
+public:
+	// Parameter columns, row i of the batch is (T[i], K[i], sig[i], r[i], U[i], b[i])
+	AlignedColumn T;		// Expiry times
+	AlignedColumn K;		// Strike prices
+	AlignedColumn sig;		// Volatilities
+	AlignedColumn r;		// Risk-free interest rates
+	AlignedColumn U;		// Current prices of the underlying securities
+	AlignedColumn b;		// Costs of carry
+
+	// Constructors
+	EuroOptBatch();									// Default constructor, creates an empty batch
+	EuroOptBatch(size_t n);							// Constructor that creates a batch of n zeroed rows
+	// Destructors
+	virtual ~EuroOptBatch();						// Default destructor
+
+	// Functionality
+	size_t Size() const;							// Number of rows in the batch
+	void Resize(size_t n);							// Resize every column to n rows
+	void Reserve(size_t n);							// Reserve capacity for n rows in every column
+	void AddRow(const EuroOptData& Data);			// Append one row of option parameters
+	void AddRow(double newT, double newK, double newSig, double newR, double newU, double newB);	// Append one row of option parameters
+	EuroOptData Row(size_t i) const;				// Return row i as an EuroOptData
+};
+
+class EuroOptBatchResult	// Structure-of-arrays output of the batch pricers, call and put values in their own contiguous columns
+{
+public:
+	AlignedColumn Call;		// Call values, Call[i] belongs to row i of the priced batch
+	AlignedColumn Put;		// Put values, Put[i] belongs to row i of the priced batch
+
+	// Constructors
+	EuroOptBatchResult();							// Default constructor, creates an empty result
+	EuroOptBatchResult(size_t n);					// Constructor that creates a result of n zeroed rows
+	// Destructors
+	virtual ~EuroOptBatchResult();					// Default destructor
+
+	// Functionality
+	size_t Size() const;							// Number of rows in the result
+	void Resize(size_t n);							// Resize both columns to n rows
+};
+
+class EuroOptGreeksResult	// Output of GreeksBatch(), one call/put column pair per output, columns that were not selected stay empty
+{
+public:
+	EuroOptBatchResult Prices;		// Option values
+	EuroOptBatchResult Deltas;		// dV/dU
+	EuroOptBatchResult Gammas;		// d2V/dU2
+	EuroOptBatchResult Vegas;		// dV/dsig
+	EuroOptBatchResult Thetas;		// -dV/dT, the change in value per year as time passes
+	EuroOptBatchResult Rhos;		// dV/dr with the yield r - b held fixed, the rho with b fixed is Rhos - CarryRhos
+	EuroOptBatchResult CarryRhos;	// dV/db
+	EuroOptBatchResult Vannas;		// d2V/dUdsig
+	EuroOptBatchResult Volgas;		// d2V/dsig2
+	EuroOptBatchResult Charms;		// -dDelta/dT, the change in delta per year as time passes
+
+	// Constructors
+	EuroOptGreeksResult();							// Default constructor, every column empty
+	// Destructors
+	virtual ~EuroOptGreeksResult();					// Default destructor
+
+	// Functionality
+	EuroOptBatchResult& Column(PricerOutput Output);				// Column pair of a single output
+	const EuroOptBatchResult& Column(PricerOutput Output) const;	// Column pair of a single output
+	void Resize(size_t n, PricerOutput Outputs);					// Resize the selected column pairs to n rows and empty the others
+};
+
+// Conversions between the row-major matrices used by MatrixPricer and the batch types
+EuroOptBatch MatrixToBatch(const vector<vector<double>>& DataVec);			// Copy a (T, K, sig, r, U, b) parameter matrix into a batch
+vector<vector<double>> BatchToMatrix(const EuroOptBatchResult& Result);		// Copy a batch result into a matrix with (call, put) rows
+vector<vector<double>> BatchToMatrix(const EuroOptBatchResult& Prices, const EuroOptBatchResult& Deltas, const EuroOptBatchResult& Gammas);	// Copy fused results into a matrix with (call price, put price, call delta, put delta, call gamma, put gamma) rows
+vector<vector<double>> BatchToMatrix(const EuroOptGreeksResult& Greeks, PricerOutput Outputs);		// Copy the selected outputs into a matrix with a (call, put) pair per output in enum order
+
+// Cost of carry model every row of Data satisfies, General_Carry unless all rows have b = r or all have b = 0.
+// The batch pricers call it once per batch and run the kernels specialized for the model over every row
+CarryModel DetectCarryModel(const EuroOptBatch& Data);
+
+// Batch pricers, Out is resized to the size of Data
+void PriceBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out);			// Call and put prices of every row in the batch
+void DeltaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out);			// Call and put deltas of every row in the batch
+void GammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out);			// Call and put gammas of every row in the batch
+
+// Single leg batch pricers for books that hold one option type, Out is resized to the size of Data
+void PriceBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out);	// Prices of every row as options of type Type
+void DeltaBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out);	// Deltas of every row as options of type Type
+
+// Fused batch pricer, computes d1, d2, N(d1), N(d2), n(d1) and the discount factors once per row and writes all three outputs
+void PriceDeltaGammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Prices, EuroOptBatchResult& Deltas, EuroOptBatchResult& Gammas);
+
+// Fused sensitivity engine, computes the shared d1, d2, N(d1), N(d2), n(d1) and discount factors once per row and any subset of outputs from them
+void GreeksBatch(const EuroOptBatch& Data, PricerOutput Outputs, EuroOptGreeksResult& Out);
+
+// Batch pricers that use Backend for this batch only, the global normal backend is left untouched
+void PriceBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, NormalBackend Backend);
+void DeltaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, NormalBackend Backend);
+void GammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, NormalBackend Backend);
+void PriceDeltaGammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Prices, EuroOptBatchResult& Deltas, EuroOptBatchResult& Gammas, NormalBackend Backend);
+void GreeksBatch(const EuroOptBatch& Data, PricerOutput Outputs, EuroOptGreeksResult& Out, NormalBackend Backend);
+
+// Conversions and batch pricers that spread the rows over Policy's threads. The normal backend active on the
+// calling thread is used by every thread, and each row is computed exactly as in the serial versions above
+EuroOptBatch MatrixToBatch(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy);
+vector<vector<double>> BatchToMatrix(const EuroOptBatchResult& Result, const ExecutionPolicy& Policy);
+vector<vector<double>> BatchToMatrix(const EuroOptBatchResult& Prices, const EuroOptBatchResult& Deltas, const EuroOptBatchResult& Gammas, const ExecutionPolicy& Policy);
+void PriceBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, const ExecutionPolicy& Policy);
+void DeltaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, const ExecutionPolicy& Policy);
+void GammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Out, const ExecutionPolicy& Policy);
+void PriceBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out, const ExecutionPolicy& Policy);
+void DeltaBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Out, const ExecutionPolicy& Policy);
+void PriceDeltaGammaBatch(const EuroOptBatch& Data, EuroOptBatchResult& Prices, EuroOptBatchResult& Deltas, EuroOptBatchResult& Gammas, const ExecutionPolicy& Policy);
+vector<vector<double>> BatchToMatrix(const EuroOptGreeksResult& Greeks, PricerOutput Outputs, const ExecutionPolicy& Policy);
+void GreeksBatch(const EuroOptBatch& Data, PricerOutput Outputs, EuroOptGreeksResult& Out, const ExecutionPolicy& Policy);
+
+#endif
@@ -0,0 +1,98 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionBook.cpp
+*/
+
+#include "EuropeanOptionBook.h"
+#include "EuropeanOptionSIMD.h"
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+vector<string> EuroBookColumns()			// Column names of a European option book
+{
+	return { "T", "K", "sig", "r", "U", "b" };
+}
+
+vector<string> EuroBookResultColumns()		// Column names of the result book written by PriceEuroBook()
+{
+	return { "call_price", "put_price" };
+}
+
+bool WriteEuroBook(const string& Path, const EuroOptBatch& Data)		// Write a batch as a book without option types
+{
+	return WriteEuroBook(Path, Data, vector<OptionType>());
+}
+
+bool WriteEuroBook(const string& Path, const EuroOptBatch& Data, const vector<OptionType>& Types)	// Write a batch as a book with the option type of every row
+{
+	size_t n = Data.Size();
+	bool WithTypes = !Types.empty();
+	if (WithTypes && (Types.size() != n))
+	{
+		cerr << "ERROR: " << Types.size() << " option types were given for a batch of " << n << " rows" << endl;
+		return false;
+	}
+
+	OptionBookWriter Writer;
+	if (!Writer.Create(Path, Euro_Book, n, EuroBookColumns(), WithTypes))
+	{
+		return false;
+	}
+
+	const AlignedColumn* Columns[6] = { &Data.T, &Data.K, &Data.sig, &Data.r, &Data.U, &Data.b };
+	for (size_t c = 0; (c < 6) && (n > 0); c++)
+	{
+		memcpy(Writer.Column(c), Columns[c]->data(), n * sizeof(double));
+	}
+	for (size_t i = 0; WithTypes && (i < n); i++)
+	{
+		Writer.SetType(i, Types[i]);
+	}
+
+	return Writer.Close();
+}
+
+bool PriceEuroBook(const string& BookPath, const string& ResultPath)		// Price every row of a book into a new result book
+{
+	return PriceEuroBook(BookPath, ResultPath, Serial_Execution);
+}
+
+bool PriceEuroBook(const string& BookPath, const string& ResultPath, const ExecutionPolicy& Policy)	// Price every row of a book into a new result book on Policy's threads
+{
+	OptionBook Book;
+	if (!Book.Open(BookPath, Euro_Book))
+	{
+		return false;
+	}
+
+	// Columns are found by name, so a book written with its columns in another order still prices correctly
+	vector<string> Names = EuroBookColumns();
+	const double* Columns[6];
+	for (size_t c = 0; c < 6; c++)
+	{
+		Columns[c] = Book.Column(Names[c]);
+		if (Columns[c] == nullptr)
+		{
+			cerr << "ERROR: " << BookPath << " has no " << Names[c] << " column" << endl;
+			return false;
+		}
+	}
+
+	size_t n = Book.Size();
+	OptionBookWriter Results;
+	if (!Results.Create(ResultPath, Result_Book, n, EuroBookResultColumns(), Book.HasTypes()))
+	{
+		return false;
+	}
+
+	// The pricer reads the mapped book and writes the mapped results, nothing is copied in between
+	PriceColumnsSIMD(n, Columns[0], Columns[1], Columns[2], Columns[3], Columns[4], Columns[5], Results.Column(0), Results.Column(1), Policy);
+	if (Book.HasTypes() && (n > 0))
+	{
+		memcpy(Results.TypeBits(), Book.TypeBits(), (n + 63) / 64 * sizeof(uint64_t));
+	}
+
+	return Results.Close();
+}
@@ -0,0 +1,30 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionBook.h
+*
+*	European option books in the OptionBook format: columns T, K, sig, r, U and b, plus an optional
+*	option type bitmap. A book is priced straight from its mapped columns by the vectorized pricer into
+*	the mapped call_price and put_price columns of a result book, which carries the same bitmap.
+*/
+
+#ifndef EuropeanOptionBook_H
+#define EuropeanOptionBook_H
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionBatch.h"
+#include "OptionBook.h"
+#include "ThreadPool.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+vector<string> EuroBookColumns();				// Column names of a European option book, in EuroOptData order
+vector<string> EuroBookResultColumns();			// Column names of the result book written by PriceEuroBook()
+
+bool WriteEuroBook(const string& Path, const EuroOptBatch& Data);									// Write a batch as a book without option types
+bool WriteEuroBook(const string& Path, const EuroOptBatch& Data, const vector<OptionType>& Types);	// Write a batch as a book with the option type of every row
+
+bool PriceEuroBook(const string& BookPath, const string& ResultPath);									// Price every row of a book into a new result book
+bool PriceEuroBook(const string& BookPath, const string& ResultPath, const ExecutionPolicy& Policy);	// As above with the rows spread over Policy's threads
+
+#endif
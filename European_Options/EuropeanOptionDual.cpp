@@ -0,0 +1,97 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionDual.cpp
+*/
+
+#include "EuropeanOptionDual.h"
+#include "NormalDistribution.h"
+
+using namespace std;
+
+static void StoreRow(const double* Partials, size_t i, EuroOptBatch& Out)		// One row of derivatives, in EuroOptParam order, into the columns of Out
+{
+	Out.T[i] = Partials[Expiry];
+	Out.K[i] = Partials[Strike];
+	Out.sig[i] = Partials[Sigma];
+	Out.r[i] = Partials[Interest];
+	Out.U[i] = Partials[Underlying];
+	Out.b[i] = Partials[Cost_Of_Carry];
+}
+
+// GLOBAL DUAL FUNCTIONS
+EuroOptDual CallDual(double T, double K, double sig, double r, double U, double b)		// Price and gradient of call
+{
+	return EuroOptDualPrice<EuroOptDual>(T, K, sig, r, U, b, Call);
+}
+
+EuroOptDual PutDual(double T, double K, double sig, double r, double U, double b)		// Price and gradient of put
+{
+	return EuroOptDualPrice<EuroOptDual>(T, K, sig, r, U, b, Put);
+}
+
+EuroOptDual2 CallDual2(double T, double K, double sig, double r, double U, double b)		// Price, gradient and second derivatives of call
+{
+	return EuroOptDualPrice<EuroOptDual2>(T, K, sig, r, U, b, Call);
+}
+
+EuroOptDual2 PutDual2(double T, double K, double sig, double r, double U, double b)		// Price, gradient and second derivatives of put
+{
+	return EuroOptDualPrice<EuroOptDual2>(T, K, sig, r, U, b, Put);
+}
+
+void JacobianBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient)		// Prices and gradients of every row on the calling thread
+{
+	JacobianBatch(Data, Type, Price, Gradient, Serial_Execution);
+}
+
+void JacobianBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient, const ExecutionPolicy& Policy)	// Prices and gradients of every row on Policy's threads
+{
+	size_t n = Data.Size();
+	Price.resize(n);
+	Gradient.Resize(n);
+	NormalBackend Backend = ActiveNormalBackend();		// The caller's tier on every thread
+
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		NormalBackendScope Scope(Backend);
+		for (size_t i = First; i < Last; i++)
+		{
+			EuroOptDual Row = EuroOptDualPrice<EuroOptDual>(Data.T[i], Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i], Type);
+			Price[i] = Row.Value;
+			StoreRow(Row.d, i, Gradient);
+		}
+	}, Policy);
+}
+
+void HessianBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient, vector<EuroOptBatch>& Hessian)		// Prices, gradients and second derivatives of every row on the calling thread
+{
+	HessianBatch(Data, Type, Price, Gradient, Hessian, Serial_Execution);
+}
+
+void HessianBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient, vector<EuroOptBatch>& Hessian, const ExecutionPolicy& Policy)	// Prices, gradients and second derivatives of every row on Policy's threads
+{
+	size_t n = Data.Size();
+	Price.resize(n);
+	Gradient.Resize(n);
+	Hessian.resize(EuroOptVariables);
+	for (EuroOptBatch& Row : Hessian)
+	{
+		Row.Resize(n);
+	}
+	NormalBackend Backend = ActiveNormalBackend();
+
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		NormalBackendScope Scope(Backend);
+		for (size_t i = First; i < Last; i++)
+		{
+			EuroOptDual2 Row = EuroOptDualPrice<EuroOptDual2>(Data.T[i], Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i], Type);
+			Price[i] = Row.Value.Value;
+			StoreRow(Row.Value.d, i, Gradient);
+			for (int j = 0; j < EuroOptVariables; j++)
+			{
+				StoreRow(Row.d[j].d, i, Hessian[j]);
+			}
+		}
+	}, Policy);
+}
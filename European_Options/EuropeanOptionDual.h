@@ -0,0 +1,60 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionDual.h
+*
+*	Forward mode sensitivities of the generalized Black-Scholes price. The templated KernelPrice() runs
+*	once on dual numbers seeded with the six inputs, indexed like EuroOptParam, and returns the price with
+*	its exact gradient, or with the second order duals also every second derivative: gamma, vanna, volga,
+*	charm and the cross terms no closed form is written for. The value is identical to CallPrice()/
+*	PutPrice(). The batch functions fill one such pass per row in place of a divided difference sweep.
+*/
+
+#ifndef EuropeanOptionDual_H
+#define EuropeanOptionDual_H
+
+#include "DualNumber.h"
+#include "EuropeanOption.h"
+#include "EuropeanOptionBatch.h"
+#include "EuropeanOptionKernels.h"
+#include "Option.h"
+#include "ThreadPool.h"
+#include <vector>
+using namespace std;
+
+const int EuroOptVariables = 6;								// Inputs (T, K, sig, r, U, b), d[Expiry] is dV/dT and so on
+typedef Dual<EuroOptVariables> EuroOptDual;					// Price and gradient
+typedef Dual<EuroOptVariables, EuroOptDual> EuroOptDual2;	// Price, gradient and second derivatives, d[i].d[j] is d2V/dx_i dx_j
+
+template <class DualType>
+inline DualType EuroOptDualPrice(double T, double K, double sig, double r, double U, double b, OptionType Type)	// Price of one option on duals seeded with the six inputs
+{
+	DualType Inputs[EuroOptVariables];
+	const double Values[EuroOptVariables] = { T, K, sig, r, U, b };
+	for (int i = 0; i < EuroOptVariables; i++)
+	{
+		Inputs[i] = DualType::Variable(Values[i], i);
+	}
+	if (Type == Call)
+	{
+		return KernelPrice<Call, General_Carry>(Inputs[Expiry], Inputs[Strike], Inputs[Sigma], Inputs[Interest], Inputs[Underlying], Inputs[Cost_Of_Carry]);
+	}
+	else
+	{
+		return KernelPrice<Put, General_Carry>(Inputs[Expiry], Inputs[Strike], Inputs[Sigma], Inputs[Interest], Inputs[Underlying], Inputs[Cost_Of_Carry]);
+	}
+}
+
+// Single option passes
+EuroOptDual CallDual(double T, double K, double sig, double r, double U, double b);			// Price and gradient of call
+EuroOptDual PutDual(double T, double K, double sig, double r, double U, double b);			// Price and gradient of put
+EuroOptDual2 CallDual2(double T, double K, double sig, double r, double U, double b);		// Price, gradient and second derivatives of call
+EuroOptDual2 PutDual2(double T, double K, double sig, double r, double U, double b);		// Price, gradient and second derivatives of put
+
+// Batch passes, Gradient has the columns of Data with each holding the derivative with respect to that parameter, and
+// Hessian holds one such batch per parameter, Hessian[i].sig[j] being d2V / dx_i dsig for the x_i of EuroOptParam i
+void JacobianBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient);
+void JacobianBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient, const ExecutionPolicy& Policy);
+void HessianBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient, vector<EuroOptBatch>& Hessian);
+void HessianBatch(const EuroOptBatch& Data, OptionType Type, AlignedColumn& Price, EuroOptBatch& Gradient, vector<EuroOptBatch>& Hessian, const ExecutionPolicy& Policy);
+
+#endif
@@ -0,0 +1,185 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionGrid.cpp
+*/
+
+#include "EuropeanOptionGrid.h"
+#include <iostream>
+
+using namespace std;
+
+// EUROOPTGRID MEMBER FUNCTIONS
+// Constructors
+EuroOptGrid::EuroOptGrid()																	// Default constructor, the base row is the default EuropeanOption
+{
+	EuropeanOption Default;
+	Base = { Default.T, Default.K, Default.sig, Default.r, Default.U, Default.b };
+}
+
+EuroOptGrid::EuroOptGrid(const EuroOptData& BaseRow) : Base(BaseRow) {}						// Constructor that accepts the base row
+
+// Destructors
+EuroOptGrid::~EuroOptGrid() {}																// Default destructor
+
+// Functionality
+EuroOptGrid& EuroOptGrid::AddAxis(EuroOptParam Parameter, double Begin, double End, int Steps)	// Append an axis, it varies faster than every axis added before it
+{
+	if ((Parameter < Expiry) || (Parameter > Cost_Of_Carry) || (Steps < 0))
+	{
+		cout << "ERROR: AddAxis() needs a parameter (Expiry, Strike, Sigma, Interest, Underlying, or Cost_Of_Carry) and a non-negative number of steps. The axis was not added";
+		return *this;
+	}
+	for (size_t a = 0; a < Axes.size(); a++)
+	{
+		if (Axes[a].Parameter == Parameter)
+		{
+			cout << "ERROR: The grid already has an axis for this parameter. The axis was not added";
+			return *this;
+		}
+	}
+
+	GridAxis NewAxis = { Parameter, Begin, End, Steps };
+	Axes.push_back(NewAxis);
+	return *this;
+}
+
+size_t EuroOptGrid::AxisCount() const					// Number of axes
+{
+	return Axes.size();
+}
+
+const GridAxis& EuroOptGrid::Axis(size_t a) const		// Axis a
+{
+	return Axes[a];
+}
+
+double EuroOptGrid::AxisValue(size_t a, size_t Index) const		// Value Index of axis a
+{
+	if (Axes[a].Steps == 0)		// A one point axis, its step would be 0 / 0
+	{
+		return Axes[a].Begin;
+	}
+	double h = ((Axes[a].End - Axes[a].Begin) / Axes[a].Steps);		// Same step and formula as GenerateMeshArray()
+	return Axes[a].Begin + (h * static_cast<int>(Index));
+}
+
+size_t EuroOptGrid::Size() const						// Number of rows in the grid
+{
+	size_t Rows = 1;
+	for (size_t a = 0; a < Axes.size(); a++)
+	{
+		Rows *= static_cast<size_t>(Axes[a].Steps) + 1;
+	}
+
+	return Rows;
+}
+
+EuroOptData EuroOptGrid::Row(size_t i) const			// Row i
+{
+	double Values[6] = { Base.T, Base.K, Base.sig, Base.r, Base.U, Base.b };	// Indexed by EuroOptParam
+	for (size_t a = Axes.size(); a-- > 0;)				// Peel the mixed radix digits off i, fastest axis first
+	{
+		size_t Points = static_cast<size_t>(Axes[a].Steps) + 1;
+		Values[Axes[a].Parameter] = AxisValue(a, i % Points);
+		i /= Points;
+	}
+
+	EuroOptData Data = { Values[0], Values[1], Values[2], Values[3], Values[4], Values[5] };
+	return Data;
+}
+
+void EuroOptGrid::Fill(size_t First, size_t Last, EuroOptBatch& Chunk) const	// Write rows [First, Last) into Chunk
+{
+	size_t n = (Last > First) ? Last - First : 0;
+	Chunk.Resize(n);
+	if (n == 0)
+	{
+		return;
+	}
+
+	// Decode the first row once, then step through the following rows like an odometer
+	size_t AxisTotal = Axes.size();
+	vector<size_t> Index(AxisTotal), Points(AxisTotal);
+	double Values[6] = { Base.T, Base.K, Base.sig, Base.r, Base.U, Base.b };
+	size_t Rest = First;
+	for (size_t a = AxisTotal; a-- > 0;)
+	{
+		Points[a] = static_cast<size_t>(Axes[a].Steps) + 1;
+		Index[a] = Rest % Points[a];
+		Rest /= Points[a];
+		Values[Axes[a].Parameter] = AxisValue(a, Index[a]);
+	}
+
+	double* Columns[6] = { Chunk.T.data(), Chunk.K.data(), Chunk.sig.data(), Chunk.r.data(), Chunk.U.data(), Chunk.b.data() };
+	for (size_t i = 0; i < n; i++)
+	{
+		for (int c = 0; c < 6; c++)
+		{
+			Columns[c][i] = Values[c];
+		}
+
+		for (size_t a = AxisTotal; a-- > 0;)		// Advance the fastest axis, carrying into slower ones when it wraps
+		{
+			if (++Index[a] < Points[a])
+			{
+				Values[Axes[a].Parameter] = AxisValue(a, Index[a]);
+				break;
+			}
+			Index[a] = 0;
+			Values[Axes[a].Parameter] = AxisValue(a, 0);
+		}
+	}
+}
+
+// EUROOPTGRIDCURSOR MEMBER FUNCTIONS
+// Constructors
+EuroOptGridCursor::EuroOptGridCursor(const EuroOptGrid& Grid) : Grid(&Grid), Next(0), Last(Grid.Size()), ChunkRows(GridChunkRows) {}		// Constructor that walks the whole grid
+
+EuroOptGridCursor::EuroOptGridCursor(const EuroOptGrid& Grid, size_t First, size_t Last, size_t ChunkRows) : Grid(&Grid), Next(First), Last(Last), ChunkRows((ChunkRows == 0) ? GridChunkRows : ChunkRows) {}	// Constructor that walks rows [First, Last)
+
+// Destructors
+EuroOptGridCursor::~EuroOptGridCursor() {}		// Default destructor
+
+// Functionality
+size_t EuroOptGridCursor::Position() const		// First row of the next chunk
+{
+	return Next;
+}
+
+bool EuroOptGridCursor::NextChunk(EuroOptBatch& Chunk)		// Fill Chunk with the next rows and advance
+{
+	if (Next >= Last)
+	{
+		Chunk.Resize(0);
+		return false;
+	}
+
+	size_t End = (Last - Next < ChunkRows) ? Last : Next + ChunkRows;
+	Grid->Fill(Next, End, Chunk);
+	Next = End;
+	return true;
+}
+
+// GLOBAL GRID FUNCTIONS
+void ForEachGridChunk(const EuroOptGrid& Grid, size_t ChunkRows, const function<void(size_t, const EuroOptBatch&)>& Body, const ExecutionPolicy& Policy)	// Call Body for consecutive chunks covering the grid
+{
+	size_t Rows = Grid.Size();
+	size_t Length = (ChunkRows == 0) ? GridChunkRows : ChunkRows;
+	size_t Chunks = (Rows + Length - 1) / Length;
+
+	ParallelFor(Chunks, [&](size_t FirstChunk, size_t LastChunk)
+	{
+		// Chunk boundaries are fixed multiples of Length, so they never depend on how the chunks were shared out
+		size_t First = FirstChunk * Length;
+		size_t Last = (LastChunk * Length < Rows) ? LastChunk * Length : Rows;
+		EuroOptGridCursor Cursor(Grid, First, Last, Length);
+		EuroOptBatch Chunk;								// Reused for every chunk of this range
+		Chunk.Reserve(Length);
+		while (Cursor.Position() < Last)
+		{
+			size_t Start = Cursor.Position();
+			Cursor.NextChunk(Chunk);
+			Body(Start, Chunk);
+		}
+	}, Policy);
+}
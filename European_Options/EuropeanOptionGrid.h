@@ -0,0 +1,80 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionGrid.h
+*
+*	Lazy Cartesian grid over any combination of the European option parameters. The grid only stores
+*	its base row and axes; rows are produced on demand, a chunk at a time, straight into a batch that
+*	the batch pricers can consume. Row i is the same whichever chunk or thread produces it: the first
+*	axis varies slowest and the last axis fastest, and every axis value is computed as in
+*	GenerateMeshArray(), so a one axis grid reproduces GenerateParameterMatrix() exactly.
+*/
+
+#ifndef EuropeanOptionGrid_H
+#define EuropeanOptionGrid_H
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionBatch.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <functional>
+#include <vector>
+using namespace std;
+
+const size_t GridChunkRows = 2048;		// Default chunk length, the six columns of a chunk fit in L2
+
+struct GridAxis			// One varied parameter of a grid, Steps + 1 evenly spaced values from Begin to End
+{
+	EuroOptParam Parameter;		// Parameter the axis varies
+	double Begin;				// First value
+	double End;					// Last value
+	int Steps;					// Number of intervals
+};
+
+class EuroOptGrid		// Cartesian grid of European option parameters that is never materialized
+{
+private:
+	EuroOptData Base;			// Values of the parameters that no axis varies
+	vector<GridAxis> Axes;		// Varied parameters, the first varies slowest
+
+public:
+	// Constructors
+	EuroOptGrid();										// Default constructor, the base row is the default EuropeanOption
+	EuroOptGrid(const EuroOptData& BaseRow);			// Constructor that accepts the base row
+	// Destructors
+	virtual ~EuroOptGrid();								// Default destructor
+
+	// Functionality
+	EuroOptGrid& AddAxis(EuroOptParam Parameter, double Begin, double End, int Steps);	// Append an axis, it varies faster than every axis added before it
+	size_t AxisCount() const;							// Number of axes
+	const GridAxis& Axis(size_t a) const;				// Axis a
+	double AxisValue(size_t a, size_t Index) const;		// Value Index of axis a
+	size_t Size() const;								// Number of rows in the grid
+	EuroOptData Row(size_t i) const;					// Row i
+	void Fill(size_t First, size_t Last, EuroOptBatch& Chunk) const;	// Write rows [First, Last) into Chunk, which is resized to Last - First rows
+};
+
+class EuroOptGridCursor	// Walks a range of grid rows one chunk at a time, each thread of a partitioned sweep uses its own cursor
+{
+private:
+	const EuroOptGrid* Grid;	// Grid being walked
+	size_t Next;				// First row of the next chunk
+	size_t Last;				// One past the last row of the range
+	size_t ChunkRows;			// Rows per chunk
+
+public:
+	// Constructors
+	EuroOptGridCursor(const EuroOptGrid& Grid);													// Constructor that walks the whole grid in chunks of GridChunkRows
+	EuroOptGridCursor(const EuroOptGrid& Grid, size_t First, size_t Last, size_t ChunkRows);	// Constructor that walks rows [First, Last)
+	// Destructors
+	virtual ~EuroOptGridCursor();																// Default destructor
+
+	// Functionality
+	size_t Position() const;						// First row of the next chunk
+	bool NextChunk(EuroOptBatch& Chunk);			// Fill Chunk with the next rows and advance, false once the range is exhausted
+};
+
+// Call Body(First, Chunk) for consecutive chunks covering the grid, Chunk holds rows [First, First + Chunk.Size()). Chunks are spread over
+// Policy's threads, whose Grain counts chunks, so Body must be safe to call concurrently for different chunks
+void ForEachGridChunk(const EuroOptGrid& Grid, size_t ChunkRows, const function<void(size_t, const EuroOptBatch&)>& Body, const ExecutionPolicy& Policy);
+
+#endif
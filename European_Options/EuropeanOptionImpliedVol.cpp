@@ -0,0 +1,260 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionImpliedVol.cpp
+*/
+
+#include "EuropeanOptionImpliedVol.h"
+#include "NormalDistribution.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+const size_t ImpliedVolBlock = 256;		// Rows solved together, small enough that a block's state stays in L1
+
+struct ImpliedVolRow		// Solver state of one row
+{
+	OptionType Type;		// Out of the money side the row is solved on
+	double Quote;			// Market price being matched, converted to the out of the money side
+	double Forward;			// U exp(bT)
+	double Discount;		// exp(-rT)
+	double sqrtT;			// Square root of the expiry time
+	double Vol;				// Current iterate
+	double Low;				// Largest vol known to price below the quote
+	double High;			// Smallest vol known to price above the quote, infinite until one is found
+};
+
+static double InitialVol(double CallQuote, double Forward, double K, double Discount, double sqrtT)	// Corrado-Miller closed form guess from the call-equivalent quote
+{
+	double C = CallQuote / Discount;											// Undiscounted call value
+	double Half = C - (0.5 * (Forward - K));
+	double Root = (Half * Half) - (((Forward - K) * (Forward - K)) / 3.14159265358979323846);
+	double Guess = (2.50662827463100050 / (Forward + K)) * (Half + sqrt(fmax(Root, 0.0))) / sqrtT;	// sqrt(2 pi) / (F + K) (Half + sqrt(Root)) / sqrt(T)
+	if (!(Guess > 0.0) || !isfinite(Guess))		// Far from the money the formula can break down, fall back to the vol that puts the strike one deviation out
+	{
+		Guess = sqrt(2.0 * fabs(log(Forward / K))) / sqrtT;
+	}
+
+	return (Guess > 0.0) ? Guess : 0.2;
+}
+
+static bool ImpliedVolStep(ImpliedVolRow& Row, double K, NormalBackend Backend, double VolTolerance)	// One price evaluation and update, true once the row has converged
+{
+	// Price, vega and volga of the current iterate from the shared d1 and d2
+	double sigSqrtT = Row.Vol * Row.sqrtT;
+	double d1 = (log(Row.Forward / K) / sigSqrtT) + (0.5 * sigSqrtT);
+	double d2 = d1 - sigSqrtT;
+	double Value = (Row.Type == Call) ? Row.Discount * ((Row.Forward * NormCdf(d1, Backend)) - (K * NormCdf(d2, Backend)))
+								  : Row.Discount * ((K * NormCdf(-d2, Backend)) - (Row.Forward * NormCdf(-d1, Backend)));
+	double Vega = Row.Discount * Row.Forward * NormPdf(d1, Backend) * Row.sqrtT;
+	double Volga = (Vega * d1 * d2) / Row.Vol;
+
+	// Solve log(Value / Quote) = 0, which is close to linear in vol even for far out of the money quotes where the price itself is exponentially flat
+	double Error = log(Value / Row.Quote);
+	double Slope = Vega / Value;						// d Error / d vol
+	double Curvature = (Volga / Vega) - Slope;			// (d2 Error / d vol2) / (d Error / d vol)
+
+	// Price is increasing in vol, so every evaluation tightens the bracket
+	if (Error > 0.0)
+	{
+		Row.High = Row.Vol;
+	}
+	else if (Error < 0.0)
+	{
+		Row.Low = Row.Vol;
+	}
+	else
+	{
+		return true;
+	}
+
+	// Halley step, falling back to Newton when the curvature correction is too large to trust, a step that is not finite is caught by the bracket test
+	double Newton = Error / Slope;
+	double Correction = 1.0 - (0.5 * Newton * Curvature);
+	double Next = Row.Vol - ((Correction > 0.5) ? (Newton / Correction) : Newton);
+
+	// Bisect when the step leaves the bracket, doubling until a vol above the quote has been seen
+	if (!((Next > Row.Low) && (Next < Row.High)))
+	{
+		Next = isinf(Row.High) ? (2.0 * Row.Vol) : (0.5 * (Row.Low + Row.High));
+	}
+
+	bool Converged = (fabs(Next - Row.Vol) <= VolTolerance) || ((Row.High - Row.Low) <= VolTolerance);
+	Row.Vol = Next;
+	return Converged;
+}
+
+static void SolveRange(const EuroOptBatch& Data, const AlignedColumn& Quotes, OptionType Type, EuroOptImpliedVolResult& Out, const ImpliedVolSettings& Settings, NormalBackend Backend, size_t First, size_t Last)	// Solve rows [First, Last) block by block
+{
+	const double NaN = numeric_limits<double>::quiet_NaN();
+	ImpliedVolRow Rows[ImpliedVolBlock];
+	size_t Active[ImpliedVolBlock];
+
+	for (size_t Start = First; Start < Last; Start += ImpliedVolBlock)
+	{
+		size_t End = (Last - Start < ImpliedVolBlock) ? Last : Start + ImpliedVolBlock;
+		size_t ActiveCount = 0;
+
+		// Screen every row against the no-arbitrage bounds and set up the ones that can be solved
+		for (size_t i = Start; i < End; i++)
+		{
+			Out.Iterations[i] = 0;
+			Out.Vol[i] = NaN;
+			double T = Data.T[i], K = Data.K[i], U = Data.U[i], Quote = Quotes[i];
+			if (!(T > 0.0) || !(K > 0.0) || !(U > 0.0) || !isfinite(Quote))
+			{
+				Out.Status[i] = Vol_Bad_Input;
+				continue;
+			}
+
+			ImpliedVolRow& Row = Rows[i - Start];
+			Row.Forward = U * exp(Data.b[i] * T);
+			Row.Discount = exp(-Data.r[i] * T);
+			Row.sqrtT = sqrt(T);
+
+			double Intrinsic = (Type == Call) ? Row.Discount * fmax(Row.Forward - K, 0.0) : Row.Discount * fmax(K - Row.Forward, 0.0);
+			double Bound = (Type == Call) ? Row.Discount * Row.Forward : Row.Discount * K;
+			if (Quote <= Intrinsic)
+			{
+				Out.Status[i] = Vol_Below_Intrinsic;
+				continue;
+			}
+			if (Quote >= Bound)
+			{
+				Out.Status[i] = Vol_Above_Bound;
+				continue;
+			}
+
+			// Solve in the money quotes on the other side of generalized put-call parity C - P = exp(-rT)(F - K). The out of the money
+			// value is the time value on its own, so the price evaluations no longer lose it against the intrinsic value
+			double CallQuote = (Type == Call) ? Quote : Quote + (Row.Discount * (Row.Forward - K));
+			Row.Type = (Row.Forward > K) ? Put : Call;
+			Row.Quote = (Row.Type == Type) ? Quote : ((Row.Type == Put) ? CallQuote - (Row.Discount * (Row.Forward - K)) : CallQuote);
+			if (!(Row.Quote > 0.0))		// Time value lost to rounding
+			{
+				Out.Status[i] = Vol_Below_Intrinsic;
+				continue;
+			}
+
+			Row.Vol = InitialVol(CallQuote, Row.Forward, K, Row.Discount, Row.sqrtT);
+			Row.Low = 0.0;
+			Row.High = numeric_limits<double>::infinity();
+			Out.Status[i] = Vol_Not_Converged;
+			Active[ActiveCount++] = i - Start;
+		}
+
+		// Sweep the unconverged rows, dropping each one from the active list as it converges
+		for (int Iteration = 1; (Iteration <= Settings.MaxIterations) && (ActiveCount > 0); Iteration++)
+		{
+			size_t StillActive = 0;
+			for (size_t j = 0; j < ActiveCount; j++)
+			{
+				size_t Slot = Active[j];
+				size_t i = Start + Slot;
+				Out.Iterations[i] = Iteration;
+				if (ImpliedVolStep(Rows[Slot], Data.K[i], Backend, Settings.VolTolerance))
+				{
+					Out.Status[i] = Vol_Converged;
+					Out.Vol[i] = Rows[Slot].Vol;
+				}
+				else
+				{
+					Active[StillActive++] = Slot;
+				}
+			}
+			ActiveCount = StillActive;
+		}
+
+		for (size_t j = 0; j < ActiveCount; j++)		// Rows that ran out of iterations report their last iterate
+		{
+			Out.Vol[Start + Active[j]] = Rows[Active[j]].Vol;
+		}
+	}
+}
+
+// EUROOPTIMPLIEDVOLRESULT MEMBER FUNCTIONS
+// Constructors
+EuroOptImpliedVolResult::EuroOptImpliedVolResult() {}											// Default constructor, creates an empty result
+
+EuroOptImpliedVolResult::EuroOptImpliedVolResult(size_t n) : Vol(n), Iterations(n), Status(n, Vol_Bad_Input) {}	// Constructor that creates a result of n rows
+
+// Destructors
+EuroOptImpliedVolResult::~EuroOptImpliedVolResult() {}											// Default destructor
+
+// Functionality
+size_t EuroOptImpliedVolResult::Size() const		// Number of rows in the result
+{
+	return Vol.size();
+}
+
+void EuroOptImpliedVolResult::Resize(size_t n)		// Resize every column to n rows
+{
+	Vol.resize(n);
+	Iterations.resize(n);
+	Status.resize(n, Vol_Bad_Input);
+}
+
+size_t EuroOptImpliedVolResult::Failures() const	// Number of rows whose status is not Vol_Converged
+{
+	size_t Count = 0;
+	for (size_t i = 0; i < Status.size(); i++)
+	{
+		if (Status[i] != Vol_Converged)
+		{
+			Count++;
+		}
+	}
+
+	return Count;
+}
+
+// GLOBAL IMPLIED VOLATILITY FUNCTIONS
+void ImpliedVolBatch(const EuroOptBatch& Data, const AlignedColumn& Quotes, OptionType Type, EuroOptImpliedVolResult& Out)		// Implied vols of every row with the default settings
+{
+	ImpliedVolBatch(Data, Quotes, Type, Out, Default_Implied_Vol, Serial_Execution);
+}
+
+void ImpliedVolBatch(const EuroOptBatch& Data, const AlignedColumn& Quotes, OptionType Type, EuroOptImpliedVolResult& Out, const ImpliedVolSettings& Settings)	// Implied vols of every row
+{
+	ImpliedVolBatch(Data, Quotes, Type, Out, Settings, Serial_Execution);
+}
+
+void ImpliedVolBatch(const EuroOptBatch& Data, const AlignedColumn& Quotes, OptionType Type, EuroOptImpliedVolResult& Out, const ImpliedVolSettings& Settings, const ExecutionPolicy& Policy)	// Implied vols of every row on Policy's threads
+{
+	size_t n = Data.Size();
+	if (Quotes.size() != n)
+	{
+		cerr << "ERROR: " << Quotes.size() << " quotes were given for a batch of " << n << " rows. No implied volatilities were solved" << endl;
+		Out.Resize(0);
+		return;
+	}
+	Out.Resize(n);
+
+	NormalBackend Backend = ActiveNormalBackend();		// Resolved once for the whole batch
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		SolveRange(Data, Quotes, Type, Out, Settings, Backend, First, Last);
+	}, Policy);
+}
+
+double CallImpliedVol(double C, double T, double K, double r, double U, double b)		// Implied volatility of a call price
+{
+	EuroOptBatch Data;
+	Data.AddRow(T, K, 0.0, r, U, b);
+	AlignedColumn Quotes(1, C);
+	EuroOptImpliedVolResult Out;
+	ImpliedVolBatch(Data, Quotes, Call, Out);
+	return (Out.Status[0] == Vol_Converged) ? Out.Vol[0] : numeric_limits<double>::quiet_NaN();
+}
+
+double PutImpliedVol(double P, double T, double K, double r, double U, double b)		// Implied volatility of a put price
+{
+	EuroOptBatch Data;
+	Data.AddRow(T, K, 0.0, r, U, b);
+	AlignedColumn Quotes(1, P);
+	EuroOptImpliedVolResult Out;
+	ImpliedVolBatch(Data, Quotes, Put, Out);
+	return (Out.Status[0] == Vol_Converged) ? Out.Vol[0] : numeric_limits<double>::quiet_NaN();
+}
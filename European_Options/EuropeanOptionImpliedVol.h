@@ -0,0 +1,68 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionImpliedVol.h
+*
+*	Implied volatility of European options under the generalized Black-Scholes model. Each row starts
+*	from the Corrado-Miller closed form guess and is refined with Halley steps on log(price / quote), built
+*	from the analytic vega and volga. In the money quotes are moved to the out of the money side with
+*	put-call parity first. Every price evaluation narrows a bracket around the root, and a step that would
+*	leave the bracket is replaced by bisection, so every quote inside the no-arbitrage bounds converges.
+*	Batches are solved in blocks whose list of unconverged rows shrinks each sweep, so rows that have
+*	converged stop costing work.
+*/
+
+#ifndef EuropeanOptionImpliedVol_H
+#define EuropeanOptionImpliedVol_H
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionBatch.h"
+#include "ThreadPool.h"
+#include <vector>
+using namespace std;
+
+enum ImpliedVolStatus			// Outcome of the solve for one row
+{
+	Vol_Converged,				// Vol holds the implied volatility
+	Vol_Below_Intrinsic,		// Quote at or below the discounted intrinsic value, no volatility reproduces it
+	Vol_Above_Bound,			// Quote at or above the zero strike (call) or zero spot (put) value, no volatility reproduces it
+	Vol_Not_Converged,			// Iteration limit reached, Vol holds the last iterate
+	Vol_Bad_Input				// T, K or U not positive, or the quote not finite
+};
+
+struct ImpliedVolSettings		// Stopping rules of the solver
+{
+	double VolTolerance;		// Stop once a step changes the volatility by less than this
+	int MaxIterations;			// Price evaluations allowed per row
+};
+
+const ImpliedVolSettings Default_Implied_Vol = { 1e-12, 100 };	// Halley converges cubically, so the returned vol is far more accurate than the last step
+
+class EuroOptImpliedVolResult	// Structure-of-arrays output of the implied volatility solver
+{
+public:
+	AlignedColumn Vol;							// Implied volatilities, NaN for Vol_Below_Intrinsic, Vol_Above_Bound and Vol_Bad_Input rows
+	vector<int> Iterations;						// Price evaluations used by each row
+	vector<ImpliedVolStatus> Status;			// Outcome of each row
+
+	// Constructors
+	EuroOptImpliedVolResult();					// Default constructor, creates an empty result
+	EuroOptImpliedVolResult(size_t n);			// Constructor that creates a result of n rows
+	// Destructors
+	virtual ~EuroOptImpliedVolResult();			// Default destructor
+
+	// Functionality
+	size_t Size() const;						// Number of rows in the result
+	void Resize(size_t n);						// Resize every column to n rows
+	size_t Failures() const;					// Number of rows whose status is not Vol_Converged
+};
+
+// Batch solvers, the sig column of Data is ignored and Quotes[i] is the market price of row i. Quotes needs one entry per row, otherwise Out is left empty
+void ImpliedVolBatch(const EuroOptBatch& Data, const AlignedColumn& Quotes, OptionType Type, EuroOptImpliedVolResult& Out);
+void ImpliedVolBatch(const EuroOptBatch& Data, const AlignedColumn& Quotes, OptionType Type, EuroOptImpliedVolResult& Out, const ImpliedVolSettings& Settings);
+void ImpliedVolBatch(const EuroOptBatch& Data, const AlignedColumn& Quotes, OptionType Type, EuroOptImpliedVolResult& Out, const ImpliedVolSettings& Settings, const ExecutionPolicy& Policy);
+
+// Single option solvers, return NaN when the quote has no implied volatility
+double CallImpliedVol(double C, double T, double K, double r, double U, double b);		// Implied volatility of a call price
+double PutImpliedVol(double P, double T, double K, double r, double U, double b);		// Implied volatility of a put price
+
+#endif
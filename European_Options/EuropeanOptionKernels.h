@@ -0,0 +1,135 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionKernels.h
+*
+*	Scalar generalized Black-Scholes kernels specialized at compile time on the option type and on the
+*	cost of carry model. With the model fixed the compiler drops the terms it makes constant: b = r
+*	(Black-Scholes) has exp((b - r)T) = 1, and b = 0 (Black-76) has exp((b - r)T) = exp(-rT), so only
+*	one exp is taken. Merton (b = r - q) and Garman-Kohlhagen (b = r - rf) use the general kernel.
+*	Every kernel evaluates the same expressions as CallPrice(), PutDelta() and friends, so when the
+*	row matches the model the result is identical to the general function.
+*
+*	The price kernel and the carry helpers are also templates over the scalar type, so the same price
+*	runs on a Dual for forward mode derivatives or on an ADouble for the adjoint tape, with values
+*	identical to the double kernel. CallPrice() and PutPrice() have generic overloads on top of it.
+*/
+
+#ifndef EuropeanOptionKernels_H
+#define EuropeanOptionKernels_H
+
+#include "DualNumber.h"
+#include "NormalDistribution.h"
+#include "Option.h"
+#include <cmath>
+
+enum CarryModel			// Cost of carry model of a batch
+{
+	General_Carry,			// Any b, including Merton (b = r - q) and Garman-Kohlhagen (b = r - rf)
+	BlackScholes_Carry,		// b = r, stock options without dividends
+	Black76_Carry			// b = 0, options on futures
+};
+
+template <CarryModel Carry, class Real>
+inline Real KernelCarry(const Real& r, const Real& b)		// Cost of carry the model implies
+{
+	if (Carry == BlackScholes_Carry)
+	{
+		return r;
+	}
+	else if (Carry == Black76_Carry)
+	{
+		return 0.0;
+	}
+	else
+	{
+		return b;
+	}
+}
+
+template <CarryModel Carry, class Real>
+inline Real KernelCarryDiscount(const Real& T, const Real& r, const Real& b, const Real& Discount)		// exp((b - r)T), given Discount = exp(-rT)
+{
+	if (Carry == BlackScholes_Carry)
+	{
+		return 1.0;
+	}
+	else if (Carry == Black76_Carry)
+	{
+		return Discount;
+	}
+	else
+	{
+		return exp((b - r) * T);
+	}
+}
+
+template <OptionType Type, CarryModel Carry, class Real>
+inline Real KernelPrice(const Real& T, const Real& K, const Real& sig, const Real& r, const Real& U, const Real& b)		// Price of one option
+{
+	Real d1 = (log(U / K) + ((KernelCarry<Carry>(r, b) + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	Real d2 = d1 - (sig * sqrt(T));
+	Real Discount = exp(-r * T);
+	Real CarryDiscount = KernelCarryDiscount<Carry>(T, r, b, Discount);
+
+	if (Type == Call)
+	{
+		return (U * CarryDiscount * NormCdf(d1)) - (K * Discount * NormCdf(d2));
+	}
+	else
+	{
+		return (K * Discount * NormCdf(-d2)) - (U * CarryDiscount * NormCdf(-d1));
+	}
+}
+
+template <OptionType Type, CarryModel Carry>
+inline double KernelDelta(double T, double K, double sig, double r, double U, double b)		// Delta of one option
+{
+	double d1 = (log(U / K) + ((KernelCarry<Carry>(r, b) + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	double CarryDiscount = KernelCarryDiscount<Carry>(T, r, b, (Carry == Black76_Carry) ? exp(-r * T) : 0.0);
+
+	if (Type == Call)
+	{
+		return CarryDiscount * NormCdf(d1);
+	}
+	else
+	{
+		return (CarryDiscount * NormCdf(d1)) - CarryDiscount;
+	}
+}
+
+template <CarryModel Carry>
+inline double KernelGamma(double T, double K, double sig, double r, double U, double b)		// Gamma of one option, the same for calls and puts
+{
+	double d1 = (log(U / K) + ((KernelCarry<Carry>(r, b) + (pow(sig, 2) / 2)) * T)) / (sig * sqrt(T));
+	double CarryDiscount = KernelCarryDiscount<Carry>(T, r, b, (Carry == Black76_Carry) ? exp(-r * T) : 0.0);
+	return (NormPdf(d1) * CarryDiscount) / (U * sig * sqrt(T));
+}
+
+// Standard normal functions of a dual, the derivative of N is the density n and that of n is -x n(x)
+template <int N, class Scalar>
+inline Dual<N, Scalar> NormCdf(const Dual<N, Scalar>& x)
+{
+	return DualChain(Scalar(NormCdf(x.Value)), x, Scalar(NormPdf(x.Value)));
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> NormPdf(const Dual<N, Scalar>& x)
+{
+	Scalar Value = NormPdf(x.Value);
+	return DualChain(Value, x, Scalar(-x.Value * Value));
+}
+
+// Generic pricers for any scalar with the arithmetic and functions of double, the double versions are in EuropeanOption.h
+template <class Real>
+inline Real CallPrice(const Real& T, const Real& K, const Real& sig, const Real& r, const Real& U, const Real& b)		// Price of call
+{
+	return KernelPrice<Call, General_Carry>(T, K, sig, r, U, b);
+}
+
+template <class Real>
+inline Real PutPrice(const Real& T, const Real& K, const Real& sig, const Real& r, const Real& U, const Real& b)		// Price of put
+{
+	return KernelPrice<Put, General_Carry>(T, K, sig, r, U, b);
+}
+
+#endif
@@ -0,0 +1,183 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionSIMD.cpp
+*/
+
+#include "EuropeanOptionSIMD.h"
+#include "EuropeanOptionSIMDKernel.h"
+#include <string>
+
+#if defined(EUROPEAN_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(EUROPEAN_SIMD_X86) && defined(__GNUC__)
+#include <cpuid.h>
+#endif
+
+using namespace std;
+
+// CPU FEATURE DETECTION
+#ifdef EUROPEAN_SIMD_X86
+static void CpuId(unsigned int Leaf, unsigned int SubLeaf, unsigned int Regs[4])	// Regs = { eax, ebx, ecx, edx } of cpuid(Leaf, SubLeaf)
+{
+#if defined(_MSC_VER)
+	int Info[4];
+	__cpuidex(Info, static_cast<int>(Leaf), static_cast<int>(SubLeaf));
+	for (int i = 0; i < 4; i++)
+	{
+		Regs[i] = static_cast<unsigned int>(Info[i]);
+	}
+#else
+	__cpuid_count(Leaf, SubLeaf, Regs[0], Regs[1], Regs[2], Regs[3]);
+#endif
+}
+
+static unsigned long long EnabledXStateFeatures()		// XCR0, which register states the OS saves on a context switch
+{
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	unsigned int Low, High;
+	__asm__ volatile("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+	return (static_cast<unsigned long long>(High) << 32) | Low;
+#endif
+}
+
+static SimdPath ProbeSimdPath()		// Query cpuid and XCR0 for the widest usable code path
+{
+	unsigned int Regs[4];
+	CpuId(0, 0, Regs);
+	if (Regs[0] < 7)
+	{
+		return Scalar_Path;
+	}
+
+	CpuId(1, 0, Regs);
+	bool OSXSave = (Regs[2] & (1u << 27)) != 0;
+	bool FMA = (Regs[2] & (1u << 12)) != 0;
+	if (!OSXSave)
+	{
+		return Scalar_Path;
+	}
+
+	unsigned long long XCR0 = EnabledXStateFeatures();
+	bool YmmSaved = (XCR0 & 0x6) == 0x6;			// SSE and AVX state
+	bool ZmmSaved = (XCR0 & 0xE6) == 0xE6;			// Plus opmask and both halves of the ZMM state
+
+	CpuId(7, 0, Regs);
+	bool AVX2 = (Regs[1] & (1u << 5)) != 0;
+	bool AVX512F = (Regs[1] & (1u << 16)) != 0;
+
+	if (AVX512F && ZmmSaved)
+	{
+		return AVX512_Path;
+	}
+	if (AVX2 && FMA && YmmSaved)
+	{
+		return AVX2_Path;
+	}
+	return Scalar_Path;
+}
+#endif
+
+SimdPath DetectSimdPath()		// Widest code path supported by this CPU and OS, detected once and cached
+{
+#ifdef EUROPEAN_SIMD_X86
+	static const SimdPath Detected = ProbeSimdPath();
+	return Detected;
+#else
+	return Scalar_Path;
+#endif
+}
+
+string SimdPathName(SimdPath Path)		// Printable name of a code path
+{
+	switch (Path)
+	{
+	case (AVX2_Path):
+		return "AVX2";
+	case (AVX512_Path):
+		return "AVX-512";
+	default:
+		return "Scalar";
+	}
+}
+
+// KERNELS
+void PriceKernelScalar(NormalBackend Backend, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* U, const double* b, double* Call, double* Put)
+{
+	PriceKernelTier<ScalarLanes>(Backend, n, T, K, sig, r, U, b, Call, Put);
+}
+
+void PriceBatchSIMD(const EuroOptBatch& Data, EuroOptBatchResult& Out)						// Vectorized call and put prices of every row, on the detected code path
+{
+	PriceBatchSIMD(Data, Out, DetectSimdPath());
+}
+
+void PriceBatchSIMD(const EuroOptBatch& Data, EuroOptBatchResult& Out, SimdPath Path)		// Vectorized call and put prices of every row, on a chosen code path
+{
+	size_t n = Data.Size();
+	Out.Resize(n);
+	if (Path > DetectSimdPath())		// Never run an instruction set the CPU does not have
+	{
+		Path = DetectSimdPath();
+	}
+
+	const double* T = Data.T.data(); const double* K = Data.K.data(); const double* sig = Data.sig.data();
+	const double* r = Data.r.data(); const double* U = Data.U.data(); const double* b = Data.b.data();
+	double* Call = Out.Call.data(); double* Put = Out.Put.data();
+	NormalBackend Backend = ActiveNormalBackend();		// Boost_Normal runs as Full_Normal, the vector paths have no boost form
+
+	switch (Path)
+	{
+#ifdef EUROPEAN_SIMD_X86
+	case (AVX512_Path):
+		PriceKernelAVX512(Backend, n, T, K, sig, r, U, b, Call, Put);
+		break;
+	case (AVX2_Path):
+		PriceKernelAVX2(Backend, n, T, K, sig, r, U, b, Call, Put);
+		break;
+#endif
+	default:
+		PriceKernelScalar(Backend, n, T, K, sig, r, U, b, Call, Put);
+		break;
+	}
+}
+
+void PriceBatchSIMD(const EuroOptBatch& Data, EuroOptBatchResult& Out, SimdPath Path, NormalBackend Backend)	// Vectorized call and put prices of every row, on a chosen code path and normal tier
+{
+	NormalBackendScope Scope(Backend);
+	PriceBatchSIMD(Data, Out, Path);
+}
+
+void PriceBatchSIMD(const EuroOptBatch& Data, EuroOptBatchResult& Out, const ExecutionPolicy& Policy)		// Vectorized prices on the detected code path and Policy's threads
+{
+	size_t n = Data.Size();
+	Out.Resize(n);
+	PriceColumnsSIMD(n, Data.T.data(), Data.K.data(), Data.sig.data(), Data.r.data(), Data.U.data(), Data.b.data(), Out.Call.data(), Out.Put.data(), Policy);
+}
+
+void PriceColumnsSIMD(size_t n, const double* T, const double* K, const double* sig, const double* r, const double* U, const double* b, double* Call, double* Put, const ExecutionPolicy& Policy)	// Vectorized prices of raw columns on Policy's threads
+{
+	SimdPath Path = DetectSimdPath();
+	NormalBackend Backend = ActiveNormalBackend();		// The caller's tier, passed to the kernels of every thread
+
+	// Every row is priced independently of its neighbours, so a range gives the same values as the whole batch
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		size_t m = Last - First;
+		switch (Path)
+		{
+#ifdef EUROPEAN_SIMD_X86
+		case (AVX512_Path):
+			PriceKernelAVX512(Backend, m, T + First, K + First, sig + First, r + First, U + First, b + First, Call + First, Put + First);
+			break;
+		case (AVX2_Path):
+			PriceKernelAVX2(Backend, m, T + First, K + First, sig + First, r + First, U + First, b + First, Call + First, Put + First);
+			break;
+#endif
+		default:
+			PriceKernelScalar(Backend, m, T + First, K + First, sig + First, r + First, U + First, b + First, Call + First, Put + First);
+			break;
+		}
+	}, Policy);
+}
@@ -0,0 +1,37 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionSIMD.h
+*
+*	Explicitly vectorized batch pricer for European options. The code path (AVX-512F, AVX2 + FMA or the
+*	portable scalar fallback) is picked once at runtime from the CPU features. Every path runs the same
+*	polynomial exp/log and normal tail from SimdMath.h instead of libm and boost. With the Full_Normal tier
+*	it agrees with CallPrice()/PutPrice() to within SimdPriceTolerance * max(U, K) absolute for T > 0 and
+*	sig > 0; the Fast_Normal and Screening_Normal tiers add their own cdf error on top of that.
+*/
+
+#ifndef EuropeanOptionSIMD_H
+#define EuropeanOptionSIMD_H
+
+#include "EuropeanOptionBatch.h"
+#include <string>
+using namespace std;
+
+const double SimdPriceTolerance = 1e-13;		// Documented absolute price tolerance per unit of max(U, K) against CallPrice()/PutPrice()
+
+enum SimdPath			// Instruction set used by the vectorized pricer
+{
+	Scalar_Path,		// Portable one row at a time fallback
+	AVX2_Path,			// Four rows per vector, needs AVX2 and FMA
+	AVX512_Path			// Eight rows per vector, needs AVX-512F
+};
+
+SimdPath DetectSimdPath();					// Widest code path supported by this CPU and OS, detected once and cached
+string SimdPathName(SimdPath Path);			// Printable name of a code path
+
+void PriceBatchSIMD(const EuroOptBatch& Data, EuroOptBatchResult& Out);						// Vectorized call and put prices of every row, on the detected code path
+void PriceBatchSIMD(const EuroOptBatch& Data, EuroOptBatchResult& Out, SimdPath Path);		// Vectorized call and put prices of every row, on a chosen code path (falls back to the detected path if unsupported)
+void PriceBatchSIMD(const EuroOptBatch& Data, EuroOptBatchResult& Out, SimdPath Path, NormalBackend Backend);	// As above with a per batch normal tier, Boost_Normal runs as Full_Normal
+void PriceBatchSIMD(const EuroOptBatch& Data, EuroOptBatchResult& Out, const ExecutionPolicy& Policy);		// Vectorized prices on the detected code path with the rows spread over Policy's threads
+void PriceColumnsSIMD(size_t n, const double* T, const double* K, const double* sig, const double* r, const double* U, const double* b, double* Call, double* Put, const ExecutionPolicy& Policy);	// As above for n rows of raw columns, such as the columns of a mapped book
+
+#endif
@@ -0,0 +1,123 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionSIMDKernel.h
+*
+*	Lane-generic generalized Black-Scholes price kernel shared by the scalar, AVX2 and AVX-512 code paths.
+*	Only EuropeanOptionSIMD.cpp and the instruction set specific translation units include this header;
+*	the instruction set specific units include it after enabling their instruction set.
+*/
+
+#ifndef EuropeanOptionSIMDKernel_H
+#define EuropeanOptionSIMDKernel_H
+
+#include "NormalDistribution.h"
+#include "SimdMath.h"
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define EUROPEAN_SIMD_X86		// AVX2 and AVX-512 paths are only built for x86 targets
+#endif
+
+template <class Lanes, NormalBackend Backend>
+inline typename Lanes::Vec SimdNormTailTier(typename Lanes::Vec XAbs)		// N(-|x|) of the chosen accuracy tier, Boost_Normal has no vector form and uses the Full tier
+{
+	if (Backend == Fast_Normal)
+	{
+		return SimdNormTailFast<Lanes>(XAbs);
+	}
+	else if (Backend == Screening_Normal)
+	{
+		return SimdNormTailScreening<Lanes>(XAbs);
+	}
+	else
+	{
+		return SimdNormTail<Lanes>(XAbs);
+	}
+}
+
+template <class Lanes, NormalBackend Backend>
+inline void PriceKernelLanes(size_t i, const double* T, const double* K, const double* sig, const double* r, const double* U, const double* b, double* Call, double* Put)	// Price rows i to i + Lanes::Width - 1
+{
+	typedef typename Lanes::Vec Vec;
+
+	Vec vT = Lanes::Load(T + i), vK = Lanes::Load(K + i), vSig = Lanes::Load(sig + i);
+	Vec vR = Lanes::Load(r + i), vU = Lanes::Load(U + i), vB = Lanes::Load(b + i);
+
+	Vec sigSqrtT = Lanes::Mul(vSig, Lanes::Sqrt(vT));
+	Vec Drift = Lanes::Fma(Lanes::Mul(vSig, vSig), Lanes::Set1(0.5), vB);
+	Vec d1 = Lanes::Div(Lanes::Fma(Drift, vT, SimdLog<Lanes>(Lanes::Div(vU, vK))), sigSqrtT);
+	Vec d2 = Lanes::Sub(d1, sigSqrtT);
+
+	// One tail evaluation per d gives both N(d) and N(-d) without cancellation
+	Vec One = Lanes::Set1(1.0), Zero = Lanes::Set1(0.0);
+	Vec Tail1 = SimdNormTailTier<Lanes, Backend>(Lanes::Abs(d1));
+	Vec Tail2 = SimdNormTailTier<Lanes, Backend>(Lanes::Abs(d2));
+	typename Lanes::Mask Pos1 = Lanes::Greater(d1, Zero);
+	typename Lanes::Mask Pos2 = Lanes::Greater(d2, Zero);
+	Vec Nd1 = Lanes::Select(Pos1, Lanes::Sub(One, Tail1), Tail1);
+	Vec Nmd1 = Lanes::Select(Pos1, Tail1, Lanes::Sub(One, Tail1));
+	Vec Nd2 = Lanes::Select(Pos2, Lanes::Sub(One, Tail2), Tail2);
+	Vec Nmd2 = Lanes::Select(Pos2, Tail2, Lanes::Sub(One, Tail2));
+
+	Vec Forward = Lanes::Mul(vU, SimdExp<Lanes>(Lanes::Mul(Lanes::Sub(vB, vR), vT)));		// U exp((b - r)T)
+	Vec Strike = Lanes::Mul(vK, SimdExp<Lanes>(Lanes::Mul(Lanes::Sub(Zero, vR), vT)));		// K exp(-rT)
+
+	Lanes::Store(Call + i, Lanes::Sub(Lanes::Mul(Forward, Nd1), Lanes::Mul(Strike, Nd2)));
+	Lanes::Store(Put + i, Lanes::Sub(Lanes::Mul(Strike, Nmd2), Lanes::Mul(Forward, Nmd1)));
+}
+
+template <class Lanes, NormalBackend Backend>
+inline void PriceKernelRange(size_t n, const double* T, const double* K, const double* sig, const double* r, const double* U, const double* b, double* Call, double* Put)	// Price n rows of raw columns
+{
+	size_t i = 0;
+	for (; i + Lanes::Width <= n; i += Lanes::Width)
+	{
+		PriceKernelLanes<Lanes, Backend>(i, T, K, sig, r, U, b, Call, Put);
+	}
+
+	// Remaining rows go through one padded vector, so the instruction set specific units never instantiate the ScalarLanes code
+	if (i < n)
+	{
+		double In[6][Lanes::Width], Out[2][Lanes::Width];
+		const double* Columns[6] = { T, K, sig, r, U, b };
+		for (size_t c = 0; c < 6; c++)
+		{
+			for (size_t j = 0; j < Lanes::Width; j++)
+			{
+				In[c][j] = Columns[c][(i + j < n) ? (i + j) : (n - 1)];		// Pad with copies of the last row
+			}
+		}
+		PriceKernelLanes<Lanes, Backend>(0, In[0], In[1], In[2], In[3], In[4], In[5], Out[0], Out[1]);
+		for (size_t j = 0; i + j < n; j++)
+		{
+			Call[i + j] = Out[0][j];
+			Put[i + j] = Out[1][j];
+		}
+	}
+}
+
+template <class Lanes>
+inline void PriceKernelTier(NormalBackend Backend, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* U, const double* b, double* Call, double* Put)	// Pick the tier once for the whole range
+{
+	switch (Backend)
+	{
+	case (Fast_Normal):
+		PriceKernelRange<Lanes, Fast_Normal>(n, T, K, sig, r, U, b, Call, Put);
+		break;
+	case (Screening_Normal):
+		PriceKernelRange<Lanes, Screening_Normal>(n, T, K, sig, r, U, b, Call, Put);
+		break;
+	default:
+		PriceKernelRange<Lanes, Full_Normal>(n, T, K, sig, r, U, b, Call, Put);
+		break;
+	}
+}
+
+// Per instruction set entry points, each prices n rows of raw columns with the given normal tier
+void PriceKernelScalar(NormalBackend Backend, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* U, const double* b, double* Call, double* Put);
+#ifdef EUROPEAN_SIMD_X86
+void PriceKernelAVX2(NormalBackend Backend, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* U, const double* b, double* Call, double* Put);
+void PriceKernelAVX512(NormalBackend Backend, size_t n, const double* T, const double* K, const double* sig, const double* r, const double* U, const double* b, double* Call, double* Put);
+#endif
+
+#endif
@@ -0,0 +1,95 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionStream.cpp
+*/
+
+#include "EuropeanOptionStream.h"
+#include "EuropeanOptionBatch.h"
+#include "EuropeanOptionSIMD.h"
+#include <iostream>
+
+using namespace std;
+
+static const PricerOutput StreamOrder[] = { Price, Delta, Gamma, Vega, Theta, Rho, CarryRho, Vanna, Volga, Charm };		// Result column order
+static const char* StreamNames[] = { "price", "delta", "gamma", "vega", "theta", "rho", "carry_rho", "vanna", "volga", "charm" };
+
+vector<string> EuropeanStreamColumns(PricerOutput Outputs)		// Names of the result columns for a selection of outputs
+{
+	vector<string> Names;
+	for (size_t o = 0; o < 10; o++)
+	{
+		if (Outputs & StreamOrder[o])
+		{
+			Names.push_back(string("call_") + StreamNames[o]);
+			Names.push_back(string("put_") + StreamNames[o]);
+		}
+	}
+
+	return Names;
+}
+
+StreamSummary PriceEuropeanStream(FILE* In, FILE* Out, const EuroStreamSettings& Settings)		// Price every record of In and write the results to Out
+{
+	PricerOutput Outputs = Settings.Outputs;
+	if ((Outputs <= 0) || ((Outputs & All_Greeks) != Outputs))
+	{
+		cerr << "ERROR: No proper output (Price, Delta, Gamma, All, or a combination of outputs) was chosen. Resorting to default output Price" << endl;	// cerr, the results may be going to cout
+		Outputs = Price;
+	}
+	size_t ChunkRows = (Settings.ChunkRows == 0) ? Default_Euro_Stream.ChunkRows : Settings.ChunkRows;
+
+	vector<string> Names = EuropeanStreamColumns(Outputs);
+	RecordReader Reader(In, Settings.Input, 6);
+	RecordWriter Writer(Out, Settings.Output, Names.size());
+	if (Settings.Header)
+	{
+		Writer.WriteHeader(Names);
+	}
+
+	// One chunk of parameters and results, reused for the whole stream
+	EuroOptBatch Chunk(ChunkRows);
+	EuroOptBatchResult Prices;
+	EuroOptGreeksResult Greeks;
+	vector<const double*> Results(Names.size());
+	StreamSummary Summary = { 0, 0, 0, false };
+
+	for (;;)
+	{
+		Chunk.Resize(ChunkRows);
+		double* Columns[6] = { Chunk.T.data(), Chunk.K.data(), Chunk.sig.data(), Chunk.r.data(), Chunk.U.data(), Chunk.b.data() };
+		size_t n = Reader.Read(ChunkRows, Columns);
+		if (n == 0)
+		{
+			break;
+		}
+		Chunk.Resize(n);
+
+		if (Outputs == Price)
+		{
+			PriceBatchSIMD(Chunk, Prices, Settings.Policy);
+			Results[0] = Prices.Call.data();
+			Results[1] = Prices.Put.data();
+		}
+		else
+		{
+			GreeksBatch(Chunk, Outputs, Greeks, Settings.Policy);
+			size_t Column = 0;
+			for (PricerOutput Output : StreamOrder)
+			{
+				if (Outputs & Output)
+				{
+					Results[Column++] = Greeks.Column(Output).Call.data();
+					Results[Column++] = Greeks.Column(Output).Put.data();
+				}
+			}
+		}
+
+		Writer.Write(n, Results.data());
+		Summary.Records += n;
+	}
+
+	Summary.BadRecords = Reader.BadRecordCount();
+	Summary.FirstBadLine = Reader.FirstBadRecordLine();
+	Summary.Failed = !Writer.Flush() || Reader.Failed();
+	return Summary;
+}
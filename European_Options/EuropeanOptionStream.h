@@ -0,0 +1,37 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionStream.h
+*
+*	Streams European option records (T, K, sig, r, U, b) from a file or pipe, prices them a chunk at a
+*	time and writes one result record per input record as it goes. Each result record holds a (call, put)
+*	pair per selected output in PricerOutput order. Prices alone go through the vectorized pricer, any
+*	other selection through GreeksBatch().
+*/
+
+#ifndef EuropeanOptionStream_H
+#define EuropeanOptionStream_H
+
+#include "EuropeanOption.h"
+#include "RecordStream.h"
+#include "ThreadPool.h"
+#include <cstdio>
+#include <string>
+#include <vector>
+using namespace std;
+
+struct EuroStreamSettings		// How a stream is read, priced and written
+{
+	StreamFormat Input;			// Encoding of the option records
+	StreamFormat Output;		// Encoding of the result records
+	PricerOutput Outputs;		// Outputs to compute, any combination
+	bool Header;				// Write a header line of column names before CSV results
+	size_t ChunkRows;			// Records priced together, bounds the memory used
+	ExecutionPolicy Policy;		// Threads used to price each chunk
+};
+
+const EuroStreamSettings Default_Euro_Stream = { Csv_Format, Csv_Format, Price, false, 65536, Parallel_Execution };
+
+StreamSummary PriceEuropeanStream(FILE* In, FILE* Out, const EuroStreamSettings& Settings);	// Price every record of In and write the results to Out
+vector<string> EuropeanStreamColumns(PricerOutput Outputs);									// Names of the result columns for a selection of outputs
+
+#endif
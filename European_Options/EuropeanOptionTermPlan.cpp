@@ -0,0 +1,159 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionTermPlan.cpp
+*/
+
+#include "EuropeanOptionTermPlan.h"
+#include "NormalDistribution.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <unordered_map>
+
+using namespace std;
+
+struct TermKey		// (T, r, b) of a row, two keys match when all three compare equal
+{
+	double T;
+	double r;
+	double b;
+
+	bool operator == (const TermKey& Other) const
+	{
+		return (T == Other.T) && (r == Other.r) && (b == Other.b);
+	}
+};
+
+struct TermKeyHash		// Hash of the bit patterns of a TermKey
+{
+	size_t operator () (const TermKey& Key) const
+	{
+		double Values[] = { Key.T + 0.0, Key.r + 0.0, Key.b + 0.0 };		// Adding 0.0 turns -0.0 into 0.0 so equal keys hash alike
+		size_t Hash = 0;
+		for (double Value : Values)
+		{
+			uint64_t Bits;
+			memcpy(&Bits, &Value, sizeof(Bits));
+			Hash ^= hash<uint64_t>()(Bits) + 0x9e3779b97f4a7c15ULL + (Hash << 6) + (Hash >> 2);
+		}
+		return Hash;
+	}
+};
+
+// EUROOPTTERMPLAN MEMBER FUNCTIONS
+// Constructors
+EuroOptTermPlan::EuroOptTermPlan() {}							// Default constructor, creates an empty plan
+
+EuroOptTermPlan::EuroOptTermPlan(const EuroOptBatch& Data)		// Constructor that plans Data
+{
+	Plan(Data);
+}
+
+// Destructors
+EuroOptTermPlan::~EuroOptTermPlan() {}							// Default destructor
+
+// Functionality
+void EuroOptTermPlan::Plan(const EuroOptBatch& Data)		// Group the rows of Data by (T, r, b) and compute each group's factors once
+{
+	size_t n = Data.Size();
+	T.clear();
+	b.clear();
+	SqrtT.clear();
+	Discount.clear();
+	CarryDiscount.clear();
+	GroupOf.resize(n);
+
+	unordered_map<TermKey, unsigned int, TermKeyHash> Groups;
+	TermKey Previous = { 0.0, 0.0, 0.0 };
+	unsigned int PreviousGroup = 0;
+	for (size_t i = 0; i < n; i++)
+	{
+		TermKey Key = { Data.T[i], Data.r[i], Data.b[i] };
+		if ((i > 0) && (Key == Previous))		// Chains are usually sorted, so most rows share the previous row's group
+		{
+			GroupOf[i] = PreviousGroup;
+			continue;
+		}
+
+		unordered_map<TermKey, unsigned int, TermKeyHash>::iterator Found = Groups.find(Key);
+		if (Found == Groups.end())
+		{
+			Found = Groups.emplace(Key, static_cast<unsigned int>(T.size())).first;
+			T.push_back(Key.T);
+			b.push_back(Key.b);
+			SqrtT.push_back(sqrt(Key.T));
+			Discount.push_back(exp(-Key.r * Key.T));
+			CarryDiscount.push_back(exp((Key.b - Key.r) * Key.T));
+		}
+		GroupOf[i] = Found->second;
+		Previous = Key;
+		PreviousGroup = Found->second;
+	}
+}
+
+size_t EuroOptTermPlan::Size() const		// Number of rows planned
+{
+	return GroupOf.size();
+}
+
+size_t EuroOptTermPlan::GroupCount() const	// Number of distinct (T, r, b) groups
+{
+	return T.size();
+}
+
+// GLOBAL TERM PLAN FUNCTIONS
+void PriceBatch(const EuroOptBatch& Data, const EuroOptTermPlan& Plan, EuroOptBatchResult& Out)		// Call and put prices of every row using the shared group factors
+{
+	PriceBatch(Data, Plan, Out, Serial_Execution);
+}
+
+void PriceBatch(const EuroOptBatch& Data, const EuroOptTermPlan& Plan, EuroOptBatchResult& Out, const ExecutionPolicy& Policy)	// Call and put prices of every row on Policy's threads
+{
+	size_t n = Data.Size();
+	if (Plan.Size() != n)
+	{
+		cerr << "ERROR: The term plan covers " << Plan.Size() << " rows but the batch has " << n << ". Resorting to the unplanned batch pricer" << endl;
+		PriceBatch(Data, Out, Policy);
+		return;
+	}
+	Out.Resize(n);
+
+	// Row columns, group columns and the row to group index, all as raw pointers
+	const double* K = Data.K.data(); const double* sig = Data.sig.data(); const double* U = Data.U.data();
+	const double* T = Plan.T.data(); const double* b = Plan.b.data(); const double* SqrtT = Plan.SqrtT.data();
+	const double* Discount = Plan.Discount.data(); const double* CarryDiscount = Plan.CarryDiscount.data();
+	const unsigned int* GroupOf = Plan.GroupOf.data();
+	double* Call = Out.Call.data(); double* Put = Out.Put.data();
+
+	NormalBackend Backend = ActiveNormalBackend();		// The caller's backend, installed on every thread of the loop
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		NormalBackendScope Scope(Backend);
+		for (size_t i = First; i < Last; i++)
+		{
+			unsigned int g = GroupOf[i];
+			double d1 = (log(U[i] / K[i]) + ((b[g] + ((sig[i] * sig[i]) / 2)) * T[g])) / (sig[i] * SqrtT[g]);
+			double d2 = d1 - (sig[i] * SqrtT[g]);
+			double Forward = U[i] * CarryDiscount[g];
+			double Strike = K[i] * Discount[g];
+			Call[i] = (Forward * NormCdf(d1)) - (Strike * NormCdf(d2));		// Calculate call price
+			Put[i] = (Strike * NormCdf(-d2)) - (Forward * NormCdf(-d1));	// Calculate put price
+		}
+	}, Policy);
+}
+
+vector<vector<double>> PlannedPriceVector(const vector<vector<double>>& DataVec)		// Price a parameter matrix through a term plan
+{
+	return PlannedPriceVector(DataVec, Serial_Execution);
+}
+
+vector<vector<double>> PlannedPriceVector(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy)	// Price a parameter matrix through a term plan on Policy's threads
+{
+	EuroOptBatch Data = MatrixToBatch(DataVec, Policy);
+	EuroOptTermPlan Plan(Data);
+	EuroOptBatchResult Prices;
+	PriceBatch(Data, Plan, Prices, Policy);
+	return BatchToMatrix(Prices, Policy);
+}
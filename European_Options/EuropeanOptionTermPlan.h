@@ -0,0 +1,54 @@
+/*	Daniel McNulty II
+*
+*	EuropeanOptionTermPlan.h
+*
+*	Batch planner for chain shaped books, where thousands of rows share an expiry, a rate and a cost of
+*	carry. The plan groups the rows of a batch by (T, r, b) and keeps sqrt(T), exp(-rT) and exp((b - r)T)
+*	once per group, so pricing a row costs its log(U / K) and normal cdfs but no exp or sqrt. Every
+*	factor is computed with the same expression as CallPrice()/PutPrice(), so the planned pricers
+*	return exactly what PriceBatch() returns for the same batch.
+*/
+
+#ifndef EuropeanOptionTermPlan_H
+#define EuropeanOptionTermPlan_H
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionBatch.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+class EuroOptTermPlan		// Groups of batch rows that share (T, r, b), with the factors every row of a group uses
+{
+public:
+	// Group columns, entry g holds the terms shared by the rows whose GroupOf is g
+	AlignedColumn T;				// Expiry time
+	AlignedColumn b;				// Cost of carry
+	AlignedColumn SqrtT;			// sqrt(T)
+	AlignedColumn Discount;			// exp(-rT)
+	AlignedColumn CarryDiscount;	// exp((b - r)T)
+
+	vector<unsigned int> GroupOf;	// Group of each row of the planned batch
+
+	// Constructors
+	EuroOptTermPlan();								// Default constructor, creates an empty plan
+	EuroOptTermPlan(const EuroOptBatch& Data);		// Constructor that plans Data
+	// Destructors
+	virtual ~EuroOptTermPlan();						// Default destructor
+
+	// Functionality
+	void Plan(const EuroOptBatch& Data);			// Group the rows of Data by (T, r, b) and compute each group's factors once, replacing any earlier plan
+	size_t Size() const;							// Number of rows planned
+	size_t GroupCount() const;						// Number of distinct (T, r, b) groups
+};
+
+// Planned batch pricers, Plan must have been built from Data and Out is resized to the size of Data
+void PriceBatch(const EuroOptBatch& Data, const EuroOptTermPlan& Plan, EuroOptBatchResult& Out);			// Call and put prices of every row using the shared group factors
+void PriceBatch(const EuroOptBatch& Data, const EuroOptTermPlan& Plan, EuroOptBatchResult& Out, const ExecutionPolicy& Policy);	// As above with the rows spread over Policy's threads
+
+// Matrix pricer that plans its input, the output is identical to PriceVector()
+vector<vector<double>> PlannedPriceVector(const vector<vector<double>>& DataVec);
+vector<vector<double>> PlannedPriceVector(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy);
+
+#endif
@@ -112,24 +112,22 @@ int main()
 					// Call GenerateParameterMatrix to generate a matrix where each row corresponds to a different expiry time corresponding to the initial expiry time and the steps taken to arrive at the final expiry time,
 					// holding all other parameters constant.
 					vector<vector<double>> VaryRange = GenerateParameterMatrix(T, K, sig, r, U, b, End_Val, Steps, Expiry);
-					// Call MatrixPricer to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
-					vector<vector<double>> VaryPrice = MatrixPricer(VaryRange, Price);
-					vector<vector<double>> VaryDelta = MatrixPricer(VaryRange, Delta);
-					vector<vector<double>> VaryGamma = MatrixPricer(VaryRange, Gamma);
+					// Call MatrixPricer once to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
+					vector<vector<double>> VaryOutput = MatrixPricer(VaryRange, All);
 
 					// Print the header of the results table.
 					cout << endl << "EXPIRY TIME | CALL PRICE | PUT PRICE | CALL DELTA | PUT DELTA | CALL GAMMA | PUT GAMMA " << endl;
-					// Loop through all the rows of VaryPrice.
-					for (unsigned int i = 0; i < VaryPrice.size(); i++)
+					// Loop through all the rows of VaryOutput.
+					for (unsigned int i = 0; i < VaryOutput.size(); i++)
 					{
 						// Print the expiry time, call price, put price, call delta, put delta, call gamma, and put gamma.
 						cout << left << setw(12) << setfill(' ') << VaryRange[i][0]
-							<< "| " << left << setw(11) << setfill(' ') << VaryPrice[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryPrice[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryDelta[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryDelta[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryGamma[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryGamma[i][1] << endl;
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][0]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][1]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][2]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][3]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][4]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][5] << endl;
 
 					}
 
@@ -142,24 +140,22 @@ int main()
 					// Call GenerateParameterMatrix to generate a matrix where each row corresponds to a different strike price corresponding to the initial strike price and the steps taken to arrive at the final strike price,
 					// holding all other parameters constant.
 					vector<vector<double>> VaryRange = GenerateParameterMatrix(T, K, sig, r, U, b, End_Val, Steps, Strike);
-					// Call MatrixPricer to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
-					vector<vector<double>> VaryPrice = MatrixPricer(VaryRange, Price);
-					vector<vector<double>> VaryDelta = MatrixPricer(VaryRange, Delta);
-					vector<vector<double>> VaryGamma = MatrixPricer(VaryRange, Gamma);
+					// Call MatrixPricer once to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
+					vector<vector<double>> VaryOutput = MatrixPricer(VaryRange, All);
 
 					// Print the header of the results table.
 					cout << endl << "STRIKE PRICE | CALL PRICE | PUT PRICE | CALL DELTA | PUT DELTA | CALL GAMMA | PUT GAMMA " << endl;
-					// Loop through all the rows of VaryPrice.
-					for (unsigned int i = 0; i < VaryPrice.size(); i++)
+					// Loop through all the rows of VaryOutput.
+					for (unsigned int i = 0; i < VaryOutput.size(); i++)
 					{
 						// Print the strike price, call price, put price, call delta, put delta, call gamma, and put gamma.
 						cout << left << setw(13) << setfill(' ') << VaryRange[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryPrice[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryPrice[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryDelta[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryDelta[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryGamma[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryGamma[i][1] << endl;
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][0]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][1]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][2]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][3]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][4]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][5] << endl;
 
 					}
 
@@ -172,24 +168,22 @@ int main()
 					// Call GenerateParameterMatrix to generate a matrix where each row corresponds to a different volatility corresponding to the initial volatility and the steps taken to arrive at the final volatility,
 					// holding all other parameters constant.
 					vector<vector<double>> VaryRange = GenerateParameterMatrix(T, K, sig, r, U, b, End_Val, Steps, Sigma);
-					// Call MatrixPricer to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
-					vector<vector<double>> VaryPrice = MatrixPricer(VaryRange, Price);
-					vector<vector<double>> VaryDelta = MatrixPricer(VaryRange, Delta);
-					vector<vector<double>> VaryGamma = MatrixPricer(VaryRange, Gamma);
+					// Call MatrixPricer once to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
+					vector<vector<double>> VaryOutput = MatrixPricer(VaryRange, All);
 
 					// Print the header of the results table.
 					cout << endl << "VOLATILITY | CALL PRICE | PUT PRICE | CALL DELTA | PUT DELTA | CALL GAMMA | PUT GAMMA " << endl;
-					// Loop through all the rows of VaryPrice.
-					for (unsigned int i = 0; i < VaryPrice.size(); i++)
+					// Loop through all the rows of VaryOutput.
+					for (unsigned int i = 0; i < VaryOutput.size(); i++)
 					{
 						// Print the volatility, call price, put price, call delta, put delta, call gamma, and put gamma.
 						cout << left << setw(11) << setfill(' ') << VaryRange[i][2]
-							<< "| " << left << setw(11) << setfill(' ') << VaryPrice[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryPrice[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryDelta[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryDelta[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryGamma[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryGamma[i][1] << endl;
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][0]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][1]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][2]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][3]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][4]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][5] << endl;
 					}
 
 					return 0;
@@ -201,24 +195,22 @@ int main()
 					// Call GenerateParameterMatrix to generate a matrix where each row corresponds to a different interest rate corresponding to the initial interest rate and the steps taken to arrive at the final interest rate,
 					// holding all other parameters constant.
 					vector<vector<double>> VaryRange = GenerateParameterMatrix(T, K, sig, r, U, b, End_Val, Steps, Interest);
-					// Call MatrixPricer to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
-					vector<vector<double>> VaryPrice = MatrixPricer(VaryRange, Price);
-					vector<vector<double>> VaryDelta = MatrixPricer(VaryRange, Delta);
-					vector<vector<double>> VaryGamma = MatrixPricer(VaryRange, Gamma);
+					// Call MatrixPricer once to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
+					vector<vector<double>> VaryOutput = MatrixPricer(VaryRange, All);
 
 					// Print the header of the results table.
 					cout << endl << "INTEREST | CALL PRICE | PUT PRICE | CALL DELTA | PUT DELTA | CALL GAMMA | PUT GAMMA " << endl;
-					// Loop through all the rows of VaryPrice.
-					for (unsigned int i = 0; i < VaryPrice.size(); i++)
+					// Loop through all the rows of VaryOutput.
+					for (unsigned int i = 0; i < VaryOutput.size(); i++)
 					{
 						// Print the interest rate, call price, put price, call delta, put delta, call gamma, and put gamma.
 						cout << left << setw(9) << setfill(' ') << VaryRange[i][3]
-							<< "| " << left << setw(11) << setfill(' ') << VaryPrice[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryPrice[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryDelta[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryDelta[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryGamma[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryGamma[i][1] << endl;
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][0]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][1]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][2]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][3]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][4]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][5] << endl;
 					}
 
 					return 0;
@@ -230,24 +222,22 @@ int main()
 					// Call GenerateParameterMatrix to generate a matrix where each row corresponds to a different underlying price corresponding to the initial underlying price and the steps taken to arrive at the final underlying price,
 					// holding all other parameters constant.
 					vector<vector<double>> VaryRange = GenerateParameterMatrix(T, K, sig, r, U, b, End_Val, Steps, Underlying);
-					// Call MatrixPricer to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
-					vector<vector<double>> VaryPrice = MatrixPricer(VaryRange, Price);
-					vector<vector<double>> VaryDelta = MatrixPricer(VaryRange, Delta);
-					vector<vector<double>> VaryGamma = MatrixPricer(VaryRange, Gamma);
+					// Call MatrixPricer once to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
+					vector<vector<double>> VaryOutput = MatrixPricer(VaryRange, All);
 
 					// Print the header of the results table.
 					cout << endl << "UNDERLYING | CALL PRICE | PUT PRICE | CALL DELTA | PUT DELTA | CALL GAMMA | PUT GAMMA " << endl;
-					// Loop through all the rows of VaryPrice.
-					for (unsigned int i = 0; i < VaryPrice.size(); i++)
+					// Loop through all the rows of VaryOutput.
+					for (unsigned int i = 0; i < VaryOutput.size(); i++)
 					{
 						// Print the interest rate, call price, put price, call delta, put delta, call gamma, and put gamma.
 						cout << left << setw(11) << setfill(' ') << VaryRange[i][4]
-							<< "| " << left << setw(11) << setfill(' ') << VaryPrice[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryPrice[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryDelta[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryDelta[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryGamma[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryGamma[i][1] << endl;
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][0]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][1]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][2]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][3]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][4]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][5] << endl;
 					}
 
 					return 0;
@@ -259,24 +249,22 @@ int main()
 					// Call GenerateParameterMatrix to generate a matrix where each row corresponds to a different cost of carry corresponding to the initial cost of carry and the steps taken to arrive at the final cost of carry,
 					// holding all other parameters constant.
 					vector<vector<double>> VaryRange = GenerateParameterMatrix(T, K, sig, r, U, b, End_Val, Steps, Cost_Of_Carry);
-					// Call MatrixPricer to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
-					vector<vector<double>> VaryPrice = MatrixPricer(VaryRange, Price);
-					vector<vector<double>> VaryDelta = MatrixPricer(VaryRange, Delta);
-					vector<vector<double>> VaryGamma = MatrixPricer(VaryRange, Gamma);
+					// Call MatrixPricer once to determine the price, delta, and gamma of the European option corresponding to the parameters specified in each row of the VaryRange matrix.
+					vector<vector<double>> VaryOutput = MatrixPricer(VaryRange, All);
 
 					// Print the header of the results table.
 					cout << endl << "COST OF CARRY | CALL PRICE | PUT PRICE | CALL DELTA | PUT DELTA | CALL GAMMA | PUT GAMMA " << endl;
-					// Loop through all the rows of VaryPrice.
-					for (unsigned int i = 0; i < VaryPrice.size(); i++)
+					// Loop through all the rows of VaryOutput.
+					for (unsigned int i = 0; i < VaryOutput.size(); i++)
 					{
 						// Print the interest rate, call price, put price, call delta, put delta, call gamma, and put gamma.
 						cout << left << setw(14) << setfill(' ') << VaryRange[i][5]
-							<< "| " << left << setw(11) << setfill(' ') << VaryPrice[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryPrice[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryDelta[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryDelta[i][1]
-							<< "| " << left << setw(11) << setfill(' ') << VaryGamma[i][0]
-							<< "| " << left << setw(10) << setfill(' ') << VaryGamma[i][1] << endl;
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][0]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][1]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][2]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][3]
+							<< "| " << left << setw(11) << setfill(' ') << VaryOutput[i][4]
+							<< "| " << left << setw(10) << setfill(' ') << VaryOutput[i][5] << endl;
 					}
 
 					return 0;
@@ -0,0 +1,101 @@
+/*	Daniel McNulty II
+*
+*	"Grid Test Source.cpp"
+*
+*	Checks the lazy grid: a one axis grid reproduces GenerateParameterMatrix(), Fill() at any chunk
+*	boundary gives the same rows as Row(), ForEachGridChunk() on several threads visits every row once
+*	with the values of Row(), and a one point axis holds its first value. Returns 1 on any failure.
+*/
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionBatch.h"
+#include "EuropeanOptionGrid.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+using namespace std;
+
+bool Check(const char* Name, bool Passed)		// Print one result, true if it passed
+{
+	cout << left << setw(52) << Name << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed;
+}
+
+bool SameRow(const EuroOptData& Row, const EuroOptBatch& Chunk, size_t j)		// Row identical to row j of Chunk
+{
+	return (Row.T == Chunk.T[j]) && (Row.K == Chunk.K[j]) && (Row.sig == Chunk.sig[j]) && (Row.r == Chunk.r[j]) && (Row.U == Chunk.U[j]) && (Row.b == Chunk.b[j]);
+}
+
+int main()
+{
+	bool Passed = true;
+	const EuroOptData Base = { 0.5, 100.0, 0.3, 0.05, 100.0, 0.02 };
+
+	// One axis against the matrix generator
+	EuroOptGrid Line(Base);
+	Line.AddAxis(Sigma, 0.3, 0.7, 40);
+	vector<vector<double>> Matrix = GenerateParameterMatrix(Base.T, Base.K, Base.sig, Base.r, Base.U, Base.b, 0.7, 40, Sigma);
+	bool Matches = (Line.Size() == Matrix.size());
+	for (size_t i = 0; Matches && (i < Matrix.size()); i++)
+	{
+		EuroOptData Row = Line.Row(i);
+		Matches = (Row.T == Matrix[i][0]) && (Row.K == Matrix[i][1]) && (Row.sig == Matrix[i][2]) && (Row.r == Matrix[i][3]) && (Row.U == Matrix[i][4]) && (Row.b == Matrix[i][5]);
+	}
+	Passed = Check("One axis grid reproduces GenerateParameterMatrix", Matches) && Passed;
+
+	// Three axes and a one point axis, filled in chunks that do not line up with the axes
+	EuroOptGrid Grid(Base);
+	Grid.AddAxis(Expiry, 0.25, 2.0, 6).AddAxis(Underlying, 110.0, 110.0, 0).AddAxis(Strike, 80.0, 120.0, 16).AddAxis(Sigma, 0.1, 0.5, 10);
+	const size_t Rows = 7 * 1 * 17 * 11;
+	Passed = Check("Grid size is the product of the axis points", Grid.Size() == Rows) && Passed;
+
+	bool OnePoint = true;
+	for (size_t i = 0; i < Rows; i++)
+	{
+		OnePoint = OnePoint && (Grid.Row(i).U == 110.0);
+	}
+	Passed = Check("One point axis holds its first value", OnePoint) && Passed;
+
+	bool Filled = true;
+	EuroOptBatch Chunk;
+	for (size_t First = 0; First < Rows; First += 37)
+	{
+		size_t Last = (First + 37 < Rows) ? First + 37 : Rows;
+		Grid.Fill(First, Last, Chunk);
+		Filled = Filled && (Chunk.Size() == Last - First);
+		for (size_t j = 0; Filled && (j < Chunk.Size()); j++)
+		{
+			Filled = SameRow(Grid.Row(First + j), Chunk, j);
+		}
+	}
+	Passed = Check("Fill matches Row at every chunk boundary", Filled) && Passed;
+
+	// Chunks spread over threads, each row once and equal to Row()
+	SetSharedThreadCount(4);
+	vector<atomic<int>> Visits(Rows);
+	atomic<bool> Equal(true);
+	ForEachGridChunk(Grid, 64, [&](size_t First, const EuroOptBatch& Part)
+	{
+		for (size_t j = 0; j < Part.Size(); j++)
+		{
+			Visits[First + j]++;
+			if (!SameRow(Grid.Row(First + j), Part, j))
+			{
+				Equal = false;
+			}
+		}
+	}, Parallel_Execution);
+	bool Once = true;
+	for (size_t i = 0; i < Rows; i++)
+	{
+		Once = Once && (Visits[i] == 1);
+	}
+	Passed = Check("ForEachGridChunk visits every row once", Once) && Passed;
+	Passed = Check("ForEachGridChunk rows match Row", Equal) && Passed;
+
+	cout << endl << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed ? 0 : 1;
+}
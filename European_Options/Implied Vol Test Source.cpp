@@ -0,0 +1,110 @@
+/*	Daniel McNulty II
+*
+*	"Implied Vol Test Source.cpp"
+*
+*	Round trip of the implied volatility solver: a random book of calls and puts (T 0.02 to 3, K 40 to 160,
+*	vol 3% to 150%, every kind of carry) is priced with CallPrice()/PutPrice(), the prices are solved back
+*	to volatilities with ImpliedVolBatch() and compared with the volatilities that produced them. Rows whose
+*	vega is below 1e-3 carry too little volatility information in a double price to be compared; the only
+*	failures accepted are quotes whose time value was lost to rounding. Also checks the single option
+*	solvers and that a quote column of the wrong length is refused. The row count can be given as the first
+*	argument, 2000000 by default. Returns 1 on any failure.
+*/
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionBatch.h"
+#include "EuropeanOptionImpliedVol.h"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+using namespace std;
+
+bool Check(const char* Name, bool Passed)		// Print one result, true if it passed
+{
+	cout << left << setw(52) << Name << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed;
+}
+
+int main(int argc, char* argv[])
+{
+	bool Passed = true;
+	size_t Rows = (argc > 1) ? strtoull(argv[1], nullptr, 10) : 2000000;
+
+	// Random book priced with the volatilities to recover
+	mt19937_64 Generator(2020);
+	uniform_real_distribution<> Unit(0.0, 1.0);
+	EuroOptBatch Book;
+	Book.Reserve(Rows);
+	for (size_t i = 0; i < Rows; i++)
+	{
+		double T = 0.02 + 2.98 * Unit(Generator);
+		double K = 40.0 + 120.0 * Unit(Generator);
+		double sig = 0.03 + 1.47 * Unit(Generator);
+		double r = 0.1 * Unit(Generator);
+		double b = r - 0.1 + 0.2 * Unit(Generator);
+		Book.AddRow(T, K, sig, r, 100.0, b);
+	}
+
+	for (OptionType Type : { Call, Put })
+	{
+		AlignedColumn Quotes(Rows);
+		for (size_t i = 0; i < Rows; i++)
+		{
+			Quotes[i] = (Type == Call) ? CallPrice(Book.T[i], Book.K[i], Book.sig[i], Book.r[i], Book.U[i], Book.b[i]) : PutPrice(Book.T[i], Book.K[i], Book.sig[i], Book.r[i], Book.U[i], Book.b[i]);
+		}
+
+		EuroOptImpliedVolResult Result;
+		auto Start = chrono::steady_clock::now();
+		ImpliedVolBatch(Book, Quotes, Type, Result, Default_Implied_Vol, Parallel_Execution);
+		double Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+
+		// Error where the price determines the volatility, and the reason for every failure
+		double Worst = 0.0, Evaluations = 0.0;
+		size_t Compared = 0, Unexpected = 0, LostTimeValue = 0;
+		for (size_t i = 0; i < Rows; i++)
+		{
+			Evaluations += Result.Iterations[i];
+			double Vega = CallVega(Book.T[i], Book.K[i], Book.sig[i], Book.r[i], Book.U[i], Book.b[i]);
+			if (Result.Status[i] == Vol_Converged)
+			{
+				if (Vega > 1e-3)
+				{
+					Worst = fmax(Worst, fabs(Result.Vol[i] - Book.sig[i]));
+					Compared++;
+				}
+			}
+			else if (Result.Status[i] == Vol_Below_Intrinsic)
+			{
+				LostTimeValue++;
+			}
+			else
+			{
+				Unexpected++;
+			}
+		}
+
+		cout << endl << ((Type == Call) ? "CALLS" : "PUTS") << ", " << Rows << " rows in " << Seconds << " s" << endl;
+		cout << "Average price evaluations per row " << Evaluations / Rows << endl;
+		cout << "Largest vol error over " << Compared << " rows with vega > 1e-3: " << Worst << endl;
+		cout << "Quotes without time value " << LostTimeValue << ", other failures " << Unexpected << endl;
+		Passed = Check("Implied vols recover the pricing vols", Worst < 1e-9) && Passed;
+		Passed = Check("No failures other than lost time value", Unexpected == 0) && Passed;
+	}
+
+	// Single option solvers
+	double CallVol = CallImpliedVol(CallPrice(0.5, 110.0, 0.35, 0.04, 100.0, 0.01), 0.5, 110.0, 0.04, 100.0, 0.01);
+	double PutVol = PutImpliedVol(PutPrice(0.5, 110.0, 0.35, 0.04, 100.0, 0.01), 0.5, 110.0, 0.04, 100.0, 0.01);
+	Passed = Check("Single option solvers recover the vol", (fabs(CallVol - 0.35) < 1e-12) && (fabs(PutVol - 0.35) < 1e-12)) && Passed;
+
+	// A quote column of the wrong length is refused
+	EuroOptImpliedVolResult Refused;
+	AlignedColumn Short(Rows / 2, 1.0);
+	ImpliedVolBatch(Book, Short, Call, Refused);
+	Passed = Check("Quote column of the wrong length is refused", Refused.Size() == 0) && Passed;
+
+	cout << endl << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed ? 0 : 1;
+}
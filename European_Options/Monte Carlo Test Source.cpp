@@ -0,0 +1,145 @@
+/*	Daniel McNulty II
+*
+*	"Monte Carlo Test Source.cpp"
+*
+*	Checks the Philox generator against the known answers of the reference implementation, the Monte Carlo
+*	European prices against CallPrice()/PutPrice() within four standard errors, that a seed gives the same
+*	bits serially and on every thread, and that the antithetic and control variates shrink the standard
+*	error of an Asian option. Prints the variance reduction of each technique. The Sobol sequence is checked
+*	against points of the Joe-Kuo reference generator, the inverse normal cdf against boost, and the
+*	scrambled Sobol samplers against the closed form and for thread independence. Returns 1 on any failure.
+*/
+
+#include "EuropeanOption.h"
+#include "MonteCarlo.h"
+#include "NormalDistribution.h"
+#include "Philox.h"
+#include "Sobol.h"
+#include <boost/math/distributions/normal.hpp>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+bool Check(const char* Name, bool Passed)		// Print one result, true if it passed
+{
+	cout << left << setw(52) << Name << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed;
+}
+
+bool Matches(const uint32_t Counter[4], uint64_t Key, const uint32_t Expected[4])		// One known answer of Philox4x32-10
+{
+	uint32_t Out[4];
+	Philox4x32(Counter, Key, Out);
+	return (Out[0] == Expected[0]) && (Out[1] == Expected[1]) && (Out[2] == Expected[2]) && (Out[3] == Expected[3]);
+}
+
+int main()
+{
+	bool Passed = true;
+
+	// Known answers of the Random123 Philox4x32-10
+	const uint32_t ZeroCounter[4] = { 0, 0, 0, 0 };
+	const uint32_t ZeroAnswer[4] = { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 };
+	const uint32_t PiCounter[4] = { 0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344 };
+	const uint32_t PiAnswer[4] = { 0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1 };
+	Passed = Check("Philox4x32-10 zero counter and key", Matches(ZeroCounter, 0, ZeroAnswer)) && Passed;
+	Passed = Check("Philox4x32-10 digits of pi", Matches(PiCounter, (static_cast<uint64_t>(0x299f31d0) << 32) | 0xa4093822, PiAnswer)) && Passed;
+
+	// European prices against the closed form, with each variance reduction switched on in turn
+	const double T = 1.0, K = 100.0, sig = 0.25, r = 0.05, U = 100.0, b = 0.02;
+	MCSettings Plain = { 200000, 1, 7, false, false, Pseudo_Random, 16 };
+	MCSettings Antithetic = Plain;
+	Antithetic.Antithetic = true;
+	MCResult Call1 = MCPrice(T, K, sig, r, U, b, Call, European_Payoff, Plain);
+	MCResult Put1 = MCPrice(T, K, sig, r, U, b, Put, European_Payoff, Antithetic);
+	cout << "European call " << Call1.Price << " +/- " << Call1.StdError << ", closed form " << CallPrice(T, K, sig, r, U, b) << endl;
+	cout << "European put  " << Put1.Price << " +/- " << Put1.StdError << ", closed form " << PutPrice(T, K, sig, r, U, b) << endl;
+	Passed = Check("European call within 4 standard errors", fabs(Call1.Price - CallPrice(T, K, sig, r, U, b)) < 4.0 * Call1.StdError) && Passed;
+	Passed = Check("Antithetic European put within 4 standard errors", fabs(Put1.Price - PutPrice(T, K, sig, r, U, b)) < 4.0 * Put1.StdError) && Passed;
+
+	// The same seed gives the same bits on any number of threads, and row 0 of a batch is stream 0
+	MCResult Serial = MCPrice(T, K, sig, r, U, b, Call, Arithmetic_Asian_Payoff, Default_MC);
+	MCResult Threaded = MCPrice(T, K, sig, r, U, b, Call, Arithmetic_Asian_Payoff, Default_MC, Parallel_Execution);
+	EuroOptBatch Batch;
+	Batch.AddRow(T, K, sig, r, U, b);
+	Batch.AddRow(T, K, sig, r, U, b);
+	AlignedColumn Prices, Errors;
+	MCPriceBatch(Batch, Call, Arithmetic_Asian_Payoff, Default_MC, Prices, Errors, Parallel_Execution);
+	Passed = Check("Serial and threaded results identical", (Serial.Price == Threaded.Price) && (Serial.StdError == Threaded.StdError)) && Passed;
+	Passed = Check("Batch row 0 identical to MCPrice", (Prices[0] == Serial.Price) && (Errors[0] == Serial.StdError)) && Passed;
+	Passed = Check("Batch rows draw from different streams", Prices[0] != Prices[1]) && Passed;
+
+	// Variance reduction on the Asian call, the same paths with each technique added
+	MCSettings AsianPlain = { Default_MC.Paths, Default_MC.TimeSteps, Default_MC.Seed, false, false, Pseudo_Random, 16 };
+	MCSettings AsianAntithetic = AsianPlain;
+	AsianAntithetic.Antithetic = true;
+	MCResult Results[3] = { MCPrice(T, K, sig, r, U, b, Call, Arithmetic_Asian_Payoff, AsianPlain), MCPrice(T, K, sig, r, U, b, Call, Arithmetic_Asian_Payoff, AsianAntithetic), Serial };
+	const char* Names[3] = { "Plain", "Antithetic", "Antithetic + control" };
+	cout << endl << "Arithmetic Asian call, " << Default_MC.Paths << " paths, " << Default_MC.TimeSteps << " dates" << endl << "METHOD                | PRICE     | STD ERROR   | VARIANCE RATIO" << endl;
+	for (int i = 0; i < 3; i++)
+	{
+		double Ratio = pow(Results[0].StdError / Results[i].StdError, 2);
+		cout << left << setw(22) << Names[i] << "| " << setw(10) << Results[i].Price << "| " << setw(12) << Results[i].StdError << "| " << Ratio << endl;
+	}
+	cout << endl;
+	Passed = Check("Antithetic pairs reduce the Asian standard error", Results[1].StdError < Results[0].StdError) && Passed;
+	Passed = Check("Control variate reduces it further", Results[2].StdError < Results[1].StdError) && Passed;
+	Passed = Check("Asian call below European call", Serial.Price < CallPrice(T, K, sig, r, U, b)) && Passed;
+	Passed = Check("Lookback call above European call", MCPrice(T, K, sig, r, U, b, Call, Lookback_Payoff, Default_MC).Price > CallPrice(T, K, sig, r, U, b)) && Passed;
+
+	// Unscrambled Sobol points 1, 2, 3, 100 and 1023 in dimensions 1, 2, 3, 31 and 64 from the Joe-Kuo generator
+	const uint32_t SobolAnswer[5][5] = {
+		{ 2147483648u, 2147483648u, 2147483648u, 2147483648u, 2147483648u },
+		{ 3221225472u, 1073741824u, 1073741824u, 1073741824u, 3221225472u },
+		{ 1073741824u, 3221225472u, 3221225472u, 3221225472u, 1073741824u },
+		{ 1778384896u, 1107296256u, 3321888768u, 3053453312u, 2785017856u },
+		{ 4194304u, 3233808384u, 2629828608u, 3988783104u, 171966464u } };
+	const int SobolIndex[5] = { 1, 2, 3, 100, 1023 }, SobolDimension[5] = { 0, 1, 2, 30, 63 };
+	SobolSequence Sobol(64);
+	vector<uint32_t> Points(64 * 1024), Run(64 * 24);
+	Sobol.Points(0, 1024, Points.data());
+	Sobol.Points(1000, 24, Run.data());
+	bool SobolMatches = true, RunMatches = true;
+	for (int i = 0; i < 5; i++)
+	{
+		for (int d = 0; d < 5; d++)
+		{
+			SobolMatches = SobolMatches && (Points[(SobolDimension[d] * 1024) + SobolIndex[i]] == SobolAnswer[i][d]);
+		}
+	}
+	for (int d = 0; d < 64; d++)
+	{
+		for (int i = 0; i < 24; i++)
+		{
+			RunMatches = RunMatches && (Run[(d * 24) + i] == Points[(d * 1024) + 1000 + i]);
+		}
+	}
+	Passed = Check("Sobol points match the Joe-Kuo generator", SobolMatches) && Passed;
+	Passed = Check("Sobol run from its first index matches", RunMatches) && Passed;
+
+	double InverseError = 0.0;
+	for (double p : { 1e-300, 1e-12, 0.001, 0.02425, 0.3, 0.7, 0.9, 0.999999 })
+	{
+		InverseError = fmax(InverseError, fabs(InverseNormCdf(p) / boost::math::quantile(boost::math::normal_distribution<>(0, 1), p) - 1.0));
+	}
+	Passed = Check("Inverse normal cdf matches boost", (InverseError < 1e-14) && (InverseNormCdf(0.5) == 0.0)) && Passed;
+
+	// Scrambled Sobol samplers, error from the spread of the replicates
+	for (MCSampler Sampler : { Sobol_Shift, Sobol_Owen })
+	{
+		MCSettings Settings = { 65536, 64, 11, false, false, Sampler, 16 };
+		MCResult European = MCPrice(T, K, sig, r, U, b, Put, European_Payoff, Settings);
+		MCResult AsianSerial = MCPrice(T, K, sig, r, U, b, Call, Arithmetic_Asian_Payoff, Settings);
+		MCResult AsianThreaded = MCPrice(T, K, sig, r, U, b, Call, Arithmetic_Asian_Payoff, Settings, Parallel_Execution);
+		cout << ((Sampler == Sobol_Shift) ? "Shifted" : "Owen scrambled") << " Sobol European put " << European.Price << " +/- " << European.StdError << ", Asian call " << AsianSerial.Price << " +/- " << AsianSerial.StdError << endl;
+		Passed = Check("Sobol European put within 4 standard errors", fabs(European.Price - PutPrice(T, K, sig, r, U, b)) < 4.0 * European.StdError) && Passed;
+		Passed = Check("Sobol Asian error below 1/10 of Philox", AsianSerial.StdError < 0.1 * Results[0].StdError * sqrt(Default_MC.Paths / 65536.0)) && Passed;
+		Passed = Check("Sobol serial and threaded results identical", (AsianSerial.Price == AsianThreaded.Price) && (AsianSerial.StdError == AsianThreaded.StdError)) && Passed;
+	}
+
+	cout << endl << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed ? 0 : 1;
+}
@@ -0,0 +1,365 @@
+/*	Daniel McNulty II
+*
+*	MonteCarlo.cpp
+*/
+
+#include "MonteCarlo.h"
+#include "BrownianBridge.h"
+#include "EuropeanOption.h"
+#include "NormalDistribution.h"
+#include "Philox.h"
+#include "Sobol.h"
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+const uint32_t SobolScrambleBlock = 0xFFFFFFFF;		// Block word of the Philox counters of the Sobol scrambles, never reached by a path block
+
+struct MCModel			// Everything a block needs to simulate one option
+{
+	double K;				// Strike price
+	double LogU;			// log of the current underlying price
+	double Drift;			// (b - sig^2 / 2) dt
+	double Vol;				// sig sqrt(dt)
+	double Discount;		// exp(-rT)
+	double Shift;			// Mean of the control, subtracted from every sample so the squared sums stay small
+	int Steps;				// Monitoring dates
+	OptionType Type;
+	MCPayoff Payoff;
+	uint64_t Seed;
+	bool Antithetic;
+	MCSampler Sampler;
+	int Replicates;			// Independently scrambled sets, 1 for Pseudo_Random
+	size_t ReplicatePaths;	// Paths of each replicate
+	size_t ReplicateBlocks;	// Blocks of each replicate, the last one may be short
+	SobolSequence Sobol;	// One dimension per step, Sobol samplers only
+	BrownianBridge Bridge;	// Path construction over the steps, Sobol samplers only
+};
+
+struct MCSums			// Sums over the samples of one block, payoff Y and control X both less the shift
+{
+	double Count;
+	double Y, X;
+	double YY, XX, XY;
+};
+
+struct MCScratch		// Per thread arrays, one entry per path of a block
+{
+	vector<uint32_t> Words;		// Philox output of one step
+	vector<double> Z;			// Normals of one step
+	vector<double> LogS;		// log of the underlying price
+	vector<double> Running;		// Sum (Asian) or extreme (lookback) of the monitoring dates
+	vector<uint32_t> Points;	// Sobol points of the block, dimension by dimension
+	vector<double> Normals;		// Inverse cdf of the scrambled points, dimension by dimension
+	vector<double> Increments;	// Standardized path increments from the bridge, step by step
+};
+
+static MCSettings CheckedSettings(const MCSettings& Settings, MCPayoff Payoff)		// Settings with invalid counts replaced by the defaults
+{
+	MCSettings Checked = Settings;
+	if (Checked.Paths < 4)
+	{
+		cout << "ERROR: Monte Carlo needs at least 4 paths. Resorting to default " << Default_MC.Paths << " paths" << endl;
+		Checked.Paths = Default_MC.Paths;
+	}
+	if (Checked.TimeSteps < 1)
+	{
+		cout << "ERROR: Monte Carlo needs at least one time step. Resorting to default " << Default_MC.TimeSteps << " steps" << endl;
+		Checked.TimeSteps = Default_MC.TimeSteps;
+	}
+	if (Checked.Sampler != Pseudo_Random)
+	{
+		if (Checked.Replicates < 2)
+		{
+			cout << "ERROR: Sobol sampling needs at least 2 replicates for its standard error. Resorting to default " << Default_MC.Replicates << " replicates" << endl;
+			Checked.Replicates = Default_MC.Replicates;
+		}
+		if ((Payoff != European_Payoff) && (Checked.TimeSteps > SobolMaxDimensions))
+		{
+			cout << "ERROR: Sobol sampling has direction numbers for " << SobolMaxDimensions << " time steps. Resorting to pseudo random sampling" << endl;
+			Checked.Sampler = Pseudo_Random;
+		}
+	}
+
+	// Whole antithetic pairs in every replicate
+	size_t Unit = ((Checked.Sampler == Pseudo_Random) ? 1 : Checked.Replicates) * (Checked.Antithetic ? 2 : 1);
+	Checked.Paths = ((Checked.Paths + Unit - 1) / Unit) * Unit;
+	return Checked;
+}
+
+static MCModel BuildModel(double T, double K, double sig, double r, double U, double b, OptionType Type, MCPayoff Payoff, const MCSettings& Settings)	// Per step constants of one option
+{
+	MCModel Model;
+	Model.Steps = (Payoff == European_Payoff) ? 1 : Settings.TimeSteps;		// The terminal value is exact in one step
+	double dt = T / Model.Steps;
+	Model.K = K;
+	Model.LogU = log(U);
+	Model.Drift = (b - (0.5 * sig * sig)) * dt;
+	Model.Vol = sig * sqrt(dt);
+	Model.Discount = exp(-r * T);
+	Model.Shift = (Type == Call) ? CallPrice(T, K, sig, r, U, b) : PutPrice(T, K, sig, r, U, b);
+	Model.Type = Type;
+	Model.Payoff = Payoff;
+	Model.Seed = Settings.Seed;
+	Model.Antithetic = Settings.Antithetic;
+	Model.Sampler = Settings.Sampler;
+	Model.Replicates = (Settings.Sampler == Pseudo_Random) ? 1 : Settings.Replicates;
+	Model.ReplicatePaths = Settings.Paths / Model.Replicates;
+	Model.ReplicateBlocks = (Model.ReplicatePaths + MCBlockPaths - 1) / MCBlockPaths;
+	if (Settings.Sampler != Pseudo_Random)
+	{
+		Model.Sobol = SobolSequence(Model.Steps);
+		Model.Bridge = BrownianBridge(Model.Steps);
+	}
+	return Model;
+}
+
+static size_t BlockCount(const MCModel& Model)		// Blocks of MCBlockPaths paths, replicate by replicate
+{
+	return Model.Replicates * Model.ReplicateBlocks;
+}
+
+static size_t BlockPaths(const MCModel& Model, size_t Block)		// Paths of one block, the last block of a replicate may be short
+{
+	return min(MCBlockPaths, Model.ReplicatePaths - ((Block % Model.ReplicateBlocks) * MCBlockPaths));
+}
+
+static void SobolNormals(const MCModel& Model, uint32_t Stream, uint32_t Block, size_t Draws, MCScratch& Scratch)	// Standardized increments of every step of one block from its replicate's scrambled Sobol points
+{
+	uint32_t Replicate = static_cast<uint32_t>(Block / Model.ReplicateBlocks);
+	uint32_t First = static_cast<uint32_t>((Block % Model.ReplicateBlocks) * (Model.Antithetic ? (MCBlockPaths / 2) : MCBlockPaths));
+	size_t Cells = static_cast<size_t>(Model.Steps) * Draws;
+	Scratch.Points.resize(Cells);
+	Scratch.Normals.resize(Cells);
+	Scratch.Increments.resize(Cells);
+	Model.Sobol.Points(First, Draws, Scratch.Points.data());
+
+	for (int d = 0; d < Model.Steps; d++)
+	{
+		// One Philox word scrambles a dimension, the same word for every block of the replicate
+		uint32_t Counter[4] = { static_cast<uint32_t>(d), Replicate, SobolScrambleBlock, Stream };
+		uint32_t Words[4];
+		Philox4x32(Counter, Model.Seed, Words);
+		const uint32_t* Points = Scratch.Points.data() + (static_cast<size_t>(d) * Draws);
+		double* Normals = Scratch.Normals.data() + (static_cast<size_t>(d) * Draws);
+		for (size_t i = 0; i < Draws; i++)
+		{
+			uint32_t x = (Model.Sampler == Sobol_Owen) ? OwenScramble(Points[i], Words[0]) : DigitalShift(Points[i], Words[0]);
+			Normals[i] = InverseNormCdf(SobolUniform(x));
+		}
+	}
+	Model.Bridge.Transform(Scratch.Normals.data(), Draws, Scratch.Increments.data());
+}
+
+static void SimulateBlock(const MCModel& Model, uint32_t Stream, uint32_t Block, size_t Paths, MCScratch& Scratch, MCSums& Out)	// Simulate one block and sum its samples
+{
+	size_t Draws = Model.Antithetic ? (Paths / 2) : Paths;		// Normals per step, the antithetic half mirrors them
+	Scratch.Words.resize(Draws + 4);
+	Scratch.Z.resize(Draws + 1);
+	Scratch.LogS.assign(Paths, Model.LogU);
+	Scratch.Running.assign(Paths, ((Model.Payoff == Lookback_Payoff) && (Model.Type == Put)) ? numeric_limits<double>::infinity() : 0.0);
+	double* LogS = Scratch.LogS.data();
+	double* Running = Scratch.Running.data();
+	if (Model.Sampler != Pseudo_Random)
+	{
+		SobolNormals(Model, Stream, Block, Draws, Scratch);
+	}
+
+	// One time step of the whole block at a time, each loop runs over contiguous arrays
+	for (int Step = 0; Step < Model.Steps; Step++)
+	{
+		const double* Z = Scratch.Z.data();
+		if (Model.Sampler == Pseudo_Random)
+		{
+			PhiloxNormals(Model.Seed, Stream, Block, static_cast<uint32_t>(Step), Draws, Scratch.Words.data(), Scratch.Z.data());
+		}
+		else
+		{
+			Z = Scratch.Increments.data() + (static_cast<size_t>(Step) * Draws);
+		}
+		for (size_t j = 0; j < Draws; j++)
+		{
+			LogS[j] += Model.Drift + (Model.Vol * Z[j]);
+		}
+		if (Model.Antithetic)
+		{
+			for (size_t j = 0; j < Draws; j++)
+			{
+				LogS[Draws + j] += Model.Drift - (Model.Vol * Z[j]);
+			}
+		}
+
+		if (Model.Payoff == Arithmetic_Asian_Payoff)
+		{
+			for (size_t j = 0; j < Paths; j++)
+			{
+				Running[j] += exp(LogS[j]);
+			}
+		}
+		else if (Model.Payoff == Lookback_Payoff)
+		{
+			for (size_t j = 0; j < Paths; j++)
+			{
+				Running[j] = (Model.Type == Call) ? fmax(Running[j], exp(LogS[j])) : fmin(Running[j], exp(LogS[j]));
+			}
+		}
+	}
+
+	// Discounted payoff and control of every path, overwriting the path arrays
+	double Sign = (Model.Type == Call) ? 1.0 : -1.0;
+	for (size_t j = 0; j < Paths; j++)
+	{
+		double Terminal = exp(LogS[j]);
+		double Underlying = (Model.Payoff == European_Payoff) ? Terminal : ((Model.Payoff == Arithmetic_Asian_Payoff) ? (Running[j] / Model.Steps) : Running[j]);
+		Running[j] = (Model.Discount * fmax(Sign * (Underlying - Model.K), 0.0)) - Model.Shift;
+		LogS[j] = (Model.Discount * fmax(Sign * (Terminal - Model.K), 0.0)) - Model.Shift;
+	}
+
+	MCSums Sums = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	for (size_t i = 0; i < Draws; i++)
+	{
+		double y = Model.Antithetic ? (0.5 * (Running[i] + Running[Draws + i])) : Running[i];
+		double x = Model.Antithetic ? (0.5 * (LogS[i] + LogS[Draws + i])) : LogS[i];
+		Sums.Y += y;
+		Sums.X += x;
+		Sums.YY += y * y;
+		Sums.XX += x * x;
+		Sums.XY += x * y;
+	}
+	Sums.Count = static_cast<double>(Draws);
+	Out = Sums;
+}
+
+static MCResult Estimate(const MCModel& Model, const vector<MCSums>& Blocks, bool ControlVariate)		// Price and standard error from the block sums, added in block order
+{
+	MCSums Total = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+	for (const MCSums& Block : Blocks)
+	{
+		Total.Count += Block.Count;
+		Total.Y += Block.Y;
+		Total.X += Block.X;
+		Total.YY += Block.YY;
+		Total.XX += Block.XX;
+		Total.XY += Block.XY;
+	}
+
+	double n = Total.Count;
+	double MeanY = Total.Y / n, MeanX = Total.X / n;
+	double Cyy = Total.YY - (n * MeanY * MeanY);
+	double Cxx = Total.XX - (n * MeanX * MeanX);
+	double Cxy = Total.XY - (n * MeanX * MeanY);
+
+	MCResult Out;
+	Out.Samples = static_cast<size_t>(n);
+	Out.Beta = (ControlVariate && (Cxx > 0.0)) ? (Cxy / Cxx) : 0.0;
+	Out.Price = Model.Shift + MeanY - (Out.Beta * MeanX);		// The control has mean 0 after the shift
+	double Variance = ControlVariate ? ((Cyy - (Out.Beta * Cxy)) / (n - 2.0)) : (Cyy / (n - 1.0));
+	Out.StdError = sqrt(fmax(Variance, 0.0) / n);
+	if (Model.Replicates == 1)
+	{
+		return Out;
+	}
+
+	// Randomized quasi Monte Carlo, the error is the spread of the replicate estimates with the pooled coefficient
+	double Sum = 0.0, SumSquares = 0.0;
+	for (int Replicate = 0; Replicate < Model.Replicates; Replicate++)
+	{
+		MCSums Set = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+		for (size_t Block = Replicate * Model.ReplicateBlocks; Block < (Replicate + 1) * Model.ReplicateBlocks; Block++)
+		{
+			Set.Count += Blocks[Block].Count;
+			Set.Y += Blocks[Block].Y;
+			Set.X += Blocks[Block].X;
+		}
+		double Estimate = (Set.Y - (Out.Beta * Set.X)) / Set.Count;
+		Sum += Estimate;
+		SumSquares += Estimate * Estimate;
+	}
+	double R = Model.Replicates;
+	double Mean = Sum / R;
+	Out.Price = Model.Shift + Mean;
+	Out.StdError = sqrt(fmax(SumSquares - (R * Mean * Mean), 0.0) / (R * (R - 1.0)));
+	return Out;
+}
+
+static MCResult Expired(double K, double U, OptionType Type)		// Result of an option at or past expiry
+{
+	MCResult Out;
+	Out.Price = fmax((Type == Call) ? (U - K) : (K - U), 0.0);
+	Out.StdError = 0.0;
+	Out.Samples = 0;
+	Out.Beta = 0.0;
+	return Out;
+}
+
+static MCResult SimulateSerial(double T, double K, double sig, double r, double U, double b, OptionType Type, MCPayoff Payoff, const MCSettings& Settings, uint32_t Stream, MCScratch& Scratch)	// One option on the calling thread
+{
+	if (!(T > 0.0))
+	{
+		return Expired(K, U, Type);
+	}
+
+	MCModel Model = BuildModel(T, K, sig, r, U, b, Type, Payoff, Settings);
+	vector<MCSums> Blocks(BlockCount(Model));
+	for (size_t Block = 0; Block < Blocks.size(); Block++)
+	{
+		SimulateBlock(Model, Stream, static_cast<uint32_t>(Block), BlockPaths(Model, Block), Scratch, Blocks[Block]);
+	}
+	return Estimate(Model, Blocks, Settings.ControlVariate);
+}
+
+// GLOBAL MONTE CARLO FUNCTIONS
+MCResult MCPrice(double T, double K, double sig, double r, double U, double b, OptionType Type, MCPayoff Payoff, const MCSettings& Settings)		// Price of one option on the calling thread
+{
+	return MCPrice(T, K, sig, r, U, b, Type, Payoff, Settings, Serial_Execution);
+}
+
+MCResult MCPrice(double T, double K, double sig, double r, double U, double b, OptionType Type, MCPayoff Payoff, const MCSettings& Settings, const ExecutionPolicy& Policy)	// Price of one option with the blocks spread over Policy's threads
+{
+	MCSettings Checked = CheckedSettings(Settings, Payoff);
+	if (!(T > 0.0))
+	{
+		return Expired(K, U, Type);
+	}
+
+	MCModel Model = BuildModel(T, K, sig, r, U, b, Type, Payoff, Checked);
+	vector<MCSums> Blocks(BlockCount(Model));
+	ParallelFor(Blocks.size(), [&](size_t First, size_t Last)
+	{
+		MCScratch Scratch;			// Arrays reused by every block of the range
+		for (size_t Block = First; Block < Last; Block++)
+		{
+			SimulateBlock(Model, 0, static_cast<uint32_t>(Block), BlockPaths(Model, Block), Scratch, Blocks[Block]);
+		}
+	}, Policy);
+	return Estimate(Model, Blocks, Checked.ControlVariate);
+}
+
+void MCPriceBatch(const EuroOptBatch& Data, OptionType Type, MCPayoff Payoff, const MCSettings& Settings, AlignedColumn& Price, AlignedColumn& StdError)		// Prices of every row on the calling thread
+{
+	MCPriceBatch(Data, Type, Payoff, Settings, Price, StdError, Serial_Execution);
+}
+
+void MCPriceBatch(const EuroOptBatch& Data, OptionType Type, MCPayoff Payoff, const MCSettings& Settings, AlignedColumn& Price, AlignedColumn& StdError, const ExecutionPolicy& Policy)	// Prices of every row on Policy's threads
+{
+	MCSettings Checked = CheckedSettings(Settings, Payoff);
+	size_t n = Data.Size();
+	Price.resize(n);
+	StdError.resize(n);
+	NormalBackend Backend = ActiveNormalBackend();		// The caller's tier for the control means on every thread
+
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		NormalBackendScope Scope(Backend);
+		MCScratch Scratch;
+		for (size_t i = First; i < Last; i++)
+		{
+			MCResult Row = SimulateSerial(Data.T[i], Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i], Type, Payoff, Checked, static_cast<uint32_t>(i), Scratch);
+			Price[i] = Row.Price;
+			StdError[i] = Row.StdError;
+		}
+	}, Policy);
+}
@@ -0,0 +1,80 @@
+/*	Daniel McNulty II
+*
+*	MonteCarlo.h
+*
+*	Monte Carlo pricer for European and path-dependent options under geometric Brownian motion with the
+*	generalized cost of carry, ln S moving by (b - sig^2 / 2) dt + sig sqrt(dt) Z between evenly spaced
+*	monitoring dates. Paths are simulated in blocks of MCBlockPaths, one time step of the whole block at a
+*	time over contiguous arrays, with the normals drawn from Philox keyed by the seed and counted by (step,
+*	block, stream). A block's numbers do not depend on which thread simulates it, and the block sums are
+*	added in block order, so a seed gives the same price and standard error on any number of threads.
+*
+*	Antithetic variates pair every path with its mirror image and average the pair into one sample. The
+*	control variate is the discounted European payoff of the same path, whose mean is CallPrice()/PutPrice();
+*	its coefficient is the regression estimate from the same samples. The standard error is that of the
+*	final estimator, so it shows what each technique saves.
+*
+*	The Sobol samplers replace the Philox normals with a scrambled Sobol sequence, one dimension per date,
+*	mapped to normals by the inverse cdf and to paths by a Brownian bridge. The paths are split into
+*	Replicates independently scrambled sets, each scramble keyed by the seed, replicate and stream, and
+*	the standard error is the spread of the replicate estimates. The control coefficient is pooled over
+*	all replicates. A block covers points of one replicate only, so the thread count again does not
+*	change the result.
+*/
+
+#ifndef MonteCarlo_H
+#define MonteCarlo_H
+
+#include "EuropeanOptionBatch.h"
+#include "Option.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <cstdint>
+using namespace std;
+
+const size_t MCBlockPaths = 1024;		// Paths simulated together, the unit of work of a thread and of an RNG stream
+
+enum MCPayoff				// Payoff of a simulated option, all struck at K
+{
+	European_Payoff,		// max(S(T) - K, 0) or max(K - S(T), 0), simulated in one step
+	Arithmetic_Asian_Payoff,// Fixed strike on the arithmetic average of the monitoring dates
+	Lookback_Payoff			// Fixed strike on the highest (call) or lowest (put) monitoring date
+};
+
+enum MCSampler				// Source of the normals driving the paths
+{
+	Pseudo_Random,			// Philox normals by Box-Muller, step by step
+	Sobol_Shift,			// Sobol points with a random digital shift per replicate, Brownian bridge paths
+	Sobol_Owen				// Sobol points with an Owen scramble per replicate, Brownian bridge paths
+};
+
+struct MCSettings			// How the paths are simulated
+{
+	size_t Paths;			// Simulated paths, an antithetic pair counts as two
+	int TimeSteps;			// Monitoring dates, evenly spaced up to and including expiry
+	uint64_t Seed;			// Philox key
+	bool Antithetic;		// Pair every path with its antithetic path
+	bool ControlVariate;	// Correct with the European payoff of the same path
+	MCSampler Sampler;		// Pseudo random or scrambled Sobol normals
+	int Replicates;			// Independently scrambled Sobol sets sharing the paths, ignored by Pseudo_Random
+};
+
+const MCSettings Default_MC = { 262144, 64, 20200601, true, true, Pseudo_Random, 16 };		// 256 blocks of paths with weekly monitoring of a one year option
+
+struct MCResult				// Estimate from one simulation
+{
+	double Price;			// Estimated price
+	double StdError;		// Standard error of Price
+	size_t Samples;			// Independent samples, half the paths with antithetic pairs
+	double Beta;			// Control variate coefficient, 0 without the control variate
+};
+
+// Single option pricers, the paths are spread over Policy's threads
+MCResult MCPrice(double T, double K, double sig, double r, double U, double b, OptionType Type, MCPayoff Payoff, const MCSettings& Settings);
+MCResult MCPrice(double T, double K, double sig, double r, double U, double b, OptionType Type, MCPayoff Payoff, const MCSettings& Settings, const ExecutionPolicy& Policy);
+
+// Batch pricers, row i draws from stream i and the rows are spread over Policy's threads
+void MCPriceBatch(const EuroOptBatch& Data, OptionType Type, MCPayoff Payoff, const MCSettings& Settings, AlignedColumn& Price, AlignedColumn& StdError);
+void MCPriceBatch(const EuroOptBatch& Data, OptionType Type, MCPayoff Payoff, const MCSettings& Settings, AlignedColumn& Price, AlignedColumn& StdError, const ExecutionPolicy& Policy);
+
+#endif
@@ -0,0 +1,281 @@
+/*	Daniel McNulty II
+*
+*	NormalDistribution.cpp
+*/
+
+#include "NormalDistribution.h"
+#include "SimdMath.h"
+#include <boost/math/distributions/normal.hpp>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <string>
+
+using namespace std;
+
+static atomic<int> GlobalBackend(Full_Normal);		// Backend shared by all threads
+static thread_local int ScopedBackend = -1;			// Per thread override installed by NormalBackendScope, -1 for none
+
+// BACKEND SELECTION
+void SetNormalBackend(NormalBackend Backend)		// Select the backend used by every thread that has no NormalBackendScope
+{
+	GlobalBackend.store(Backend, memory_order_relaxed);
+}
+
+NormalBackend GetNormalBackend()					// The global backend
+{
+	return static_cast<NormalBackend>(GlobalBackend.load(memory_order_relaxed));
+}
+
+NormalBackend ActiveNormalBackend()					// The backend the calling thread will use
+{
+	return (ScopedBackend >= 0) ? static_cast<NormalBackend>(ScopedBackend) : GetNormalBackend();
+}
+
+string NormalBackendName(NormalBackend Backend)		// Printable name of a backend
+{
+	switch (Backend)
+	{
+	case (Boost_Normal):
+		return "Boost";
+	case (Full_Normal):
+		return "Full";
+	case (Fast_Normal):
+		return "Fast";
+	case (Screening_Normal):
+		return "Screening";
+	default:
+		return "Unknown";
+	}
+}
+
+// NORMALBACKENDSCOPE MEMBER FUNCTIONS
+NormalBackendScope::NormalBackendScope(NormalBackend Backend) : Previous(ScopedBackend)		// Constructor that installs Backend for the calling thread
+{
+	ScopedBackend = Backend;
+}
+
+NormalBackendScope::~NormalBackendScope()		// Destructor that restores the previous override
+{
+	ScopedBackend = Previous;
+}
+
+// STANDARD NORMAL FUNCTIONS
+double NormCdf(double x)								// N(x) with the active backend
+{
+	return NormCdf(x, ActiveNormalBackend());
+}
+
+double NormCdf(double x, NormalBackend Backend)			// N(x) with a given backend
+{
+	double Tail;
+	switch (Backend)
+	{
+	case (Boost_Normal):
+		return boost::math::cdf(boost::math::normal_distribution<>(0, 1), x);
+	case (Fast_Normal):
+		Tail = SimdNormTailFast<ScalarLanes>(fabs(x));
+		break;
+	case (Screening_Normal):
+		Tail = SimdNormTailScreening<ScalarLanes>(fabs(x));
+		break;
+	default:
+		Tail = SimdNormTail<ScalarLanes>(fabs(x));
+		break;
+	}
+
+	return (x > 0.0) ? (1.0 - Tail) : Tail;			// The tiers approximate N(-|x|), reflect for positive x
+}
+
+double NormPdf(double x)								// n(x) with the active backend
+{
+	return NormPdf(x, ActiveNormalBackend());
+}
+
+double NormPdf(double x, NormalBackend Backend)			// n(x) with a given backend
+{
+	if (Backend == Boost_Normal)
+	{
+		return boost::math::pdf(boost::math::normal_distribution<>(0, 1), x);
+	}
+	return 0.3989422804014327 * exp(-0.5 * x * x);
+}
+
+double BivariateNormCdf(double x, double y, double rho)		// P(X < x, Y < y) for standard normals with correlation rho
+{
+	return BivariateNormCdf(x, y, BivariateNormPlan(rho));
+}
+
+BivariateNormTerms BivariateNormPlan(double rho)		// Terms of BivariateNormCdf() that only depend on rho
+{
+	// Gauss-Legendre nodes and weights on [-1, 0] for 6, 12 and 20 point rules, more points as |rho| grows
+	static const double Weights[3][10] = {
+		{ 0.1713244923791705, 0.3607615730481384, 0.4679139345726904 },
+		{ 0.04717533638651177, 0.1069393259953183, 0.1600783285433464, 0.2031674267230659, 0.2334925365383547, 0.2491470458134029 },
+		{ 0.01761400713915212, 0.04060142980038694, 0.06267204833410906, 0.08327674157670475, 0.1019301198172404,
+		  0.1181945319615184, 0.1316886384491766, 0.1420961093183821, 0.1491729864726037, 0.1527533871307259 } };
+	static const double Nodes[3][10] = {
+		{ -0.9324695142031522, -0.6612093864662647, -0.2386191860831970 },
+		{ -0.9815606342467191, -0.9041172563704750, -0.7699026741943050, -0.5873179542866171, -0.3678314989981802, -0.1252334085114692 },
+		{ -0.9931285991850949, -0.9639719272779138, -0.9122344282513259, -0.8391169718222188, -0.7463319064601508,
+		  -0.6360536807265150, -0.5108670019508271, -0.3737060887154196, -0.2277858511416451, -0.07652652113349733 } };
+	const double TwoPi = 6.283185307179586;
+
+	BivariateNormTerms Terms;
+	int Rule = (fabs(rho) < 0.3) ? 0 : ((fabs(rho) < 0.75) ? 1 : 2);
+	Terms.rho = rho;
+	Terms.Points = (Rule == 0) ? 3 : ((Rule == 1) ? 6 : 10);
+	Terms.Scale = 0.0;
+	Terms.Ass = (1 - rho) * (1 + rho);
+
+	if (fabs(rho) < 0.925)
+	{
+		// Points along the correlation from 0 to rho, two per node, one on each side of the midpoint
+		double asr = asin(rho);
+		Terms.Scale = asr / (2 * TwoPi);
+		for (int i = 0; i < Terms.Points; i++)
+		{
+			for (int Side = -1; Side <= 1; Side += 2)
+			{
+				int j = (2 * i) + ((Side + 1) / 2);
+				double sn = sin(asr * ((Side * Nodes[Rule][i]) + 1) / 2);
+				Terms.Sin[j] = sn;
+				Terms.Cos[j] = 1 - (sn * sn);
+				Terms.Weight[j] = Weights[Rule][i];
+			}
+		}
+	}
+	else if (fabs(rho) < 1.0)
+	{
+		// Points from rho to +-1, in the sqrt(1 - rho^2) substitution of the singular part
+		double a = sqrt(Terms.Ass);
+		Terms.Scale = a;
+		a /= 2;
+		for (int i = 0; i < Terms.Points; i++)
+		{
+			for (int Side = -1; Side <= 1; Side += 2)
+			{
+				int j = (2 * i) + ((Side + 1) / 2);
+				double xs = pow(a * ((Side * Nodes[Rule][i]) + 1), 2);
+				Terms.Sin[j] = xs;
+				Terms.Cos[j] = sqrt(1 - xs);
+				Terms.Weight[j] = a * Weights[Rule][i];
+			}
+		}
+	}
+
+	return Terms;
+}
+
+double BivariateNormCdf(double x, double y, const BivariateNormTerms& Terms)		// P(X < x, Y < y) with the rho dependent terms precomputed
+{
+	const double TwoPi = 6.283185307179586;
+	double rho = Terms.rho;
+	int Nodes = 2 * Terms.Points;
+	double h = -x, k = -y, hk = h * k;
+	double Result = 0.0;
+
+	if (fabs(rho) < 0.925)
+	{
+		// Integrate the density along the correlation from 0 to rho
+		if (fabs(rho) > 0.0)
+		{
+			double hs = ((h * h) + (k * k)) / 2;
+			for (int j = 0; j < Nodes; j++)
+			{
+				Result += Terms.Weight[j] * exp(((Terms.Sin[j] * hk) - hs) / Terms.Cos[j]);
+			}
+			Result *= Terms.Scale;
+		}
+		return Result + (NormCdf(-h) * NormCdf(-k));
+	}
+
+	// Close to perfect correlation, integrate from rho to +-1 after removing the singular part
+	if (rho < 0.0)
+	{
+		k = -k;
+		hk = -hk;
+	}
+	if (fabs(rho) < 1.0)
+	{
+		double Ass = Terms.Ass;
+		double a = Terms.Scale;
+		double bs = (h - k) * (h - k);
+		double c = (4 - hk) / 8;
+		double d = (12 - hk) / 16;
+		double asr = -((bs / Ass) + hk) / 2;
+		if (asr > -100)
+		{
+			Result = a * exp(asr) * (1 - ((c * (bs - Ass) * (1 - ((d * bs) / 5))) / 3) + ((c * d * Ass * Ass) / 5));
+		}
+		if (-hk < 100)
+		{
+			double b = sqrt(bs);
+			Result -= exp(-hk / 2) * sqrt(TwoPi) * NormCdf(-b / a) * b * (1 - ((c * bs * (1 - ((d * bs) / 5))) / 3));
+		}
+		for (int j = 0; j < Nodes; j++)
+		{
+			double xs = Terms.Sin[j];
+			double rs = Terms.Cos[j];
+			asr = -((bs / xs) + hk) / 2;
+			if (asr > -100)
+			{
+				Result += Terms.Weight[j] * exp(asr) * ((exp(-(hk * (1 - rs)) / (2 * (1 + rs))) / rs) - (1 + (c * xs * (1 + (d * xs)))));
+			}
+		}
+		Result = -Result / TwoPi;
+	}
+
+	if (rho > 0.0)
+	{
+		return Result + NormCdf(-fmax(h, k));
+	}
+	Result = -Result;
+	if (k > h)
+	{
+		Result += NormCdf(k) - NormCdf(h);
+	}
+	return Result;
+}
+
+double InverseNormCdf(double p)		// x with N(x) = p for 0 < p < 1
+{
+	// Acklam's rational approximations, a central one and one for the tail, about 1.15e-9 relative
+	static const double a[6] = { -3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02, 1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00 };
+	static const double b[5] = { -5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02, 6.680131188771972e+01, -1.328068155288572e+01 };
+	static const double c[6] = { -7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00, -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00 };
+	static const double d[4] = { 7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00 };
+	const double Low = 0.02425;
+
+	if (!(p > 0.0))
+	{
+		return -numeric_limits<double>::infinity();
+	}
+	if (!(p < 1.0))
+	{
+		return numeric_limits<double>::infinity();
+	}
+
+	if (p > 0.5)
+	{
+		return -InverseNormCdf(1 - p);		// 1 - p is exact here, and the lower half refines to full relative accuracy
+	}
+
+	double x;
+	if (p < Low)
+	{
+		double q = sqrt(-2 * log(p));
+		x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) / ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1);
+	}
+	else
+	{
+		double q = p - 0.5;
+		double rr = q * q;
+		x = (((((a[0] * rr + a[1]) * rr + a[2]) * rr + a[3]) * rr + a[4]) * rr + a[5]) * q / (((((b[0] * rr + b[1]) * rr + b[2]) * rr + b[3]) * rr + b[4]) * rr + 1);
+	}
+
+	// One Halley step on N(x) - p with the complementary error function, which keeps its relative accuracy in the lower tail
+	double e = (0.5 * erfc(-x / 1.4142135623730951)) - p;
+	double u = e * 2.5066282746310002 * exp(0.5 * x * x);
+	return x - (u / (1 + (x * u / 2)));
+}
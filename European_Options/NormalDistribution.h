@@ -0,0 +1,66 @@
+/*	Daniel McNulty II
+*
+*	NormalDistribution.h
+*
+*	Standard normal cdf/pdf backend used by every European pricer. The backend is chosen globally with
+*	SetNormalBackend(), or for the current thread only with a NormalBackendScope, which is how the batch
+*	pricers take a per batch backend.
+*/
+
+#ifndef NormalDistribution_H
+#define NormalDistribution_H
+
+#include <string>
+using namespace std;
+
+enum NormalBackend			// Accuracy tiers of the standard normal cdf, absolute error against boost
+{
+	Boost_Normal,			// boost::math::normal_distribution, the reference implementation
+	Full_Normal,			// Hart (1968) / West (2005) rational approximation, about 2e-16
+	Fast_Normal,			// Degree 9 polynomial in 1 / (1 + 0.3x) times n(x), about 1e-11
+	Screening_Normal		// Abramowitz and Stegun 26.2.17, about 7.5e-8
+};
+
+void SetNormalBackend(NormalBackend Backend);		// Select the backend used by every thread that has no NormalBackendScope
+NormalBackend GetNormalBackend();					// The global backend
+NormalBackend ActiveNormalBackend();				// The backend the calling thread will use, its innermost NormalBackendScope or else the global one
+string NormalBackendName(NormalBackend Backend);	// Printable name of a backend
+
+class NormalBackendScope		// Overrides the backend for the calling thread until the scope object is destroyed
+{
+private:
+	int Previous;				// Override that was active when the scope was entered, -1 for none
+
+public:
+	// Constructors
+	NormalBackendScope(NormalBackend Backend);		// Constructor that installs Backend for the calling thread
+	// Destructors
+	virtual ~NormalBackendScope();					// Destructor that restores the previous override
+
+private:
+	NormalBackendScope(const NormalBackendScope& source);					// Not copyable
+	NormalBackendScope& operator = (const NormalBackendScope& source);		// Not assignable
+};
+
+struct BivariateNormTerms		// Correlation dependent terms of BivariateNormCdf(), computed once and shared by calls with the same rho
+{
+	double rho;					// Correlation
+	int Points;					// Gauss-Legendre nodes on each side of the interval
+	double Scale;				// asin(rho) / (4 pi) for |rho| < 0.925, else sqrt(1 - rho^2)
+	double Ass;					// 1 - rho^2
+	double Sin[20];				// sin of each quadrature point on [0, asin(rho)] for |rho| < 0.925, else the squared point on [0, sqrt(1 - rho^2)]
+	double Cos[20];				// 1 - Sin^2 for |rho| < 0.925, else sqrt(1 - Sin)
+	double Weight[20];			// Quadrature weight of each point, scaled by sqrt(1 - rho^2) / 2 for |rho| >= 0.925
+};
+
+// Standard normal functions
+double NormCdf(double x);								// N(x) with the active backend
+double NormCdf(double x, NormalBackend Backend);		// N(x) with a given backend
+double NormPdf(double x);								// n(x) with the active backend
+double NormPdf(double x, NormalBackend Backend);		// n(x) with a given backend
+double BivariateNormCdf(double x, double y, double rho);	// P(X < x, Y < y) for standard normals with correlation rho, Genz (2004), about 1e-15 plus the active backend's error
+BivariateNormTerms BivariateNormPlan(double rho);		// Terms of BivariateNormCdf() that only depend on rho
+double BivariateNormCdf(double x, double y, const BivariateNormTerms& Terms);	// As above with the rho dependent terms precomputed, identical results
+double InverseNormCdf(double p);						// x with N(x) = p for 0 < p < 1, Acklam (2003) with one Halley step, about 1e-15 relative
+
+#endif
@@ -0,0 +1,516 @@
+/*	Daniel McNulty II
+*
+*	OptionBook.cpp
+*/
+
+#include "OptionBook.h"
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static_assert(sizeof(BookHeader) == 64, "BookHeader must stay 64 bytes");
+static_assert(sizeof(BookColumn) == 32, "BookColumn must stay 32 bytes");
+
+static const char BookMagic[8] = { 'O', 'P', 'T', 'B', 'O', 'O', 'K', 0 };
+static const uint32_t BookByteOrder = 0x01020304;
+
+static size_t AlignUp(size_t Bytes)		// Round Bytes up to the next multiple of BookAlignment
+{
+	return (Bytes + BookAlignment - 1) / BookAlignment * BookAlignment;
+}
+
+static size_t TypeWords(size_t Rows)	// 64 bit words in the option type bitmap of Rows records
+{
+	return (Rows + 63) / 64;
+}
+
+// MAPPEDFILE MEMBER FUNCTIONS
+// Constructors
+#ifdef _WIN32
+MappedFile::MappedFile() : Base(nullptr), Bytes(0), FileHandle(INVALID_HANDLE_VALUE), MappingHandle(nullptr) {}	// Default constructor
+#else
+MappedFile::MappedFile() : Base(nullptr), Bytes(0), Descriptor(-1) {}		// Default constructor
+#endif
+
+// Destructors
+MappedFile::~MappedFile()		// Destructor that unmaps the file
+{
+	Close();
+}
+
+// Functionality
+bool MappedFile::OpenRead(const string& Path)		// Map an existing file read only
+{
+	Close();
+#ifdef _WIN32
+	FileHandle = CreateFileA(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	LARGE_INTEGER Length;
+	if ((FileHandle == INVALID_HANDLE_VALUE) || !GetFileSizeEx(FileHandle, &Length) || (Length.QuadPart == 0))
+	{
+		Close();
+		return false;
+	}
+	MappingHandle = CreateFileMappingA(FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	Base = (MappingHandle == nullptr) ? nullptr : static_cast<unsigned char*>(MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+	Bytes = static_cast<size_t>(Length.QuadPart);
+#else
+	Descriptor = open(Path.c_str(), O_RDONLY);
+	struct stat Info;
+	if ((Descriptor < 0) || (fstat(Descriptor, &Info) != 0) || (Info.st_size == 0))
+	{
+		Close();
+		return false;
+	}
+	Bytes = static_cast<size_t>(Info.st_size);
+	void* Address = mmap(nullptr, Bytes, PROT_READ, MAP_SHARED, Descriptor, 0);
+	Base = (Address == MAP_FAILED) ? nullptr : static_cast<unsigned char*>(Address);
+	if (Base != nullptr)
+	{
+		madvise(Base, Bytes, MADV_SEQUENTIAL);		// Pricing reads every column front to back
+	}
+#endif
+	if (Base == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+bool MappedFile::Create(const string& Path, size_t Size)		// Create or truncate a file of Size bytes and map it for writing
+{
+	Close();
+#ifdef _WIN32
+	FileHandle = CreateFileA(Path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (FileHandle == INVALID_HANDLE_VALUE)
+	{
+		Close();
+		return false;
+	}
+	unsigned long long Length = Size;
+	MappingHandle = CreateFileMappingA(FileHandle, nullptr, PAGE_READWRITE, static_cast<DWORD>(Length >> 32), static_cast<DWORD>(Length & 0xFFFFFFFFull), nullptr);		// Extends the file to Size
+	Base = (MappingHandle == nullptr) ? nullptr : static_cast<unsigned char*>(MapViewOfFile(MappingHandle, FILE_MAP_WRITE, 0, 0, 0));
+#else
+	Descriptor = open(Path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if ((Descriptor < 0) || (ftruncate(Descriptor, static_cast<off_t>(Size)) != 0))
+	{
+		Close();
+		return false;
+	}
+	void* Address = mmap(nullptr, Size, PROT_READ | PROT_WRITE, MAP_SHARED, Descriptor, 0);
+	Base = (Address == MAP_FAILED) ? nullptr : static_cast<unsigned char*>(Address);
+#endif
+	Bytes = Size;
+	if (Base == nullptr)
+	{
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void MappedFile::Close()		// Unmap and close the file
+{
+#ifdef _WIN32
+	if (Base != nullptr)
+	{
+		UnmapViewOfFile(Base);
+	}
+	if (MappingHandle != nullptr)
+	{
+		CloseHandle(MappingHandle);
+	}
+	if (FileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(FileHandle);
+	}
+	MappingHandle = nullptr;
+	FileHandle = INVALID_HANDLE_VALUE;
+#else
+	if (Base != nullptr)
+	{
+		munmap(Base, Bytes);
+	}
+	if (Descriptor >= 0)
+	{
+		close(Descriptor);
+	}
+	Descriptor = -1;
+#endif
+	Base = nullptr;
+	Bytes = 0;
+}
+
+const unsigned char* MappedFile::Data() const		// First byte of the mapping
+{
+	return Base;
+}
+
+unsigned char* MappedFile::Data()					// First byte of the mapping
+{
+	return Base;
+}
+
+size_t MappedFile::Size() const						// Length of the mapping
+{
+	return Bytes;
+}
+
+// OPTIONBOOK MEMBER FUNCTIONS
+// Constructors
+OptionBook::OptionBook() : Kind(Euro_Book), Rows(0), Types(nullptr) {}		// Default constructor
+
+// Destructors
+OptionBook::~OptionBook() {}		// Default destructor
+
+// Functionality
+bool OptionBook::Open(const string& Path, BookKind Expected)		// Map a book and check its header and layout
+{
+	Close();
+	if (!File.OpenRead(Path))
+	{
+		cerr << "ERROR: Could not map " << Path << endl;
+		return false;
+	}
+
+	// Every offset and size is checked against the mapping before a column pointer is handed out
+	const unsigned char* Base = File.Data();
+	size_t Bytes = File.Size();
+	BookHeader Header;
+	bool Valid = (Bytes >= sizeof(BookHeader));
+	if (Valid)
+	{
+		memcpy(&Header, Base, sizeof(BookHeader));
+		Valid = (memcmp(Header.Magic, BookMagic, sizeof(BookMagic)) == 0) && (Header.FileBytes == Bytes);
+	}
+	if (!Valid)
+	{
+		cerr << "ERROR: " << Path << " is not an option book or is truncated" << endl;
+		Close();
+		return false;
+	}
+	if ((Header.Version != BookVersion) || (Header.ByteOrder != BookByteOrder))
+	{
+		cerr << "ERROR: " << Path << " has format version " << Header.Version << " or a byte order this program cannot read" << endl;
+		Close();
+		return false;
+	}
+	if (Header.Kind != static_cast<uint32_t>(Expected))
+	{
+		cerr << "ERROR: " << Path << " holds a different kind of book than expected" << endl;
+		Close();
+		return false;
+	}
+
+	size_t ColumnBytes = static_cast<size_t>(Header.Rows) * sizeof(double);
+	Valid = (Header.Rows <= Bytes / sizeof(double)) && (Header.Columns <= (Bytes - sizeof(BookHeader)) / sizeof(BookColumn));
+	for (size_t c = 0; Valid && (c < Header.Columns); c++)
+	{
+		BookColumn Entry;
+		memcpy(&Entry, Base + sizeof(BookHeader) + (c * sizeof(BookColumn)), sizeof(BookColumn));
+		Valid = (Entry.Offset % BookAlignment == 0) && (Entry.Offset <= Bytes) && (ColumnBytes <= Bytes - Entry.Offset);
+		Names.push_back(string(Entry.Name, strnlen(Entry.Name, sizeof(Entry.Name))));
+		Columns.push_back(reinterpret_cast<const double*>(Base + Entry.Offset));
+	}
+	if (Valid && (Header.TypeOffset != 0))
+	{
+		size_t TypeBytes = TypeWords(static_cast<size_t>(Header.Rows)) * sizeof(uint64_t);
+		Valid = (Header.TypeOffset % BookAlignment == 0) && (Header.TypeOffset <= Bytes) && (TypeBytes <= Bytes - Header.TypeOffset);
+		Types = reinterpret_cast<const uint64_t*>(Base + Header.TypeOffset);
+	}
+	if (!Valid)
+	{
+		cerr << "ERROR: " << Path << " has a column outside the file" << endl;
+		Close();
+		return false;
+	}
+
+	Kind = Expected;
+	Rows = static_cast<size_t>(Header.Rows);
+	return true;
+}
+
+void OptionBook::Close()		// Release the mapping
+{
+	File.Close();
+	Rows = 0;
+	Names.clear();
+	Columns.clear();
+	Types = nullptr;
+}
+
+BookKind OptionBook::GetKind() const		// What the columns hold
+{
+	return Kind;
+}
+
+size_t OptionBook::Size() const				// Records in every column
+{
+	return Rows;
+}
+
+size_t OptionBook::ColumnCount() const		// Number of columns
+{
+	return Columns.size();
+}
+
+const string& OptionBook::ColumnName(size_t c) const		// Name of column c
+{
+	return Names[c];
+}
+
+const double* OptionBook::Column(size_t c) const			// Values of column c
+{
+	return Columns[c];
+}
+
+const double* OptionBook::Column(const string& Name) const	// Values of the column called Name
+{
+	for (size_t c = 0; c < Names.size(); c++)
+	{
+		if (Names[c] == Name)
+		{
+			return Columns[c];
+		}
+	}
+
+	return nullptr;
+}
+
+bool OptionBook::HasTypes() const					// The book carries an option type bitmap
+{
+	return Types != nullptr;
+}
+
+const uint64_t* OptionBook::TypeBits() const		// The option type bitmap
+{
+	return Types;
+}
+
+OptionType OptionBook::Type(size_t i) const			// Option type of row i
+{
+	if (Types == nullptr)
+	{
+		return Call;
+	}
+
+	return ((Types[i / 64] >> (i % 64)) & 1) ? Call : Put;
+}
+
+// OPTIONBOOKWRITER MEMBER FUNCTIONS
+// Constructors
+OptionBookWriter::OptionBookWriter() : Rows(0), Types(nullptr) {}		// Default constructor
+
+// Destructors
+OptionBookWriter::~OptionBookWriter()		// Destructor that closes the book
+{
+	Close();
+}
+
+// Functionality
+bool OptionBookWriter::Create(const string& Path, BookKind Kind, size_t newRows, const vector<string>& Names, bool WithTypes)	// Lay out a book of newRows records
+{
+	Close();
+
+	// Lay out the header, the column table, the columns and the bitmap, each section on a 64 byte boundary
+	BookHeader Header;
+	memset(&Header, 0, sizeof(Header));
+	memcpy(Header.Magic, BookMagic, sizeof(BookMagic));
+	Header.Version = BookVersion;
+	Header.ByteOrder = BookByteOrder;
+	Header.Kind = static_cast<uint32_t>(Kind);
+	Header.Columns = static_cast<uint32_t>(Names.size());
+	Header.Rows = newRows;
+
+	vector<BookColumn> Table(Names.size());
+	size_t Offset = AlignUp(sizeof(BookHeader) + (Names.size() * sizeof(BookColumn)));
+	for (size_t c = 0; c < Names.size(); c++)
+	{
+		memset(&Table[c], 0, sizeof(BookColumn));
+		memcpy(Table[c].Name, Names[c].data(), (Names[c].size() < sizeof(Table[c].Name)) ? Names[c].size() : sizeof(Table[c].Name) - 1);
+		Table[c].Offset = Offset;
+		Offset = AlignUp(Offset + (newRows * sizeof(double)));
+	}
+	if (WithTypes)
+	{
+		Header.TypeOffset = Offset;
+		Offset = AlignUp(Offset + (TypeWords(newRows) * sizeof(uint64_t)));
+	}
+	Header.FileBytes = Offset;
+
+	if (!File.Create(Path, Offset))
+	{
+		cerr << "ERROR: Could not create " << Path << endl;
+		return false;
+	}
+
+	// A new file reads as zeros, so only the header and the table are written here
+	unsigned char* Base = File.Data();
+	memcpy(Base, &Header, sizeof(Header));
+	if (!Table.empty())
+	{
+		memcpy(Base + sizeof(BookHeader), Table.data(), Table.size() * sizeof(BookColumn));
+	}
+	Rows = newRows;
+	for (size_t c = 0; c < Table.size(); c++)
+	{
+		Columns.push_back(reinterpret_cast<double*>(Base + Table[c].Offset));
+	}
+	Types = WithTypes ? reinterpret_cast<uint64_t*>(Base + Header.TypeOffset) : nullptr;
+
+	return true;
+}
+
+bool OptionBookWriter::Close()		// Unmap the file
+{
+	bool WasOpen = (File.Data() != nullptr);
+	File.Close();
+	Rows = 0;
+	Columns.clear();
+	Types = nullptr;
+
+	return WasOpen;
+}
+
+size_t OptionBookWriter::Size() const		// Records in every column
+{
+	return Rows;
+}
+
+double* OptionBookWriter::Column(size_t c)	// Values of column c
+{
+	return Columns[c];
+}
+
+uint64_t* OptionBookWriter::TypeBits()		// The option type bitmap
+{
+	return Types;
+}
+
+void OptionBookWriter::SetType(size_t i, OptionType Type)		// Set the option type of row i
+{
+	if (Types == nullptr)
+	{
+		return;
+	}
+
+	uint64_t Bit = uint64_t(1) << (i % 64);
+	Types[i / 64] = (Type == Call) ? (Types[i / 64] | Bit) : (Types[i / 64] & ~Bit);
+}
+
+// GLOBAL OPTION BOOK FUNCTIONS
+struct SpillColumns		// One temporary file per column holding a stream until its row count is known, the files are deleted when closed
+{
+	vector<FILE*> Files;
+
+	SpillColumns(size_t Count) : Files(Count, nullptr)
+	{
+		for (size_t c = 0; c < Count; c++)
+		{
+			Files[c] = tmpfile();
+		}
+	}
+
+	~SpillColumns()
+	{
+		for (size_t c = 0; c < Files.size(); c++)
+		{
+			if (Files[c] != nullptr)
+			{
+				fclose(Files[c]);
+			}
+		}
+	}
+
+	bool Opened() const		// Every temporary file could be created
+	{
+		for (size_t c = 0; c < Files.size(); c++)
+		{
+			if (Files[c] == nullptr)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+bool StreamToBook(FILE* In, StreamFormat Format, BookKind Kind, const vector<string>& Names, const string& Path, StreamSummary& Summary)	// Convert a record stream into a book
+{
+	// The row count has to be known before the book is laid out, so each chunk is appended to a temporary file per column
+	// and only one chunk of the stream is ever held in memory
+	const size_t ChunkRows = 65536;
+	size_t ColumnCount = Names.size();
+	RecordReader Reader(In, Format, ColumnCount);
+	SpillColumns Spill(ColumnCount);
+	vector<vector<double>> Chunk(ColumnCount, vector<double>(ChunkRows));
+	vector<double*> Columns(ColumnCount);
+	for (size_t c = 0; c < ColumnCount; c++)
+	{
+		Columns[c] = Chunk[c].data();
+	}
+
+	bool SpillFailed = !Spill.Opened();
+	size_t Rows = 0;
+	while (!SpillFailed)
+	{
+		size_t n = Reader.Read(ChunkRows, Columns.data());
+		if (n == 0)
+		{
+			break;
+		}
+		for (size_t c = 0; c < ColumnCount; c++)
+		{
+			SpillFailed = SpillFailed || (fwrite(Columns[c], sizeof(double), n, Spill.Files[c]) != n);
+		}
+		Rows += n;
+	}
+
+	Summary.Records = Rows;
+	Summary.BadRecords = Reader.BadRecordCount();
+	Summary.FirstBadLine = Reader.FirstBadRecordLine();
+	Summary.Failed = Reader.Failed() || SpillFailed;
+	if (SpillFailed)
+	{
+		cerr << "ERROR: Could not write the temporary column files for " << Path << endl;
+	}
+	if (Summary.Failed)
+	{
+		return false;
+	}
+
+	// Copy every spilled column straight into its place in the mapped book
+	OptionBookWriter Writer;
+	if (!Writer.Create(Path, Kind, Rows, Names, false))
+	{
+		Summary.Failed = true;
+		return false;
+	}
+	for (size_t c = 0; c < ColumnCount; c++)
+	{
+		rewind(Spill.Files[c]);
+		if ((Rows > 0) && (fread(Writer.Column(c), sizeof(double), Rows, Spill.Files[c]) != Rows))
+		{
+			cerr << "ERROR: Could not read back the temporary column files for " << Path << endl;
+			Summary.Failed = true;
+			Writer.Close();
+			return false;
+		}
+	}
+
+	return Writer.Close();
+}
@@ -0,0 +1,155 @@
+/*	Daniel McNulty II
+*
+*	OptionBook.h
+*
+*	Versioned columnar binary format for books of option parameters and for the results priced from
+*	them. A book file is laid out as
+*
+*		BookHeader							64 bytes at offset 0
+*		BookColumn[Columns]					32 bytes each, name and byte offset of every column
+*		column 0 ... column Columns - 1		Rows native doubles each, every column starts on a 64 byte boundary
+*		option type bitmap (optional)		ceil(Rows / 64) 64 bit words, bit i set when row i is a call
+*
+*	The file is memory mapped, so the columns are read straight from the page cache and results are
+*	written straight into the mapped output file with no parsing and no copies. Files are written in
+*	the byte order of the machine that creates them; a file with the other byte order is rejected.
+*/
+
+#ifndef OptionBook_H
+#define OptionBook_H
+
+#include "Option.h"
+#include "RecordStream.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+using namespace std;
+
+const uint32_t BookVersion = 1;			// Format version written by this code, the only one it reads
+const size_t BookAlignment = 64;		// Alignment of every column and of the bitmap within the file
+
+enum BookKind			// What the columns of a book hold
+{
+	Euro_Book = 1,			// European option parameters (T, K, sig, r, U, b)
+	Perpetual_Book = 2,		// Perpetual American option parameters (K, sig, r, U, b)
+	Result_Book = 3			// Pricer output, one (call, put) column pair per output
+};
+
+struct BookHeader		// Fixed size header at the start of every book file
+{
+	char Magic[8];			// "OPTBOOK" and a terminating zero
+	uint32_t Version;		// BookVersion of the writer
+	uint32_t ByteOrder;		// 0x01020304 as written by the creating machine
+	uint32_t Kind;			// BookKind of the columns
+	uint32_t Columns;		// Number of BookColumn entries after the header
+	uint64_t Rows;			// Records in every column
+	uint64_t TypeOffset;	// Byte offset of the option type bitmap, 0 if the book has none
+	uint64_t FileBytes;		// Size of the whole file, catches truncated copies
+	uint8_t Reserved[16];	// Zero
+};
+
+struct BookColumn		// Entry of the column table
+{
+	char Name[16];			// Column name, zero padded
+	uint64_t Offset;		// Byte offset of the first value
+	uint64_t Reserved;		// Zero
+};
+
+class MappedFile		// Whole file memory mapping, read only or read and write
+{
+private:
+	unsigned char* Base;	// First byte of the mapping, nullptr when nothing is mapped
+	size_t Bytes;			// Length of the mapping
+#ifdef _WIN32
+	void* FileHandle;		// HANDLE of the open file
+	void* MappingHandle;	// HANDLE of the file mapping object
+#else
+	int Descriptor;			// Descriptor of the open file
+#endif
+
+public:
+	// Constructors
+	MappedFile();										// Default constructor, maps nothing
+	// Destructors
+	virtual ~MappedFile();								// Destructor that unmaps the file
+
+	// Functionality
+	bool OpenRead(const string& Path);					// Map an existing file read only
+	bool Create(const string& Path, size_t Size);		// Create or truncate a file of Size bytes and map it for writing
+	void Close();										// Unmap and close the file
+	const unsigned char* Data() const;					// First byte of the mapping
+	unsigned char* Data();								// First byte of the mapping, writable when created with Create()
+	size_t Size() const;								// Length of the mapping
+
+private:
+	MappedFile(const MappedFile& source);					// Not copyable
+	MappedFile& operator = (const MappedFile& source);		// Not assignable
+};
+
+class OptionBook		// Read only view of a mapped book file, the columns point into the mapping
+{
+private:
+	MappedFile File;				// Mapping of the whole file
+	BookKind Kind;					// What the columns hold
+	size_t Rows;					// Records in every column
+	vector<string> Names;			// Column names
+	vector<const double*> Columns;	// Column start addresses within the mapping
+	const uint64_t* Types;			// Option type bitmap within the mapping, nullptr if the book has none
+
+public:
+	// Constructors
+	OptionBook();										// Default constructor, holds no book
+	// Destructors
+	virtual ~OptionBook();								// Default destructor
+
+	// Functionality
+	bool Open(const string& Path, BookKind Expected);	// Map a book and check its header and layout, false with a message on cerr if it is not a valid book of kind Expected
+	void Close();										// Release the mapping
+	BookKind GetKind() const;							// What the columns hold
+	size_t Size() const;								// Records in every column
+	size_t ColumnCount() const;							// Number of columns
+	const string& ColumnName(size_t c) const;			// Name of column c
+	const double* Column(size_t c) const;				// Values of column c
+	const double* Column(const string& Name) const;		// Values of the column called Name, nullptr if there is none
+	bool HasTypes() const;								// The book carries an option type bitmap
+	const uint64_t* TypeBits() const;					// The option type bitmap, nullptr if there is none
+	OptionType Type(size_t i) const;					// Option type of row i, Call if the book has no bitmap
+
+private:
+	OptionBook(const OptionBook& source);					// Not copyable
+	OptionBook& operator = (const OptionBook& source);		// Not assignable
+};
+
+class OptionBookWriter		// Creates a book file at its final size and hands out its mapped columns for filling in place
+{
+private:
+	MappedFile File;				// Mapping of the whole file
+	size_t Rows;					// Records in every column
+	vector<double*> Columns;		// Column start addresses within the mapping
+	uint64_t* Types;				// Option type bitmap within the mapping, nullptr if the book has none
+
+public:
+	// Constructors
+	OptionBookWriter();					// Default constructor, holds no book
+	// Destructors
+	virtual ~OptionBookWriter();		// Destructor that closes the book
+
+	// Functionality
+	bool Create(const string& Path, BookKind Kind, size_t Rows, const vector<string>& Names, bool WithTypes);	// Lay out a book of Rows records, false with a message on cerr if the file cannot be created
+	bool Close();														// Unmap the file, it is complete and can be opened by other processes
+	size_t Size() const;												// Records in every column
+	double* Column(size_t c);											// Values of column c, zero until written
+	uint64_t* TypeBits();												// The option type bitmap, nullptr if the book has none
+	void SetType(size_t i, OptionType Type);							// Set the option type of row i, ignored if the book has no bitmap
+
+private:
+	OptionBookWriter(const OptionBookWriter& source);					// Not copyable
+	OptionBookWriter& operator = (const OptionBookWriter& source);		// Not assignable
+};
+
+// Conversion of a record stream into a book, the records wait in one temporary file per column until the row count is known, so memory use does not grow with the stream
+bool StreamToBook(FILE* In, StreamFormat Format, BookKind Kind, const vector<string>& Names, const string& Path, StreamSummary& Summary);
+
+#endif
@@ -0,0 +1,340 @@
+/*	Daniel McNulty II
+*
+*	OptionPDE.cpp
+*/
+
+#include "OptionPDE.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+const double PSOROmega = 1.2;				// Over-relaxation of projected SOR
+const double PDETolerance = 1e-10;			// Largest change per unit of value at which an iteration has converged
+const int PDEMaxIterations = 1000;			// Iteration cap of projected SOR, the penalty iteration settles in a handful
+const double PenaltyWeight = 1e8;			// Diagonal penalty on the nodes below the payoff, about 1 / PDETolerance^(4/5)
+
+struct PDEOperator		// Rows of the discrete operator L, (LV)_i = Sub[i] V[i - 1] + Diag[i] V[i] + Super[i] V[i + 1]
+{
+	vector<double> Sub;
+	vector<double> Diag;
+	vector<double> Super;
+};
+
+struct PDESystem		// Rows of I - theta dt L and their LU factors, shared by every step of the same size
+{
+	double Explicit;			// (1 - theta) dt, weight of L on the known values
+	vector<double> Sub;			// Sub diagonal, -theta dt L
+	vector<double> Diag;		// Diagonal, 1 - theta dt L
+	vector<double> Super;		// Super diagonal, -theta dt L
+	vector<double> Lower;		// Multipliers of the forward substitution
+	vector<double> InvPivot;	// Reciprocal pivots of the back substitution
+};
+
+static void BuildOperator(PDEOperator& L, int N, double sig, double r, double b)		// Central differences on S_i = i dS, dS cancels
+{
+	L.Sub.assign(N + 1, 0.0);
+	L.Diag.assign(N + 1, 0.0);
+	L.Super.assign(N + 1, 0.0);
+
+	L.Diag[0] = -r;							// S = 0, dV/dt = rV
+	for (int i = 1; i < N; i++)
+	{
+		double Diffusion = 0.5 * sig * sig * i * i;
+		double Drift = 0.5 * b * i;
+		L.Sub[i] = Diffusion - Drift;
+		L.Diag[i] = -(2.0 * Diffusion) - r;
+		L.Super[i] = Diffusion + Drift;
+	}
+	L.Sub[N] = -b * N;						// Top edge, V_SS = 0 with a one sided V_S
+	L.Diag[N] = (b * N) - r;
+}
+
+static void Factor(PDESystem& Sys, const PDEOperator& L, double Theta, double dt)		// Fill and factor I - theta dt L
+{
+	size_t n = L.Diag.size();
+	Sys.Explicit = (1.0 - Theta) * dt;
+	Sys.Sub.resize(n);
+	Sys.Diag.resize(n);
+	Sys.Super.resize(n);
+	Sys.Lower.resize(n);
+	Sys.InvPivot.resize(n);
+	for (size_t i = 0; i < n; i++)
+	{
+		Sys.Sub[i] = -Theta * dt * L.Sub[i];
+		Sys.Diag[i] = 1.0 - (Theta * dt * L.Diag[i]);
+		Sys.Super[i] = -Theta * dt * L.Super[i];
+	}
+
+	double Pivot = Sys.Diag[0];
+	Sys.InvPivot[0] = 1.0 / Pivot;
+	Sys.Lower[0] = 0.0;
+	for (size_t i = 1; i < n; i++)
+	{
+		Sys.Lower[i] = Sys.Sub[i] * Sys.InvPivot[i - 1];
+		Pivot = Sys.Diag[i] - (Sys.Lower[i] * Sys.Super[i - 1]);
+		Sys.InvPivot[i] = 1.0 / Pivot;
+	}
+}
+
+static void ExplicitPart(const PDESystem& Sys, const PDEOperator& L, const vector<double>& V, vector<double>& Rhs)	// Rhs = V + (1 - theta) dt L V
+{
+	size_t n = V.size();
+	double w = Sys.Explicit;
+	Rhs[0] = V[0] + (w * ((L.Diag[0] * V[0]) + (L.Super[0] * V[1])));
+	for (size_t i = 1; i + 1 < n; i++)
+	{
+		Rhs[i] = V[i] + (w * ((L.Sub[i] * V[i - 1]) + (L.Diag[i] * V[i]) + (L.Super[i] * V[i + 1])));
+	}
+	Rhs[n - 1] = V[n - 1] + (w * ((L.Sub[n - 1] * V[n - 2]) + (L.Diag[n - 1] * V[n - 1])));
+}
+
+static void FactoredSolve(const PDESystem& Sys, const vector<double>& Rhs, vector<double>& V)		// Thomas algorithm on the stored factors
+{
+	size_t n = Rhs.size();
+	V[0] = Rhs[0];
+	for (size_t i = 1; i < n; i++)
+	{
+		V[i] = Rhs[i] - (Sys.Lower[i] * V[i - 1]);
+	}
+	V[n - 1] *= Sys.InvPivot[n - 1];
+	for (size_t i = n - 1; i-- > 0;)
+	{
+		V[i] = (V[i] - (Sys.Super[i] * V[i + 1])) * Sys.InvPivot[i];
+	}
+}
+
+static void PSORSolve(const PDESystem& Sys, const vector<double>& Rhs, const vector<double>& Payoff, vector<double>& V)	// Projected SOR, V holds the previous step on entry
+{
+	size_t n = Rhs.size();
+	for (size_t i = 0; i < n; i++)
+	{
+		V[i] = fmax(V[i], Payoff[i]);
+	}
+
+	for (int Iteration = 0; Iteration < PDEMaxIterations; Iteration++)
+	{
+		double Change = 0.0, Size = 1.0;
+		for (size_t i = 0; i < n; i++)
+		{
+			double Neighbours = ((i > 0) ? (Sys.Sub[i] * V[i - 1]) : 0.0) + ((i + 1 < n) ? (Sys.Super[i] * V[i + 1]) : 0.0);
+			double GaussSeidel = (Rhs[i] - Neighbours) / Sys.Diag[i];
+			double Updated = fmax(Payoff[i], V[i] + (PSOROmega * (GaussSeidel - V[i])));
+			Change = fmax(Change, fabs(Updated - V[i]));
+			Size = fmax(Size, fabs(Updated));
+			V[i] = Updated;
+		}
+		if (Change <= PDETolerance * Size)
+		{
+			return;
+		}
+	}
+}
+
+static void PenaltySolve(const PDESystem& Sys, const vector<double>& Rhs, const vector<double>& Payoff, vector<double>& V, vector<double>& Pivot, vector<double>& Work)	// Penalty iteration, V holds the previous step on entry
+{
+	size_t n = Rhs.size();
+	vector<char> Penalized(n, 0);
+	for (int Iteration = 0; Iteration < PDEMaxIterations; Iteration++)
+	{
+		// Penalize the nodes the last iterate put below the payoff, then solve (I - theta dt L + P) V = Rhs + P Payoff
+		bool Settled = (Iteration > 0);
+		for (size_t i = 0; i < n; i++)
+		{
+			char Below = (V[i] < Payoff[i]) ? 1 : 0;
+			Settled = Settled && (Below == Penalized[i]);
+			Penalized[i] = Below;
+		}
+
+		double Change = 0.0, Size = 1.0;
+		Pivot[0] = Sys.Diag[0] + (Penalized[0] ? PenaltyWeight : 0.0);
+		Work[0] = Rhs[0] + (Penalized[0] ? (PenaltyWeight * Payoff[0]) : 0.0);
+		for (size_t i = 1; i < n; i++)
+		{
+			double Multiplier = Sys.Sub[i] / Pivot[i - 1];
+			Pivot[i] = Sys.Diag[i] + (Penalized[i] ? PenaltyWeight : 0.0) - (Multiplier * Sys.Super[i - 1]);
+			Work[i] = Rhs[i] + (Penalized[i] ? (PenaltyWeight * Payoff[i]) : 0.0) - (Multiplier * Work[i - 1]);
+		}
+		for (size_t i = n; i-- > 0;)
+		{
+			double Updated = (Work[i] - ((i + 1 < n) ? (Sys.Super[i] * V[i + 1]) : 0.0)) / Pivot[i];
+			Change = fmax(Change, fabs(Updated - V[i]));
+			Size = fmax(Size, fabs(Updated));
+			V[i] = Updated;
+		}
+
+		if (Settled || (Change <= PDETolerance * Size))
+		{
+			return;
+		}
+	}
+}
+
+// PDESOLUTION MEMBER FUNCTIONS
+double PDESolution::PriceAt(double U) const		// Quadratic interpolation of the three nodes nearest U
+{
+	size_t N = Price.size() - 1;
+	double Position = fmin(fmax(U / Step, 0.0), static_cast<double>(N));
+	size_t j = min(max(static_cast<size_t>(Position + 0.5), static_cast<size_t>(1)), N - 1);
+	double x = Position - j;
+	double Slope = 0.5 * (Price[j + 1] - Price[j - 1]);
+	double Curvature = Price[j + 1] - (2.0 * Price[j]) + Price[j - 1];
+	return Price[j] + (x * Slope) + (0.5 * x * x * Curvature);
+}
+
+double PDESolution::DeltaAt(double U) const		// Linear interpolation of the grid deltas
+{
+	size_t N = Delta.size() - 1;
+	double Position = fmin(fmax(U / Step, 0.0), static_cast<double>(N));
+	size_t i = min(static_cast<size_t>(Position), N - 1);
+	double w = Position - i;
+	return ((1.0 - w) * Delta[i]) + (w * Delta[i + 1]);
+}
+
+double PDESolution::GammaAt(double U) const		// Linear interpolation of the grid gammas
+{
+	size_t N = Gamma.size() - 1;
+	double Position = fmin(fmax(U / Step, 0.0), static_cast<double>(N));
+	size_t i = min(static_cast<size_t>(Position), N - 1);
+	double w = Position - i;
+	return ((1.0 - w) * Gamma[i]) + (w * Gamma[i + 1]);
+}
+
+// GLOBAL PDE FUNCTIONS
+PDESolution SolvePDE(double T, double K, double sig, double r, double b, double MaxU, OptionType Type, ExerciseStyle Style, const PDESettings& Settings)	// Price curve of one option up to at least MaxU
+{
+	PDESettings Grid = Settings;
+	if (Grid.SpotSteps < 3)
+	{
+		cout << "ERROR: The spot grid needs at least 3 intervals. Resorting to default " << Default_PDE.SpotSteps << " intervals" << endl;
+		Grid.SpotSteps = Default_PDE.SpotSteps;
+	}
+	if (Grid.TimeSteps < 1)
+	{
+		cout << "ERROR: The PDE needs at least one time step. Resorting to default " << Default_PDE.TimeSteps << " steps" << endl;
+		Grid.TimeSteps = Default_PDE.TimeSteps;
+	}
+
+	// Spot grid with the strike on a node
+	int N = Grid.SpotSteps;
+	double Edge = fmax(K, MaxU) * exp(Grid.Width * sig * sqrt(fmax(T, 0.0)));
+	int StrikeNode = max(1, static_cast<int>(floor((K * N / Edge) + 0.5)));
+	PDESolution Out;
+	Out.Step = K / StrikeNode;
+	Out.Spot.resize(N + 1);
+	Out.Price.resize(N + 1);
+	for (int i = 0; i <= N; i++)
+	{
+		Out.Spot[i] = i * Out.Step;
+		Out.Price[i] = fmax((Type == Call) ? (Out.Spot[i] - K) : (K - Out.Spot[i]), 0.0);
+	}
+	vector<double> Payoff = Out.Price;
+
+	if (T > 0.0)
+	{
+		PDEOperator L;
+		BuildOperator(L, N, sig, r, b);
+		double dt = T / Grid.TimeSteps;
+		int Rannacher = min(max(Grid.RannacherSteps, 0), Grid.TimeSteps);
+		PDESystem CrankNicolson, HalfEuler;
+		Factor(CrankNicolson, L, 0.5, dt);
+		if (Rannacher > 0)
+		{
+			Factor(HalfEuler, L, 1.0, 0.5 * dt);
+		}
+
+		vector<double> Rhs(N + 1), Pivot(N + 1), Work(N + 1);
+		vector<double>& V = Out.Price;
+		for (int Step = 0; Step < Grid.TimeSteps; Step++)
+		{
+			const PDESystem& Sys = (Step < Rannacher) ? HalfEuler : CrankNicolson;
+			for (int Part = 0; Part < ((Step < Rannacher) ? 2 : 1); Part++)
+			{
+				ExplicitPart(Sys, L, V, Rhs);
+				if (Style == European_Exercise)
+					FactoredSolve(Sys, Rhs, V);
+				else if (Grid.Constraint == Projected_SOR)
+					PSORSolve(Sys, Rhs, Payoff, V);
+				else
+					PenaltySolve(Sys, Rhs, Payoff, V, Pivot, Work);
+			}
+		}
+	}
+
+	// Sensitivities from the grid, one sided at the edges
+	Out.Delta.resize(N + 1);
+	Out.Gamma.resize(N + 1);
+	double Step = Out.Step;
+	for (int i = 1; i < N; i++)
+	{
+		Out.Delta[i] = (Out.Price[i + 1] - Out.Price[i - 1]) / (2.0 * Step);
+		Out.Gamma[i] = (Out.Price[i + 1] - (2.0 * Out.Price[i]) + Out.Price[i - 1]) / (Step * Step);
+	}
+	Out.Delta[0] = (Out.Price[1] - Out.Price[0]) / Step;
+	Out.Delta[N] = (Out.Price[N] - Out.Price[N - 1]) / Step;
+	Out.Gamma[0] = Out.Gamma[1];
+	Out.Gamma[N] = Out.Gamma[N - 1];
+	return Out;
+}
+
+double PDEPrice(double T, double K, double sig, double r, double U, double b, OptionType Type, ExerciseStyle Style, const PDESettings& Settings)		// Price of one option at U
+{
+	return SolvePDE(T, K, sig, r, b, U, Type, Style, Settings).PriceAt(U);
+}
+
+vector<vector<double>> PDEUnderlyingPricer(double T, double K, double sig, double r, double StartU, double b, double EndU, int steps, ExerciseStyle Style, PricerOutput Out, const PDESettings& Settings)	// Rows of MatrixPricer(GenerateUnderlyingMatrix(...), Out) from one solve per option type
+{
+	if ((Out != Price) && (Out != Delta) && (Out != Gamma) && (Out != All))
+	{
+		cout << "ERROR: The PDE pricer outputs Price, Delta, Gamma, or All. Resorting to default output Price";
+		Out = Price;
+	}
+
+	vector<double> UnderRange = GenerateMeshArray(StartU, EndU, steps);
+	double MaxU = fmax(StartU, EndU);
+	PDESolution Calls = SolvePDE(T, K, sig, r, b, MaxU, Call, Style, Settings);
+	PDESolution Puts = SolvePDE(T, K, sig, r, b, MaxU, Put, Style, Settings);
+
+	vector<vector<double>> ReturnMatrix;
+	for (double U : UnderRange)
+	{
+		switch (Out)
+		{
+		case (Delta):
+			ReturnMatrix.push_back({ Calls.DeltaAt(U), Puts.DeltaAt(U) });
+			break;
+		case (Gamma):
+			ReturnMatrix.push_back({ Calls.GammaAt(U), Puts.GammaAt(U) });
+			break;
+		case (All):
+			ReturnMatrix.push_back({ Calls.PriceAt(U), Puts.PriceAt(U), Calls.DeltaAt(U), Puts.DeltaAt(U), Calls.GammaAt(U), Puts.GammaAt(U) });
+			break;
+		default:
+			ReturnMatrix.push_back({ Calls.PriceAt(U), Puts.PriceAt(U) });
+			break;
+		}
+	}
+
+	return ReturnMatrix;
+}
+
+vector<double> PDEStrikeChain(double T, const vector<double>& Strikes, double sig, double r, double U, double b, OptionType Type, ExerciseStyle Style, const PDESettings& Settings)		// Prices of one expiry's strikes from one grid struck at U
+{
+	// Prices are homogeneous of degree one in (U, K), so strike K at spot U is K / U times strike U at spot U^2 / K
+	double MinK = U;
+	for (double K : Strikes)
+	{
+		MinK = fmin(MinK, K);
+	}
+	PDESolution Curve = SolvePDE(T, U, sig, r, b, (U * U) / MinK, Type, Style, Settings);
+
+	vector<double> Prices(Strikes.size());
+	for (size_t i = 0; i < Strikes.size(); i++)
+	{
+		Prices[i] = (Strikes[i] / U) * Curve.PriceAt((U * U) / Strikes[i]);
+	}
+	return Prices;
+}
@@ -0,0 +1,73 @@
+/*	Daniel McNulty II
+*
+*	OptionPDE.h
+*
+*	Finite difference engine for the generalized Black-Scholes PDE, V_t + sig^2 S^2 V_SS / 2 + b S V_S - rV = 0.
+*	One solve steps the payoff back from expiry on a uniform spot grid from 0 to a few standard deviations
+*	above max(K, highest spot asked for), with the strike on a node, and returns the whole price curve with
+*	delta and gamma read off the grid. The S = 0 node follows dV/dt = rV and the top node has V_SS = 0, so no
+*	boundary values are imposed. Time steps are Crank-Nicolson; the first few are each replaced by two
+*	implicit Euler half steps (Rannacher start-up) to damp the oscillations CN leaves from the kink at the
+*	strike. The steps have constant coefficients, so the European solve factors its tridiagonal matrix once
+*	per step size and each step is one forward and one back substitution over contiguous arrays.
+*
+*	Early exercise is applied at every step, either by projected SOR on the Crank-Nicolson system or by
+*	the penalty iteration of Forsyth and Vetzal, which re-solves the system with a large diagonal penalty
+*	wherever the value has fallen below the payoff.
+*/
+
+#ifndef OptionPDE_H
+#define OptionPDE_H
+
+#include "EuropeanOption.h"
+#include "Option.h"
+#include <vector>
+using namespace std;
+
+enum ExerciseStyle			// When the holder may exercise
+{
+	European_Exercise,		// At expiry only
+	American_Exercise		// At any time up to expiry
+};
+
+enum ExerciseConstraint		// How early exercise is imposed on each time step
+{
+	Projected_SOR,			// Gauss-Seidel with over-relaxation, projected onto the payoff after every update
+	Penalty_Iteration		// Direct solves with a penalty term on the nodes below the payoff, until the set of those nodes settles
+};
+
+struct PDESettings			// How the grid is built and stepped
+{
+	int SpotSteps;						// Intervals of the spot grid
+	int TimeSteps;						// Time steps, the Rannacher steps included
+	int RannacherSteps;					// Leading steps taken as two implicit Euler half steps each
+	double Width;						// Upper grid edge in standard deviations sig sqrt(T) above max(K, highest spot)
+	ExerciseConstraint Constraint;		// Early exercise method of American_Exercise solves
+};
+
+const PDESettings Default_PDE = { 400, 200, 2, 5.0, Penalty_Iteration };		// A few tenths of a cent on typical listed options
+
+class PDESolution			// Values of one solve on its spot grid, Spot[i] = i * Step
+{
+public:
+	double Step;				// Spot spacing of the grid
+	vector<double> Spot;		// Grid spots, from 0 to the upper edge
+	vector<double> Price;		// Option values at the grid spots
+	vector<double> Delta;		// Central difference deltas at the grid spots
+	vector<double> Gamma;		// Central difference gammas at the grid spots
+
+	// Functionality, spots between nodes are interpolated and spots outside the grid are clamped to its edges
+	double PriceAt(double U) const;		// Quadratic interpolation of the three nodes nearest U
+	double DeltaAt(double U) const;		// Linear interpolation of the grid deltas
+	double GammaAt(double U) const;		// Linear interpolation of the grid gammas
+};
+
+// Solvers
+PDESolution SolvePDE(double T, double K, double sig, double r, double b, double MaxU, OptionType Type, ExerciseStyle Style, const PDESettings& Settings);	// Price curve of one option up to at least MaxU
+double PDEPrice(double T, double K, double sig, double r, double U, double b, OptionType Type, ExerciseStyle Style, const PDESettings& Settings);			// Price of one option at U
+
+// Grid pricers from a single solve per option type
+vector<vector<double>> PDEUnderlyingPricer(double T, double K, double sig, double r, double StartU, double b, double EndU, int steps, ExerciseStyle Style, PricerOutput Out, const PDESettings& Settings);	// Same rows as MatrixPricer(GenerateUnderlyingMatrix(...), Out) for Price, Delta, Gamma and All
+vector<double> PDEStrikeChain(double T, const vector<double>& Strikes, double sig, double r, double U, double b, OptionType Type, ExerciseStyle Style, const PDESettings& Settings);		// Prices of one expiry's strikes, V(U; K) = (K / U) V(U^2 / K; U) on one grid struck at U
+
+#endif
@@ -0,0 +1,236 @@
+/*	Daniel McNulty II
+*
+*	OptionPortfolio.cpp
+*/
+
+#include "OptionPortfolio.h"
+#include "PerpetualAmericanKernels.h"
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+static const PricerOutput PortfolioOrder[] = { Price, Delta, Gamma, Vega, Theta, Rho, CarryRho, Vanna, Volga, Charm };		// Single outputs in enum order
+
+static void ScatterRows(const double* Values, const vector<size_t>& Positions, vector<double>& Column)		// Copy partition row j to entry Positions[j] of Column
+{
+	for (size_t j = 0; j < Positions.size(); j++)
+	{
+		Column[Positions[j]] = Values[j];
+	}
+}
+
+template <OptionType Type>
+static double PerpetualOutput(PricerOutput Output, double K, double sig, double r, double U, double b)		// One supported output of one perpetual American option
+{
+	switch (Output)
+	{
+	case (Delta):
+		return PerpKernelDelta<Type>(K, sig, r, U, b);
+	case (Gamma):
+		return PerpKernelGamma<Type>(K, sig, r, U, b);
+	case (Vega):
+		return PerpKernelVega<Type>(K, sig, r, U, b);
+	case (Rho):
+		return PerpKernelRho<Type>(K, sig, r, U, b);
+	case (CarryRho):
+		return PerpKernelCarryRho<Type>(K, sig, r, U, b);
+	default:
+		return PerpKernelPrice<Type>(K, sig, r, U, b);
+	}
+}
+
+template <OptionType Type>
+static void ComputePerpetualRows(const PerpAmerOptColumns& Rows, const vector<size_t>& Positions, PricerOutput Output, double* Values, const ExecutionPolicy& Policy)	// One output of one perpetual American partition into the position ordered column
+{
+	const double* K = Rows.K.data(); const double* sig = Rows.sig.data(); const double* r = Rows.r.data();
+	const double* U = Rows.U.data(); const double* b = Rows.b.data();
+	const size_t* Position = Positions.data();
+
+	ParallelFor(Rows.Size(), [&](size_t First, size_t Last)
+	{
+		for (size_t j = First; j < Last; j++)
+		{
+			Values[Position[j]] = PerpetualOutput<Type>(Output, K[j], sig[j], r[j], U[j], b[j]);
+		}
+	}, Policy);
+}
+
+// PERPAMEROPTCOLUMNS MEMBER FUNCTIONS
+// Constructors
+PerpAmerOptColumns::PerpAmerOptColumns() {}			// Default constructor, creates empty columns
+
+// Destructors
+PerpAmerOptColumns::~PerpAmerOptColumns() {}		// Default destructor
+
+// Functionality
+size_t PerpAmerOptColumns::Size() const				// Number of rows
+{
+	return K.size();
+}
+
+void PerpAmerOptColumns::AddRow(double newK, double newSig, double newR, double newU, double newB)	// Append one row of option parameters
+{
+	K.push_back(newK);
+	sig.push_back(newSig);
+	r.push_back(newR);
+	U.push_back(newU);
+	b.push_back(newB);
+}
+
+// PORTFOLIORESULT MEMBER FUNCTIONS
+// Constructors
+PortfolioResult::PortfolioResult() : Outputs(Price) {}		// Default constructor, every column empty
+
+// Destructors
+PortfolioResult::~PortfolioResult() {}						// Default destructor
+
+// Functionality
+vector<double>& PortfolioResult::Column(PricerOutput Output)		// Column of a single output
+{
+	return const_cast<vector<double>&>(static_cast<const PortfolioResult&>(*this).Column(Output));
+}
+
+const vector<double>& PortfolioResult::Column(PricerOutput Output) const	// Column of a single output
+{
+	switch (Output)
+	{
+	case (Price):
+		return Prices;
+	case (Delta):
+		return Deltas;
+	case (Gamma):
+		return Gammas;
+	case (Vega):
+		return Vegas;
+	case (Theta):
+		return Thetas;
+	case (Rho):
+		return Rhos;
+	case (CarryRho):
+		return CarryRhos;
+	case (Vanna):
+		return Vannas;
+	case (Volga):
+		return Volgas;
+	case (Charm):
+		return Charms;
+	default:
+		cout << "ERROR: Column() needs a single output (Price, Delta, Gamma, Vega, Theta, Rho, CarryRho, Vanna, Volga, or Charm). Resorting to default output Price";
+		return Prices;
+	}
+}
+
+// OPTIONPORTFOLIO MEMBER FUNCTIONS
+// Constructors
+OptionPortfolio::OptionPortfolio() {}			// Default constructor, creates an empty portfolio
+
+// Destructors
+OptionPortfolio::~OptionPortfolio() {}			// Default destructor
+
+// Functionality
+size_t OptionPortfolio::Add(const EuropeanOption& Option)		// Add a European position
+{
+	PortfolioPartition Partition = (Option.optionType == Call) ? European_Call_Partition : European_Put_Partition;
+	EuropeanRows[Option.optionType].AddRow(Option.T, Option.K, Option.sig, Option.r, Option.U, Option.b);
+	PartitionPositions[Partition].push_back(Locations.size());
+	Locations.push_back({ Partition, PartitionPositions[Partition].size() - 1 });
+	return Locations.size() - 1;
+}
+
+size_t OptionPortfolio::AddPerpetualAmerican(double K, double sig, double r, double U, double b, OptionType Type)	// Add a perpetual American position
+{
+	PortfolioPartition Partition = (Type == Call) ? Perpetual_Call_Partition : Perpetual_Put_Partition;
+	PerpetualRows[Type].AddRow(K, sig, r, U, b);
+	PartitionPositions[Partition].push_back(Locations.size());
+	Locations.push_back({ Partition, PartitionPositions[Partition].size() - 1 });
+	return Locations.size() - 1;
+}
+
+size_t OptionPortfolio::Size() const		// Number of positions
+{
+	return Locations.size();
+}
+
+size_t OptionPortfolio::PartitionSize(PortfolioPartition Partition) const		// Number of positions in one partition
+{
+	return ((Partition >= 0) && (Partition < Portfolio_Partitions)) ? PartitionPositions[Partition].size() : 0;
+}
+
+PricerOutput OptionPortfolio::SupportedOutputs(size_t Position) const		// Outputs the model of a position can produce
+{
+	if (Position >= Locations.size())
+	{
+		return static_cast<PricerOutput>(0);
+	}
+
+	PortfolioPartition Partition = Locations[Position].Partition;
+	bool European = (Partition == European_Call_Partition) || (Partition == European_Put_Partition);
+	return static_cast<PricerOutput>(European ? ModelCapabilities<EuropeanModel>::Outputs : ModelCapabilities<PerpetualAmericanModel>::Outputs);
+}
+
+void OptionPortfolio::Compute(PricerOutput Outputs, PortfolioResult& Out) const		// Compute the selected outputs of every position on the calling thread
+{
+	Compute(Outputs, Out, Serial_Execution);
+}
+
+void OptionPortfolio::Compute(PricerOutput Outputs, PortfolioResult& Out, const ExecutionPolicy& Policy) const	// Compute the selected outputs of every position on Policy's threads
+{
+	int Selected = static_cast<int>(Outputs) & All_Greeks;
+	if ((Selected == 0) || (Selected != static_cast<int>(Outputs)))
+	{
+		cout << "ERROR: No proper output (Price, Delta, Gamma, All, or a combination of outputs) was chosen. Resorting to default output Price";
+		Selected = Price;
+	}
+
+	// Selected columns start as NaN so outputs a model cannot produce stay NaN
+	Out.Outputs = static_cast<PricerOutput>(Selected);
+	for (PricerOutput Output : PortfolioOrder)
+	{
+		Out.Column(Output).assign((Selected & Output) ? Locations.size() : 0, numeric_limits<double>::quiet_NaN());
+	}
+
+	// European partitions, one batch call per partition
+	for (OptionType Type : { Put, Call })
+	{
+		const EuroOptBatch& Rows = EuropeanRows[Type];
+		const vector<size_t>& Positions = PartitionPositions[(Type == Call) ? European_Call_Partition : European_Put_Partition];
+		if (Rows.Size() == 0)
+		{
+			continue;
+		}
+
+		if ((Selected == Price) || (Selected == Delta))		// Single leg kernels for the common single output requests
+		{
+			AlignedColumn Values;
+			if (Selected == Price)
+				PriceBatch(Rows, Type, Values, Policy);
+			else
+				DeltaBatch(Rows, Type, Values, Policy);
+			ScatterRows(Values.data(), Positions, Out.Column(static_cast<PricerOutput>(Selected)));
+		}
+		else
+		{
+			EuroOptGreeksResult Greeks;
+			GreeksBatch(Rows, static_cast<PricerOutput>(Selected), Greeks, Policy);
+			for (PricerOutput Output : PortfolioOrder)
+			{
+				if (Selected & Output)
+				{
+					const EuroOptBatchResult& Pair = Greeks.Column(Output);
+					ScatterRows((Type == Call) ? Pair.Call.data() : Pair.Put.data(), Positions, Out.Column(Output));
+				}
+			}
+		}
+	}
+
+	// Perpetual American partitions, one pass per supported output
+	for (PricerOutput Output : PortfolioOrder)
+	{
+		if (ModelSupports<PerpetualAmericanModel>(Output) && (Selected & Output))
+		{
+			ComputePerpetualRows<Call>(PerpetualRows[Call], PartitionPositions[Perpetual_Call_Partition], Output, Out.Column(Output).data(), Policy);
+			ComputePerpetualRows<Put>(PerpetualRows[Put], PartitionPositions[Perpetual_Put_Partition], Output, Out.Column(Output).data(), Policy);
+		}
+	}
+}
@@ -0,0 +1,134 @@
+/*	Daniel McNulty II
+*
+*	OptionPortfolio.h
+*
+*	Mixed book of European and perpetual American options without virtual calls. Positions are stored by
+*	model and option type in four contiguous structure-of-arrays partitions, and each partition is priced
+*	by its batch kernel in one pass. Which outputs a model can produce is known at compile time through
+*	ModelCapabilities, so callers check ModelSupports() instead of catching NotImplementedException;
+*	outputs a position's model does not support come back as NaN.
+*
+*	The perpetual American closed form comes from PerpetualAmericanKernels.h, kept identical to the copy in
+*	the Perpetual_American_Options project.
+*/
+
+#ifndef OptionPortfolio_H
+#define OptionPortfolio_H
+
+#include "EuropeanOption.h"
+#include "EuropeanOptionBatch.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <vector>
+using namespace std;
+
+// Model tags
+struct EuropeanModel {};				// Generalized Black-Scholes European options
+struct PerpetualAmericanModel {};		// Perpetual American options
+
+template <class Model>
+struct ModelCapabilities;				// Outputs a model can produce, one specialization per model tag
+
+template <>
+struct ModelCapabilities<EuropeanModel>
+{
+	static constexpr int Outputs = All_Greeks;		// Price and every sensitivity
+};
+
+template <>
+struct ModelCapabilities<PerpetualAmericanModel>
+{
+	static constexpr int Outputs = Price | Delta | Gamma | Vega | Rho | CarryRho;	// Closed form price and sensitivities, no time dependence to differentiate
+};
+
+template <class Model>
+constexpr bool ModelSupports(PricerOutput Outputs)		// True when Model can produce every output in Outputs
+{
+	return (ModelCapabilities<Model>::Outputs & static_cast<int>(Outputs)) == static_cast<int>(Outputs);
+}
+
+enum PortfolioPartition		// Contiguous partition a position is stored in
+{
+	European_Call_Partition,
+	European_Put_Partition,
+	Perpetual_Call_Partition,
+	Perpetual_Put_Partition,
+	Portfolio_Partitions		// Number of partitions
+};
+
+class PerpAmerOptColumns		// Structure-of-arrays perpetual American option parameters
+{
+public:
+	AlignedColumn K;		// Strike prices
+	AlignedColumn sig;		// Volatilities
+	AlignedColumn r;		// Risk-free interest rates
+	AlignedColumn U;		// Current prices of the underlying securities
+	AlignedColumn b;		// Costs of carry
+
+	// Constructors
+	PerpAmerOptColumns();							// Default constructor, creates empty columns
+	// Destructors
+	virtual ~PerpAmerOptColumns();					// Default destructor
+
+	// Functionality
+	size_t Size() const;							// Number of rows
+	void AddRow(double newK, double newSig, double newR, double newU, double newB);		// Append one row of option parameters
+};
+
+class PortfolioResult		// Outputs of OptionPortfolio::Compute(), entry i of a column belongs to position i
+{
+public:
+	PricerOutput Outputs;		// Outputs that were computed, the other columns are empty
+	vector<double> Prices;		// Option values
+	vector<double> Deltas;		// dV/dU
+	vector<double> Gammas;		// d2V/dU2
+	vector<double> Vegas;		// dV/dsig
+	vector<double> Thetas;		// -dV/dT
+	vector<double> Rhos;		// dV/dr with r - b held fixed
+	vector<double> CarryRhos;	// dV/db
+	vector<double> Vannas;		// d2V/dUdsig
+	vector<double> Volgas;		// d2V/dsig2
+	vector<double> Charms;		// -dDelta/dT
+
+	// Constructors
+	PortfolioResult();								// Default constructor, every column empty
+	// Destructors
+	virtual ~PortfolioResult();						// Default destructor
+
+	// Functionality
+	vector<double>& Column(PricerOutput Output);				// Column of a single output
+	const vector<double>& Column(PricerOutput Output) const;	// Column of a single output
+};
+
+class OptionPortfolio		// Devirtualized mixed book, one partition per model and option type
+{
+private:
+	struct PositionLocation		// Where a position is stored
+	{
+		PortfolioPartition Partition;		// Partition of its model and type
+		size_t Row;							// Row within the partition
+	};
+
+	EuroOptBatch EuropeanRows[2];						// European partitions, indexed by OptionType
+	PerpAmerOptColumns PerpetualRows[2];				// Perpetual American partitions, indexed by OptionType
+	vector<size_t> PartitionPositions[Portfolio_Partitions];	// Position of each row of each partition
+	vector<PositionLocation> Locations;					// Location of each position
+
+public:
+	// Constructors
+	OptionPortfolio();								// Default constructor, creates an empty portfolio
+	// Destructors
+	virtual ~OptionPortfolio();						// Default destructor
+
+	// Functionality
+	size_t Add(const EuropeanOption& Option);		// Add a European position, returns its position index
+	size_t AddPerpetualAmerican(double K, double sig, double r, double U, double b, OptionType Type);	// Add a perpetual American position, returns its position index
+	size_t Size() const;							// Number of positions
+	size_t PartitionSize(PortfolioPartition Partition) const;		// Number of positions in one partition
+	PricerOutput SupportedOutputs(size_t Position) const;			// Outputs the model of a position can produce
+
+	void Compute(PricerOutput Outputs, PortfolioResult& Out) const;							// Compute the selected outputs of every position, partition by partition
+	void Compute(PricerOutput Outputs, PortfolioResult& Out, const ExecutionPolicy& Policy) const;	// As above with each partition's rows spread over Policy's threads
+};
+
+#endif
@@ -0,0 +1,85 @@
+/*	Daniel McNulty II
+*
+*	"PDE Test Source.cpp"
+*
+*	Checks the Crank-Nicolson engine against the closed forms. European prices, deltas and gammas over a
+*	spot range are compared with MatrixPricer(), and the error is shown to fall about fourfold each time
+*	the grid is refined. American puts from both early exercise methods are compared with a fine Leisen-
+*	Reimer lattice, and a 200 year American option with the perpetual closed form. Returns 1 if any
+*	error is above its tolerance.
+*/
+
+#include "AmericanOptionLattice.h"
+#include "EuropeanOption.h"
+#include "OptionPDE.h"
+#include "PerpetualAmericanKernels.h"
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+bool Check(const char* Name, double Error, double Tolerance)		// Print one result, true if it passed
+{
+	cout << left << setw(44) << Name << "| " << setw(13) << Error << "| " << Tolerance << endl;
+	return Error <= Tolerance;
+}
+
+double EuropeanError(const PDESettings& Settings, int Column)		// Largest error of one column of the All rows over the test spot range
+{
+	vector<vector<double>> Grid = PDEUnderlyingPricer(0.5, 100.0, 0.25, 0.05, 60.0, 0.02, 150.0, 90, European_Exercise, All, Settings);
+	vector<vector<double>> Exact = MatrixPricer(GenerateUnderlyingMatrix(0.5, 100.0, 0.25, 0.05, 60.0, 0.02, 150.0, 90), All);
+	double Worst = 0.0;
+	for (unsigned int i = 0; i < Grid.size(); i++)
+	{
+		Worst = fmax(Worst, fabs(Grid[i][Column] - Exact[i][Column]));
+	}
+	return Worst;
+}
+
+int main()
+{
+	bool Passed = true;
+	cout << "TEST                                        | ERROR        | TOLERANCE" << endl;
+
+	// European call and put over a spot range, columns of All are (call price, put price, call delta, put delta, call gamma, put gamma)
+	Passed = Check("European call prices", EuropeanError(Default_PDE, 0), 5e-3) && Passed;
+	Passed = Check("European put prices", EuropeanError(Default_PDE, 1), 5e-3) && Passed;
+	Passed = Check("European call deltas", EuropeanError(Default_PDE, 2), 1e-3) && Passed;
+	Passed = Check("European put gammas", EuropeanError(Default_PDE, 5), 1e-4) && Passed;
+
+	// Second order convergence, halving both steps should cut the error by about four
+	PDESettings Coarse = { 200, 100, 2, 5.0, Penalty_Iteration };
+	PDESettings Fine = { 800, 400, 2, 5.0, Penalty_Iteration };
+	double Ratio = EuropeanError(Coarse, 0) / EuropeanError(Default_PDE, 0);
+	double FineRatio = EuropeanError(Default_PDE, 0) / EuropeanError(Fine, 0);
+	Passed = Check("4 minus coarse to default error ratio", fabs(4.0 - Ratio), 0.5) && Passed;
+	Passed = Check("4 minus default to fine error ratio", fabs(4.0 - FineRatio), 0.5) && Passed;
+
+	// American put against a 4001 step Leisen-Reimer lattice, with both early exercise methods
+	LatticeSettings Reference = { Leisen_Reimer_Lattice, 4001, true };
+	double Lattice = AmericanPutPrice(0.25, 100.0, 0.2, 0.08, 100.0, 0.08, Reference);
+	PDESettings SOR = Fine;
+	SOR.Constraint = Projected_SOR;
+	Passed = Check("American put, penalty iteration", fabs(PDEPrice(0.25, 100.0, 0.2, 0.08, 100.0, 0.08, Put, American_Exercise, Fine) - Lattice), 1e-3) && Passed;
+	Passed = Check("American put, projected SOR", fabs(PDEPrice(0.25, 100.0, 0.2, 0.08, 100.0, 0.08, Put, American_Exercise, SOR) - Lattice), 1e-3) && Passed;
+
+	// A 200 year American option is worth the perpetual one to within exp(-rT), on a grid wide enough for the slow put tail
+	PDESettings Long = { 4000, 2000, 2, 1.0, Penalty_Iteration };
+	Passed = Check("200 year put against perpetual put", fabs(PDEPrice(200.0, 100.0, 0.2, 0.1, 100.0, 0.02, Put, American_Exercise, Long) - PerpKernelPrice<Put>(100.0, 0.2, 0.1, 100.0, 0.02)), 1e-3) && Passed;
+	Passed = Check("200 year call against perpetual call", fabs(PDEPrice(200.0, 100.0, 0.2, 0.1, 100.0, 0.02, Call, American_Exercise, Long) - PerpKernelPrice<Call>(100.0, 0.2, 0.1, 100.0, 0.02)), 1e-3) && Passed;
+
+	// Strike chain from one solve
+	vector<double> Strikes = GenerateMeshArray(70.0, 130.0, 12);
+	vector<double> Chain = PDEStrikeChain(0.5, Strikes, 0.25, 0.05, 100.0, 0.02, Call, European_Exercise, Default_PDE);
+	double ChainError = 0.0;
+	for (unsigned int i = 0; i < Strikes.size(); i++)
+	{
+		ChainError = fmax(ChainError, fabs(Chain[i] - CallPrice(0.5, Strikes[i], 0.25, 0.05, 100.0, 0.02)));
+	}
+	Passed = Check("European call strike chain", ChainError, 5e-3) && Passed;
+
+	cout << endl << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed ? 0 : 1;
+}
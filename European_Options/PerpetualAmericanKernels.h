@@ -0,0 +1,138 @@
+/*	Daniel McNulty II
+*
+*	PerpetualAmericanKernels.h
+*
+*	Closed form of the perpetual American option as inline kernels specialized on the option type. They
+*	evaluate exactly the expressions of CallPrice() and PutPrice() in PerpetualAmericanOption.cpp, so
+*	their results are identical. The header only needs Option.h, which lets the European project keep a
+*	copy of it for the perpetual positions of its mixed portfolios.
+*
+*	The sensitivities follow from V = A (U / K)^y with y a root of 0.5 sig^2 y (y - 1) + b y - r = 0.
+*	Delta and gamma are y V / U and y (y - 1) V / U^2. The coefficient A is chosen optimally, so
+*	dV/dy = V log(((y - 1) / y) (U / K)), and vega, rho and carry rho are that times dy/dsig, dy/dr and
+*	dy/db, found by differentiating the quadratic. Where the price degenerates to U every sensitivity but
+*	delta is zero.
+*
+*	The exponent and the price are also templates over the scalar type, so they run on the dual numbers
+*	of DualNumber.h for the whole gradient, or the second derivatives, in one pass. CallPrice() and
+*	PutPrice() have generic overloads on top of them.
+*/
+
+#ifndef PerpetualAmericanKernels_H
+#define PerpetualAmericanKernels_H
+
+#include "Option.h"
+#include <cmath>
+
+template <OptionType Type, class Real>
+inline Real PerpKernelExponent(const Real& sig, const Real& r, const Real& b)		// y1 for a call, y2 for a put
+{
+	if (Type == Call)
+	{
+		return 0.5 - (b / pow(sig, 2)) + sqrt(pow((0.5 - (b / pow(sig, 2))), 2) + ((2 * r) / pow(sig, 2)));
+	}
+	else
+	{
+		return 0.5 - (b / pow(sig, 2)) - sqrt(pow((0.5 - (b / pow(sig, 2))), 2) + ((2 * r) / pow(sig, 2)));
+	}
+}
+
+template <OptionType Type, class Real>
+inline Real PerpKernelPrice(const Real& K, const Real& sig, const Real& r, const Real& U, const Real& b)		// Price of one option
+{
+	Real y = PerpKernelExponent<Type>(sig, r, b);
+	if ((y == 0.0) || (y == 1.0))
+	{
+		return U;
+	}
+	else if (Type == Call)
+	{
+		return ((K / (y - 1))*pow((((y - 1) / y)*(U / K)), y));
+	}
+	else
+	{
+		return ((K / (1 - y))*pow((((y - 1) / y)*(U / K)), y));
+	}
+}
+
+inline void PerpKernelExponentDerivatives(double sig, double b, double y, double& dSig, double& dR, double& dB)	// dy/dsig, dy/dr and dy/db of the root y
+{
+	double Slope = (pow(sig, 2) * (y - 0.5)) + b;		// d/dy of 0.5 sig^2 y (y - 1) + b y - r
+	dSig = -(sig * y * (y - 1)) / Slope;
+	dR = 1 / Slope;
+	dB = -y / Slope;
+}
+
+template <OptionType Type>
+inline double PerpKernelDelta(double K, double sig, double r, double U, double b)		// dV/dU of one option
+{
+	double y = PerpKernelExponent<Type>(sig, r, b);
+	if ((y == 0.0) || (y == 1.0))
+	{
+		return 1.0;
+	}
+	return y * PerpKernelPrice<Type>(K, sig, r, U, b) / U;
+}
+
+template <OptionType Type>
+inline double PerpKernelGamma(double K, double sig, double r, double U, double b)		// d2V/dU2 of one option
+{
+	double y = PerpKernelExponent<Type>(sig, r, b);
+	if ((y == 0.0) || (y == 1.0))
+	{
+		return 0.0;
+	}
+	return y * (y - 1) * PerpKernelPrice<Type>(K, sig, r, U, b) / (U * U);
+}
+
+template <OptionType Type>
+inline double PerpKernelExponentSensitivity(double K, double sig, double r, double U, double b, double& dSig, double& dR, double& dB)	// dV/dy, with the derivatives of y in dSig, dR and dB
+{
+	double y = PerpKernelExponent<Type>(sig, r, b);
+	if ((y == 0.0) || (y == 1.0))
+	{
+		dSig = dR = dB = 0.0;
+		return 0.0;
+	}
+	PerpKernelExponentDerivatives(sig, b, y, dSig, dR, dB);
+	return PerpKernelPrice<Type>(K, sig, r, U, b) * log(((y - 1) / y) * (U / K));
+}
+
+template <OptionType Type>
+inline double PerpKernelVega(double K, double sig, double r, double U, double b)		// dV/dsig of one option
+{
+	double dSig, dR, dB;
+	double dV = PerpKernelExponentSensitivity<Type>(K, sig, r, U, b, dSig, dR, dB);
+	return dV * dSig;
+}
+
+template <OptionType Type>
+inline double PerpKernelRho(double K, double sig, double r, double U, double b)		// dV/dr of one option, b moves with r so the yield r - b is held fixed
+{
+	double dSig, dR, dB;
+	double dV = PerpKernelExponentSensitivity<Type>(K, sig, r, U, b, dSig, dR, dB);
+	return dV * (dR + dB);
+}
+
+template <OptionType Type>
+inline double PerpKernelCarryRho(double K, double sig, double r, double U, double b)	// dV/db of one option
+{
+	double dSig, dR, dB;
+	double dV = PerpKernelExponentSensitivity<Type>(K, sig, r, U, b, dSig, dR, dB);
+	return dV * dB;
+}
+
+// Generic pricers for any scalar with the arithmetic and functions of double, the double versions are in PerpetualAmericanOption.h
+template <class Real>
+inline Real CallPrice(const Real& K, const Real& sig, const Real& r, const Real& U, const Real& b)		// Call price for a perpetual american option
+{
+	return PerpKernelPrice<Call>(K, sig, r, U, b);
+}
+
+template <class Real>
+inline Real PutPrice(const Real& K, const Real& sig, const Real& r, const Real& U, const Real& b)		// Put price for a perpetual american option
+{
+	return PerpKernelPrice<Put>(K, sig, r, U, b);
+}
+
+#endif
@@ -0,0 +1,77 @@
+/*	Daniel McNulty II
+*
+*	Philox.h
+*
+*	Philox4x32-10 counter-based random numbers (Salmon, Moraes, Dror and Shaw, 2011). A draw is a pure
+*	function of a 128 bit counter and a 64 bit key, so there is no generator state to share or advance:
+*	whoever knows the counter of a number can compute it on any thread in any order. The Monte Carlo
+*	engine keys it with the seed and counts (draw group, time step, path block, stream), which gives every
+*	block of every batch row its own stream and makes results independent of the thread count.
+*/
+
+#ifndef Philox_H
+#define Philox_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+const uint32_t PhiloxMultiplier0 = 0xD2511F53;		// Round multipliers
+const uint32_t PhiloxMultiplier1 = 0xCD9E8D57;
+const uint32_t PhiloxWeyl0 = 0x9E3779B9;			// Key schedule increments, the golden ratio and sqrt(3) - 1
+const uint32_t PhiloxWeyl1 = 0xBB67AE85;
+const int PhiloxRounds = 10;						// Rounds of the standard Philox4x32-10
+
+inline void Philox4x32(const uint32_t Counter[4], uint64_t Key, uint32_t Out[4])	// Four random words for one counter
+{
+	uint32_t c0 = Counter[0], c1 = Counter[1], c2 = Counter[2], c3 = Counter[3];
+	uint32_t k0 = static_cast<uint32_t>(Key), k1 = static_cast<uint32_t>(Key >> 32);
+	for (int Round = 0; Round < PhiloxRounds; Round++)
+	{
+		uint64_t Product0 = static_cast<uint64_t>(PhiloxMultiplier0) * c0;
+		uint64_t Product1 = static_cast<uint64_t>(PhiloxMultiplier1) * c2;
+		uint32_t Next0 = static_cast<uint32_t>(Product1 >> 32) ^ c1 ^ k0;
+		uint32_t Next2 = static_cast<uint32_t>(Product0 >> 32) ^ c3 ^ k1;
+		c1 = static_cast<uint32_t>(Product1);
+		c3 = static_cast<uint32_t>(Product0);
+		c0 = Next0;
+		c2 = Next2;
+		k0 += PhiloxWeyl0;
+		k1 += PhiloxWeyl1;
+	}
+	Out[0] = c0;
+	Out[1] = c1;
+	Out[2] = c2;
+	Out[3] = c3;
+}
+
+inline double PhiloxUniform(uint32_t Word)		// Uniform on (0, 1), never exactly 0 or 1
+{
+	return (Word + 0.5) * (1.0 / 4294967296.0);
+}
+
+inline void PhiloxNormals(uint64_t Key, uint32_t Stream, uint32_t Block, uint32_t Step, size_t n, uint32_t* Words, double* Z)	// n standard normals of one (stream, block, step), Words holds at least n + 3 words of scratch
+{
+	// Counter words are (draw group, step, block, stream), each counter gives the words of four normals
+	for (size_t Group = 0; 4 * Group < n; Group++)
+	{
+		uint32_t Counter[4] = { static_cast<uint32_t>(Group), Step, Block, Stream };
+		Philox4x32(Counter, Key, Words + (4 * Group));
+	}
+
+	// Box-Muller on pairs of words, a separate loop over contiguous arrays so it vectorizes
+	const double TwoPi = 6.283185307179586;
+	for (size_t i = 0; i + 1 < n; i += 2)
+	{
+		double Radius = sqrt(-2.0 * log(PhiloxUniform(Words[i])));
+		double Angle = TwoPi * PhiloxUniform(Words[i + 1]);
+		Z[i] = Radius * cos(Angle);
+		Z[i + 1] = Radius * sin(Angle);
+	}
+	if (n % 2)
+	{
+		Z[n - 1] = sqrt(-2.0 * log(PhiloxUniform(Words[n - 1]))) * cos(TwoPi * PhiloxUniform(Words[n]));
+	}
+}
+
+#endif
@@ -0,0 +1,165 @@
+/*	Daniel McNulty II
+*
+*	"Portfolio Test Source.cpp"
+*
+*	Checks OptionPortfolio on a mixed book of European and perpetual American calls and puts added in
+*	random order: every output of every position against the EuropeanOption member functions and the
+*	perpetual American kernels, NaN for the outputs a perpetual position does not support, the single
+*	output paths against the full pass, and the threaded pass against the serial one. Returns 1 on any
+*	failure.
+*/
+
+#include "EuropeanOption.h"
+#include "OptionPortfolio.h"
+#include "PerpetualAmericanKernels.h"
+#include "ThreadPool.h"
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <vector>
+using namespace std;
+
+static_assert(ModelSupports<EuropeanModel>(All_Greeks), "European options support every output");
+static_assert(ModelSupports<PerpetualAmericanModel>(Price | Delta | Gamma | Vega | Rho | CarryRho) && !ModelSupports<PerpetualAmericanModel>(Theta), "Perpetual American options have no theta");
+
+const PricerOutput Outputs[] = { Price, Delta, Gamma, Vega, Theta, Rho, CarryRho, Vanna, Volga, Charm };		// Single outputs in enum order
+
+bool Check(const char* Name, bool Passed)		// Print one result, true if it passed
+{
+	cout << left << setw(52) << Name << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed;
+}
+
+double Relative(double Value, double Exact)		// Error relative to Exact, absolute below 1
+{
+	return fabs(Value - Exact) / fmax(1.0, fabs(Exact));
+}
+
+double EuropeanReference(const EuropeanOption& Option, PricerOutput Output)		// One output from the EuropeanOption member functions
+{
+	switch (Output)
+	{
+	case (Delta): return Option.Delta();
+	case (Gamma): return Option.Gamma();
+	case (Vega): return Option.Vega();
+	case (Theta): return Option.Theta();
+	case (Rho): return Option.Rho();
+	case (CarryRho): return Option.CarryRho();
+	case (Vanna): return Option.Vanna();
+	case (Volga): return Option.Volga();
+	case (Charm): return Option.Charm();
+	default: return Option.Price();
+	}
+}
+
+template <OptionType Type>
+double PerpetualReference(const vector<double>& Row, PricerOutput Output)		// One output from the perpetual American kernels, NaN if unsupported
+{
+	double K = Row[0], sig = Row[1], r = Row[2], U = Row[3], b = Row[4];
+	switch (Output)
+	{
+	case (Price): return PerpKernelPrice<Type>(K, sig, r, U, b);
+	case (Delta): return PerpKernelDelta<Type>(K, sig, r, U, b);
+	case (Gamma): return PerpKernelGamma<Type>(K, sig, r, U, b);
+	case (Vega): return PerpKernelVega<Type>(K, sig, r, U, b);
+	case (Rho): return PerpKernelRho<Type>(K, sig, r, U, b);
+	case (CarryRho): return PerpKernelCarryRho<Type>(K, sig, r, U, b);
+	default: return NAN;
+	}
+}
+
+int main()
+{
+	bool Passed = true;
+	SetSharedThreadCount(4);
+
+	// Positions of all four partitions in random order
+	mt19937_64 Generator(2020);
+	uniform_real_distribution<> Unit(0.0, 1.0);
+	OptionPortfolio Portfolio;
+	vector<bool> IsEuropean;
+	vector<OptionType> Types;
+	vector<EuropeanOption> European;
+	vector<vector<double>> Perpetual;
+	const size_t Positions = 4000;
+	for (size_t i = 0; i < Positions; i++)
+	{
+		OptionType Type = (Unit(Generator) < 0.5) ? Call : Put;
+		double r = 0.03 + 0.07 * Unit(Generator);
+		double K = 60.0 + 80.0 * Unit(Generator), sig = 0.1 + 0.5 * Unit(Generator), U = 80.0 + 40.0 * Unit(Generator);
+		if (Unit(Generator) < 0.5)
+		{
+			EuropeanOption Option(0.05 + 2.0 * Unit(Generator), K, sig, r, U, r - 0.05 + 0.1 * Unit(Generator), Type);
+			size_t Position = Portfolio.Add(Option);
+			Passed = Passed && (Position == i);
+			European.push_back(Option);
+			Perpetual.push_back(vector<double>());
+			IsEuropean.push_back(true);
+		}
+		else
+		{
+			double b = r - 0.01 - 0.05 * Unit(Generator);		// b < r, so every call has a finite price
+			size_t Position = Portfolio.AddPerpetualAmerican(K, sig, r, U, b, Type);
+			Passed = Passed && (Position == i);
+			European.push_back(EuropeanOption());
+			Perpetual.push_back({ K, sig, r, U, b });
+			IsEuropean.push_back(false);
+		}
+		Types.push_back(Type);
+	}
+	size_t Partitioned = 0;
+	for (int p = 0; p < Portfolio_Partitions; p++)
+	{
+		Partitioned += Portfolio.PartitionSize(static_cast<PortfolioPartition>(p));
+	}
+	Passed = Check("Positions numbered in the order they were added", Passed && (Portfolio.Size() == Positions) && (Partitioned == Positions)) && Passed;
+
+	// Every output of every position against its model
+	PortfolioResult Full;
+	Portfolio.Compute(All_Greeks, Full);
+	double Worst = 0.0;
+	bool Unsupported = true, Capabilities = true;
+	for (size_t i = 0; i < Positions; i++)
+	{
+		PricerOutput Supported = Portfolio.SupportedOutputs(i);
+		Capabilities = Capabilities && (Supported == (IsEuropean[i] ? ModelCapabilities<EuropeanModel>::Outputs : ModelCapabilities<PerpetualAmericanModel>::Outputs));
+		for (PricerOutput Output : Outputs)
+		{
+			double Value = Full.Column(Output)[i];
+			if (!(Supported & Output))
+			{
+				Unsupported = Unsupported && isnan(Value);
+				continue;
+			}
+			double Reference = IsEuropean[i] ? EuropeanReference(European[i], Output) : ((Types[i] == Call) ? PerpetualReference<Call>(Perpetual[i], Output) : PerpetualReference<Put>(Perpetual[i], Output));
+			Worst = fmax(Worst, Relative(Value, Reference));
+		}
+	}
+	cout << "Largest error against the single option functions " << Worst << endl;
+	Passed = Check("Every output matches its model", Worst < 1e-12) && Passed;
+	Passed = Check("Unsupported outputs are NaN", Unsupported) && Passed;
+	Passed = Check("SupportedOutputs follows the position's model", Capabilities) && Passed;
+
+	// Single output paths and the threaded pass
+	PortfolioResult Prices, Deltas, Threaded;
+	Portfolio.Compute(Price, Prices);
+	Portfolio.Compute(Delta, Deltas);
+	Portfolio.Compute(All_Greeks, Threaded, Parallel_Execution);
+	double WorstSingle = 0.0;
+	bool Identical = true;
+	for (size_t i = 0; i < Positions; i++)
+	{
+		WorstSingle = fmax(WorstSingle, fmax(Relative(Prices.Prices[i], Full.Prices[i]), Relative(Deltas.Deltas[i], Full.Deltas[i])));
+		for (PricerOutput Output : Outputs)
+		{
+			double a = Threaded.Column(Output)[i], b = Full.Column(Output)[i];
+			Identical = Identical && ((a == b) || (isnan(a) && isnan(b)));
+		}
+	}
+	Passed = Check("Single output paths match the full pass", (Prices.Gammas.empty()) && (WorstSingle < 1e-12)) && Passed;
+	Passed = Check("Threaded pass identical to the serial one", Identical) && Passed;
+
+	cout << endl << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed ? 0 : 1;
+}
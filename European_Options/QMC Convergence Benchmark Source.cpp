@@ -0,0 +1,109 @@
+/*	Daniel McNulty II
+*
+*	"QMC Convergence Benchmark Source.cpp"
+*
+*	Error against the number of paths for the pseudo random and the two scrambled Sobol samplers. A
+*	European call, with the antithetic and control variates off so only the sampler differs, is priced
+*	with 2^10 to 2^20 paths under several seeds and compared with CallPrice(). The RMS error over the
+*	seeds and the mean reported standard error are printed for each count, with the slope of log error
+*	against log paths: about -0.5 for Monte Carlo and closer to -1 for the Sobol samplers. An arithmetic
+*	Asian call on 64 dates then shows what the Brownian bridge keeps of that gain on a path-dependent
+*	payoff.
+*/
+
+#include "EuropeanOption.h"
+#include "MonteCarlo.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+using namespace std;
+
+const int Seeds = 8;				// Independent runs behind every RMS error
+const int SmallestPower = 10;		// 2^10 paths
+const int LargestPower = 20;		// 2^20 paths
+
+struct ConvergencePoint			// One sampler at one path count
+{
+	double RMSError;			// RMS error against the closed form over the seeds
+	double StdError;			// Mean reported standard error over the seeds
+	double Seconds;				// Mean time of one run
+};
+
+ConvergencePoint Converge(MCSampler Sampler, size_t Paths, MCPayoff Payoff, int Steps, double Exact)	// Runs of one sampler and path count under every seed
+{
+	const double T = 1.0, K = 100.0, sig = 0.25, r = 0.05, U = 100.0, b = 0.02;
+	ConvergencePoint Point = { 0.0, 0.0, 0.0 };
+	for (int Seed = 0; Seed < Seeds; Seed++)
+	{
+		MCSettings Settings = { Paths, Steps, static_cast<uint64_t>(1000 + Seed), false, false, Sampler, 16 };
+		auto Start = chrono::steady_clock::now();
+		MCResult Result = MCPrice(T, K, sig, r, U, b, Call, Payoff, Settings);
+		Point.Seconds += chrono::duration<double>(chrono::steady_clock::now() - Start).count() / Seeds;
+		Point.RMSError += pow(Result.Price - Exact, 2) / Seeds;
+		Point.StdError += Result.StdError / Seeds;
+	}
+	Point.RMSError = sqrt(Point.RMSError);
+	return Point;
+}
+
+int main()
+{
+	const double T = 1.0, K = 100.0, sig = 0.25, r = 0.05, U = 100.0, b = 0.02;
+	const MCSampler Samplers[3] = { Pseudo_Random, Sobol_Shift, Sobol_Owen };
+	const char* Names[3] = { "Pseudo random", "Sobol + shift", "Sobol + Owen" };
+	double Exact = CallPrice(T, K, sig, r, U, b);
+
+	cout << "European call " << Exact << ", RMS error over " << Seeds << " seeds, 16 replicates per Sobol run" << endl;
+	cout << "PATHS    | ";
+	for (int s = 0; s < 3; s++)
+	{
+		cout << left << setw(26) << Names[s] << "| ";
+	}
+	cout << endl << "         | ";
+	for (int s = 0; s < 3; s++)
+	{
+		cout << left << setw(13) << "RMS ERROR" << setw(13) << "STD ERROR" << "| ";
+	}
+	cout << endl;
+
+	ConvergencePoint First[3], Last[3];
+	for (int Power = SmallestPower; Power <= LargestPower; Power++)
+	{
+		size_t Paths = static_cast<size_t>(1) << Power;
+		cout << left << setw(9) << Paths << "| ";
+		for (int s = 0; s < 3; s++)
+		{
+			ConvergencePoint Point = Converge(Samplers[s], Paths, European_Payoff, 1, Exact);
+			cout << setw(13) << Point.RMSError << setw(13) << Point.StdError << "| ";
+			if (Power == SmallestPower)
+			{
+				First[s] = Point;
+			}
+			Last[s] = Point;
+		}
+		cout << endl;
+	}
+
+	cout << endl << "SAMPLER        | ERROR SLOPE | STD ERROR SLOPE | SECONDS AT 2^" << LargestPower << endl;
+	double LogRange = (LargestPower - SmallestPower) * log(2.0);
+	for (int s = 0; s < 3; s++)
+	{
+		cout << left << setw(15) << Names[s] << "| " << setw(12) << log(Last[s].RMSError / First[s].RMSError) / LogRange << "| "
+			<< setw(16) << log(Last[s].StdError / First[s].StdError) / LogRange << "| " << Last[s].Seconds << endl;
+	}
+
+	// Path-dependent payoff, the exact price is estimated by a long Owen scrambled run
+	const size_t AsianPaths = static_cast<size_t>(1) << 16;
+	MCSettings Reference = { static_cast<size_t>(1) << 22, 64, 7, true, true, Sobol_Owen, 16 };
+	double Asian = MCPrice(T, K, sig, r, U, b, Call, Arithmetic_Asian_Payoff, Reference).Price;
+	cout << endl << "Arithmetic Asian call on 64 dates, " << AsianPaths << " paths, reference " << Asian << endl << "SAMPLER        | RMS ERROR    | STD ERROR    | VARIANCE RATIO" << endl;
+	double Baseline = 0.0;
+	for (int s = 0; s < 3; s++)
+	{
+		ConvergencePoint Point = Converge(Samplers[s], AsianPaths, Arithmetic_Asian_Payoff, 64, Asian);
+		Baseline = (s == 0) ? Point.StdError : Baseline;
+		cout << left << setw(15) << Names[s] << "| " << setw(13) << Point.RMSError << "| " << setw(13) << Point.StdError << "| " << pow(Baseline / Point.StdError, 2) << endl;
+	}
+	return 0;
+}
@@ -0,0 +1,97 @@
+/*	Daniel McNulty II
+*
+*	RecordStream.h
+*
+*	Chunked reading and writing of fixed width records of doubles, either as CSV text or as packed
+*	binary (native byte order, Fields doubles per record). Records are moved in column order so they go
+*	straight into and out of the structure-of-arrays batch types. Memory use is bounded by the I/O
+*	buffer and the chunk the caller asks for, whatever the size of the stream.
+*/
+
+#ifndef RecordStream_H
+#define RecordStream_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+using namespace std;
+
+enum StreamFormat		// Encoding of a record stream
+{
+	Csv_Format,			// One record per line, fields separated by commas, blank lines and lines starting with # are skipped
+	Binary_Format		// Packed doubles, Fields per record
+};
+
+struct StreamSummary	// Totals of a streaming run
+{
+	size_t Records;			// Records read and written
+	size_t BadRecords;		// Records that could not be parsed, written out as NaN so the output stays aligned with the input
+	size_t FirstBadLine;	// CSV line number of the first bad record, 0 if there was none
+	bool Failed;			// A read or write error stopped the run early
+};
+
+class RecordReader		// Reads records of a fixed number of doubles from a stream
+{
+private:
+	FILE* Source;				// Stream being read
+	StreamFormat Format;		// Encoding of the stream
+	size_t Fields;				// Doubles per record
+	vector<char> Buffer;		// Bytes read but not yet parsed live in [Begin, End)
+	size_t Begin;
+	size_t End;
+	bool SourceDone;			// Source has reported end of file or an error
+	size_t Line;				// CSV lines consumed so far
+	bool FirstRecordSeen;		// A non-blank CSV line has been seen, only the first one can be a header
+	size_t BadRecords;			// Records that failed to parse
+	size_t FirstBadLine;		// Line of the first bad record
+
+	bool Refill();										// Move the unparsed bytes to the front and read more, false if nothing new arrived
+	bool ParseLine(const char* First, const char* Last, double* Values) const;	// Parse one CSV line into Fields values
+
+public:
+	// Constructors
+	RecordReader(FILE* Source, StreamFormat Format, size_t Fields);		// Constructor that accepts the stream, its encoding and the record width
+	// Destructors
+	virtual ~RecordReader();											// Default destructor
+
+	// Functionality
+	size_t Read(size_t MaxRecords, double* const* Columns);	// Read up to MaxRecords records, field f of record i goes to Columns[f][i], returns the number read (0 at the end)
+	size_t BadRecordCount() const;							// Records that failed to parse so far
+	size_t FirstBadRecordLine() const;						// CSV line of the first bad record, 0 if there was none
+	bool Failed() const;									// Reading the stream failed
+
+private:
+	RecordReader(const RecordReader& source);					// Not copyable
+	RecordReader& operator = (const RecordReader& source);		// Not assignable
+};
+
+class RecordWriter		// Writes records of a fixed number of doubles to a stream
+{
+private:
+	FILE* Sink;					// Stream being written
+	StreamFormat Format;		// Encoding of the stream
+	size_t Fields;				// Doubles per record
+	vector<char> Buffer;		// Bytes waiting to be written
+	size_t Used;				// Bytes of Buffer in use
+	bool Failed;				// A write to Sink failed
+
+	void Drain();				// Write the buffered bytes
+
+public:
+	// Constructors
+	RecordWriter(FILE* Sink, StreamFormat Format, size_t Fields);		// Constructor that accepts the stream, its encoding and the record width
+	// Destructors
+	virtual ~RecordWriter();											// Destructor that flushes the buffered records
+
+	// Functionality
+	void WriteHeader(const vector<string>& Names);						// Write a CSV header line, ignored for binary streams
+	void Write(size_t n, const double* const* Columns);					// Write n records, field f of record i comes from Columns[f][i]
+	bool Flush();														// Write everything buffered and flush Sink, false if any write failed
+
+private:
+	RecordWriter(const RecordWriter& source);					// Not copyable
+	RecordWriter& operator = (const RecordWriter& source);		// Not assignable
+};
+
+#endif
@@ -0,0 +1,83 @@
+/*	Daniel McNulty II
+*
+*	Sobol.h
+*
+*	Sobol low discrepancy sequence in base 2 with 32 bit points. The first dimension is the van der Corput
+*	sequence and dimensions 2 to SobolMaxDimensions use the primitive polynomials and initial direction
+*	numbers of Joe and Kuo (2008), new-joe-kuo-6.21201, which are chosen so that every pair of dimensions
+*	is well distributed. Points are generated in Gray code order, one XOR per coordinate, and any run of
+*	points can be generated on its own from its first index, so blocks of a sequence can be split over
+*	threads without sharing state.
+*
+*	A plain Sobol set is deterministic and has no error estimate. Randomizing it with an independent
+*	scramble per replicate gives unbiased replicates whose spread is the error. The digital shift XORs
+*	every coordinate with a random word. The Owen scramble permutes the digits of every coordinate
+*	depending on all of its more significant digits, with the hash of Burley (2020), which keeps the
+*	low discrepancy and also improves the convergence rate on smooth integrands.
+*/
+
+#ifndef Sobol_H
+#define Sobol_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+using namespace std;
+
+const int SobolBits = 32;					// Bits of every coordinate, and the log2 of the longest sequence
+const int SobolMaxDimensions = 256;			// Dimensions with Joe-Kuo direction numbers
+
+class SobolSequence
+{
+private:
+	int Dims;								// Dimensions of every point
+	vector<uint32_t> Directions;			// SobolBits direction numbers of each dimension, dimension by dimension
+
+public:
+	// Constructors
+	SobolSequence();						// Default constructor, one dimension
+	SobolSequence(int Dimensions);			// Constructor that accepts the number of dimensions
+	// Destructors
+	virtual ~SobolSequence();				// Default destructor
+
+	// Accessors
+	int Dimensions() const;								// Dimensions of every point
+	uint32_t Direction(int Dimension, int Bit) const;	// Direction number of one bit of one dimension
+
+	// Functionality
+	void Points(uint32_t First, size_t n, uint32_t* Out) const;		// Points First to First + n - 1, coordinate d of point First + i in Out[d * n + i]
+};
+
+inline uint32_t ReverseBits(uint32_t x)			// Bit 0 swapped with bit 31, bit 1 with bit 30 and so on
+{
+	x = ((x >> 1) & 0x55555555) | ((x & 0x55555555) << 1);
+	x = ((x >> 2) & 0x33333333) | ((x & 0x33333333) << 2);
+	x = ((x >> 4) & 0x0F0F0F0F) | ((x & 0x0F0F0F0F) << 4);
+	x = ((x >> 8) & 0x00FF00FF) | ((x & 0x00FF00FF) << 8);
+	return (x >> 16) | (x << 16);
+}
+
+inline uint32_t OwenScramble(uint32_t x, uint32_t Seed)		// Nested uniform scramble of one coordinate, Burley (2020)
+{
+	// Reversed, the most significant digit is the lowest bit, and a product only carries upwards, so each
+	// digit is flipped depending on the seed and the digits above it
+	x = ReverseBits(x);
+	x += Seed;
+	x ^= x * 0x6C50B47C;
+	x ^= x * 0xB82F1E52;
+	x ^= x * 0xC7AFE638;
+	x ^= x * 0x8D22F6E6;
+	return ReverseBits(x);
+}
+
+inline uint32_t DigitalShift(uint32_t x, uint32_t Seed)		// Random digital shift of one coordinate
+{
+	return x ^ Seed;
+}
+
+inline double SobolUniform(uint32_t Word)		// Centre of the 2^-32 cell of a coordinate, never exactly 0 or 1
+{
+	return (Word + 0.5) * (1.0 / 4294967296.0);
+}
+
+#endif
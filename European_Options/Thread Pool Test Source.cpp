@@ -0,0 +1,110 @@
+/*	Daniel McNulty II
+*
+*	"Thread Pool Test Source.cpp"
+*
+*	Checks ParallelFor on the shared pool: every row of a loop is visited exactly once, a ParallelFor
+*	nested inside a loop body runs on that body's thread and gives the serial result, including when the
+*	outer body runs on the calling thread that owns the pool, and an exception thrown by a body reaches
+*	the caller and leaves the pool usable. Returns 1 on any failure.
+*/
+
+#include "ThreadPool.h"
+#include <atomic>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+using namespace std;
+
+bool Check(const char* Name, bool Passed)		// Print one result, true if it passed
+{
+	cout << left << setw(52) << Name << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed;
+}
+
+int main()
+{
+	bool Passed = true;
+	const ExecutionPolicy FineGrain = { 4, 1 };		// Several threads and one row at a time, so every loop below is split
+	SetSharedThreadCount(4);						// Workers even on a single core machine, so the pool itself is exercised
+	cout << "Hardware threads " << HardwareThreads() << ", pool workers " << SharedThreadPool().WorkerCount() << endl;
+
+	// Every row visited exactly once
+	const size_t Rows = 100000;
+	vector<atomic<int>> Visits(Rows);
+	ParallelFor(Rows, [&](size_t First, size_t Last)
+	{
+		for (size_t i = First; i < Last; i++)
+		{
+			Visits[i]++;
+		}
+	}, FineGrain);
+	bool Once = true;
+	for (size_t i = 0; i < Rows; i++)
+	{
+		Once = Once && (Visits[i] == 1);
+	}
+	Passed = Check("Every row visited exactly once", Once) && Passed;
+
+	// Nested loops, each outer row sums its inner loop on the thread running it
+	const size_t Outer = 64, Inner = 1000;
+	vector<double> Sums(Outer, 0.0);
+	vector<int> SameThread(Outer, 1);
+	ParallelFor(Outer, [&](size_t First, size_t Last)
+	{
+		for (size_t i = First; i < Last; i++)
+		{
+			thread::id Owner = this_thread::get_id();
+			vector<double> Terms(Inner);
+			ParallelFor(Inner, [&](size_t InnerFirst, size_t InnerLast)
+			{
+				for (size_t j = InnerFirst; j < InnerLast; j++)
+				{
+					Terms[j] = static_cast<double>(i * Inner + j);
+				}
+				if (this_thread::get_id() != Owner)
+				{
+					SameThread[i] = 0;
+				}
+			}, Parallel_Execution);
+			for (size_t j = 0; j < Inner; j++)
+			{
+				Sums[i] += Terms[j];
+			}
+		}
+	}, FineGrain);
+	bool Nested = true, Inline = true;
+	for (size_t i = 0; i < Outer; i++)
+	{
+		double Expected = static_cast<double>(i * Inner * Inner) + static_cast<double>(Inner * (Inner - 1) / 2);
+		Nested = Nested && (Sums[i] == Expected);
+		Inline = Inline && (SameThread[i] == 1);
+	}
+	Passed = Check("Nested loops give the serial sums", Nested) && Passed;
+	Passed = Check("Nested loops stay on the body's thread", Inline) && Passed;
+
+	// An exception from a body reaches the caller, then the pool runs the next loop
+	bool Caught = false;
+	try
+	{
+		ParallelFor(Rows, [&](size_t First, size_t Last)
+		{
+			if ((First <= Rows / 2) && (Rows / 2 < Last))
+			{
+				throw runtime_error("Row failed");
+			}
+		}, FineGrain);
+	}
+	catch (const runtime_error&)
+	{
+		Caught = true;
+	}
+	atomic<size_t> Count(0);
+	ParallelFor(Rows, [&](size_t First, size_t Last) { Count += Last - First; }, FineGrain);
+	Passed = Check("Exception reaches the caller", Caught) && Passed;
+	Passed = Check("Pool usable after an exception", Count == Rows) && Passed;
+
+	cout << endl << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed ? 0 : 1;
+}
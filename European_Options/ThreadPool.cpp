@@ -0,0 +1,260 @@
+/*	Daniel McNulty II
+*
+*	ThreadPool.cpp
+*/
+
+#include "ThreadPool.h"
+#include <algorithm>
+#include <exception>
+#include <memory>
+using namespace std;
+
+struct alignas(64) StealRange		// Rows [Begin, End) not yet taken by any thread, one per participant and on its own cache line
+{
+	mutex Lock;
+	size_t Begin;
+	size_t End;
+};
+
+static thread_local bool InsideLoop = false;		// Set while the thread runs the body of a ParallelFor, a loop nested in it then stays on that thread
+
+static bool TakeOwn(StealRange& Own, size_t Grain, size_t& Begin, size_t& End)		// Take up to Grain rows from the front of the participant's own range
+{
+	lock_guard<mutex> Guard(Own.Lock);
+	if (Own.Begin >= Own.End)
+	{
+		return false;
+	}
+	Begin = Own.Begin;
+	End = min(Own.End, Own.Begin + Grain);
+	Own.Begin = End;
+	return true;
+}
+
+static bool Steal(vector<StealRange>& Ranges, unsigned int Thief)		// Move the back half of the largest other range into the thief's range
+{
+	for (;;)
+	{
+		// Find the participant with the most rows left
+		unsigned int Victim = Thief;
+		size_t MostLeft = 0;
+		for (unsigned int p = 0; p < Ranges.size(); p++)
+		{
+			if (p == Thief)
+			{
+				continue;
+			}
+			lock_guard<mutex> Guard(Ranges[p].Lock);
+			size_t Left = Ranges[p].End - Ranges[p].Begin;
+			if (Left > MostLeft)
+			{
+				MostLeft = Left;
+				Victim = p;
+			}
+		}
+		if (Victim == Thief)
+		{
+			return false;		// Nothing left anywhere
+		}
+
+		size_t StolenBegin, StolenEnd;
+		{
+			lock_guard<mutex> Guard(Ranges[Victim].Lock);
+			size_t Left = Ranges[Victim].End - Ranges[Victim].Begin;
+			if (Left == 0)
+			{
+				continue;		// The victim finished in the meantime, look again
+			}
+			StolenBegin = Ranges[Victim].Begin + (Left / 2);
+			StolenEnd = Ranges[Victim].End;
+			Ranges[Victim].End = StolenBegin;
+		}
+
+		lock_guard<mutex> Guard(Ranges[Thief].Lock);
+		Ranges[Thief].Begin = StolenBegin;
+		Ranges[Thief].End = StolenEnd;
+		return true;
+	}
+}
+
+// PRIVATE MEMBER FUNCTIONS
+void ThreadPool::WorkerLoop(unsigned int Index)		// Body of worker thread Index
+{
+	unsigned long long Seen = 0;
+	for (;;)
+	{
+		function<void(unsigned int)> MyJob;
+		{
+			unique_lock<mutex> Guard(Lock);
+			WorkReady.wait(Guard, [&] { return Stopping || (Generation != Seen); });
+			if (Stopping)
+			{
+				return;
+			}
+			Seen = Generation;
+			if (Index >= JobParticipants)
+			{
+				continue;		// Not needed for this job
+			}
+			MyJob = Job;
+		}
+
+		MyJob(Index);
+
+		lock_guard<mutex> Guard(Lock);
+		if (--Running == 0)
+		{
+			WorkDone.notify_all();
+		}
+	}
+}
+
+// PUBLIC MEMBER FUNCTIONS
+// Constructors
+ThreadPool::ThreadPool(unsigned int WorkerCount) : JobParticipants(0), Running(0), Generation(0), Stopping(false)	// Constructor that starts WorkerCount worker threads
+{
+	for (unsigned int i = 0; i < WorkerCount; i++)
+	{
+		Workers.push_back(thread(&ThreadPool::WorkerLoop, this, i));
+	}
+}
+
+// Destructors
+ThreadPool::~ThreadPool()		// Destructor that joins every worker
+{
+	{
+		lock_guard<mutex> Guard(Lock);
+		Stopping = true;
+	}
+	WorkReady.notify_all();
+	for (unsigned int i = 0; i < Workers.size(); i++)
+	{
+		Workers[i].join();
+	}
+}
+
+// Functionality
+unsigned int ThreadPool::WorkerCount() const		// Number of worker threads, not counting the caller
+{
+	return static_cast<unsigned int>(Workers.size());
+}
+
+void ThreadPool::ParallelFor(size_t n, const function<void(size_t, size_t)>& Body, const ExecutionPolicy& Policy)	// Call Body(begin, end) over disjoint ranges covering [0, n)
+{
+	if (n == 0)
+	{
+		return;
+	}
+
+	unsigned int Threads = (Policy.Threads == 0) ? (WorkerCount() + 1) : min(Policy.Threads, WorkerCount() + 1);
+	size_t Grain = Policy.Grain;
+	if (Grain == 0)		// Small enough pieces that the last ones balance the load, large enough to amortize the locking
+	{
+		Grain = max<size_t>(1, min<size_t>(4096, n / (static_cast<size_t>(Threads) * 32)));
+	}
+
+	// Serial path, also taken for a ParallelFor nested inside a loop body, whose thread may already own LoopLock, and
+	// when a loop from another thread owns the pool
+	unique_lock<mutex> Loop(LoopLock, defer_lock);
+	if ((Threads <= 1) || (n <= Grain) || InsideLoop || !Loop.try_lock())
+	{
+		Body(0, n);
+		return;
+	}
+
+	// One contiguous starting range per participant
+	vector<StealRange> Ranges(Threads);
+	for (unsigned int p = 0; p < Threads; p++)
+	{
+		Ranges[p].Begin = (n * p) / Threads;
+		Ranges[p].End = (n * (p + 1)) / Threads;
+	}
+
+	exception_ptr Error;
+	mutex ErrorLock;
+	auto Participant = [&](unsigned int p)
+	{
+		InsideLoop = true;
+		try
+		{
+			size_t Begin, End;
+			while (TakeOwn(Ranges[p], Grain, Begin, End) || (Steal(Ranges, p) && TakeOwn(Ranges[p], Grain, Begin, End)))
+			{
+				Body(Begin, End);
+			}
+		}
+		catch (...)
+		{
+			{
+				lock_guard<mutex> Guard(ErrorLock);
+				if (!Error)
+				{
+					Error = current_exception();
+				}
+			}
+			for (unsigned int q = 0; q < Ranges.size(); q++)		// Drop the remaining rows so every participant stops
+			{
+				lock_guard<mutex> Guard(Ranges[q].Lock);
+				Ranges[q].Begin = Ranges[q].End;
+			}
+		}
+		InsideLoop = false;
+	};
+
+	// Workers 0 to Threads - 2 are participants 1 to Threads - 1, the caller is participant 0
+	{
+		lock_guard<mutex> Guard(Lock);
+		Job = [&](unsigned int Worker) { Participant(Worker + 1); };
+		JobParticipants = Threads - 1;
+		Running = Threads - 1;
+		Generation++;
+	}
+	WorkReady.notify_all();
+	Participant(0);
+	{
+		unique_lock<mutex> Guard(Lock);
+		WorkDone.wait(Guard, [&] { return Running == 0; });
+		Job = nullptr;
+	}
+
+	if (Error)
+	{
+		rethrow_exception(Error);
+	}
+}
+
+// GLOBAL THREAD POOL FUNCTIONS
+static mutex SharedPoolLock;						// Guards creation and replacement of the shared pool
+static unique_ptr<ThreadPool> SharedPool;			// Created on first use
+
+unsigned int HardwareThreads()						// Number of hardware threads, at least 1
+{
+	unsigned int Count = thread::hardware_concurrency();
+	return (Count == 0) ? 1 : Count;
+}
+
+ThreadPool& SharedThreadPool()						// Pool shared by every matrix function
+{
+	lock_guard<mutex> Guard(SharedPoolLock);
+	if (!SharedPool)
+	{
+		SharedPool.reset(new ThreadPool(HardwareThreads() - 1));
+	}
+	return *SharedPool;
+}
+
+void SetSharedThreadCount(unsigned int Threads)		// Recreate the shared pool so it can run Threads threads including the caller
+{
+	lock_guard<mutex> Guard(SharedPoolLock);
+	SharedPool.reset(new ThreadPool((Threads == 0) ? (HardwareThreads() - 1) : (Threads - 1)));
+}
+
+void ParallelFor(size_t n, const function<void(size_t, size_t)>& Body, const ExecutionPolicy& Policy)		// ParallelFor on the shared pool
+{
+	if ((Policy.Threads == 1) || (n == 0))		// The serial path never touches the pool
+	{
+		Body(0, n);
+		return;
+	}
+	SharedThreadPool().ParallelFor(n, Body, Policy);
+}
@@ -0,0 +1,69 @@
+/*	Daniel McNulty II
+*
+*	ThreadPool.h
+*
+*	Work-stealing parallel loop used by the matrix generators and pricers. A loop over n rows is cut
+*	into one contiguous range per thread; each thread takes Grain rows at a time from the front of its
+*	own range and, once that is empty, steals the back half of the largest range left. Every row is
+*	computed by exactly one call of the loop body, so results written by row index are identical to the
+*	serial loop whatever the thread count or scheduling.
+*/
+
+#ifndef ThreadPool_H
+#define ThreadPool_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+using namespace std;
+
+struct ExecutionPolicy		// How a matrix function spreads its rows over threads
+{
+	unsigned int Threads;	// Number of threads to use including the caller, 0 for every hardware thread, 1 for the serial path
+	size_t Grain;			// Rows a thread takes from its range at a time, 0 to pick one from the row and thread counts
+};
+
+const ExecutionPolicy Serial_Execution = { 1, 0 };			// Run on the calling thread only
+const ExecutionPolicy Parallel_Execution = { 0, 0 };		// Use every hardware thread with an automatic grain
+
+class ThreadPool		// Fixed set of worker threads that run ParallelFor loops together with the calling thread
+{
+private:
+	vector<thread> Workers;							// Worker threads, the caller of ParallelFor is the extra participant
+	mutex Lock;										// Guards the job state below
+	condition_variable WorkReady;					// Signalled when a new job is posted or the pool shuts down
+	condition_variable WorkDone;					// Signalled when the last participant of a job finishes
+	function<void(unsigned int)> Job;				// Current job, called with the participant number
+	unsigned int JobParticipants;					// Number of workers that take part in the current job
+	unsigned int Running;							// Workers still inside the current job
+	unsigned long long Generation;					// Incremented for every job so each worker runs it once
+	bool Stopping;									// Set by the destructor
+	mutex LoopLock;									// Held for the duration of a ParallelFor, one loop runs on the pool at a time
+
+	void WorkerLoop(unsigned int Index);			// Body of worker thread Index
+
+public:
+	// Constructors
+	ThreadPool(unsigned int WorkerCount);			// Constructor that starts WorkerCount worker threads
+	// Destructors
+	virtual ~ThreadPool();							// Destructor that joins every worker
+
+	// Functionality
+	unsigned int WorkerCount() const;				// Number of worker threads, not counting the caller
+	void ParallelFor(size_t n, const function<void(size_t, size_t)>& Body, const ExecutionPolicy& Policy);	// Call Body(begin, end) over disjoint ranges covering [0, n)
+
+private:
+	ThreadPool(const ThreadPool& source);					// Not copyable
+	ThreadPool& operator = (const ThreadPool& source);		// Not assignable
+};
+
+ThreadPool& SharedThreadPool();						// Pool shared by every matrix function, one worker per hardware thread beyond the caller
+void SetSharedThreadCount(unsigned int Threads);	// Recreate the shared pool so it can run Threads threads including the caller, call while no loop is running
+unsigned int HardwareThreads();						// Number of hardware threads, at least 1
+
+void ParallelFor(size_t n, const function<void(size_t, size_t)>& Body, const ExecutionPolicy& Policy);		// ParallelFor on the shared pool
+
+#endif
@@ -0,0 +1,154 @@
+/*	Daniel McNulty II
+*
+*	Non-interactive batch pricer for perpetual American options, meant to be driven from scripts and
+*	pipelines instead of the menu in Final Exam Code.cpp. Option records (K, sig, r, U, b) are read from a file
+*	or standard input, priced in chunks and written out as they go, so memory use stays bounded however
+*	large the input is.
+*
+*	Usage: BatchPricer [options] [input file]
+*		-o FILE			write results to FILE instead of standard output
+*		--binary-in		input records are 5 packed doubles instead of CSV lines
+*		--binary-out	result records are 2 packed doubles (call, put) instead of CSV lines
+*		--threads N		threads used to price each chunk, 0 for every hardware thread (default 0)
+*		--chunk N		records priced together (default 65536)
+*		--header		write a line of column names before CSV results
+*		--make-book		convert the input records into an option book written to the -o file, nothing is priced
+*		--book			the input file is an option book, its prices are written to the -o file as a result book
+*
+*	A summary goes to standard error. The exit code is 0 on success, 1 for bad arguments or an I/O error.
+*/
+
+#include "PerpetualAmericanBook.h"
+#include "PerpetualAmericanOption.h"
+#include "PerpetualAmericanStream.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+	PerpStreamSettings Settings = Default_Perp_Stream;
+	const char* InputPath = nullptr;
+	const char* OutputPath = nullptr;
+	bool MakeBook = false;
+	bool BookIn = false;
+
+	// Read the command line
+	for (int i = 1; i < argc; i++)
+	{
+		string Arg = argv[i];
+		bool HasValue = (i + 1 < argc);
+		if ((Arg == "-o") && HasValue)
+		{
+			OutputPath = argv[++i];
+		}
+		else if (Arg == "--binary-in")
+		{
+			Settings.Input = Binary_Format;
+		}
+		else if (Arg == "--binary-out")
+		{
+			Settings.Output = Binary_Format;
+		}
+		else if ((Arg == "--threads") && HasValue)
+		{
+			Settings.Policy.Threads = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+		}
+		else if ((Arg == "--chunk") && HasValue)
+		{
+			Settings.ChunkRows = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+		}
+		else if (Arg == "--header")
+		{
+			Settings.Header = true;
+		}
+		else if (Arg == "--make-book")
+		{
+			MakeBook = true;
+		}
+		else if (Arg == "--book")
+		{
+			BookIn = true;
+		}
+		else if ((Arg[0] != '-') || (Arg == "-"))
+		{
+			InputPath = argv[i];
+		}
+		else
+		{
+			cerr << "ERROR: Unknown or incomplete option " << Arg << endl;
+			return 1;
+		}
+	}
+
+	// Books are mapped files, so both ends have to be named files
+	if ((MakeBook || BookIn) && ((OutputPath == nullptr) || (BookIn && ((InputPath == nullptr) || (strcmp(InputPath, "-") == 0)))))
+	{
+		cerr << "ERROR: --book needs an input file and -o, --make-book needs -o" << endl;
+		return 1;
+	}
+	if (BookIn)
+	{
+		if (!PricePerpetualBook(InputPath, OutputPath, Settings.Policy))
+		{
+			return 1;
+		}
+		cerr << "Priced book " << InputPath << " into " << OutputPath << endl;
+		return 0;
+	}
+
+	// Open the streams, standard input and output are switched to binary mode so Windows does not translate line endings
+#ifdef _WIN32
+	_setmode(_fileno(stdin), _O_BINARY);
+	_setmode(_fileno(stdout), _O_BINARY);
+#endif
+	FILE* In = ((InputPath == nullptr) || (strcmp(InputPath, "-") == 0)) ? stdin : fopen(InputPath, "rb");
+	FILE* Out = ((OutputPath == nullptr) || MakeBook) ? stdout : fopen(OutputPath, "wb");		// A book is created and mapped by name instead
+	if ((In == nullptr) || (Out == nullptr))
+	{
+		cerr << "ERROR: Could not open " << ((In == nullptr) ? InputPath : OutputPath) << endl;
+		return 1;
+	}
+
+	StreamSummary Summary;
+	if (MakeBook)
+	{
+		Summary.Failed = !StreamToBook(In, Settings.Input, Perpetual_Book, PerpetualBookColumns(), OutputPath, Summary);
+	}
+	else
+	{
+		Summary = PricePerpetualStream(In, Out, Settings);
+	}
+
+	if (In != stdin)
+	{
+		fclose(In);
+	}
+	if ((Out != stdout) && (fclose(Out) != 0))
+	{
+		Summary.Failed = true;
+	}
+
+	cerr << (MakeBook ? "Converted " : "Priced ") << Summary.Records << " records";
+	if (Summary.BadRecords > 0)
+	{
+		cerr << ", " << Summary.BadRecords << " could not be parsed and were written as NaN (first on line " << Summary.FirstBadLine << ")";
+	}
+	cerr << endl;
+	if (Summary.Failed)
+	{
+		cerr << "ERROR: Reading or writing failed, the output is incomplete" << endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,138 @@
+/*	Daniel McNulty II
+*
+*	"Benchmark Suite Source.cpp"
+*
+*	Benchmark of every perpetual American option pricing entry point at batch sizes from L1 resident up to DRAM
+*	bound. Progress goes to standard error and the results to standard output (or the -o file) as JSON,
+*	in ns/option and options/sec, so they can be kept and compared against earlier runs.
+*
+*	Usage: BenchmarkSuite [-o FILE] [--min-time SECONDS] [--max-batch N] [--threads N]
+*		-o FILE				write the JSON to FILE instead of standard output
+*		--min-time SECONDS	least time spent timing each case (default 0.2)
+*		--max-batch N		largest batch size (default 1048576)
+*		--threads N			threads used by the parallel cases, 0 for every hardware thread (default 0)
+*/
+
+#include "BenchmarkSuite.h"
+#include "PerpetualAmericanBatch.h"
+#include "PerpetualAmericanOption.h"
+#include "ThreadPool.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+using namespace std;
+
+int main(int argc, char* argv[])
+{
+	const char* OutputPath = nullptr;
+	double MinSeconds = 0.2;
+	size_t MaxBatch = 1048576;
+	ExecutionPolicy Parallel = Parallel_Execution;
+
+	// Read the command line
+	for (int i = 1; i < argc; i++)
+	{
+		string Arg = argv[i];
+		bool HasValue = (i + 1 < argc);
+		if ((Arg == "-o") && HasValue)
+			OutputPath = argv[++i];
+		else if ((Arg == "--min-time") && HasValue)
+			MinSeconds = atof(argv[++i]);
+		else if ((Arg == "--max-batch") && HasValue)
+			MaxBatch = static_cast<size_t>(strtoull(argv[++i], nullptr, 10));
+		else if ((Arg == "--threads") && HasValue)
+			Parallel.Threads = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+		else
+		{
+			cerr << "ERROR: Unknown or incomplete option " << Arg << endl;
+			return 1;
+		}
+	}
+	vector<size_t> Batches = BenchmarkBatchSizes(MaxBatch);
+	if (Batches.empty())
+	{
+		cerr << "ERROR: --max-batch must be at least " << BenchmarkBatchSizes(~size_t(0))[0] << endl;
+		return 1;
+	}
+
+	// One random book as large as the largest batch, smaller batches use its first rows. The cost of carry
+	// stays below the interest rate so every call has a finite price
+	mt19937_64 Generator(2020);
+	uniform_real_distribution<> Unit(0.0, 1.0);
+	size_t Rows = Batches.back();
+	vector<double> K(Rows), sig(Rows), r(Rows), U(Rows), b(Rows);
+	for (size_t i = 0; i < Rows; i++)
+	{
+		K[i] = 50.0 + 100.0 * Unit(Generator);
+		sig[i] = 0.1 + 0.5 * Unit(Generator);
+		r[i] = 0.04 + 0.06 * Unit(Generator);
+		U[i] = 50.0 + 100.0 * Unit(Generator);
+		b[i] = 0.03 * Unit(Generator);
+	}
+
+	BenchmarkSuite Suite("Perpetual American", MinSeconds);
+	Suite.AddProperty("parallel_threads", to_string((Parallel.Threads == 0) ? HardwareThreads() : Parallel.Threads));
+
+	const size_t RowBytes = 5 * sizeof(double);						// Parameters read per option
+	const size_t MatrixRowBytes = RowBytes + (3 * sizeof(void*));	// A matrix row also costs its vector header and its own allocation
+	for (size_t n : Batches)
+	{
+		// Scalar pricing functions, one call per option
+		Suite.Run("CallPrice", n, RowBytes, [&]() { double Sum = 0.0; for (size_t i = 0; i < n; i++) Sum += CallPrice(K[i], sig[i], r[i], U[i], b[i]); return Sum; });
+		Suite.Run("PutPrice", n, RowBytes, [&]() { double Sum = 0.0; for (size_t i = 0; i < n; i++) Sum += PutPrice(K[i], sig[i], r[i], U[i], b[i]); return Sum; });
+
+		// Matrix pricers, rows of (K, sig, r, U, b) in and rows of (call, put) out
+		vector<vector<double>> DataVec(n);
+		for (size_t i = 0; i < n; i++)
+		{
+			DataVec[i] = { K[i], sig[i], r[i], U[i], b[i] };
+		}
+		Suite.Run("MatrixPricer", n, MatrixRowBytes, [&]() { return MatrixPricer(DataVec).back()[0]; });
+		Suite.Run("MatrixPricer/parallel", n, MatrixRowBytes, [&]() { return MatrixPricer(DataVec, Parallel).back()[0]; });
+		DataVec = vector<vector<double>>();
+
+		// Batch pricers. Every random row has its own (sig, r, b), the strike sweep shares one group
+		PerpAmerOptBatch Batch(n), Sweep(n);
+		PerpAmerOptBatchResult Result;
+		for (size_t i = 0; i < n; i++)
+		{
+			Batch.K[i] = K[i]; Batch.sig[i] = sig[i]; Batch.r[i] = r[i]; Batch.U[i] = U[i]; Batch.b[i] = b[i];
+			Sweep.K[i] = K[i]; Sweep.sig[i] = 0.3; Sweep.r[i] = 0.06; Sweep.U[i] = 100.0; Sweep.b[i] = 0.02;
+		}
+		PerpAmerOptExponentPlan BatchPlan(Batch), SweepPlan(Sweep);
+		Suite.Run("PriceBatch", n, RowBytes, [&]() { PriceBatch(Batch, Result); return Result.Call.back(); });
+		Suite.Run("PriceBatch/parallel", n, RowBytes, [&]() { PriceBatch(Batch, Result, Parallel); return Result.Call.back(); });
+		Suite.Run("PriceBatch/sweep", n, RowBytes, [&]() { PriceBatch(Sweep, Result); return Result.Call.back(); });
+		for (int Path = Scalar_Path; Path <= DetectSimdPath(); Path++)
+		{
+			Suite.Run("PriceBatch/planned/" + SimdPathName(static_cast<SimdPath>(Path)), n, RowBytes, [&]() { PriceBatch(Batch, BatchPlan, Result, static_cast<SimdPath>(Path)); return Result.Call.back(); });
+			Suite.Run("PriceBatch/planned/sweep/" + SimdPathName(static_cast<SimdPath>(Path)), n, RowBytes, [&]() { PriceBatch(Sweep, SweepPlan, Result, static_cast<SimdPath>(Path)); return Result.Call.back(); });
+		}
+
+		// Generators, one option row or mesh point per unit
+		int Steps = static_cast<int>(n) - 1;
+		Suite.Run("GenerateParameterMatrix", n, MatrixRowBytes, [&]() { return GenerateParameterMatrix(100.0, 0.1, 0.1, 110.0, 0.02, 0.6, Steps, Sigma).back()[1]; });
+		Suite.Run("GenerateParameterMatrix/parallel", n, MatrixRowBytes, [&]() { return GenerateParameterMatrix(100.0, 0.1, 0.1, 110.0, 0.02, 0.6, Steps, Sigma, Parallel).back()[1]; });
+		Suite.Run("GenerateMeshArray", n, sizeof(double), [&]() { return GenerateMeshArray(50.0, 150.0, Steps).back(); });
+	}
+
+	if (OutputPath == nullptr)
+	{
+		Suite.WriteJson(cout);
+		return 0;
+	}
+
+	ofstream File(OutputPath);
+	Suite.WriteJson(File);
+	File.close();
+	if (!File)
+	{
+		cerr << "ERROR: Could not write " << OutputPath << endl;
+		return 1;
+	}
+
+	return 0;
+}
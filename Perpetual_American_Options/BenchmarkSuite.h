@@ -0,0 +1,58 @@
+/*	Daniel McNulty II
+*
+*	BenchmarkSuite.h
+*
+*	Timing harness shared by the benchmark mains. Every case is run once to warm the caches and fault
+*	in its memory, then repeatedly until it has at least MinSamples timed samples covering MinSeconds.
+*	The median and the fastest sample are reported per option, and the whole run is written out as
+*	JSON so results can be stored and compared between builds and machines.
+*/
+
+#ifndef BenchmarkSuite_H
+#define BenchmarkSuite_H
+
+#include <cstddef>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+struct BenchmarkResult		// Timing of one case at one batch size
+{
+	string Name;				// Entry point and variant timed
+	size_t BatchSize;			// Options per call of the case
+	size_t WorkingSetBytes;		// Bytes of input and output the case touches per call
+	size_t Samples;				// Timed calls
+	double MedianNs;			// Median time per option
+	double MinNs;				// Fastest time per option
+	double OptionsPerSec;		// Options per second at the median time
+};
+
+class BenchmarkSuite		// Runs timed cases and collects their results
+{
+private:
+	string Model;						// Option model the suite covers
+	double MinSeconds;					// Least total time spent on the timed samples of a case
+	size_t MinSamples;					// Least number of timed samples of a case
+	vector<BenchmarkResult> Results;	// Results in the order the cases were run
+	vector<pair<string, string>> Properties;	// Extra description of the run, written at the top of the JSON document
+	double Sink;						// Sum of every value the cases return, reported so no timed work can be optimized away
+
+public:
+	// Constructors
+	BenchmarkSuite(const string& Model, double MinSeconds);		// Constructor that accepts the model name and the least time per case
+	// Destructors
+	virtual ~BenchmarkSuite();									// Default destructor
+
+	// Functionality
+	void AddProperty(const string& Key, const string& Value);	// Describe the run, for example the code path or thread count used
+	void Run(const string& Name, size_t BatchSize, size_t BytesPerOption, const function<double()>& Case);	// Time Case, one call of which handles BatchSize options and returns a value derived from its results
+	const vector<BenchmarkResult>& GetResults() const;			// Results so far
+	void WriteJson(ostream& Out) const;							// Write the machine description and every result as one JSON document
+};
+
+vector<size_t> BenchmarkBatchSizes(size_t MaxBatch);		// Batch sizes from L1 resident up to DRAM bound, none larger than MaxBatch
+
+#endif
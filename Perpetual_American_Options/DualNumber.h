@@ -0,0 +1,259 @@
+/*	Daniel McNulty II
+*
+*	DualNumber.h
+*
+*	Forward mode algorithmic differentiation with multi-component dual numbers. A Dual<N> carries a value
+*	and its partial derivatives with respect to N variables, and every operation applies the chain rule to
+*	all N at once, so one evaluation of a templated pricer gives the price and its whole gradient. The
+*	derivatives sit in a fixed size contiguous array and each operation is a loop of N independent
+*	multiply-adds over it, which the compiler unrolls and vectorizes.
+*
+*	The component type is itself a template parameter. Dual<N, Dual<N>> differentiates the first order
+*	result again, giving the value, gradient and full matrix of second derivatives from the same pass.
+*	Values are computed with the same double expressions as the plain function, so the value of a dual
+*	evaluation is identical to the double one. The header only needs <cmath> so both projects keep a copy.
+*/
+
+#ifndef DualNumber_H
+#define DualNumber_H
+
+#include <cmath>
+using namespace std;
+
+template <int N, class Scalar = double>
+class Dual;
+
+inline double DualSeed(double x, int, double*)		// Value of a plain component
+{
+	return x;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> DualSeed(double x, int i, Dual<N, Scalar>*)		// Value of a nested component, itself seeded as variable i
+{
+	return Dual<N, Scalar>::Variable(x, i);
+}
+
+template <int N, class Scalar>
+class Dual
+{
+public:
+	Scalar Value;		// Value of the function
+	Scalar d[N];		// Partial derivative with respect to each variable
+
+	// Constructors
+	Dual() : Value(0.0), d() {}									// Default constructor, the constant 0
+	Dual(double newValue) : Value(newValue), d() {}				// Constructor of a constant
+	Dual(const Scalar& newValue, int) : Value(newValue), d() {}	// Constructor of a constant from a component value, the int only tells it apart from the one above
+
+	static Dual Variable(double x, int i)		// Variable i with value x, dx/dx_i = 1, nested components are seeded the same way
+	{
+		Dual Out(DualSeed(x, i, static_cast<Scalar*>(nullptr)), 0);
+		Out.d[i] = Scalar(1.0);
+		return Out;
+	}
+};
+
+inline double DualValue(double x)		// Innermost value of a plain double
+{
+	return x;
+}
+
+template <int N, class Scalar>
+inline double DualValue(const Dual<N, Scalar>& x)		// Innermost value of a dual
+{
+	return DualValue(x.Value);
+}
+
+// Chain rule helper, f(x) with component derivative Slope
+template <int N, class Scalar>
+inline Dual<N, Scalar> DualChain(const Scalar& Value, const Dual<N, Scalar>& x, const Scalar& Slope)
+{
+	Dual<N, Scalar> Out(Value, 0);
+	for (int i = 0; i < N; i++)
+	{
+		Out.d[i] = Slope * x.d[i];
+	}
+	return Out;
+}
+
+// Arithmetic operators
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator + (const Dual<N, Scalar>& a, const Dual<N, Scalar>& b)
+{
+	Dual<N, Scalar> Out(a.Value + b.Value, 0);
+	for (int i = 0; i < N; i++)
+	{
+		Out.d[i] = a.d[i] + b.d[i];
+	}
+	return Out;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator - (const Dual<N, Scalar>& a, const Dual<N, Scalar>& b)
+{
+	Dual<N, Scalar> Out(a.Value - b.Value, 0);
+	for (int i = 0; i < N; i++)
+	{
+		Out.d[i] = a.d[i] - b.d[i];
+	}
+	return Out;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator * (const Dual<N, Scalar>& a, const Dual<N, Scalar>& b)
+{
+	Dual<N, Scalar> Out(a.Value * b.Value, 0);
+	for (int i = 0; i < N; i++)
+	{
+		Out.d[i] = (a.d[i] * b.Value) + (a.Value * b.d[i]);
+	}
+	return Out;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator / (const Dual<N, Scalar>& a, const Dual<N, Scalar>& b)
+{
+	Dual<N, Scalar> Out(a.Value / b.Value, 0);
+	Scalar Inverse = 1.0 / b.Value;
+	for (int i = 0; i < N; i++)
+	{
+		Out.d[i] = (a.d[i] - (Out.Value * b.d[i])) * Inverse;
+	}
+	return Out;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator - (const Dual<N, Scalar>& a)
+{
+	Dual<N, Scalar> Out(-a.Value, 0);
+	for (int i = 0; i < N; i++)
+	{
+		Out.d[i] = -a.d[i];
+	}
+	return Out;
+}
+
+// Operators with a constant, which has no derivatives
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator + (const Dual<N, Scalar>& a, double b)
+{
+	Dual<N, Scalar> Out(a);
+	Out.Value = a.Value + b;
+	return Out;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator + (double a, const Dual<N, Scalar>& b)
+{
+	Dual<N, Scalar> Out(b);
+	Out.Value = a + b.Value;
+	return Out;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator - (const Dual<N, Scalar>& a, double b)
+{
+	Dual<N, Scalar> Out(a);
+	Out.Value = a.Value - b;
+	return Out;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator - (double a, const Dual<N, Scalar>& b)
+{
+	Dual<N, Scalar> Out = -b;
+	Out.Value = a - b.Value;
+	return Out;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator * (const Dual<N, Scalar>& a, double b)
+{
+	Dual<N, Scalar> Out(a.Value * b, 0);
+	for (int i = 0; i < N; i++)
+	{
+		Out.d[i] = a.d[i] * b;
+	}
+	return Out;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator * (double a, const Dual<N, Scalar>& b)
+{
+	Dual<N, Scalar> Out(a * b.Value, 0);
+	for (int i = 0; i < N; i++)
+	{
+		Out.d[i] = a * b.d[i];
+	}
+	return Out;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator / (const Dual<N, Scalar>& a, double b)
+{
+	Dual<N, Scalar> Out(a.Value / b, 0);
+	for (int i = 0; i < N; i++)
+	{
+		Out.d[i] = a.d[i] / b;
+	}
+	return Out;
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> operator / (double a, const Dual<N, Scalar>& b)
+{
+	return Dual<N, Scalar>(a) / b;
+}
+
+// Comparisons, on the value only
+template <int N, class Scalar> inline bool operator == (const Dual<N, Scalar>& a, double b) { return a.Value == b; }
+template <int N, class Scalar> inline bool operator != (const Dual<N, Scalar>& a, double b) { return a.Value != b; }
+template <int N, class Scalar> inline bool operator < (const Dual<N, Scalar>& a, double b) { return a.Value < b; }
+template <int N, class Scalar> inline bool operator > (const Dual<N, Scalar>& a, double b) { return a.Value > b; }
+
+// Elementary functions
+template <int N, class Scalar>
+inline Dual<N, Scalar> exp(const Dual<N, Scalar>& x)		// e^x
+{
+	Scalar Value = exp(x.Value);
+	return DualChain(Value, x, Value);
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> log(const Dual<N, Scalar>& x)		// Natural logarithm
+{
+	return DualChain(Scalar(log(x.Value)), x, Scalar(1.0 / x.Value));
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> sqrt(const Dual<N, Scalar>& x)		// Square root
+{
+	Scalar Value = sqrt(x.Value);
+	return DualChain(Value, x, Scalar(0.5 / Value));
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> pow(const Dual<N, Scalar>& x, double p)		// x^p for a constant power
+{
+	if (p == 2.0)
+	{
+		return DualChain(Scalar(x.Value * x.Value), x, Scalar(2.0 * x.Value));		// Optimizing compilers take pow(x, 2) as x * x, which can differ from the library pow in the last bit
+	}
+	return DualChain(Scalar(pow(x.Value, p)), x, Scalar(p * pow(x.Value, p - 1.0)));
+}
+
+template <int N, class Scalar>
+inline Dual<N, Scalar> pow(const Dual<N, Scalar>& x, const Dual<N, Scalar>& p)		// x^p for x > 0, d(x^p) = x^p (p dx / x + log(x) dp)
+{
+	Dual<N, Scalar> Out(pow(x.Value, p.Value), 0);
+	Scalar Base = p.Value / x.Value;
+	Scalar Log = log(x.Value);
+	for (int i = 0; i < N; i++)
+	{
+		Out.d[i] = Out.Value * ((Base * x.d[i]) + (Log * p.d[i]));
+	}
+	return Out;
+}
+
+#endif
@@ -0,0 +1,183 @@
+/*	Daniel McNulty II
+*
+*	"Greeks Test Source.cpp"
+*
+*	Checks the analytic perpetual American sensitivities against central divided differences of Price(),
+*	first for the Group B test option and then over a grid of parameters, for the class members and for
+*	GreeksBatch(). The second order dual pass of HessianBatch() is checked against the class members as
+*	well, with its price identical to Price(). Returns 1 if any sensitivity is further from its reference
+*	than the tolerance.
+*/
+
+#include "PerpetualAmericanBatch.h"
+#include "PerpetualAmericanDual.h"
+#include "PerpetualAmericanOption.h"
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+enum GreekParam		// Sensitivity under test
+{
+	Delta_Greek,
+	Gamma_Greek,
+	Vega_Greek,
+	Rho_Greek,
+	CarryRho_Greek,
+	Greek_Count
+};
+
+const string GreekNames[Greek_Count] = { "Delta", "Gamma", "Vega", "Rho", "CarryRho" };
+const double Tolerance = 1e-5;		// Largest accepted error, relative to max(1, |sensitivity|)
+
+double Analytic(const PerpetualAmericanOption& Opt, GreekParam Greek)		// Sensitivity from the class member
+{
+	switch (Greek)
+	{
+	case (Delta_Greek):
+		return Opt.Delta();
+	case (Gamma_Greek):
+		return Opt.Gamma();
+	case (Vega_Greek):
+		return Opt.Vega();
+	case (Rho_Greek):
+		return Opt.Rho();
+	default:
+		return Opt.CarryRho();
+	}
+}
+
+double Bumped(PerpetualAmericanOption Opt, GreekParam Greek, double h)		// Price with the parameter of Greek moved by h
+{
+	switch (Greek)
+	{
+	case (Vega_Greek):
+		Opt.sig += h;
+		break;
+	case (Rho_Greek):
+		Opt.r += h;			// The yield r - b is held fixed
+		Opt.b += h;
+		break;
+	case (CarryRho_Greek):
+		Opt.b += h;
+		break;
+	default:
+		Opt.U += h;
+		break;
+	}
+	return Opt.Price();
+}
+
+double FromDual(const PerpAmerOptDual2& Value, GreekParam Greek)		// Sensitivity from a second order dual pass
+{
+	switch (Greek)
+	{
+	case (Delta_Greek):
+		return Value.Value.d[Underlying];
+	case (Gamma_Greek):
+		return Value.d[Underlying].d[Underlying];
+	case (Vega_Greek):
+		return Value.Value.d[Sigma];
+	case (Rho_Greek):
+		return Value.Value.d[Interest] + Value.Value.d[Cost_Of_Carry];		// The yield r - b is held fixed
+	default:
+		return Value.Value.d[Cost_Of_Carry];
+	}
+}
+
+double Divided(const PerpetualAmericanOption& Opt, GreekParam Greek)		// Central divided difference of Price()
+{
+	if (Greek == Gamma_Greek)
+	{
+		double h = 1e-4 * Opt.U;
+		return (Bumped(Opt, Greek, h) - (2 * Opt.Price()) + Bumped(Opt, Greek, -h)) / (h * h);
+	}
+
+	double h = (Greek == Delta_Greek) ? (1e-5 * Opt.U) : 1e-6;
+	return (Bumped(Opt, Greek, h) - Bumped(Opt, Greek, -h)) / (2 * h);
+}
+
+double Error(double Value, double Reference)		// Error relative to max(1, |Reference|)
+{
+	return fabs(Value - Reference) / fmax(1.0, fabs(Reference));
+}
+
+int main()
+{
+	// The Group B test option
+	PerpetualAmericanOption TestData(100, 0.1, 0.1, 110, 0.02);
+	cout << "Perpetual American sensitivities with K = 100, sig = 0.1, r = 0.1, b = 0.02, S = 110" << endl << "GREEK    | CALL ANALYTIC | CALL DIVIDED | PUT ANALYTIC | PUT DIVIDED" << endl;
+	for (int g = 0; g < Greek_Count; g++)
+	{
+		GreekParam Greek = static_cast<GreekParam>(g);
+		PerpetualAmericanOption PutData(TestData.K, TestData.sig, TestData.r, TestData.U, TestData.b, Put);
+		cout << left << setw(9) << GreekNames[g] << "| " << setw(14) << Analytic(TestData, Greek) << "| " << setw(13) << Divided(TestData, Greek) << "| " << setw(13) << Analytic(PutData, Greek) << "| " << Divided(PutData, Greek) << endl;
+	}
+
+	// Grid of parameters with b < r, where every call has a finite price
+	PerpAmerOptBatch Batch;
+	vector<PerpetualAmericanOption> Options;
+	for (double sig : { 0.1, 0.25, 0.4 })
+	{
+		for (double r : { 0.03, 0.08 })
+		{
+			for (double b : { -0.02, 0.0, 0.02 })
+			{
+				for (double U : { 60.0, 95.0, 110.0, 150.0 })
+				{
+					Batch.AddRow(100.0, sig, r, U, b);
+					Options.push_back(PerpetualAmericanOption(100.0, sig, r, U, b));
+				}
+			}
+		}
+	}
+	PerpAmerOptGreeksResult Greeks;
+	GreeksBatch(Batch, Greeks);
+	const PerpAmerOptBatchResult* BatchColumns[Greek_Count] = { &Greeks.Delta, &Greeks.Gamma, &Greeks.Vega, &Greeks.Rho, &Greeks.CarryRho };
+
+	// Worst error of each sensitivity over the grid, class against divided differences, batch and dual pass against class
+	double WorstDivided[Greek_Count] = {}, WorstBatch[Greek_Count] = {}, WorstDual[Greek_Count] = {};
+	bool Identical = true;
+	for (size_t i = 0; i < Options.size(); i++)
+	{
+		for (OptionType Type : { Call, Put })
+		{
+			PerpetualAmericanOption Opt = Options[i];
+			Opt.optionType = Type;
+			PerpAmerOptDual2 Dual = (Type == Call) ? CallDual2(Opt.K, Opt.sig, Opt.r, Opt.U, Opt.b) : PutDual2(Opt.K, Opt.sig, Opt.r, Opt.U, Opt.b);
+			Identical = Identical && (Dual.Value.Value == Opt.Price());
+			for (int g = 0; g < Greek_Count; g++)
+			{
+				double Value = Analytic(Opt, static_cast<GreekParam>(g));
+				double BatchValue = (Type == Call) ? BatchColumns[g]->Call[i] : BatchColumns[g]->Put[i];
+				WorstDivided[g] = fmax(WorstDivided[g], Error(Value, Divided(Opt, static_cast<GreekParam>(g))));
+				WorstBatch[g] = fmax(WorstBatch[g], Error(BatchValue, Value));
+				WorstDual[g] = fmax(WorstDual[g], Error(FromDual(Dual, static_cast<GreekParam>(g)), Value));
+			}
+		}
+	}
+
+	// The dual batch against the single option pass
+	AlignedColumn DualPrices;
+	PerpAmerOptBatch Gradient;
+	vector<PerpAmerOptBatch> Hessian;
+	HessianBatch(Batch, Put, DualPrices, Gradient, Hessian, Parallel_Execution);
+	size_t Row = Batch.Size() - 1;
+	PerpAmerOptDual2 Last = PutDual2(Batch.K[Row], Batch.sig[Row], Batch.r[Row], Batch.U[Row], Batch.b[Row]);
+	Identical = Identical && (DualPrices[Row] == Last.Value.Value) && (Gradient.sig[Row] == Last.Value.d[Sigma]) && (Hessian[Sigma].U[Row] == Last.d[Sigma].d[Underlying]);
+
+	bool Passed = Identical;
+	cout << endl << "Worst error over " << Options.size() << " calls and puts, relative to max(1, |sensitivity|)" << endl << "GREEK    | CLASS VS DIVIDED | BATCH VS CLASS | DUAL VS CLASS" << endl;
+	for (int g = 0; g < Greek_Count; g++)
+	{
+		cout << left << setw(9) << GreekNames[g] << "| " << setw(17) << WorstDivided[g] << "| " << setw(15) << WorstBatch[g] << "| " << WorstDual[g] << endl;
+		Passed = Passed && (WorstDivided[g] < Tolerance) && (WorstBatch[g] < Tolerance) && (WorstDual[g] < Tolerance);
+	}
+	cout << "Dual prices and batch rows identical to Price() and the single option pass: " << (Identical ? "YES" : "NO") << endl;
+	cout << endl << (Passed ? "PASSED" : "FAILED") << endl;
+
+	return Passed ? 0 : 1;
+}
@@ -0,0 +1,175 @@
+/*	Daniel McNulty II
+*
+*	"Live Book Test Source.cpp"
+*
+*	Checks the live perpetual American book: a tick reprices the options of its underlying to the values
+*	of PerpetualAmericanOption at the new spot and leaves other underlyings alone, a burst of ticks posted
+*	from several feed threads is conflated into one reprice per underlying at its latest spot, Start() and
+*	Stop() can be called repeatedly and in any order, and the options left in a group after RemoveOption()
+*	keep their own outputs. Returns 1 on any failure.
+*/
+
+#include "PerpetualAmericanOption.h"
+#include "PerpetualLiveBook.h"
+#include "ThreadPool.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+bool Check(const char* Name, bool Passed)		// Print one result, true if it passed
+{
+	cout << left << setw(52) << Name << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed;
+}
+
+double Relative(double Value, double Exact)		// Error relative to Exact, absolute below 1
+{
+	return fabs(Value - Exact) / fmax(1.0, fabs(Exact));
+}
+
+double QuoteError(const PerpLiveBook& Book, size_t Id, PerpetualAmericanOption Option, double Spot)		// Largest error of a live quote against the option priced at Spot
+{
+	Option.U = Spot;
+	PerpLiveQuote Live = Book.Quote(Id);
+	double Errors[3] = { Relative(Live.Price, Option.Price()), Relative(Live.Delta, Option.Delta()), Relative(Live.Gamma, Option.Gamma()) };
+	double Worst = (Live.Spot == Spot) ? 0.0 : 1.0;
+	for (double Error : Errors)
+	{
+		Worst = fmax(Worst, Error);
+	}
+	return Worst;
+}
+
+bool WaitForSpot(const PerpLiveBook& Book, size_t Id, double Spot)		// Poll until the option has been repriced at Spot, false after 5 seconds
+{
+	for (int Poll = 0; Poll < 5000; Poll++)
+	{
+		if (Book.Quote(Id).Spot == Spot)
+		{
+			return true;
+		}
+		this_thread::sleep_for(chrono::milliseconds(1));
+	}
+	return false;
+}
+
+int main()
+{
+	bool Passed = true;
+	SetSharedThreadCount(4);
+
+	// Random calls and puts on underlyings 7, 8 and 9, all starting at a spot of 100
+	PerpLiveBook Book;
+	mutex UpdateLock;
+	map<unsigned int, int> Updates;
+	Book.Subscribe([&](const PerpLiveUpdate& Update)
+	{
+		lock_guard<mutex> Guard(UpdateLock);
+		Updates[Update.Underlying]++;
+	});
+
+	mt19937_64 Generator(2020);
+	uniform_real_distribution<> Unit(0.0, 1.0);
+	vector<PerpetualAmericanOption> Options;
+	vector<unsigned int> Underlyings;
+	vector<size_t> Ids;
+	for (int i = 0; i < 300; i++)
+	{
+		double r = 0.03 + 0.07 * Unit(Generator);
+		PerpetualAmericanOption Option(60.0 + 80.0 * Unit(Generator), 0.1 + 0.5 * Unit(Generator), r, 100.0, r - 0.01 - 0.05 * Unit(Generator), (i % 2 == 0) ? Call : Put);		// b < r, so every call has a finite price
+		unsigned int Underlying = 7 + (i % 3);
+		Options.push_back(Option);
+		Underlyings.push_back(Underlying);
+		Ids.push_back(Book.AddOption(Underlying, Option));
+	}
+	Passed = Check("Options and underlyings counted", (Book.OptionCount() == 300) && (Book.UnderlyingCount() == 3)) && Passed;
+
+	// One tick reprices its own underlying only
+	Book.ApplyTick(7, 104.5, Parallel_Execution);
+	double Worst = 0.0;
+	for (size_t i = 0; i < Ids.size(); i++)
+	{
+		Worst = fmax(Worst, QuoteError(Book, Ids[i], Options[i], (Underlyings[i] == 7) ? 104.5 : 100.0));
+	}
+	cout << "Largest error of a live quote against PerpetualAmericanOption " << Worst << endl;
+	Passed = Check("Tick matches PerpetualAmericanOption at new spot", Worst < 1e-11) && Passed;
+
+	// A burst of ticks from two feed threads, each posting one underlying, is conflated into one reprice per underlying
+	Updates.clear();
+	const int Burst = 20000;
+	vector<thread> Feeds;
+	for (unsigned int Underlying : { 8u, 9u })
+	{
+		Feeds.push_back(thread([&Book, Underlying]()
+		{
+			for (int t = 1; t <= Burst; t++)
+			{
+				Book.PostTick(Underlying, 90.0 + (20.0 * t) / Burst);
+			}
+		}));
+	}
+	for (thread& Feed : Feeds)
+	{
+		Feed.join();
+	}
+	Book.PostTick(99, 50.0);		// No options, dropped
+	size_t Repriced = Book.ProcessTicks(Parallel_Execution);
+	Worst = 0.0;
+	for (size_t i = 0; i < Ids.size(); i++)
+	{
+		Worst = fmax(Worst, QuoteError(Book, Ids[i], Options[i], (Underlyings[i] == 7) ? 104.5 : 110.0));
+	}
+	Passed = Check("Burst conflated into one reprice per underlying", (Repriced == 2) && (Updates.size() == 2) && (Updates[8] == 1) && (Updates[9] == 1)) && Passed;
+	Passed = Check("Conflated reprice uses the latest spot", Worst < 1e-11) && Passed;
+	Passed = Check("Nothing left queued after ProcessTicks", Book.ProcessTicks() == 0) && Passed;
+
+	// Start and Stop repeated and out of order
+	Book.Stop();							// No worker yet
+	Book.Start(Parallel_Execution);
+	Book.Start(Parallel_Execution);			// Replaces the running worker
+	Book.PostTick(7, 101.0);
+	bool Running = WaitForSpot(Book, Ids[0], 101.0);
+	Book.Stop();
+	Book.Stop();
+	Book.PostTick(7, 102.0);
+	this_thread::sleep_for(chrono::milliseconds(50));
+	bool Stopped = (Book.Quote(Ids[0]).Spot == 101.0);
+	bool Manual = (Book.ProcessTicks() == 1) && (Book.Quote(Ids[0]).Spot == 102.0);
+	Book.Start(Serial_Execution);
+	Book.PostTick(7, 103.0);
+	bool Restarted = WaitForSpot(Book, Ids[0], 103.0);
+	Book.Stop();
+	Passed = Check("Started worker reprices posted ticks", Running) && Passed;
+	Passed = Check("Stopped book leaves ticks queued", Stopped && Manual) && Passed;
+	Passed = Check("Book restarts after Stop", Restarted) && Passed;
+
+	// Removing options moves the last slot into the hole, the options left keep their own outputs
+	vector<size_t> GroupIds;
+	for (size_t i = 0; i < 6; i++)
+	{
+		GroupIds.push_back(Book.AddOption(20, Options[i]));
+	}
+	Book.RemoveOption(GroupIds[0]);
+	Book.RemoveOption(GroupIds[3]);
+	Book.RemoveOption(GroupIds[5]);		// The last slot
+	Book.RemoveOption(GroupIds[3]);		// Already removed, ignored
+	Book.ApplyTick(20, 95.0);
+	Worst = 0.0;
+	for (size_t i : { 1, 2, 4 })
+	{
+		Worst = fmax(Worst, QuoteError(Book, GroupIds[i], Options[i], 95.0));
+	}
+	bool Removed = isnan(Book.Quote(GroupIds[0]).Price) && isnan(Book.Quote(GroupIds[3]).Price) && isnan(Book.Quote(GroupIds[5]).Price);
+	Passed = Check("Options left after RemoveOption keep their outputs", Worst < 1e-11) && Passed;
+	Passed = Check("Removed options quote NaN", Removed && (Book.OptionCount() == 303)) && Passed;
+
+	cout << endl << (Passed ? "PASSED" : "FAILED") << endl;
+	return Passed ? 0 : 1;
+}
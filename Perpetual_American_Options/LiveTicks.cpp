@@ -0,0 +1,68 @@
+/*	Daniel McNulty II
+*
+*	LiveTicks.cpp
+*/
+
+#include "LiveTicks.h"
+
+using namespace std;
+
+// Constructors
+TickConflator::TickConflator() : Stopping(false) {}		// Default constructor
+
+// Destructors
+TickConflator::~TickConflator() {}		// Default destructor
+
+// Functionality
+void TickConflator::Post(unsigned int Underlying, double Spot)		// Queue a tick, replacing the spot of one already waiting for the same underlying
+{
+	{
+		lock_guard<mutex> Guard(Lock);
+		unordered_map<unsigned int, size_t>::iterator Found = Slot.find(Underlying);
+		if (Found != Slot.end())
+		{
+			Ticks[Found->second].Spot = Spot;		// Keep the first post time, the update is late by that much
+			return;
+		}
+		Slot[Underlying] = Ticks.size();
+		Ticks.push_back({ Underlying, Spot, chrono::steady_clock::now() });
+	}
+	Ready.notify_one();
+}
+
+size_t TickConflator::Drain(vector<PendingTick>& Out)		// Move every waiting tick into Out and empty the queue
+{
+	Out.clear();
+	lock_guard<mutex> Guard(Lock);
+	Out.swap(Ticks);		// Out's old storage is reused by the next ticks
+	Slot.clear();
+	return Out.size();
+}
+
+bool TickConflator::Wait()			// Block until a tick is waiting or Stop() is called
+{
+	unique_lock<mutex> Guard(Lock);
+	Ready.wait(Guard, [this]() { return Stopping || !Ticks.empty(); });
+	return !Stopping;
+}
+
+void TickConflator::Stop()			// Wake every waiter
+{
+	{
+		lock_guard<mutex> Guard(Lock);
+		Stopping = true;
+	}
+	Ready.notify_all();
+}
+
+void TickConflator::Restart()		// Allow Wait() to block again after Stop()
+{
+	lock_guard<mutex> Guard(Lock);
+	Stopping = false;
+}
+
+size_t TickConflator::Size()		// Number of underlyings waiting
+{
+	lock_guard<mutex> Guard(Lock);
+	return Ticks.size();
+}
@@ -0,0 +1,57 @@
+/*	Daniel McNulty II
+*
+*	LiveTicks.h
+*
+*	Conflating queue of spot ticks for the live books. Ticks can be posted from any number of feed
+*	threads. A tick for an underlying that already has one waiting replaces its spot, so the queue never
+*	holds more than one tick per underlying and a slow pricing cycle cannot build up a backlog: every
+*	underlying is repriced at most once per drain, at its latest spot.
+*/
+
+#ifndef LiveTicks_H
+#define LiveTicks_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+struct PendingTick		// Latest spot of an underlying waiting to be priced
+{
+	unsigned int Underlying;					// Underlying ID
+	double Spot;								// Latest spot posted
+	chrono::steady_clock::time_point Posted;	// When the oldest tick this one replaced was posted, for latency measurement
+};
+
+class TickConflator		// Thread-safe queue that keeps only the latest tick of each underlying
+{
+private:
+	mutex Lock;								// Guards everything below
+	condition_variable Ready;				// Signalled when a tick is posted or the queue is stopped
+	vector<PendingTick> Ticks;				// Waiting ticks in the order their underlyings were first posted
+	unordered_map<unsigned int, size_t> Slot;	// Position of each waiting underlying in Ticks
+	bool Stopping;							// Set by Stop(), wakes every waiter
+
+public:
+	// Constructors
+	TickConflator();						// Default constructor, creates an empty queue
+	// Destructors
+	virtual ~TickConflator();				// Default destructor
+
+	// Functionality
+	void Post(unsigned int Underlying, double Spot);		// Queue a tick, replacing the spot of one already waiting for the same underlying
+	size_t Drain(vector<PendingTick>& Out);					// Move every waiting tick into Out and empty the queue, returns the number moved
+	bool Wait();											// Block until a tick is waiting or Stop() is called, false once stopped
+	void Stop();											// Wake every waiter, later Wait() calls return false at once
+	void Restart();											// Allow Wait() to block again after Stop()
+	size_t Size();											// Number of underlyings waiting
+
+private:
+	TickConflator(const TickConflator& source);					// Not copyable
+	TickConflator& operator = (const TickConflator& source);	// Not assignable
+};
+
+#endif
@@ -0,0 +1,74 @@
+/*	Daniel McNulty II
+*
+*	PerpetualAmericanAVX2.cpp
+*
+*	AVX2 + FMA path of the perpetual American batch pricer, four rows per vector. MSVC builds this file with
+*	/arch:AVX2 (set per file in the project); GCC and Clang get the same instruction set from the pragma
+*	below. Nothing in here may be called unless DetectSimdPath() has reported AVX2 support.
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+
+#if defined(__GNUC__) && !defined(__AVX2__)
+#pragma GCC target("avx2,fma")
+#endif
+
+#include "PerpetualAmericanSIMDKernel.h"
+
+struct AVX2Lanes		// Four doubles per __m256d
+{
+	typedef __m256d Vec;
+	typedef __m256d Mask;
+	static const size_t Width = 4;
+
+	static Vec Load(const double* p) { return _mm256_loadu_pd(p); }
+	static void Store(double* p, Vec a) { _mm256_storeu_pd(p, a); }
+	static Vec Set1(double a) { return _mm256_set1_pd(a); }
+
+	static Vec Add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+	static Vec Sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+	static Vec Mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+	static Vec Div(Vec a, Vec b) { return _mm256_div_pd(a, b); }
+	static Vec Fma(Vec a, Vec b, Vec c) { return _mm256_fmadd_pd(a, b, c); }
+	static Vec Sqrt(Vec a) { return _mm256_sqrt_pd(a); }
+	static Vec Abs(Vec a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+	static Vec Min(Vec a, Vec b) { return _mm256_min_pd(a, b); }
+	static Vec Max(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+	static Vec Round(Vec a) { return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+	static Mask Less(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+	static Mask Greater(Vec a, Vec b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+	static Vec Select(Mask m, Vec a, Vec b) { return _mm256_blendv_pd(b, a, m); }
+
+	static Vec Exp2Int(Vec n)		// 2^n for integer valued n in [-1022, 1023], the sum puts n + 1023 in the low mantissa bits
+	{
+		__m256i Bits = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(4503599627370496.0 + 1023.0)));
+		return _mm256_castsi256_pd(_mm256_slli_epi64(Bits, 52));
+	}
+
+	static Vec Exponent(Vec a)		// Unbiased binary exponent of a positive normal a, as a double
+	{
+		__m256i Biased = _mm256_srli_epi64(_mm256_castpd_si256(a), 52);
+		Vec AsDouble = _mm256_castsi256_pd(_mm256_or_si256(Biased, _mm256_set1_epi64x(0x4330000000000000LL)));
+		return _mm256_sub_pd(AsDouble, _mm256_set1_pd(4503599627370496.0 + 1023.0));
+	}
+
+	static Vec Mantissa(Vec a)		// Mantissa of a positive normal a, scaled into [1, 2)
+	{
+		__m256i Bits = _mm256_and_si256(_mm256_castpd_si256(a), _mm256_set1_epi64x(0x000FFFFFFFFFFFFFLL));
+		return _mm256_castsi256_pd(_mm256_or_si256(Bits, _mm256_set1_epi64x(0x3FF0000000000000LL)));
+	}
+};
+
+void PowerKernelAVX2(size_t n, const double* K, const double* U, const double* Y1, const double* C1, const double* Y2, const double* C2, double* Call, double* Put)
+{
+	PowerKernelRange<AVX2Lanes>(n, K, U, Y1, C1, Y2, C2, Call, Put);
+}
+
+#endif
@@ -0,0 +1,500 @@
+/*	Daniel McNulty II
+*
+*	PerpetualAmericanBatch.cpp
+*/
+
+#include "PerpetualAmericanBatch.h"
+#include "PerpetualAmericanKernels.h"
+#include "PerpetualAmericanSIMDKernel.h"
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+#if defined(PERPETUAL_SIMD_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(PERPETUAL_SIMD_X86) && defined(__GNUC__)
+#include <cpuid.h>
+#endif
+
+using namespace std;
+
+const size_t PowerChunkRows = 256;		// Rows whose group terms are gathered at once, the gathered columns stay in L1
+
+struct ExponentKey		// (sig, r, b) of a row, two keys match when all three compare equal
+{
+	double sig;
+	double r;
+	double b;
+
+	bool operator == (const ExponentKey& Other) const
+	{
+		return (sig == Other.sig) && (r == Other.r) && (b == Other.b);
+	}
+};
+
+struct ExponentKeyHash		// Hash of the bit patterns of an ExponentKey
+{
+	size_t operator () (const ExponentKey& Key) const
+	{
+		double Values[] = { Key.sig + 0.0, Key.r + 0.0, Key.b + 0.0 };		// Adding 0.0 turns -0.0 into 0.0 so equal keys hash alike
+		size_t Hash = 0;
+		for (double Value : Values)
+		{
+			uint64_t Bits;
+			memcpy(&Bits, &Value, sizeof(Bits));
+			Hash ^= hash<uint64_t>()(Bits) + 0x9e3779b97f4a7c15ULL + (Hash << 6) + (Hash >> 2);
+		}
+		return Hash;
+	}
+};
+
+// CPU FEATURE DETECTION
+#ifdef PERPETUAL_SIMD_X86
+static void CpuId(unsigned int Leaf, unsigned int SubLeaf, unsigned int Regs[4])	// Regs = { eax, ebx, ecx, edx } of cpuid(Leaf, SubLeaf)
+{
+#if defined(_MSC_VER)
+	int Info[4];
+	__cpuidex(Info, static_cast<int>(Leaf), static_cast<int>(SubLeaf));
+	for (int i = 0; i < 4; i++)
+	{
+		Regs[i] = static_cast<unsigned int>(Info[i]);
+	}
+#else
+	__cpuid_count(Leaf, SubLeaf, Regs[0], Regs[1], Regs[2], Regs[3]);
+#endif
+}
+
+static unsigned long long EnabledXStateFeatures()		// XCR0, which register states the OS saves on a context switch
+{
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	unsigned int Low, High;
+	__asm__ volatile("xgetbv" : "=a"(Low), "=d"(High) : "c"(0));
+	return (static_cast<unsigned long long>(High) << 32) | Low;
+#endif
+}
+
+static SimdPath ProbeSimdPath()		// Query cpuid and XCR0 for the widest usable code path
+{
+	unsigned int Regs[4];
+	CpuId(0, 0, Regs);
+	if (Regs[0] < 7)
+	{
+		return Scalar_Path;
+	}
+
+	CpuId(1, 0, Regs);
+	bool OSXSave = (Regs[2] & (1u << 27)) != 0;
+	bool FMA = (Regs[2] & (1u << 12)) != 0;
+	if (!OSXSave)
+	{
+		return Scalar_Path;
+	}
+
+	unsigned long long XCR0 = EnabledXStateFeatures();
+	bool YmmSaved = (XCR0 & 0x6) == 0x6;			// SSE and AVX state
+	bool ZmmSaved = (XCR0 & 0xE6) == 0xE6;			// Plus opmask and both halves of the ZMM state
+
+	CpuId(7, 0, Regs);
+	bool AVX2 = (Regs[1] & (1u << 5)) != 0;
+	bool AVX512F = (Regs[1] & (1u << 16)) != 0;
+
+	if (AVX512F && ZmmSaved)
+	{
+		return AVX512_Path;
+	}
+	if (AVX2 && FMA && YmmSaved)
+	{
+		return AVX2_Path;
+	}
+	return Scalar_Path;
+}
+#endif
+
+SimdPath DetectSimdPath()		// Widest code path supported by this CPU and OS, detected once and cached
+{
+#ifdef PERPETUAL_SIMD_X86
+	static const SimdPath Detected = ProbeSimdPath();
+	return Detected;
+#else
+	return Scalar_Path;
+#endif
+}
+
+string SimdPathName(SimdPath Path)		// Printable name of a code path
+{
+	switch (Path)
+	{
+	case (AVX2_Path):
+		return "AVX2";
+	case (AVX512_Path):
+		return "AVX-512";
+	default:
+		return "Scalar";
+	}
+}
+
+// KERNELS
+void PowerKernelScalar(size_t n, const double* K, const double* U, const double* Y1, const double* C1, const double* Y2, const double* C2, double* Call, double* Put)
+{
+	PowerKernelRange<ScalarLanes>(n, K, U, Y1, C1, Y2, C2, Call, Put);
+}
+
+static void PriceRows(SimdPath Path, const PerpAmerOptBatch& Data, const PerpAmerOptExponentPlan& Plan, size_t First, size_t Last, double* Call, double* Put)	// Price rows [First, Last) chunk by chunk
+{
+	alignas(CacheLineSize) double Y1[PowerChunkRows], C1[PowerChunkRows], Y2[PowerChunkRows], C2[PowerChunkRows];
+	const unsigned int* GroupOf = Plan.GroupOf.data();
+
+	for (size_t Begin = First; Begin < Last; Begin += PowerChunkRows)
+	{
+		size_t m = ((Last - Begin) < PowerChunkRows) ? (Last - Begin) : PowerChunkRows;
+		for (size_t j = 0; j < m; j++)		// Gather the group terms of the chunk into contiguous columns
+		{
+			unsigned int g = GroupOf[Begin + j];
+			Y1[j] = Plan.Y1[g];
+			C1[j] = Plan.CallCoef[g];
+			Y2[j] = Plan.Y2[g];
+			C2[j] = Plan.PutCoef[g];
+		}
+
+		const double* K = Data.K.data() + Begin;
+		const double* U = Data.U.data() + Begin;
+		switch (Path)
+		{
+#ifdef PERPETUAL_SIMD_X86
+		case (AVX512_Path):
+			PowerKernelAVX512(m, K, U, Y1, C1, Y2, C2, Call + Begin, Put + Begin);
+			break;
+		case (AVX2_Path):
+			PowerKernelAVX2(m, K, U, Y1, C1, Y2, C2, Call + Begin, Put + Begin);
+			break;
+#endif
+		default:
+			PowerKernelScalar(m, K, U, Y1, C1, Y2, C2, Call + Begin, Put + Begin);
+			break;
+		}
+	}
+}
+
+struct ExponentSlopes		// Terms of one leg of a group that turn dV/dy into vega, rho and carry rho
+{
+	double LogRatio;		// log((y - 1) / y), so dV/dy = V (LogRatio + log(U / K))
+	double dSig;			// dy/dsig
+	double dRate;			// dy/dr + dy/db, r - b held fixed
+	double dCarry;			// dy/db
+};
+
+static ExponentSlopes LegSlopes(double sig, double b, double y)		// Slopes of a leg, zero where the plan marked the leg degenerate with y = 1
+{
+	ExponentSlopes Slopes = { 0.0, 0.0, 0.0, 0.0 };
+	if (y != 1.0)
+	{
+		double dR, dB;
+		PerpKernelExponentDerivatives(sig, b, y, Slopes.dSig, dR, dB);
+		Slopes.LogRatio = log((y - 1) / y);
+		Slopes.dRate = dR + dB;
+		Slopes.dCarry = dB;
+	}
+	return Slopes;
+}
+
+static void LegGreeks(double V, double y, const ExponentSlopes& Slopes, double U, double LogMoneyness, double& Delta, double& Gamma, double& Vega, double& Rho, double& CarryRho)	// Sensitivities of one leg from its price V
+{
+	double dV = V * (Slopes.LogRatio + LogMoneyness);
+	Delta = (y == 1.0) ? 1.0 : (y * V / U);
+	Gamma = y * (y - 1) * V / (U * U);
+	Vega = dV * Slopes.dSig;
+	Rho = dV * Slopes.dRate;
+	CarryRho = dV * Slopes.dCarry;
+}
+
+// PERPAMEROPTBATCH MEMBER FUNCTIONS
+// Constructors
+PerpAmerOptBatch::PerpAmerOptBatch() {}															// Default constructor, creates an empty batch
+
+PerpAmerOptBatch::PerpAmerOptBatch(size_t n) : K(n), sig(n), r(n), U(n), b(n) {}				// Constructor that creates a batch of n zeroed rows
+
+// Destructors
+PerpAmerOptBatch::~PerpAmerOptBatch() {}														// Default destructor
+
+// Functionality
+size_t PerpAmerOptBatch::Size() const		// Number of rows in the batch
+{
+	return K.size();
+}
+
+void PerpAmerOptBatch::Resize(size_t n)		// Resize every column to n rows
+{
+	K.resize(n);
+	sig.resize(n);
+	r.resize(n);
+	U.resize(n);
+	b.resize(n);
+}
+
+void PerpAmerOptBatch::Reserve(size_t n)	// Reserve capacity for n rows in every column
+{
+	K.reserve(n);
+	sig.reserve(n);
+	r.reserve(n);
+	U.reserve(n);
+	b.reserve(n);
+}
+
+void PerpAmerOptBatch::AddRow(double newK, double newSig, double newR, double newU, double newB)	// Append one row of option parameters
+{
+	K.push_back(newK);
+	sig.push_back(newSig);
+	r.push_back(newR);
+	U.push_back(newU);
+	b.push_back(newB);
+}
+
+// PERPAMEROPTBATCHRESULT MEMBER FUNCTIONS
+// Constructors
+PerpAmerOptBatchResult::PerpAmerOptBatchResult() {}										// Default constructor, creates an empty result
+
+PerpAmerOptBatchResult::PerpAmerOptBatchResult(size_t n) : Call(n), Put(n) {}			// Constructor that creates a result of n zeroed rows
+
+// Destructors
+PerpAmerOptBatchResult::~PerpAmerOptBatchResult() {}									// Default destructor
+
+// Functionality
+size_t PerpAmerOptBatchResult::Size() const		// Number of rows in the result
+{
+	return Call.size();
+}
+
+void PerpAmerOptBatchResult::Resize(size_t n)	// Resize both columns to n rows
+{
+	Call.resize(n);
+	Put.resize(n);
+}
+
+// PERPAMEROPTGREEKSRESULT MEMBER FUNCTIONS
+// Constructors
+PerpAmerOptGreeksResult::PerpAmerOptGreeksResult() {}															// Default constructor, creates an empty result
+
+PerpAmerOptGreeksResult::PerpAmerOptGreeksResult(size_t n) : Price(n), Delta(n), Gamma(n), Vega(n), Rho(n), CarryRho(n) {}	// Constructor that creates a result of n zeroed rows
+
+// Destructors
+PerpAmerOptGreeksResult::~PerpAmerOptGreeksResult() {}															// Default destructor
+
+// Functionality
+size_t PerpAmerOptGreeksResult::Size() const		// Number of rows in the result
+{
+	return Price.Size();
+}
+
+void PerpAmerOptGreeksResult::Resize(size_t n)		// Resize every column to n rows
+{
+	PerpAmerOptBatchResult* Columns[] = { &Price, &Delta, &Gamma, &Vega, &Rho, &CarryRho };
+	for (PerpAmerOptBatchResult* Column : Columns)
+	{
+		Column->Resize(n);
+	}
+}
+
+// PERPAMEROPTEXPONENTPLAN MEMBER FUNCTIONS
+// Constructors
+PerpAmerOptExponentPlan::PerpAmerOptExponentPlan() {}									// Default constructor, creates an empty plan
+
+PerpAmerOptExponentPlan::PerpAmerOptExponentPlan(const PerpAmerOptBatch& Data)			// Constructor that plans Data
+{
+	Plan(Data);
+}
+
+// Destructors
+PerpAmerOptExponentPlan::~PerpAmerOptExponentPlan() {}									// Default destructor
+
+// Functionality
+void PerpAmerOptExponentPlan::Plan(const PerpAmerOptBatch& Data)		// Group the rows of Data by (sig, r, b) and compute each group's terms once
+{
+	size_t n = Data.Size();
+	AlignedColumn* Columns[] = { &sig, &r, &b, &Y1, &Y2, &CallCoef, &PutCoef };
+	for (AlignedColumn* Column : Columns)
+	{
+		Column->clear();
+	}
+	GroupOf.resize(n);
+
+	unordered_map<ExponentKey, unsigned int, ExponentKeyHash> Groups;
+	ExponentKey Previous = { 0.0, 0.0, 0.0 };
+	unsigned int PreviousGroup = 0;
+	for (size_t i = 0; i < n; i++)
+	{
+		ExponentKey Key = { Data.sig[i], Data.r[i], Data.b[i] };
+		if ((i > 0) && (Key == Previous))		// Sweeps keep (sig, r, b) fixed, so most rows share the previous row's group
+		{
+			GroupOf[i] = PreviousGroup;
+			continue;
+		}
+
+		unordered_map<ExponentKey, unsigned int, ExponentKeyHash>::iterator Found = Groups.find(Key);
+		if (Found == Groups.end())
+		{
+			Found = Groups.emplace(Key, static_cast<unsigned int>(sig.size())).first;
+			sig.push_back(Key.sig);
+			r.push_back(Key.r);
+			b.push_back(Key.b);
+
+			// Exponents exactly as in CallPrice() and PutPrice(), a degenerate exponent prices as U = K (U / K)^1
+			double y1 = PerpKernelExponent<Call>(Key.sig, Key.r, Key.b);
+			double y2 = PerpKernelExponent<Put>(Key.sig, Key.r, Key.b);
+			bool CallDegenerate = (y1 == 0.0) || (y1 == 1.0);
+			bool PutDegenerate = (y2 == 0.0) || (y2 == 1.0);
+			Y1.push_back(CallDegenerate ? 1.0 : y1);
+			Y2.push_back(PutDegenerate ? 1.0 : y2);
+			CallCoef.push_back(CallDegenerate ? 1.0 : (pow((y1 - 1) / y1, y1) / (y1 - 1)));
+			PutCoef.push_back(PutDegenerate ? 1.0 : (pow((y2 - 1) / y2, y2) / (1 - y2)));
+		}
+		GroupOf[i] = Found->second;
+		Previous = Key;
+		PreviousGroup = Found->second;
+	}
+}
+
+size_t PerpAmerOptExponentPlan::Size() const		// Number of rows planned
+{
+	return GroupOf.size();
+}
+
+size_t PerpAmerOptExponentPlan::GroupCount() const	// Number of distinct (sig, r, b) groups
+{
+	return sig.size();
+}
+
+// GLOBAL BATCH FUNCTIONS
+PerpAmerOptBatch MatrixToBatch(const vector<vector<double>>& DataVec)		// Copy a parameter matrix into a batch
+{
+	PerpAmerOptBatch Batch(DataVec.size());
+	for (size_t i = 0; i < DataVec.size(); i++)
+	{
+		Batch.K[i] = DataVec[i][0];
+		Batch.sig[i] = DataVec[i][1];
+		Batch.r[i] = DataVec[i][2];
+		Batch.U[i] = DataVec[i][3];
+		Batch.b[i] = DataVec[i][4];
+	}
+
+	return Batch;
+}
+
+vector<vector<double>> BatchToMatrix(const PerpAmerOptBatchResult& Result)		// Copy a batch result into a matrix with (call, put) rows
+{
+	vector<vector<double>> Matrix(Result.Size());
+	for (size_t i = 0; i < Result.Size(); i++)
+	{
+		Matrix[i] = { Result.Call[i], Result.Put[i] };
+	}
+
+	return Matrix;
+}
+
+void PriceBatch(const PerpAmerOptBatch& Data, PerpAmerOptBatchResult& Out)		// Call and put prices of every row, on the detected code path
+{
+	PriceBatch(Data, Out, Serial_Execution);
+}
+
+void PriceBatch(const PerpAmerOptBatch& Data, PerpAmerOptBatchResult& Out, const ExecutionPolicy& Policy)		// Call and put prices of every row on Policy's threads
+{
+	PerpAmerOptExponentPlan Plan(Data);
+	PriceBatch(Data, Plan, Out, Policy);
+}
+
+void PriceBatch(const PerpAmerOptBatch& Data, const PerpAmerOptExponentPlan& Plan, PerpAmerOptBatchResult& Out)	// Call and put prices of every row using a plan built from Data
+{
+	PriceBatch(Data, Plan, Out, Serial_Execution);
+}
+
+void PriceBatch(const PerpAmerOptBatch& Data, const PerpAmerOptExponentPlan& Plan, PerpAmerOptBatchResult& Out, const ExecutionPolicy& Policy)	// Call and put prices of every row using a plan on Policy's threads
+{
+	size_t n = Data.Size();
+	if (Plan.Size() != n)
+	{
+		cerr << "ERROR: The exponent plan covers " << Plan.Size() << " rows but the batch has " << n << ". Resorting to a plan of the batch" << endl;
+		PriceBatch(Data, Out, Policy);
+		return;
+	}
+	Out.Resize(n);
+
+	// Every row is priced independently of its neighbours, so a range gives the same values as the whole batch
+	SimdPath Path = DetectSimdPath();
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		PriceRows(Path, Data, Plan, First, Last, Out.Call.data(), Out.Put.data());
+	}, Policy);
+}
+
+void PriceBatch(const PerpAmerOptBatch& Data, const PerpAmerOptExponentPlan& Plan, PerpAmerOptBatchResult& Out, SimdPath Path)	// Call and put prices of every row on a chosen code path
+{
+	size_t n = Data.Size();
+	if (Plan.Size() != n)
+	{
+		cerr << "ERROR: The exponent plan covers " << Plan.Size() << " rows but the batch has " << n << ". Resorting to a plan of the batch" << endl;
+		PriceBatch(Data, PerpAmerOptExponentPlan(Data), Out, Path);
+		return;
+	}
+	Out.Resize(n);
+	if (Path > DetectSimdPath())		// Never run an instruction set the CPU does not have
+	{
+		Path = DetectSimdPath();
+	}
+
+	PriceRows(Path, Data, Plan, 0, n, Out.Call.data(), Out.Put.data());
+}
+
+void GreeksBatch(const PerpAmerOptBatch& Data, PerpAmerOptGreeksResult& Out)		// Prices and sensitivities of every row
+{
+	GreeksBatch(Data, Out, Serial_Execution);
+}
+
+void GreeksBatch(const PerpAmerOptBatch& Data, PerpAmerOptGreeksResult& Out, const ExecutionPolicy& Policy)		// Prices and sensitivities of every row on Policy's threads
+{
+	PerpAmerOptExponentPlan Plan(Data);
+	GreeksBatch(Data, Plan, Out, Policy);
+}
+
+void GreeksBatch(const PerpAmerOptBatch& Data, const PerpAmerOptExponentPlan& Plan, PerpAmerOptGreeksResult& Out)	// Prices and sensitivities of every row using a plan built from Data
+{
+	GreeksBatch(Data, Plan, Out, Serial_Execution);
+}
+
+void GreeksBatch(const PerpAmerOptBatch& Data, const PerpAmerOptExponentPlan& Plan, PerpAmerOptGreeksResult& Out, const ExecutionPolicy& Policy)	// Prices and sensitivities of every row using a plan on Policy's threads
+{
+	size_t n = Data.Size();
+	if (Plan.Size() != n)
+	{
+		cerr << "ERROR: The exponent plan covers " << Plan.Size() << " rows but the batch has " << n << ". Resorting to a plan of the batch" << endl;
+		GreeksBatch(Data, Out, Policy);
+		return;
+	}
+	Out.Resize(n);
+
+	// Slopes of y1 and y2 once per group
+	size_t Groups = Plan.GroupCount();
+	vector<ExponentSlopes> CallSlopes(Groups), PutSlopes(Groups);
+	for (size_t g = 0; g < Groups; g++)
+	{
+		CallSlopes[g] = LegSlopes(Plan.sig[g], Plan.b[g], Plan.Y1[g]);
+		PutSlopes[g] = LegSlopes(Plan.sig[g], Plan.b[g], Plan.Y2[g]);
+	}
+
+	SimdPath Path = DetectSimdPath();
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		PriceRows(Path, Data, Plan, First, Last, Out.Price.Call.data(), Out.Price.Put.data());
+		for (size_t i = First; i < Last; i++)
+		{
+			unsigned int g = Plan.GroupOf[i];
+			double LogMoneyness = log(Data.U[i] / Data.K[i]);		// Shared by both legs
+			LegGreeks(Out.Price.Call[i], Plan.Y1[g], CallSlopes[g], Data.U[i], LogMoneyness, Out.Delta.Call[i], Out.Gamma.Call[i], Out.Vega.Call[i], Out.Rho.Call[i], Out.CarryRho.Call[i]);
+			LegGreeks(Out.Price.Put[i], Plan.Y2[g], PutSlopes[g], Data.U[i], LogMoneyness, Out.Delta.Put[i], Out.Gamma.Put[i], Out.Vega.Put[i], Out.Rho.Put[i], Out.CarryRho.Put[i]);
+		}
+	}, Policy);
+}
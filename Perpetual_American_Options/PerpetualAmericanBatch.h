@@ -0,0 +1,182 @@
+/*	Daniel McNulty II
+*
+*	PerpetualAmericanBatch.h
+*
+*	Batch pricer for perpetual American options. The exponents y1 and y2 and the coefficients in front of
+*	the power term only depend on (sig, r, b), which a strike or underlying sweep keeps constant, so the
+*	rows of a batch are first grouped by (sig, r, b) and each group's terms are computed once. The price
+*	of a row is then K C (U / K)^y, evaluated in vector lanes as K C exp(y log(U / K)) with one log shared
+*	by the call and the put. The code path (AVX-512F, AVX2 + FMA or the portable scalar fallback) is picked
+*	once at runtime from the CPU features. Prices agree with CallPrice()/PutPrice() to within
+*	PerpSimdPriceTolerance times (1 + |y log(U / K)|) relative.
+*
+*	GreeksBatch() adds the analytic delta, gamma, vega, rho and carry rho on top of the batch prices. The
+*	derivatives of y1 and y2 in sig, r and b are also shared by a group, so they are computed once per
+*	group as well.
+*/
+
+#ifndef PerpetualAmericanBatch_H
+#define PerpetualAmericanBatch_H
+
+#include "PerpetualAmericanOption.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+using namespace std;
+
+const size_t CacheLineSize = 64;					// Alignment used for every batch column so each column starts on its own cache line
+const double PerpSimdPriceTolerance = 1e-14;		// Documented relative price tolerance per unit of (1 + |y log(U / K)|) against CallPrice()/PutPrice()
+
+template <class Type, size_t Alignment = CacheLineSize>
+class AlignedAllocator		// Allocator that places the storage of a vector on an Alignment byte boundary
+{
+public:
+	typedef Type value_type;
+
+	template <class Other>
+	struct rebind
+	{
+		typedef AlignedAllocator<Other, Alignment> other;
+	};
+
+	// Constructors
+	AlignedAllocator() {}															// Default constructor
+	template <class Other>
+	AlignedAllocator(const AlignedAllocator<Other, Alignment>&) {}					// Converting copy constructor
+
+	// Functionality
+	Type* allocate(size_t n)														// Allocate aligned storage for n objects of type Type
+	{
+		return static_cast<Type*>(::operator new(n * sizeof(Type), align_val_t(Alignment)));
+	}
+
+	void deallocate(Type* p, size_t)												// Release storage obtained from allocate()
+	{
+		::operator delete(p, align_val_t(Alignment));
+	}
+
+	template <class Other>
+	bool operator == (const AlignedAllocator<Other, Alignment>&) const { return true; }
+	template <class Other>
+	bool operator != (const AlignedAllocator<Other, Alignment>&) const { return false; }
+};
+
+typedef vector<double, AlignedAllocator<double>> AlignedColumn;		// Contiguous, cache line aligned column of doubles
+
+enum SimdPath			// Instruction set used by the vectorized power term
+{
+	Scalar_Path,		// Portable one row at a time fallback
+	AVX2_Path,			// Four rows per vector, needs AVX2 and FMA
+	AVX512_Path			// Eight rows per vector, needs AVX-512F
+};
+
+SimdPath DetectSimdPath();					// Widest code path supported by this CPU and OS, detected once and cached
+string SimdPathName(SimdPath Path);			// Printable name of a code path
+
+class PerpAmerOptBatch		// Structure-of-arrays batch of perpetual American option parameters, one contiguous column per parameter
+{
+public:
+	// Parameter columns, row i of the batch is (K[i], sig[i], r[i], U[i], b[i])
+	AlignedColumn K;		// Strike prices
+	AlignedColumn sig;		// Volatilities
+	AlignedColumn r;		// Risk-free interest rates
+	AlignedColumn U;		// Current prices of the underlying securities
+	AlignedColumn b;		// Costs of carry
+
+	// Constructors
+	PerpAmerOptBatch();								// Default constructor, creates an empty batch
+	PerpAmerOptBatch(size_t n);						// Constructor that creates a batch of n zeroed rows
+	// Destructors
+	virtual ~PerpAmerOptBatch();					// Default destructor
+
+	// Functionality
+	size_t Size() const;							// Number of rows in the batch
+	void Resize(size_t n);							// Resize every column to n rows
+	void Reserve(size_t n);							// Reserve capacity for n rows in every column
+	void AddRow(double newK, double newSig, double newR, double newU, double newB);		// Append one row of option parameters
+};
+
+class PerpAmerOptBatchResult	// Structure-of-arrays output of the batch pricer, call and put values in their own contiguous columns
+{
+public:
+	AlignedColumn Call;		// Call values, Call[i] belongs to row i of the priced batch
+	AlignedColumn Put;		// Put values, Put[i] belongs to row i of the priced batch
+
+	// Constructors
+	PerpAmerOptBatchResult();						// Default constructor, creates an empty result
+	PerpAmerOptBatchResult(size_t n);				// Constructor that creates a result of n zeroed rows
+	// Destructors
+	virtual ~PerpAmerOptBatchResult();				// Default destructor
+
+	// Functionality
+	size_t Size() const;							// Number of rows in the result
+	void Resize(size_t n);							// Resize both columns to n rows
+};
+
+class PerpAmerOptExponentPlan	// Groups of batch rows that share (sig, r, b), with the exponents and coefficients every row of a group uses
+{
+public:
+	// Group columns, entry g holds the terms shared by the rows whose GroupOf is g
+	AlignedColumn sig;				// Volatility
+	AlignedColumn r;				// Risk-free interest rate
+	AlignedColumn b;				// Cost of carry
+	AlignedColumn Y1;				// y1, or 1 where CallPrice() returns U
+	AlignedColumn Y2;				// y2, or 1 where PutPrice() returns U
+	AlignedColumn CallCoef;			// ((y1 - 1) / y1)^y1 / (y1 - 1), so the call is K CallCoef (U / K)^y1
+	AlignedColumn PutCoef;			// ((y2 - 1) / y2)^y2 / (1 - y2), so the put is K PutCoef (U / K)^y2
+
+	vector<unsigned int> GroupOf;	// Group of each row of the planned batch
+
+	// Constructors
+	PerpAmerOptExponentPlan();								// Default constructor, creates an empty plan
+	PerpAmerOptExponentPlan(const PerpAmerOptBatch& Data);	// Constructor that plans Data
+	// Destructors
+	virtual ~PerpAmerOptExponentPlan();						// Default destructor
+
+	// Functionality
+	void Plan(const PerpAmerOptBatch& Data);		// Group the rows of Data by (sig, r, b) and compute each group's terms once, replacing any earlier plan
+	size_t Size() const;							// Number of rows planned
+	size_t GroupCount() const;						// Number of distinct (sig, r, b) groups
+};
+
+class PerpAmerOptGreeksResult	// Structure-of-arrays output of GreeksBatch(), one call and put column pair per output
+{
+public:
+	PerpAmerOptBatchResult Price;		// Option values
+	PerpAmerOptBatchResult Delta;		// dV/dU
+	PerpAmerOptBatchResult Gamma;		// d2V/dU2
+	PerpAmerOptBatchResult Vega;		// dV/dsig
+	PerpAmerOptBatchResult Rho;			// dV/dr with r - b held fixed
+	PerpAmerOptBatchResult CarryRho;	// dV/db
+
+	// Constructors
+	PerpAmerOptGreeksResult();						// Default constructor, creates an empty result
+	PerpAmerOptGreeksResult(size_t n);				// Constructor that creates a result of n zeroed rows
+	// Destructors
+	virtual ~PerpAmerOptGreeksResult();				// Default destructor
+
+	// Functionality
+	size_t Size() const;							// Number of rows in the result
+	void Resize(size_t n);							// Resize every column to n rows
+};
+
+// Conversions between the (K, sig, r, U, b) parameter matrices used by MatrixPricer and the batch types
+PerpAmerOptBatch MatrixToBatch(const vector<vector<double>>& DataVec);				// Copy a parameter matrix into a batch
+vector<vector<double>> BatchToMatrix(const PerpAmerOptBatchResult& Result);		// Copy a batch result into a matrix with (call, put) rows
+
+// Batch pricers, Out is resized to the size of Data. The overloads without a plan build one for the call
+void PriceBatch(const PerpAmerOptBatch& Data, PerpAmerOptBatchResult& Out);										// Call and put prices of every row, on the detected code path
+void PriceBatch(const PerpAmerOptBatch& Data, PerpAmerOptBatchResult& Out, const ExecutionPolicy& Policy);		// As above with the rows spread over Policy's threads
+void PriceBatch(const PerpAmerOptBatch& Data, const PerpAmerOptExponentPlan& Plan, PerpAmerOptBatchResult& Out);	// Call and put prices of every row using a plan built from Data
+void PriceBatch(const PerpAmerOptBatch& Data, const PerpAmerOptExponentPlan& Plan, PerpAmerOptBatchResult& Out, const ExecutionPolicy& Policy);
+void PriceBatch(const PerpAmerOptBatch& Data, const PerpAmerOptExponentPlan& Plan, PerpAmerOptBatchResult& Out, SimdPath Path);	// On a chosen code path (falls back to the detected path if unsupported), calling thread only
+
+// Batch Greeks, the prices come from the batch pricer on the detected code path and the sensitivities from the closed form
+void GreeksBatch(const PerpAmerOptBatch& Data, PerpAmerOptGreeksResult& Out);										// Prices and sensitivities of every row
+void GreeksBatch(const PerpAmerOptBatch& Data, PerpAmerOptGreeksResult& Out, const ExecutionPolicy& Policy);		// As above with the rows spread over Policy's threads
+void GreeksBatch(const PerpAmerOptBatch& Data, const PerpAmerOptExponentPlan& Plan, PerpAmerOptGreeksResult& Out);	// Prices and sensitivities of every row using a plan built from Data
+void GreeksBatch(const PerpAmerOptBatch& Data, const PerpAmerOptExponentPlan& Plan, PerpAmerOptGreeksResult& Out, const ExecutionPolicy& Policy);
+
+#endif
@@ -0,0 +1,111 @@
+/*	Daniel McNulty II
+*
+*	PerpetualAmericanBook.cpp
+*/
+
+#include "PerpetualAmericanBook.h"
+#include <cstring>
+#include <iostream>
+
+using namespace std;
+
+vector<string> PerpetualBookColumns()			// Column names of a perpetual American option book
+{
+	return { "K", "sig", "r", "U", "b" };
+}
+
+vector<string> PerpetualBookResultColumns()		// Column names of the result book written by PricePerpetualBook()
+{
+	return { "call_price", "put_price" };
+}
+
+bool WritePerpetualBook(const string& Path, const vector<vector<double>>& DataVec)		// Write a parameter matrix as a book without option types
+{
+	return WritePerpetualBook(Path, DataVec, vector<OptionType>());
+}
+
+bool WritePerpetualBook(const string& Path, const vector<vector<double>>& DataVec, const vector<OptionType>& Types)	// Write a parameter matrix as a book with the option type of every row
+{
+	size_t n = DataVec.size();
+	bool WithTypes = !Types.empty();
+	if (WithTypes && (Types.size() != n))
+	{
+		cerr << "ERROR: " << Types.size() << " option types were given for a matrix of " << n << " rows" << endl;
+		return false;
+	}
+
+	OptionBookWriter Writer;
+	if (!Writer.Create(Path, Perpetual_Book, n, PerpetualBookColumns(), WithTypes))
+	{
+		return false;
+	}
+
+	// Transpose the rows into the mapped columns
+	for (size_t c = 0; c < 5; c++)
+	{
+		double* Column = Writer.Column(c);
+		for (size_t i = 0; i < n; i++)
+		{
+			Column[i] = DataVec[i][c];
+		}
+	}
+	for (size_t i = 0; WithTypes && (i < n); i++)
+	{
+		Writer.SetType(i, Types[i]);
+	}
+
+	return Writer.Close();
+}
+
+bool PricePerpetualBook(const string& BookPath, const string& ResultPath)		// Price every row of a book into a new result book
+{
+	return PricePerpetualBook(BookPath, ResultPath, Serial_Execution);
+}
+
+bool PricePerpetualBook(const string& BookPath, const string& ResultPath, const ExecutionPolicy& Policy)	// Price every row of a book into a new result book on Policy's threads
+{
+	OptionBook Book;
+	if (!Book.Open(BookPath, Perpetual_Book))
+	{
+		return false;
+	}
+
+	// Columns are found by name, so a book written with its columns in another order still prices correctly
+	vector<string> Names = PerpetualBookColumns();
+	const double* Columns[5];
+	for (size_t c = 0; c < 5; c++)
+	{
+		Columns[c] = Book.Column(Names[c]);
+		if (Columns[c] == nullptr)
+		{
+			cerr << "ERROR: " << BookPath << " has no " << Names[c] << " column" << endl;
+			return false;
+		}
+	}
+
+	size_t n = Book.Size();
+	OptionBookWriter Results;
+	if (!Results.Create(ResultPath, Result_Book, n, PerpetualBookResultColumns(), Book.HasTypes()))
+	{
+		return false;
+	}
+
+	// The pricer reads the mapped book and writes the mapped results, nothing is copied in between
+	const double* K = Columns[0]; const double* sig = Columns[1]; const double* r = Columns[2];
+	const double* U = Columns[3]; const double* b = Columns[4];
+	double* Call = Results.Column(0); double* Put = Results.Column(1);
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		for (size_t i = First; i < Last; i++)
+		{
+			Call[i] = CallPrice(K[i], sig[i], r[i], U[i], b[i]);		// Calculate call price
+			Put[i] = PutPrice(K[i], sig[i], r[i], U[i], b[i]);			// Calculate put price
+		}
+	}, Policy);
+	if (Book.HasTypes() && (n > 0))
+	{
+		memcpy(Results.TypeBits(), Book.TypeBits(), (n + 63) / 64 * sizeof(uint64_t));
+	}
+
+	return Results.Close();
+}
@@ -0,0 +1,29 @@
+/*	Daniel McNulty II
+*
+*	PerpetualAmericanBook.h
+*
+*	Perpetual American option books in the OptionBook format: columns K, sig, r, U and b, plus an
+*	optional option type bitmap. A book is priced straight from its mapped columns into the mapped
+*	call_price and put_price columns of a result book, which carries the same bitmap.
+*/
+
+#ifndef PerpetualAmericanBook_H
+#define PerpetualAmericanBook_H
+
+#include "PerpetualAmericanOption.h"
+#include "OptionBook.h"
+#include "ThreadPool.h"
+#include <string>
+#include <vector>
+using namespace std;
+
+vector<string> PerpetualBookColumns();				// Column names of a perpetual American option book, in (K, sig, r, U, b) order
+vector<string> PerpetualBookResultColumns();		// Column names of the result book written by PricePerpetualBook()
+
+bool WritePerpetualBook(const string& Path, const vector<vector<double>>& DataVec);									// Write a (K, sig, r, U, b) parameter matrix as a book without option types
+bool WritePerpetualBook(const string& Path, const vector<vector<double>>& DataVec, const vector<OptionType>& Types);	// Write a parameter matrix as a book with the option type of every row
+
+bool PricePerpetualBook(const string& BookPath, const string& ResultPath);										// Price every row of a book into a new result book
+bool PricePerpetualBook(const string& BookPath, const string& ResultPath, const ExecutionPolicy& Policy);		// As above with the rows spread over Policy's threads
+
+#endif
@@ -0,0 +1,91 @@
+/*	Daniel McNulty II
+*
+*	PerpetualAmericanDual.cpp
+*/
+
+#include "PerpetualAmericanDual.h"
+
+using namespace std;
+
+static void StoreRow(const double* Partials, size_t i, PerpAmerOptBatch& Out)		// One row of derivatives, in PerpAmerOptParam order, into the columns of Out
+{
+	Out.K[i] = Partials[Strike];
+	Out.sig[i] = Partials[Sigma];
+	Out.r[i] = Partials[Interest];
+	Out.U[i] = Partials[Underlying];
+	Out.b[i] = Partials[Cost_Of_Carry];
+}
+
+// GLOBAL DUAL FUNCTIONS
+PerpAmerOptDual CallDual(double K, double sig, double r, double U, double b)		// Price and gradient of call
+{
+	return PerpAmerOptDualPrice<PerpAmerOptDual>(K, sig, r, U, b, Call);
+}
+
+PerpAmerOptDual PutDual(double K, double sig, double r, double U, double b)		// Price and gradient of put
+{
+	return PerpAmerOptDualPrice<PerpAmerOptDual>(K, sig, r, U, b, Put);
+}
+
+PerpAmerOptDual2 CallDual2(double K, double sig, double r, double U, double b)		// Price, gradient and second derivatives of call
+{
+	return PerpAmerOptDualPrice<PerpAmerOptDual2>(K, sig, r, U, b, Call);
+}
+
+PerpAmerOptDual2 PutDual2(double K, double sig, double r, double U, double b)		// Price, gradient and second derivatives of put
+{
+	return PerpAmerOptDualPrice<PerpAmerOptDual2>(K, sig, r, U, b, Put);
+}
+
+void JacobianBatch(const PerpAmerOptBatch& Data, OptionType Type, AlignedColumn& Price, PerpAmerOptBatch& Gradient)		// Prices and gradients of every row on the calling thread
+{
+	JacobianBatch(Data, Type, Price, Gradient, Serial_Execution);
+}
+
+void JacobianBatch(const PerpAmerOptBatch& Data, OptionType Type, AlignedColumn& Price, PerpAmerOptBatch& Gradient, const ExecutionPolicy& Policy)	// Prices and gradients of every row on Policy's threads
+{
+	size_t n = Data.Size();
+	Price.resize(n);
+	Gradient.Resize(n);
+
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		for (size_t i = First; i < Last; i++)
+		{
+			PerpAmerOptDual Row = PerpAmerOptDualPrice<PerpAmerOptDual>(Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i], Type);
+			Price[i] = Row.Value;
+			StoreRow(Row.d, i, Gradient);
+		}
+	}, Policy);
+}
+
+void HessianBatch(const PerpAmerOptBatch& Data, OptionType Type, AlignedColumn& Price, PerpAmerOptBatch& Gradient, vector<PerpAmerOptBatch>& Hessian)		// Prices, gradients and second derivatives of every row on the calling thread
+{
+	HessianBatch(Data, Type, Price, Gradient, Hessian, Serial_Execution);
+}
+
+void HessianBatch(const PerpAmerOptBatch& Data, OptionType Type, AlignedColumn& Price, PerpAmerOptBatch& Gradient, vector<PerpAmerOptBatch>& Hessian, const ExecutionPolicy& Policy)	// Prices, gradients and second derivatives of every row on Policy's threads
+{
+	size_t n = Data.Size();
+	Price.resize(n);
+	Gradient.Resize(n);
+	Hessian.resize(PerpAmerOptVariables);
+	for (PerpAmerOptBatch& Row : Hessian)
+	{
+		Row.Resize(n);
+	}
+
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		for (size_t i = First; i < Last; i++)
+		{
+			PerpAmerOptDual2 Row = PerpAmerOptDualPrice<PerpAmerOptDual2>(Data.K[i], Data.sig[i], Data.r[i], Data.U[i], Data.b[i], Type);
+			Price[i] = Row.Value.Value;
+			StoreRow(Row.Value.d, i, Gradient);
+			for (int j = 0; j < PerpAmerOptVariables; j++)
+			{
+				StoreRow(Row.d[j].d, i, Hessian[j]);
+			}
+		}
+	}, Policy);
+}
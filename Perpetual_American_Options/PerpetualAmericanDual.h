@@ -0,0 +1,59 @@
+/*	Daniel McNulty II
+*
+*	PerpetualAmericanDual.h
+*
+*	Forward mode sensitivities of the perpetual American price. The templated PerpKernelPrice() runs once
+*	on dual numbers seeded with the five inputs, indexed like PerpAmerOptParam, and returns the price with
+*	its exact gradient, or with the second order duals also every second derivative. The exponent y is a
+*	dual as well, so its dependence on sig, r and b is carried through the quadratic root directly. The
+*	value is identical to CallPrice()/PutPrice(). Where the price degenerates to U the gradient is that of U.
+*/
+
+#ifndef PerpetualAmericanDual_H
+#define PerpetualAmericanDual_H
+
+#include "DualNumber.h"
+#include "PerpetualAmericanBatch.h"
+#include "PerpetualAmericanKernels.h"
+#include "PerpetualAmericanOption.h"
+#include "ThreadPool.h"
+#include <vector>
+using namespace std;
+
+const int PerpAmerOptVariables = 5;									// Inputs (K, sig, r, U, b), d[Strike] is dV/dK and so on
+typedef Dual<PerpAmerOptVariables> PerpAmerOptDual;					// Price and gradient
+typedef Dual<PerpAmerOptVariables, PerpAmerOptDual> PerpAmerOptDual2;	// Price, gradient and second derivatives, d[i].d[j] is d2V/dx_i dx_j
+
+template <class DualType>
+inline DualType PerpAmerOptDualPrice(double K, double sig, double r, double U, double b, OptionType Type)	// Price of one option on duals seeded with the five inputs
+{
+	DualType Inputs[PerpAmerOptVariables];
+	const double Values[PerpAmerOptVariables] = { K, sig, r, U, b };
+	for (int i = 0; i < PerpAmerOptVariables; i++)
+	{
+		Inputs[i] = DualType::Variable(Values[i], i);
+	}
+	if (Type == Call)
+	{
+		return PerpKernelPrice<Call>(Inputs[Strike], Inputs[Sigma], Inputs[Interest], Inputs[Underlying], Inputs[Cost_Of_Carry]);
+	}
+	else
+	{
+		return PerpKernelPrice<Put>(Inputs[Strike], Inputs[Sigma], Inputs[Interest], Inputs[Underlying], Inputs[Cost_Of_Carry]);
+	}
+}
+
+// Single option passes
+PerpAmerOptDual CallDual(double K, double sig, double r, double U, double b);		// Price and gradient of call
+PerpAmerOptDual PutDual(double K, double sig, double r, double U, double b);		// Price and gradient of put
+PerpAmerOptDual2 CallDual2(double K, double sig, double r, double U, double b);		// Price, gradient and second derivatives of call
+PerpAmerOptDual2 PutDual2(double K, double sig, double r, double U, double b);		// Price, gradient and second derivatives of put
+
+// Batch passes, Gradient has the columns of Data with each holding the derivative with respect to that parameter, and
+// Hessian holds one such batch per parameter, Hessian[i].sig[j] being d2V / dx_i dsig for the x_i of PerpAmerOptParam i
+void JacobianBatch(const PerpAmerOptBatch& Data, OptionType Type, AlignedColumn& Price, PerpAmerOptBatch& Gradient);
+void JacobianBatch(const PerpAmerOptBatch& Data, OptionType Type, AlignedColumn& Price, PerpAmerOptBatch& Gradient, const ExecutionPolicy& Policy);
+void HessianBatch(const PerpAmerOptBatch& Data, OptionType Type, AlignedColumn& Price, PerpAmerOptBatch& Gradient, vector<PerpAmerOptBatch>& Hessian);
+void HessianBatch(const PerpAmerOptBatch& Data, OptionType Type, AlignedColumn& Price, PerpAmerOptBatch& Gradient, vector<PerpAmerOptBatch>& Hessian, const ExecutionPolicy& Policy);
+
+#endif
@@ -4,6 +4,9 @@
 */
 
 #include "PerpetualAmericanOption.h"
+#include "PerpetualAmericanKernels.h"
+#include <cmath>
+#include <iostream>
 #include <string>
 #include <vector>
 using namespace std;
@@ -53,6 +56,46 @@ double PerpetualAmericanOption::PriceWithS(double newU) const		// Calculate pric
 		return ::PutPrice(K, sig, r, newU, b);
 	}
 }
+
+double PerpetualAmericanOption::Delta() const				// Calculate the delta of the given option
+{
+	if (optionType == Call)
+		return ::CallDelta(K, sig, r, U, b);
+	else
+		return ::PutDelta(K, sig, r, U, b);
+}
+
+double PerpetualAmericanOption::Gamma() const				// Calculate the gamma of the given option
+{
+	if (optionType == Call)
+		return ::CallGamma(K, sig, r, U, b);
+	else
+		return ::PutGamma(K, sig, r, U, b);
+}
+
+double PerpetualAmericanOption::Vega() const				// Calculate the vega of the given option
+{
+	if (optionType == Call)
+		return ::CallVega(K, sig, r, U, b);
+	else
+		return ::PutVega(K, sig, r, U, b);
+}
+
+double PerpetualAmericanOption::Rho() const				// Calculate the rho of the given option
+{
+	if (optionType == Call)
+		return ::CallRho(K, sig, r, U, b);
+	else
+		return ::PutRho(K, sig, r, U, b);
+}
+
+double PerpetualAmericanOption::CarryRho() const				// Calculate the cost of carry rho of the given option
+{
+	if (optionType == Call)
+		return ::CallCarryRho(K, sig, r, U, b);
+	else
+		return ::PutCarryRho(K, sig, r, U, b);
+}
 											
 // Assignment operator
 PerpetualAmericanOption& PerpetualAmericanOption::operator = (const PerpetualAmericanOption& Opt)
@@ -176,28 +219,103 @@ vector<vector<double>> MatrixPricer(const vector<vector<double>> DataVec)
 	return Prices;
 }
 
-double CallPrice(double K, double sig, double r, double U, double b)			// Call price for a perpetual american option
+vector<vector<double>> GenerateParameterMatrix(double K, double sig, double r, double U, double b, double End_Parameter_Val, int steps, PerpAmerOptParam VariedParameter, const ExecutionPolicy& Policy)	// General Parameter Varying Matrix Generator on Policy's threads
 {
-	double y1 = 0.5 - (b / pow(sig, 2)) + sqrt(pow((0.5 - (b / pow(sig, 2))), 2) + ((2 * r) / pow(sig, 2)));
-	if ((y1 == 0.0) || (y1 == 1.0))
+	vector<double> BaseRow = { K, sig, r, U, b };				// Every row starts as the base parameters
+	int Column = VariedParameter;								// Column of the varied parameter, enum order matches the row layout
+	if ((VariedParameter < Strike) || (VariedParameter > Cost_Of_Carry))
 	{
-		return U;
+		cout << "ERROR: No proper parameter (Strike, Sigma, Interest, Underlying, or Cost_Of_Carry) was chosen. Resorting to default parameter Underlying Price";
+		Column = Underlying;
 	}
-	else
+
+	double Begin = BaseRow[Column];
+	double h = ((End_Parameter_Val - Begin) / steps);			// Same step and formula as GenerateMeshArray() so the values match the serial generators exactly
+	vector<vector<double>> ReturnMatrix(steps + 1, BaseRow);	// Create the return matrix
+	ParallelFor(ReturnMatrix.size(), [&](size_t First, size_t Last)
 	{
-		return ((K / (y1 - 1))*pow((((y1 - 1) / y1)*(U / K)), y1));
-	}
+		for (size_t i = First; i < Last; i++)
+		{
+			ReturnMatrix[i][Column] = Begin + (h * static_cast<int>(i));
+		}
+	}, Policy);
+
+	return ReturnMatrix;
 }
 
-double PutPrice(double K, double sig, double r, double U, double b)				// Put price for a perpetual american option
+vector<vector<double>> MatrixPricer(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy)		// Price vector with the rows spread over Policy's threads
 {
-	double y2 = 0.5 - (b / pow(sig, 2)) - sqrt(pow((0.5 - (b / pow(sig, 2))), 2) + ((2 * r) / pow(sig, 2)));
-	if ((y2 == 0.0) || (y2 == 1.0))
-	{
-		return U;
-	}
-	else
+	vector<vector<double>> Prices(DataVec.size());																	// Rows are filled in place so their order never depends on the threads
+	ParallelFor(DataVec.size(), [&](size_t First, size_t Last)
 	{
-		return ((K / (1 - y2))*pow((((y2 - 1) / y2)*(U / K)), y2));
-	}
-}
\ No newline at end of file
+		for (size_t i = First; i < Last; i++)
+		{
+			double CallP = CallPrice(DataVec[i][0], DataVec[i][1], DataVec[i][2], DataVec[i][3], DataVec[i][4]);	// Calculate call price
+			double PutP = PutPrice(DataVec[i][0], DataVec[i][1], DataVec[i][2], DataVec[i][3], DataVec[i][4]);		// Calculate put price
+
+			Prices[i] = { CallP, PutP };
+		}
+	}, Policy);
+
+	return Prices;
+}
+
+double CallPrice(double K, double sig, double r, double U, double b)			// Call price for a perpetual american option
+{
+	return PerpKernelPrice<Call>(K, sig, r, U, b);
+}
+
+double PutPrice(double K, double sig, double r, double U, double b)				// Put price for a perpetual american option
+{
+	return PerpKernelPrice<Put>(K, sig, r, U, b);
+}
+
+double CallDelta(double K, double sig, double r, double U, double b)		// Delta of call
+{
+	return PerpKernelDelta<Call>(K, sig, r, U, b);
+}
+
+double CallGamma(double K, double sig, double r, double U, double b)		// Gamma of call
+{
+	return PerpKernelGamma<Call>(K, sig, r, U, b);
+}
+
+double CallVega(double K, double sig, double r, double U, double b)		// Vega of call
+{
+	return PerpKernelVega<Call>(K, sig, r, U, b);
+}
+
+double CallRho(double K, double sig, double r, double U, double b)		// Rho of call
+{
+	return PerpKernelRho<Call>(K, sig, r, U, b);
+}
+
+double CallCarryRho(double K, double sig, double r, double U, double b)		// Cost of carry rho of call
+{
+	return PerpKernelCarryRho<Call>(K, sig, r, U, b);
+}
+
+double PutDelta(double K, double sig, double r, double U, double b)		// Delta of put
+{
+	return PerpKernelDelta<Put>(K, sig, r, U, b);
+}
+
+double PutGamma(double K, double sig, double r, double U, double b)		// Gamma of put
+{
+	return PerpKernelGamma<Put>(K, sig, r, U, b);
+}
+
+double PutVega(double K, double sig, double r, double U, double b)		// Vega of put
+{
+	return PerpKernelVega<Put>(K, sig, r, U, b);
+}
+
+double PutRho(double K, double sig, double r, double U, double b)		// Rho of put
+{
+	return PerpKernelRho<Put>(K, sig, r, U, b);
+}
+
+double PutCarryRho(double K, double sig, double r, double U, double b)		// Cost of carry rho of put
+{
+	return PerpKernelCarryRho<Put>(K, sig, r, U, b);
+}
@@ -7,6 +7,7 @@
 #define PerpetualAmericanOption_H
 
 #include "Option.h"
+#include "ThreadPool.h"
 #include <string>
 #include <vector>
 using namespace std;
@@ -37,6 +38,11 @@ public:
 	// Functionality
 	double Price() const;						// Calculate the price of the given option
 	double PriceWithS(double newU) const;		// Calculate price using the set K,sig, r, and b with a different underlying value
+	double Delta() const;						// Calculate the delta of the given option
+	double Gamma() const;						// Calculate the gamma of the given option
+	double Vega() const;						// Calculate the vega of the given option
+	double Rho() const;							// Calculate the rho of the given option, b moves with r so the yield r - b is held fixed
+	double CarryRho() const;					// Calculate the cost of carry rho of the given option
 
 	// Assignment operator
 	PerpetualAmericanOption& operator = (const PerpetualAmericanOption& Opt);
@@ -64,7 +70,23 @@ vector<vector<double>> GenerateUnderlyingMatrix(double K, double sig, double r,
 vector<vector<double>> GenerateCostOfCarryMatrix(double K, double sig, double r, double U, double Start_b, double End_b, int steps);		// Cost of Carry Varying Matrix Generator
 vector<vector<double>> MatrixPricer(vector<vector<double>> DataVec);				// Pricer of an input matrix
 
+// Generator and pricer that spread the rows over Policy's threads, the output is identical to the serial versions above
+vector<vector<double>> GenerateParameterMatrix(double K, double sig, double r, double U, double b, double End_Parameter_Val, int steps, PerpAmerOptParam VariedParameter, const ExecutionPolicy& Policy);
+vector<vector<double>> MatrixPricer(const vector<vector<double>>& DataVec, const ExecutionPolicy& Policy);
+
 double CallPrice(double K, double sig, double r, double U, double b);				// Call price for a perpetual american option
 double PutPrice(double K, double sig, double r, double U, double b);				// Put price for a perpetual american option
 
+// Analytic sensitivities
+double CallDelta(double K, double sig, double r, double U, double b);				// Delta of call
+double CallGamma(double K, double sig, double r, double U, double b);				// Gamma of call
+double CallVega(double K, double sig, double r, double U, double b);				// Vega of call
+double CallRho(double K, double sig, double r, double U, double b);					// Rho of call
+double CallCarryRho(double K, double sig, double r, double U, double b);			// Cost of carry rho of call
+double PutDelta(double K, double sig, double r, double U, double b);				// Delta of put
+double PutGamma(double K, double sig, double r, double U, double b);				// Gamma of put
+double PutVega(double K, double sig, double r, double U, double b);					// Vega of put
+double PutRho(double K, double sig, double r, double U, double b);					// Rho of put
+double PutCarryRho(double K, double sig, double r, double U, double b);				// Cost of carry rho of put
+
 #endif
\ No newline at end of file
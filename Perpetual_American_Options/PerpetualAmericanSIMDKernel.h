@@ -0,0 +1,71 @@
+/*	Daniel McNulty II
+*
+*	PerpetualAmericanSIMDKernel.h
+*
+*	Lane-generic power term kernel of the perpetual American batch pricer, shared by the scalar, AVX2 and
+*	AVX-512 code paths. With the exponent y and the coefficient C of a row's (sig, r, b) group already
+*	known, the price is K C (U / K)^y, evaluated as K C exp(y log(U / K)) with one log shared by the call
+*	and the put. Only PerpetualAmericanBatch.cpp and the instruction set specific translation units include
+*	this header; the instruction set specific units include it after enabling their instruction set.
+*/
+
+#ifndef PerpetualAmericanSIMDKernel_H
+#define PerpetualAmericanSIMDKernel_H
+
+#include "SimdMath.h"
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define PERPETUAL_SIMD_X86		// AVX2 and AVX-512 paths are only built for x86 targets
+#endif
+
+template <class Lanes>
+inline void PowerKernelLanes(size_t i, const double* K, const double* U, const double* Y1, const double* C1, const double* Y2, const double* C2, double* Call, double* Put)	// Price rows i to i + Lanes::Width - 1
+{
+	typedef typename Lanes::Vec Vec;
+
+	Vec vK = Lanes::Load(K + i);
+	Vec LogMoneyness = SimdLog<Lanes>(Lanes::Div(Lanes::Load(U + i), vK));		// log(U / K), shared by both legs
+
+	Lanes::Store(Call + i, Lanes::Mul(Lanes::Mul(vK, Lanes::Load(C1 + i)), SimdExp<Lanes>(Lanes::Mul(Lanes::Load(Y1 + i), LogMoneyness))));
+	Lanes::Store(Put + i, Lanes::Mul(Lanes::Mul(vK, Lanes::Load(C2 + i)), SimdExp<Lanes>(Lanes::Mul(Lanes::Load(Y2 + i), LogMoneyness))));
+}
+
+template <class Lanes>
+inline void PowerKernelRange(size_t n, const double* K, const double* U, const double* Y1, const double* C1, const double* Y2, const double* C2, double* Call, double* Put)	// Price n rows of raw columns
+{
+	size_t i = 0;
+	for (; i + Lanes::Width <= n; i += Lanes::Width)
+	{
+		PowerKernelLanes<Lanes>(i, K, U, Y1, C1, Y2, C2, Call, Put);
+	}
+
+	// Remaining rows go through one padded vector, so the instruction set specific units never instantiate the ScalarLanes code
+	if (i < n)
+	{
+		double In[6][Lanes::Width], Out[2][Lanes::Width];
+		const double* Columns[6] = { K, U, Y1, C1, Y2, C2 };
+		for (size_t c = 0; c < 6; c++)
+		{
+			for (size_t j = 0; j < Lanes::Width; j++)
+			{
+				In[c][j] = Columns[c][(i + j < n) ? (i + j) : (n - 1)];		// Pad with copies of the last row
+			}
+		}
+		PowerKernelLanes<Lanes>(0, In[0], In[1], In[2], In[3], In[4], In[5], Out[0], Out[1]);
+		for (size_t j = 0; i + j < n; j++)
+		{
+			Call[i + j] = Out[0][j];
+			Put[i + j] = Out[1][j];
+		}
+	}
+}
+
+// Per instruction set entry points, each prices n rows of raw columns
+void PowerKernelScalar(size_t n, const double* K, const double* U, const double* Y1, const double* C1, const double* Y2, const double* C2, double* Call, double* Put);
+#ifdef PERPETUAL_SIMD_X86
+void PowerKernelAVX2(size_t n, const double* K, const double* U, const double* Y1, const double* C1, const double* Y2, const double* C2, double* Call, double* Put);
+void PowerKernelAVX512(size_t n, const double* K, const double* U, const double* Y1, const double* C1, const double* Y2, const double* C2, double* Call, double* Put);
+#endif
+
+#endif
@@ -0,0 +1,50 @@
+/*	Daniel McNulty II
+*
+*	PerpetualAmericanStream.cpp
+*/
+
+#include "PerpetualAmericanStream.h"
+#include "PerpetualAmericanBatch.h"
+
+using namespace std;
+
+StreamSummary PricePerpetualStream(FILE* In, FILE* Out, const PerpStreamSettings& Settings)		// Price every record of In and write the results to Out
+{
+	size_t ChunkRows = (Settings.ChunkRows == 0) ? Default_Perp_Stream.ChunkRows : Settings.ChunkRows;
+	RecordReader Reader(In, Settings.Input, 5);
+	RecordWriter Writer(Out, Settings.Output, 2);
+	if (Settings.Header)
+	{
+		Writer.WriteHeader({ "call_price", "put_price" });
+	}
+
+	// One chunk of parameters, exponent plan and results, reused for the whole stream
+	PerpAmerOptBatch Chunk(ChunkRows);
+	PerpAmerOptExponentPlan Plan;
+	PerpAmerOptBatchResult Prices;
+	StreamSummary Summary = { 0, 0, 0, false };
+
+	for (;;)
+	{
+		Chunk.Resize(ChunkRows);
+		double* Columns[5] = { Chunk.K.data(), Chunk.sig.data(), Chunk.r.data(), Chunk.U.data(), Chunk.b.data() };
+		size_t n = Reader.Read(ChunkRows, Columns);
+		if (n == 0)
+		{
+			break;
+		}
+		Chunk.Resize(n);
+
+		Plan.Plan(Chunk);									// Exponents and coefficients once per (sig, r, b) group of the chunk
+		PriceBatch(Chunk, Plan, Prices, Settings.Policy);	// Vectorized power term over the chunk
+		const double* Results[2] = { Prices.Call.data(), Prices.Put.data() };
+
+		Writer.Write(n, Results);
+		Summary.Records += n;
+	}
+
+	Summary.BadRecords = Reader.BadRecordCount();
+	Summary.FirstBadLine = Reader.FirstBadRecordLine();
+	Summary.Failed = !Writer.Flush() || Reader.Failed();
+	return Summary;
+}
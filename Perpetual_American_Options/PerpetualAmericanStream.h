@@ -0,0 +1,31 @@
+/*	Daniel McNulty II
+*
+*	PerpetualAmericanStream.h
+*
+*	Streams perpetual American option records (K, sig, r, U, b) from a file or pipe, prices them a chunk
+*	at a time and writes one (call, put) result record per input record as it goes.
+*/
+
+#ifndef PerpetualAmericanStream_H
+#define PerpetualAmericanStream_H
+
+#include "PerpetualAmericanOption.h"
+#include "RecordStream.h"
+#include "ThreadPool.h"
+#include <cstdio>
+using namespace std;
+
+struct PerpStreamSettings		// How a stream is read, priced and written
+{
+	StreamFormat Input;			// Encoding of the option records
+	StreamFormat Output;		// Encoding of the result records
+	bool Header;				// Write a header line of column names before CSV results
+	size_t ChunkRows;			// Records priced together, bounds the memory used
+	ExecutionPolicy Policy;		// Threads used to price each chunk
+};
+
+const PerpStreamSettings Default_Perp_Stream = { Csv_Format, Csv_Format, false, 65536, Parallel_Execution };
+
+StreamSummary PricePerpetualStream(FILE* In, FILE* Out, const PerpStreamSettings& Settings);	// Price every record of In and write the results to Out
+
+#endif
@@ -0,0 +1,265 @@
+/*	Daniel McNulty II
+*
+*	PerpetualLiveBook.cpp
+*/
+
+#include "PerpetualLiveBook.h"
+#include "PerpetualAmericanKernels.h"
+#include <cmath>
+#include <limits>
+
+using namespace std;
+
+// PERPLIVEGROUP MEMBER FUNCTIONS
+// Constructors
+PerpLiveGroup::PerpLiveGroup(unsigned int newUnderlying, double newSpot) : Underlying(newUnderlying), Spot(newSpot) {}	// Constructor that accepts the underlying ID and its first spot
+
+// Destructors
+PerpLiveGroup::~PerpLiveGroup() {}		// Default destructor
+
+// Functionality
+size_t PerpLiveGroup::Add(size_t OptionId, const PerpetualAmericanOption& Option)		// Append an option and price it at the group's spot
+{
+	// The root and the degenerate case are decided exactly as in CallPrice() and PutPrice()
+	double y = (Option.optionType == Call) ? PerpKernelExponent<Call>(Option.sig, Option.r, Option.b) : PerpKernelExponent<Put>(Option.sig, Option.r, Option.b);
+	if ((y == 0.0) || (y == 1.0))
+	{
+		Exponent.push_back(1.0);
+		Scale.push_back(1.0);
+	}
+	else
+	{
+		double Factor = (Option.optionType == Call) ? (Option.K / (y - 1)) : (Option.K / (1 - y));
+		Exponent.push_back(y);
+		Scale.push_back(Factor * pow(((y - 1) / y) / Option.K, y));
+	}
+	Ids.push_back(OptionId);
+	Price.push_back(0.0);
+	Delta.push_back(0.0);
+	Gamma.push_back(0.0);
+
+	size_t Slot = Ids.size() - 1;
+	Reprice(Slot, Slot + 1);
+	return Slot;
+}
+
+size_t PerpLiveGroup::Remove(size_t Slot)		// Move the last option into Slot
+{
+	size_t Last = Ids.size() - 1;
+	Ids[Slot] = Ids[Last];
+	vector<double>* Columns[] = { &Exponent, &Scale, &Price, &Delta, &Gamma };
+	for (vector<double>* Column : Columns)
+	{
+		(*Column)[Slot] = (*Column)[Last];
+		Column->pop_back();
+	}
+	Ids.pop_back();
+
+	return (Slot < Ids.size()) ? Ids[Slot] : numeric_limits<size_t>::max();
+}
+
+void PerpLiveGroup::Reprice(size_t First, size_t Last)		// Reprice slots [First, Last) at Spot
+{
+	double LogU = log(Spot);		// The only log shared by the whole group
+	for (size_t i = First; i < Last; i++)
+	{
+		double y = Exponent[i];
+		double V = Scale[i] * exp(y * LogU);
+		Price[i] = V;
+		Delta[i] = (y * V) / Spot;
+		Gamma[i] = (y * (y - 1) * V) / (Spot * Spot);
+	}
+}
+
+// PERPLIVEBOOK MEMBER FUNCTIONS
+// Private Functions
+PerpLiveGroup* PerpLiveBook::FindGroup(unsigned int Underlying) const		// Group of an underlying, BookLock must be held
+{
+	unordered_map<unsigned int, size_t>::const_iterator Found = GroupIndex.find(Underlying);
+	return (Found == GroupIndex.end()) ? nullptr : Groups[Found->second].get();
+}
+
+void PerpLiveBook::RepriceGroup(PerpLiveGroup& Group, double Spot, double QueuedSeconds, const ExecutionPolicy& Policy)	// Reprice and publish one group
+{
+	lock_guard<mutex> Guard(Group.Lock);
+	Group.Spot = Spot;
+
+	ParallelFor(Group.Ids.size(), [&](size_t First, size_t Last)
+	{
+		Group.Reprice(First, Last);
+	}, Policy);
+
+	if (Subscriber)
+	{
+		PerpLiveUpdate Update = { Group.Underlying, Spot, QueuedSeconds, Group.Ids.size(), Group.Ids.data(), Group.Price.data(), Group.Delta.data(), Group.Gamma.data() };
+		Subscriber(Update);
+	}
+}
+
+// Constructors
+PerpLiveBook::PerpLiveBook() : LiveOptions(0) {}		// Default constructor
+
+// Destructors
+PerpLiveBook::~PerpLiveBook()		// Destructor that stops the worker
+{
+	Stop();
+}
+
+// Functionality
+size_t PerpLiveBook::AddOption(unsigned int Underlying, const PerpetualAmericanOption& Option)	// Add a position priced at the underlying's latest spot
+{
+	lock_guard<mutex> Guard(BookLock);
+	PerpLiveGroup* Group = FindGroup(Underlying);
+	if (Group == nullptr)
+	{
+		GroupIndex[Underlying] = Groups.size();
+		Groups.push_back(unique_ptr<PerpLiveGroup>(new PerpLiveGroup(Underlying, Option.U)));
+		Group = Groups.back().get();
+	}
+
+	size_t OptionId = Locations.size();
+	lock_guard<mutex> GroupGuard(Group->Lock);
+	Locations.push_back({ Group, Group->Add(OptionId, Option) });
+	LiveOptions++;
+	return OptionId;
+}
+
+void PerpLiveBook::RemoveOption(size_t OptionId)		// Remove a position
+{
+	lock_guard<mutex> Guard(BookLock);
+	if ((OptionId >= Locations.size()) || (Locations[OptionId].Group == nullptr))
+	{
+		return;
+	}
+
+	OptionLocation& Location = Locations[OptionId];
+	lock_guard<mutex> GroupGuard(Location.Group->Lock);
+	size_t Moved = Location.Group->Remove(Location.Slot);
+	if (Moved != numeric_limits<size_t>::max())
+	{
+		Locations[Moved].Slot = Location.Slot;
+	}
+	Location.Group = nullptr;
+	LiveOptions--;
+}
+
+void PerpLiveBook::Subscribe(const function<void(const PerpLiveUpdate&)>& Callback)	// Set the function called with every update
+{
+	lock_guard<mutex> Guard(BookLock);
+	Subscriber = Callback;
+}
+
+PerpLiveQuote PerpLiveBook::Quote(size_t OptionId) const		// Latest outputs of an option
+{
+	lock_guard<mutex> Guard(BookLock);
+	if ((OptionId >= Locations.size()) || (Locations[OptionId].Group == nullptr))
+	{
+		double NaN = numeric_limits<double>::quiet_NaN();
+		return { NaN, NaN, NaN, NaN };
+	}
+
+	const OptionLocation& Location = Locations[OptionId];
+	PerpLiveGroup& Group = *Location.Group;
+	lock_guard<mutex> GroupGuard(Group.Lock);
+	size_t i = Location.Slot;
+	return { Group.Spot, Group.Price[i], Group.Delta[i], Group.Gamma[i] };
+}
+
+size_t PerpLiveBook::OptionCount() const		// Live positions
+{
+	lock_guard<mutex> Guard(BookLock);
+	return LiveOptions;
+}
+
+size_t PerpLiveBook::UnderlyingCount() const	// Underlyings with a group
+{
+	lock_guard<mutex> Guard(BookLock);
+	return Groups.size();
+}
+
+void PerpLiveBook::ApplyTick(unsigned int Underlying, double Spot)		// Reprice the dependent options on the calling thread
+{
+	ApplyTick(Underlying, Spot, Serial_Execution);
+}
+
+void PerpLiveBook::ApplyTick(unsigned int Underlying, double Spot, const ExecutionPolicy& Policy)	// Reprice the dependent options on Policy's threads
+{
+	PerpLiveGroup* Group;
+	{
+		lock_guard<mutex> Guard(BookLock);
+		Group = FindGroup(Underlying);
+	}
+	if (Group != nullptr)		// Groups are never freed, so the pointer stays valid without BookLock
+	{
+		RepriceGroup(*Group, Spot, 0.0, Policy);
+	}
+}
+
+void PerpLiveBook::PostTick(unsigned int Underlying, double Spot)		// Queue a tick from any thread
+{
+	Pending.Post(Underlying, Spot);
+}
+
+size_t PerpLiveBook::ProcessTicks()				// Reprice every underlying with a queued tick on the calling thread
+{
+	return ProcessTicks(Serial_Execution);
+}
+
+size_t PerpLiveBook::ProcessTicks(const ExecutionPolicy& Policy)		// Reprice every underlying with a queued tick on Policy's threads
+{
+	lock_guard<mutex> Guard(ProcessLock);
+	size_t n = Pending.Drain(Draining);
+	chrono::steady_clock::time_point Now = chrono::steady_clock::now();
+
+	// Look every group up once, then reprice them without holding the book lock
+	vector<PerpLiveGroup*> Targets(n);
+	{
+		lock_guard<mutex> BookGuard(BookLock);
+		for (size_t t = 0; t < n; t++)
+		{
+			Targets[t] = FindGroup(Draining[t].Underlying);
+		}
+	}
+
+	size_t Repriced = 0;
+	for (size_t t = 0; t < n; t++)
+	{
+		Repriced += (Targets[t] != nullptr) ? 1 : 0;		// Ticks for underlyings without options are dropped
+	}
+
+	ParallelFor(n, [&](size_t First, size_t Last)
+	{
+		for (size_t t = First; t < Last; t++)
+		{
+			if (Targets[t] != nullptr)
+			{
+				double Queued = chrono::duration<double>(Now - Draining[t].Posted).count();
+				RepriceGroup(*Targets[t], Draining[t].Spot, Queued, Serial_Execution);
+			}
+		}
+	}, Policy);
+
+	return Repriced;
+}
+
+void PerpLiveBook::Start(const ExecutionPolicy& Policy)		// Start a worker that runs ProcessTicks() as ticks arrive
+{
+	Stop();
+	Pending.Restart();
+	Worker = thread([this, Policy]()
+	{
+		while (Pending.Wait())
+		{
+			ProcessTicks(Policy);
+		}
+	});
+}
+
+void PerpLiveBook::Stop()		// Stop the worker after its current pass
+{
+	if (Worker.joinable())
+	{
+		Pending.Stop();
+		Worker.join();
+	}
+}
@@ -0,0 +1,124 @@
+/*	Daniel McNulty II
+*
+*	PerpetualLiveBook.h
+*
+*	Live book of perpetual American options indexed by underlying. With y the root of the option type,
+*	the price formula of CallPrice()/PutPrice() is Scale * U^y, where Scale only depends on K, sig, r and
+*	b. The options of an underlying keep y and Scale as structure-of-arrays columns, so a spot tick costs
+*	one log for the underlying and one exp per dependent option; no other option is touched. Prices agree
+*	with CallPrice()/PutPrice() to rounding, and delta and gamma follow as y V / U and y (y - 1) V / U^2.
+*
+*	Ticks are either applied at once with ApplyTick() or posted from feed threads with PostTick() into a
+*	conflating queue that ProcessTicks() drains, or that a worker started with Start() drains as ticks
+*	arrive. Conflation keeps at most one pending reprice per underlying, so the time from a tick to its
+*	published update is bounded by one pass over the underlyings that ticked, whatever the tick rate.
+*/
+
+#ifndef PerpetualLiveBook_H
+#define PerpetualLiveBook_H
+
+#include "PerpetualAmericanOption.h"
+#include "LiveTicks.h"
+#include "ThreadPool.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+struct PerpLiveQuote		// Latest outputs of one live option
+{
+	double Spot;			// Underlying price the outputs were computed at
+	double Price;			// Option value
+	double Delta;			// dV/dU
+	double Gamma;			// d2V/dU2
+};
+
+struct PerpLiveUpdate		// What a subscriber is given each time an underlying is repriced, the pointers are only valid during the call
+{
+	unsigned int Underlying;	// Underlying ID
+	double Spot;				// Spot the options were repriced at
+	double QueuedSeconds;		// Time from the oldest tick this update covers being posted to the start of the reprice, 0 for ApplyTick()
+	size_t Count;				// Options of the underlying
+	const size_t* OptionIds;	// Option IDs, entry i belongs to the outputs at index i
+	const double* Price;		// Option values
+	const double* Delta;		// dV/dU
+	const double* Gamma;		// d2V/dU2
+};
+
+class PerpLiveGroup		// Options of one underlying with their spot independent terms and latest outputs
+{
+public:
+	mutex Lock;						// Held while the group is repriced, changed or read
+	unsigned int Underlying;		// Underlying ID
+	double Spot;					// Spot of the latest reprice
+	vector<size_t> Ids;				// Option ID of each slot
+	vector<double> Exponent;		// y1 for a call, y2 for a put, 1 where the formula degenerates to V = U
+	vector<double> Scale;			// V / U^y
+	vector<double> Price, Delta, Gamma;		// Latest outputs
+
+	// Constructors
+	PerpLiveGroup(unsigned int Underlying, double Spot);		// Constructor that accepts the underlying ID and its first spot
+	// Destructors
+	virtual ~PerpLiveGroup();									// Default destructor
+
+	// Functionality
+	size_t Add(size_t OptionId, const PerpetualAmericanOption& Option);	// Append an option and price it at the group's spot, returns its slot
+	size_t Remove(size_t Slot);									// Move the last option into Slot, returns the ID of the option moved (or the removed one if it was last)
+	void Reprice(size_t First, size_t Last);					// Reprice slots [First, Last) at Spot
+};
+
+class PerpLiveBook		// Live perpetual American option book indexed by underlying
+{
+private:
+	struct OptionLocation		// Where a live option is stored
+	{
+		PerpLiveGroup* Group;	// Group of its underlying, nullptr once removed
+		size_t Slot;			// Slot within the group
+	};
+
+	mutable mutex BookLock;									// Guards the index below, taken before any group lock
+	unordered_map<unsigned int, size_t> GroupIndex;			// Underlying ID to position in Groups
+	vector<unique_ptr<PerpLiveGroup>> Groups;				// One group per underlying, never freed while the book lives
+	vector<OptionLocation> Locations;						// Location of each option ID
+	size_t LiveOptions;										// Options added and not removed
+	function<void(const PerpLiveUpdate&)> Subscriber;		// Called after every reprice of an underlying
+	TickConflator Pending;									// Ticks posted and not yet priced
+	vector<PendingTick> Draining;							// Ticks taken from Pending by the current ProcessTicks() call
+	mutex ProcessLock;										// One ProcessTicks() at a time
+	thread Worker;											// Thread started by Start()
+
+	PerpLiveGroup* FindGroup(unsigned int Underlying) const;						// Group of an underlying, nullptr if it has no options yet, BookLock must be held
+	void RepriceGroup(PerpLiveGroup& Group, double Spot, double QueuedSeconds, const ExecutionPolicy& Policy);	// Reprice and publish one group
+
+public:
+	// Constructors
+	PerpLiveBook();							// Default constructor, creates an empty book
+	// Destructors
+	virtual ~PerpLiveBook();				// Destructor that stops the worker
+
+	// Functionality
+	size_t AddOption(unsigned int Underlying, const PerpetualAmericanOption& Option);	// Add a position priced at the underlying's latest spot (the option's U for a new underlying), returns its option ID
+	void RemoveOption(size_t OptionId);											// Remove a position, its ID is not reused
+	void Subscribe(const function<void(const PerpLiveUpdate&)>& Callback);		// Set the function called with every update before ticks start. It runs on the repricing threads, possibly several at once for different underlyings, and must not call back into the book
+	PerpLiveQuote Quote(size_t OptionId) const;									// Latest outputs of an option, NaN if it was removed
+	size_t OptionCount() const;													// Live positions
+	size_t UnderlyingCount() const;												// Underlyings with a group
+
+	void ApplyTick(unsigned int Underlying, double Spot);									// Reprice the dependent options on the calling thread and publish them
+	void ApplyTick(unsigned int Underlying, double Spot, const ExecutionPolicy& Policy);	// As above with the options spread over Policy's threads
+	void PostTick(unsigned int Underlying, double Spot);									// Queue a tick from any thread, a later tick for the same underlying replaces it
+	size_t ProcessTicks();																	// Reprice every underlying with a queued tick at its latest spot, returns the number repriced
+	size_t ProcessTicks(const ExecutionPolicy& Policy);										// As above with the underlyings spread over Policy's threads
+	void Start(const ExecutionPolicy& Policy);												// Start a worker that runs ProcessTicks() as ticks arrive
+	void Stop();																			// Stop the worker after its current pass
+
+private:
+	PerpLiveBook(const PerpLiveBook& source);					// Not copyable
+	PerpLiveBook& operator = (const PerpLiveBook& source);		// Not assignable
+};
+
+#endif
@@ -0,0 +1,305 @@
+/*	Daniel McNulty II
+*
+*	RecordStream.cpp
+*/
+
+#include "RecordStream.h"
+#include <charconv>
+#include <cstring>
+#include <limits>
+
+using namespace std;
+
+const size_t StreamBufferBytes = 1 << 20;		// Bytes moved per read or write call
+
+// RECORDREADER MEMBER FUNCTIONS
+// Private Functions
+bool RecordReader::Refill()			// Move the unparsed bytes to the front and read more
+{
+	if (SourceDone)
+	{
+		return false;
+	}
+
+	size_t Left = End - Begin;
+	if (Begin > 0)
+	{
+		memmove(Buffer.data(), Buffer.data() + Begin, Left);
+	}
+	Begin = 0;
+	End = Left;
+	if (End == Buffer.size())			// A single line longer than the buffer, let the buffer grow with it
+	{
+		Buffer.resize(2 * Buffer.size());
+	}
+
+	size_t Got = fread(Buffer.data() + End, 1, Buffer.size() - End, Source);
+	End += Got;
+	if (Got == 0)
+	{
+		SourceDone = true;
+	}
+
+	return Got > 0;
+}
+
+bool RecordReader::ParseLine(const char* First, const char* Last, double* Values) const		// Parse one CSV line into Fields values
+{
+	const char* p = First;
+	for (size_t f = 0; f < Fields; f++)
+	{
+		while ((p < Last) && ((*p == ' ') || (*p == '\t')))
+		{
+			p++;
+		}
+		if ((p < Last) && (*p == '+'))		// from_chars does not take a leading plus
+		{
+			p++;
+		}
+
+		from_chars_result Result = from_chars(p, Last, Values[f]);
+		if (Result.ec != errc())
+		{
+			return false;
+		}
+		p = Result.ptr;
+
+		while ((p < Last) && ((*p == ' ') || (*p == '\t')))
+		{
+			p++;
+		}
+		if (f + 1 < Fields)
+		{
+			if ((p == Last) || (*p != ','))
+			{
+				return false;
+			}
+			p++;
+		}
+	}
+
+	return p == Last;		// Extra fields make the record bad rather than silently dropping data
+}
+
+// Constructors
+RecordReader::RecordReader(FILE* Source, StreamFormat Format, size_t Fields) : Source(Source), Format(Format), Fields(Fields), Buffer(StreamBufferBytes), Begin(0), End(0), SourceDone(false), Line(0), FirstRecordSeen(false), BadRecords(0), FirstBadLine(0) {}	// Constructor that accepts the stream, its encoding and the record width
+
+// Destructors
+RecordReader::~RecordReader() {}		// Default destructor
+
+// Functionality
+size_t RecordReader::Read(size_t MaxRecords, double* const* Columns)		// Read up to MaxRecords records into Columns
+{
+	size_t Count = 0;
+	size_t RecordBytes = Fields * sizeof(double);
+	vector<double> Values(Fields);
+
+	if (Format == Binary_Format)
+	{
+		while (Count < MaxRecords)
+		{
+			if ((End - Begin < RecordBytes) && !Refill())
+			{
+				break;		// A trailing partial record is ignored
+			}
+			if (End - Begin < RecordBytes)
+			{
+				continue;
+			}
+
+			// Transpose the packed records in the buffer into the columns
+			size_t Ready = (End - Begin) / RecordBytes;
+			if (Ready > MaxRecords - Count)
+			{
+				Ready = MaxRecords - Count;
+			}
+			for (size_t i = 0; i < Ready; i++, Count++)
+			{
+				memcpy(Values.data(), Buffer.data() + Begin + (i * RecordBytes), RecordBytes);
+				for (size_t f = 0; f < Fields; f++)
+				{
+					Columns[f][Count] = Values[f];
+				}
+			}
+			Begin += Ready * RecordBytes;
+		}
+
+		return Count;
+	}
+
+	while (Count < MaxRecords)
+	{
+		// Find the end of the next line, reading more when the buffer holds only part of it
+		const char* LineEnd = static_cast<const char*>(memchr(Buffer.data() + Begin, '\n', End - Begin));
+		if (LineEnd == nullptr)
+		{
+			if (Refill())
+			{
+				continue;
+			}
+			if (Begin == End)
+			{
+				break;
+			}
+			LineEnd = Buffer.data() + End;		// Last line without a newline
+		}
+
+		const char* First = Buffer.data() + Begin;
+		const char* Last = LineEnd;
+		Begin = (LineEnd == Buffer.data() + End) ? End : static_cast<size_t>(LineEnd - Buffer.data()) + 1;
+		Line++;
+
+		if ((Last > First) && (*(Last - 1) == '\r'))
+		{
+			Last--;
+		}
+		const char* Text = First;
+		while ((Text < Last) && ((*Text == ' ') || (*Text == '\t')))
+		{
+			Text++;
+		}
+		if ((Text == Last) || (*Text == '#'))
+		{
+			continue;		// Blank or comment line
+		}
+
+		bool HeaderCandidate = !FirstRecordSeen;
+		FirstRecordSeen = true;
+		if (ParseLine(First, Last, Values.data()))
+		{
+			for (size_t f = 0; f < Fields; f++)
+			{
+				Columns[f][Count] = Values[f];
+			}
+		}
+		else
+		{
+			bool Header = HeaderCandidate && (((*Text >= 'A') && (*Text <= 'Z')) || ((*Text >= 'a') && (*Text <= 'z')));
+			if (Header)
+			{
+				continue;		// A first line of column names
+			}
+
+			for (size_t f = 0; f < Fields; f++)
+			{
+				Columns[f][Count] = numeric_limits<double>::quiet_NaN();
+			}
+			if (BadRecords++ == 0)
+			{
+				FirstBadLine = Line;
+			}
+		}
+		Count++;
+	}
+
+	return Count;
+}
+
+size_t RecordReader::BadRecordCount() const			// Records that failed to parse so far
+{
+	return BadRecords;
+}
+
+size_t RecordReader::FirstBadRecordLine() const		// CSV line of the first bad record, 0 if there was none
+{
+	return FirstBadLine;
+}
+
+bool RecordReader::Failed() const						// Reading the stream failed
+{
+	return ferror(Source) != 0;
+}
+
+// RECORDWRITER MEMBER FUNCTIONS
+// Private Functions
+void RecordWriter::Drain()		// Write the buffered bytes
+{
+	if ((Used > 0) && (fwrite(Buffer.data(), 1, Used, Sink) != Used))
+	{
+		Failed = true;
+	}
+	Used = 0;
+}
+
+// Constructors
+RecordWriter::RecordWriter(FILE* Sink, StreamFormat Format, size_t Fields) : Sink(Sink), Format(Format), Fields(Fields), Buffer(StreamBufferBytes), Used(0), Failed(false) {}	// Constructor that accepts the stream, its encoding and the record width
+
+// Destructors
+RecordWriter::~RecordWriter()		// Destructor that flushes the buffered records
+{
+	Flush();
+}
+
+// Functionality
+void RecordWriter::WriteHeader(const vector<string>& Names)		// Write a CSV header line
+{
+	if (Format != Csv_Format)
+	{
+		return;
+	}
+
+	string Header;
+	for (size_t f = 0; f < Names.size(); f++)
+	{
+		Header += (f == 0) ? Names[f] : "," + Names[f];
+	}
+	Header += "\n";
+
+	if (Used + Header.size() > Buffer.size())
+	{
+		Drain();
+	}
+	if (Header.size() > Buffer.size())
+	{
+		Buffer.resize(Header.size());
+	}
+	memcpy(Buffer.data() + Used, Header.data(), Header.size());
+	Used += Header.size();
+}
+
+void RecordWriter::Write(size_t n, const double* const* Columns)	// Write n records from Columns
+{
+	if (Format == Binary_Format)
+	{
+		size_t RecordBytes = Fields * sizeof(double);
+		for (size_t i = 0; i < n; i++)
+		{
+			if (Used + RecordBytes > Buffer.size())
+			{
+				Drain();
+			}
+			for (size_t f = 0; f < Fields; f++, Used += sizeof(double))
+			{
+				memcpy(Buffer.data() + Used, &Columns[f][i], sizeof(double));
+			}
+		}
+		return;
+	}
+
+	const size_t MaxFieldChars = 32;		// Shortest round trip form of any double plus a separator
+	for (size_t i = 0; i < n; i++)
+	{
+		if (Used + (Fields * MaxFieldChars) > Buffer.size())
+		{
+			Drain();
+		}
+		char* p = Buffer.data() + Used;
+		for (size_t f = 0; f < Fields; f++)
+		{
+			p = to_chars(p, p + MaxFieldChars - 1, Columns[f][i]).ptr;		// Shortest text that reads back to the same double
+			*p++ = (f + 1 < Fields) ? ',' : '\n';
+		}
+		Used = static_cast<size_t>(p - Buffer.data());
+	}
+}
+
+bool RecordWriter::Flush()		// Write everything buffered and flush Sink
+{
+	Drain();
+	if (fflush(Sink) != 0)
+	{
+		Failed = true;
+	}
+
+	return !Failed;
+}
@@ -0,0 +1,211 @@
+/*	Daniel McNulty II
+*
+*	SimdMath.h
+*
+*	Lane-generic exp, log and standard normal tail functions used by the vectorized pricing kernels.
+*	Every function is a template over a Lanes type which supplies the vector type (Vec), the comparison
+*	mask type (Mask), the lane count (Width) and the primitive operations on them. ScalarLanes below is
+*	the portable one lane version; the AVX2 and AVX-512 versions live in the translation units compiled
+*	for those instruction sets, which must include this header after enabling the instruction set.
+*
+*	Accuracy of the double precision routines (measured against libm/boost over the ranges used by the pricers):
+*		SimdExp			<= 1 ulp for -708 <= x <= 709, arguments outside are clamped to that range
+*		SimdLog			<= 2 ulp for positive normal x
+*		SimdNormTail			<= 2e-16 absolute (Hart 5666 as given by West 2005), exactly 0 for |x| > 37; the relative
+*								error is 1e-15 for |x| < 1 and grows to about 1e-8 in the far tail where N(-|x|) < 1e-15
+*		SimdNormTailFast		<= 1e-11 absolute, n(x) times a degree 9 least squares polynomial in 1 / (1 + 0.3x)
+*		SimdNormTailScreening	<= 7.5e-8 absolute, Abramowitz and Stegun 26.2.17
+*/
+
+#ifndef SimdMath_H
+#define SimdMath_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+struct ScalarLanes		// One lane "vector", used for the portable fallback and for the tail rows of the vector kernels
+{
+	typedef double Vec;
+	typedef bool Mask;
+	static const size_t Width = 1;
+
+	static Vec Load(const double* p) { return *p; }
+	static void Store(double* p, Vec a) { *p = a; }
+	static Vec Set1(double a) { return a; }
+
+	static Vec Add(Vec a, Vec b) { return a + b; }
+	static Vec Sub(Vec a, Vec b) { return a - b; }
+	static Vec Mul(Vec a, Vec b) { return a * b; }
+	static Vec Div(Vec a, Vec b) { return a / b; }
+	static Vec Fma(Vec a, Vec b, Vec c) { return (a * b) + c; }		// a * b + c
+	static Vec Sqrt(Vec a) { return std::sqrt(a); }
+	static Vec Abs(Vec a) { return std::fabs(a); }
+	static Vec Min(Vec a, Vec b) { return (a < b) ? a : b; }
+	static Vec Max(Vec a, Vec b) { return (a > b) ? a : b; }
+	static Vec Round(Vec a) { return std::nearbyint(a); }			// Round to nearest integer
+
+	static Mask Less(Vec a, Vec b) { return a < b; }
+	static Mask Greater(Vec a, Vec b) { return a > b; }
+	static Vec Select(Mask m, Vec a, Vec b) { return m ? a : b; }	// a where m is set, b elsewhere
+
+	static Vec Exp2Int(Vec n)		// 2^n for integer valued n in [-1022, 1023]
+	{
+		int64_t Bits = (static_cast<int64_t>(n) + 1023) << 52;
+		double Result;
+		std::memcpy(&Result, &Bits, sizeof(Result));
+		return Result;
+	}
+
+	static Vec Exponent(Vec a)		// Unbiased binary exponent of a positive normal a, as a double
+	{
+		uint64_t Bits;
+		std::memcpy(&Bits, &a, sizeof(Bits));
+		return static_cast<double>(static_cast<int64_t>(Bits >> 52) - 1023);
+	}
+
+	static Vec Mantissa(Vec a)		// Mantissa of a positive normal a, scaled into [1, 2)
+	{
+		uint64_t Bits;
+		std::memcpy(&Bits, &a, sizeof(Bits));
+		Bits = (Bits & 0x000FFFFFFFFFFFFFULL) | 0x3FF0000000000000ULL;
+		double Result;
+		std::memcpy(&Result, &Bits, sizeof(Result));
+		return Result;
+	}
+};
+
+template <class Lanes>
+inline typename Lanes::Vec SimdExp(typename Lanes::Vec x)		// e^x
+{
+	typedef typename Lanes::Vec Vec;
+
+	// Split x = n ln2 + f with |f| <= ln2 / 2, using a two part ln2 so f is exact
+	x = Lanes::Min(Lanes::Max(x, Lanes::Set1(-708.0)), Lanes::Set1(709.0));
+	Vec n = Lanes::Round(Lanes::Mul(x, Lanes::Set1(1.4426950408889634)));
+	Vec f = Lanes::Fma(n, Lanes::Set1(-6.93147180369123816490e-01), x);
+	f = Lanes::Fma(n, Lanes::Set1(-1.90821492927058770002e-10), f);
+
+	// Degree 13 Taylor polynomial of e^f, the truncation error is below 2e-17 on |f| <= ln2 / 2
+	Vec p = Lanes::Set1(1.0 / 6227020800.0);
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0 / 479001600.0));
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0 / 39916800.0));
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0 / 3628800.0));
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0 / 362880.0));
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0 / 40320.0));
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0 / 5040.0));
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0 / 720.0));
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0 / 120.0));
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0 / 24.0));
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0 / 6.0));
+	p = Lanes::Fma(p, f, Lanes::Set1(0.5));
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0));
+	p = Lanes::Fma(p, f, Lanes::Set1(1.0));
+
+	return Lanes::Mul(p, Lanes::Exp2Int(n));
+}
+
+template <class Lanes>
+inline typename Lanes::Vec SimdLog(typename Lanes::Vec x)		// Natural log of a positive normal x
+{
+	typedef typename Lanes::Vec Vec;
+
+	// Write x = 2^e m with sqrt(1/2) <= m < sqrt(2)
+	Vec e = Lanes::Exponent(x);
+	Vec m = Lanes::Mantissa(x);
+	typename Lanes::Mask Big = Lanes::Greater(m, Lanes::Set1(1.4142135623730951));
+	m = Lanes::Select(Big, Lanes::Mul(m, Lanes::Set1(0.5)), m);
+	e = Lanes::Select(Big, Lanes::Add(e, Lanes::Set1(1.0)), e);
+
+	// log(m) = 2 atanh(s) with s = (m - 1) / (m + 1), |s| <= 0.1716, series truncated after s^23
+	Vec s = Lanes::Div(Lanes::Sub(m, Lanes::Set1(1.0)), Lanes::Add(m, Lanes::Set1(1.0)));
+	Vec s2 = Lanes::Mul(s, s);
+	Vec p = Lanes::Set1(1.0 / 23.0);
+	p = Lanes::Fma(p, s2, Lanes::Set1(1.0 / 21.0));
+	p = Lanes::Fma(p, s2, Lanes::Set1(1.0 / 19.0));
+	p = Lanes::Fma(p, s2, Lanes::Set1(1.0 / 17.0));
+	p = Lanes::Fma(p, s2, Lanes::Set1(1.0 / 15.0));
+	p = Lanes::Fma(p, s2, Lanes::Set1(1.0 / 13.0));
+	p = Lanes::Fma(p, s2, Lanes::Set1(1.0 / 11.0));
+	p = Lanes::Fma(p, s2, Lanes::Set1(1.0 / 9.0));
+	p = Lanes::Fma(p, s2, Lanes::Set1(1.0 / 7.0));
+	p = Lanes::Fma(p, s2, Lanes::Set1(1.0 / 5.0));
+	p = Lanes::Fma(p, s2, Lanes::Set1(1.0 / 3.0));
+	Vec LogM = Lanes::Fma(Lanes::Mul(Lanes::Add(s, s), s2), p, Lanes::Add(s, s));
+
+	// e ln2 with the same two part ln2 as SimdExp
+	return Lanes::Fma(e, Lanes::Set1(6.93147180369123816490e-01), Lanes::Fma(e, Lanes::Set1(1.90821492927058770002e-10), LogM));
+}
+
+template <class Lanes>
+inline typename Lanes::Vec SimdNormTail(typename Lanes::Vec XAbs)		// N(-|x|) for XAbs = |x|, so N(x) = 1 - tail for x > 0 and tail otherwise
+{
+	typedef typename Lanes::Vec Vec;
+
+	Vec Exponential = SimdExp<Lanes>(Lanes::Mul(Lanes::Mul(XAbs, XAbs), Lanes::Set1(-0.5)));
+
+	// Hart (1968) rational approximation for |x| < 7.07
+	Vec Num = Lanes::Set1(3.52624965998911e-02);
+	Num = Lanes::Fma(Num, XAbs, Lanes::Set1(0.700383064443688));
+	Num = Lanes::Fma(Num, XAbs, Lanes::Set1(6.37396220353165));
+	Num = Lanes::Fma(Num, XAbs, Lanes::Set1(33.912866078383));
+	Num = Lanes::Fma(Num, XAbs, Lanes::Set1(112.079291497871));
+	Num = Lanes::Fma(Num, XAbs, Lanes::Set1(221.213596169931));
+	Num = Lanes::Fma(Num, XAbs, Lanes::Set1(220.206867912376));
+	Vec Den = Lanes::Set1(8.83883476483184e-02);
+	Den = Lanes::Fma(Den, XAbs, Lanes::Set1(1.75566716318264));
+	Den = Lanes::Fma(Den, XAbs, Lanes::Set1(16.064177579207));
+	Den = Lanes::Fma(Den, XAbs, Lanes::Set1(86.7807322029461));
+	Den = Lanes::Fma(Den, XAbs, Lanes::Set1(296.564248779674));
+	Den = Lanes::Fma(Den, XAbs, Lanes::Set1(637.333633378831));
+	Den = Lanes::Fma(Den, XAbs, Lanes::Set1(793.826512519948));
+	Den = Lanes::Fma(Den, XAbs, Lanes::Set1(440.413735824752));
+	Vec Central = Lanes::Div(Lanes::Mul(Exponential, Num), Den);
+
+	// Continued fraction for the far tail
+	Vec Frac = Lanes::Add(XAbs, Lanes::Div(Lanes::Set1(4.0), Lanes::Add(XAbs, Lanes::Set1(0.65))));
+	Frac = Lanes::Add(XAbs, Lanes::Div(Lanes::Set1(3.0), Frac));
+	Frac = Lanes::Add(XAbs, Lanes::Div(Lanes::Set1(2.0), Frac));
+	Frac = Lanes::Add(XAbs, Lanes::Div(Lanes::Set1(1.0), Frac));
+	Vec Far = Lanes::Div(Exponential, Lanes::Mul(Frac, Lanes::Set1(2.506628274631000502)));
+
+	Vec Tail = Lanes::Select(Lanes::Less(XAbs, Lanes::Set1(7.07106781186547)), Central, Far);
+	return Lanes::Select(Lanes::Greater(XAbs, Lanes::Set1(37.0)), Lanes::Set1(0.0), Tail);
+}
+
+template <class Lanes>
+inline typename Lanes::Vec SimdNormTailFast(typename Lanes::Vec XAbs)		// N(-|x|) to about 1e-11 absolute
+{
+	typedef typename Lanes::Vec Vec;
+
+	Vec t = Lanes::Div(Lanes::Set1(1.0), Lanes::Fma(XAbs, Lanes::Set1(0.3), Lanes::Set1(1.0)));
+	Vec p = Lanes::Set1(-5.49598494828711602e-02);
+	p = Lanes::Fma(p, t, Lanes::Set1(3.97458142331119338e-01));
+	p = Lanes::Fma(p, t, Lanes::Set1(-1.13823530823349426e+00));
+	p = Lanes::Fma(p, t, Lanes::Set1(1.52983986653610386e+00));
+	p = Lanes::Fma(p, t, Lanes::Set1(-9.83921530616127444e-01));
+	p = Lanes::Fma(p, t, Lanes::Set1(7.72502205725403033e-01));
+	p = Lanes::Fma(p, t, Lanes::Set1(1.02912021755491018e-01));
+	p = Lanes::Fma(p, t, Lanes::Set1(3.30058973523820569e-01));
+	p = Lanes::Fma(p, t, Lanes::Set1(2.97659615776330646e-01));
+	Vec Density = Lanes::Mul(Lanes::Set1(0.3989422804014327), SimdExp<Lanes>(Lanes::Mul(Lanes::Mul(XAbs, XAbs), Lanes::Set1(-0.5))));
+	return Lanes::Mul(Density, Lanes::Mul(p, t));
+}
+
+template <class Lanes>
+inline typename Lanes::Vec SimdNormTailScreening(typename Lanes::Vec XAbs)	// N(-|x|) to about 7.5e-8 absolute
+{
+	typedef typename Lanes::Vec Vec;
+
+	Vec t = Lanes::Div(Lanes::Set1(1.0), Lanes::Fma(XAbs, Lanes::Set1(0.2316419), Lanes::Set1(1.0)));
+	Vec p = Lanes::Set1(1.330274429);
+	p = Lanes::Fma(p, t, Lanes::Set1(-1.821255978));
+	p = Lanes::Fma(p, t, Lanes::Set1(1.781477937));
+	p = Lanes::Fma(p, t, Lanes::Set1(-0.356563782));
+	p = Lanes::Fma(p, t, Lanes::Set1(0.319381530));
+	Vec Density = Lanes::Mul(Lanes::Set1(0.3989422804014327), SimdExp<Lanes>(Lanes::Mul(Lanes::Mul(XAbs, XAbs), Lanes::Set1(-0.5))));
+	return Lanes::Mul(Density, Lanes::Mul(p, t));
+}
+
+#endif